@@ -21,12 +21,20 @@
 
 #if defined(DYNAREC_X86_64)
 #include "core/gte.h"
+#include "core/gteprofiler.h"
 #define COP2_CONTROL_OFFSET(reg) ((uintptr_t)&m_regs.CP2C.r[(reg)] - (uintptr_t)this)
 #define COP2_DATA_OFFSET(reg) ((uintptr_t)&m_regs.CP2D.r[(reg)] - (uintptr_t)this)
 
 void DynaRecCPU::recCOP2(uint32_t code) {
     const auto func = m_recGTE[m_regs.code & 0x3F];  // Look up the opcode in our decoding LUT
-    (*this.*func)(code);                             // Jump into the handler to recompile it
+    // The GTE profiler's probes only get compiled in while it runs, and it flushes the blocks when toggled
+    const bool profiled = PCSX::g_emulator->m_gteProfiler->enabled() && PCSX::GTEProfiler::name(code);
+    if (profiled) {
+        gen.mov(arg1, code);
+        call(PCSX::GTEProfiler::enterProbe);
+    }
+    (*this.*func)(code);  // Jump into the handler to recompile it
+    if (profiled) call(PCSX::GTEProfiler::leaveProbe);
 }
 
 void DynaRecCPU::recGTEMove(uint32_t code) {
@@ -22,6 +22,7 @@
 #include <filesystem>
 
 PCSX::Arguments::Arguments(const CommandLine::args& args) {
+    if (args.get<bool>("no-ui") || args.get<bool>("cli")) m_uiDisabled = true;
     if (args.get<bool>("lua_stdout") || args.get<bool>("no-ui") || args.get<bool>("cli")) {
         m_luaStdoutEnabled = true;
     }
@@ -33,6 +33,10 @@ class Arguments {
     Arguments& operator=(const Arguments&) = delete;
     Arguments& operator=(Arguments&&) = delete;
 
+    // Returns true if the emulator runs without any window, nor OpenGL context.
+    // Enabled with the flags -no-ui or -cli.
+    bool isUIDisabled() const { return m_uiDisabled; }
+
     // Returns true if stdout should be enabled.
     // Enabled with the flags -stdout (but not when -tui is used), -no-ui, or -cli.
     bool isStdoutEnabled() const { return m_stdoutEnabled; }
@@ -75,6 +79,7 @@ class Arguments {
     bool isViewportsEnabled() const { return m_viewportsEnabled; }
 
   private:
+    bool m_uiDisabled = false;
     bool m_luaStdoutEnabled = false;
     bool m_stdoutEnabled = false;
     bool m_guiLogsEnabled = true;
@@ -0,0 +1,173 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "core/audiodump.h"
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+#include <algorithm>
+
+#include "core/system.h"
+#include "fmt/format.h"
+
+namespace {
+
+// What Lua gets to keep, in stereo samples, if the vsyncs stop coming for some reason.
+constexpr size_t c_maxLuaFrames = PCSX::AudioDump::SAMPLE_RATE * 2;
+
+void append(std::vector<int16_t> &buffer, const int16_t *samples, size_t frames) {
+    const size_t room = c_maxLuaFrames * 2 - std::min(buffer.size(), c_maxLuaFrames * 2);
+    buffer.insert(buffer.end(), samples, samples + std::min(frames * 2, room));
+}
+
+}  // namespace
+
+// One audio file, encoded synchronously.
+struct PCSX::AudioDump::Output {
+    ~Output() { close(); }
+    std::string open(const std::filesystem::path &path);
+    void write(const int16_t *samples, size_t frames) { m_audio.write(samples, frames); }
+    void close();
+
+  private:
+    AVFormatContext *m_format = nullptr;
+    AudioEncoder m_audio;
+    bool m_headerWritten = false;
+};
+
+std::string PCSX::AudioDump::Output::open(const std::filesystem::path &path) {
+    const auto filename = path.string();
+    if ((avformat_alloc_output_context2(&m_format, nullptr, nullptr, filename.c_str()) < 0) || !m_format) {
+        return fmt::format("Unable to find a container format for {}", filename);
+    }
+    const AVCodec *codec = AudioEncoder::findCodec(m_format);
+    if (!codec) return fmt::format("No audio encoder available for {}", filename);
+    auto error = m_audio.open(m_format, codec);
+    if (!error.empty()) return error;
+
+    if (!(m_format->oformat->flags & AVFMT_NOFILE) &&
+        (avio_open(&m_format->pb, filename.c_str(), AVIO_FLAG_WRITE) < 0)) {
+        return fmt::format("Unable to open {}", filename);
+    }
+    if (avformat_write_header(m_format, nullptr) < 0) return fmt::format("Unable to write the header of {}", filename);
+    m_headerWritten = true;
+    return "";
+}
+
+void PCSX::AudioDump::Output::close() {
+    if (m_headerWritten) {
+        m_audio.flush();
+        av_write_trailer(m_format);
+        m_headerWritten = false;
+    }
+    if (m_format && !(m_format->oformat->flags & AVFMT_NOFILE)) avio_closep(&m_format->pb);
+    if (m_format) avformat_free_context(m_format);
+    m_audio.close();
+    m_format = nullptr;
+}
+
+PCSX::AudioDump::AudioDump() : m_listener(g_system->m_eventBus) {
+    m_listener.listen<Events::GPU::VSync>([this](auto event) {
+        if (enabled()) signalLua();
+    });
+    m_listener.listen<Events::Quitting>([this](auto event) { stop(); });
+}
+
+PCSX::AudioDump::~AudioDump() { stop(); }
+
+std::string PCSX::AudioDump::start(const std::filesystem::path &path, bool stems) {
+    stop();
+    std::unique_lock<std::mutex> l(m_mutex);
+    if (!path.empty()) {
+        m_output = std::make_unique<Output>();
+        auto error = m_output->open(path);
+        for (unsigned v = 0; stems && error.empty() && (v < VOICES); v++) {
+            auto stem = path;
+            stem.replace_extension(fmt::format(".voice{:02}{}", v, path.extension().string()));
+            m_voiceOutputs[v] = std::make_unique<Output>();
+            error = m_voiceOutputs[v]->open(stem);
+        }
+        if (!error.empty()) {
+            close();
+            return error;
+        }
+    }
+    m_cdAudio.clear();
+    m_luaMix.clear();
+    for (auto &buffer : m_luaVoices) buffer.clear();
+    m_frames = 0;
+    m_stems = stems;
+    m_enabled = true;
+    return "";
+}
+
+void PCSX::AudioDump::stop() {
+    std::unique_lock<std::mutex> l(m_mutex);
+    m_enabled = false;
+    m_stems = false;
+    close();
+}
+
+void PCSX::AudioDump::close() {
+    m_output.reset();
+    for (auto &output : m_voiceOutputs) output.reset();
+}
+
+void PCSX::AudioDump::queueAudio(const int16_t *samples, size_t frames, unsigned stream) {
+    std::unique_lock<std::mutex> l(m_mutex);
+    if (!enabled()) return;
+    if (stream != 0) {
+        m_cdAudio.queue(samples, frames);
+        return;
+    }
+
+    std::vector<int16_t> mix(samples, samples + frames * 2);
+    m_cdAudio.mix(mix.data(), frames);
+
+    if (m_output) m_output->write(mix.data(), frames);
+    append(m_luaMix, mix.data(), frames);
+    m_frames += frames;
+}
+
+void PCSX::AudioDump::queueVoice(unsigned voice, const int16_t *samples, size_t frames) {
+    std::unique_lock<std::mutex> l(m_mutex);
+    if (!stems() || (voice >= VOICES)) return;
+    if (m_voiceOutputs[voice]) m_voiceOutputs[voice]->write(samples, frames);
+    append(m_luaVoices[voice], samples, frames);
+}
+
+void PCSX::AudioDump::signalLua() {
+    // Taking the samples out first, as the listeners may very well stop the dump.
+    std::vector<int16_t> mix;
+    std::array<std::vector<int16_t>, VOICES> voices;
+    {
+        std::unique_lock<std::mutex> l(m_mutex);
+        mix.swap(m_luaMix);
+        voices.swap(m_luaVoices);
+    }
+    auto &bus = g_system->m_eventBus;
+    if (!mix.empty()) bus->signal(Events::SPU::Samples{mix.data(), unsigned(mix.size() / 2), -1});
+    for (unsigned v = 0; v < VOICES; v++) {
+        if (voices[v].empty()) continue;
+        bus->signal(Events::SPU::Samples{voices[v].data(), unsigned(voices[v].size() / 2), int(v)});
+    }
+}
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/audioencoder.h"
+#include "support/eventbus.h"
+
+namespace PCSX {
+
+// Dumps the SPU output into audio files, through libavcodec, the format being picked from the file
+// extension, such as wav or flac. Optionally, the dry output of each of the 24 voices, after their
+// volume but before the reverb, goes into its own file too, named after the main one: "music.flac"
+// gets "music.voice00.flac" to "music.voice23.flac". The stems are sample exact with the mix, and
+// a voice which isn't playing gets silence, so that they all stay aligned with each other.
+//
+// Without a file name, nothing gets written, and the samples only go to Lua: at each vsync, the ones
+// produced since the previous one are signaled as SPU::Samples events, for the mix, and for each voice
+// when the stems are on. The files are written as the samples come in, from whichever thread runs the
+// SPU, which is why a dump is best paired with the headless SPU mode, which mixes on the emulation
+// thread as fast as it runs, instead of being paced by the audio device.
+class AudioDump {
+  public:
+    static constexpr unsigned SAMPLE_RATE = AudioEncoder::SAMPLE_RATE;
+    static constexpr unsigned VOICES = 24;
+
+    AudioDump();
+    ~AudioDump();
+
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    bool stems() const { return m_stems.load(std::memory_order_relaxed); }
+    // Returns an error message if any of the files can't be created.
+    std::string start(const std::filesystem::path &path = {}, bool stems = false);
+    // Flushes and finalizes the files.
+    void stop();
+    // Stereo samples dumped since the start.
+    uint64_t frames() const { return m_frames.load(std::memory_order_relaxed); }
+
+    // Interleaved stereo samples, as fed to the audio output, either from the voices (stream 0) or
+    // from the CD (stream 1), which get mixed into the voices ones as they come in.
+    void audio(const int16_t *samples, size_t frames, unsigned stream) {
+        if (enabled()) queueAudio(samples, frames, stream);
+    }
+    // The interleaved stereo samples of one voice, in step with the voices stream given to audio.
+    void voice(unsigned voice, const int16_t *samples, size_t frames) {
+        if (stems()) queueVoice(voice, samples, frames);
+    }
+
+  private:
+    struct Output;
+
+    void queueAudio(const int16_t *samples, size_t frames, unsigned stream);
+    void queueVoice(unsigned voice, const int16_t *samples, size_t frames);
+    void signalLua();
+    void close();
+
+    EventBus::Listener m_listener;
+    std::atomic<bool> m_enabled = false;
+    std::atomic<bool> m_stems = false;
+    std::atomic<uint64_t> m_frames = 0;
+
+    // Everything below can be touched by the SPU thread, under the mutex.
+    std::mutex m_mutex;
+    std::unique_ptr<Output> m_output;
+    std::array<std::unique_ptr<Output>, VOICES> m_voiceOutputs;
+    CDAudioMix m_cdAudio;
+    // The samples for Lua, since the last vsync.
+    std::vector<int16_t> m_luaMix;
+    std::array<std::vector<int16_t>, VOICES> m_luaVoices;
+};
+
+}  // namespace PCSX
@@ -0,0 +1,146 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "core/audioencoder.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/frame.h>
+#include <libswresample/swresample.h>
+}
+
+#include <algorithm>
+
+#include "fmt/format.h"
+
+const AVCodec *PCSX::AudioEncoder::findCodec(const AVFormatContext *format) {
+    const auto codec = format->oformat->audio_codec;
+    return codec != AV_CODEC_ID_NONE ? avcodec_find_encoder(codec) : nullptr;
+}
+
+std::string PCSX::AudioEncoder::open(AVFormatContext *format, const AVCodec *codec) {
+    m_format = format;
+    m_stream = avformat_new_stream(format, nullptr);
+    m_context = avcodec_alloc_context3(codec);
+    if (!m_stream || !m_context) return "Out of memory";
+    AVSampleFormat sampleFormat = AV_SAMPLE_FMT_S16;
+    if (codec->sample_fmts) {
+        sampleFormat = codec->sample_fmts[0];
+        for (auto f = codec->sample_fmts; *f != AV_SAMPLE_FMT_NONE; f++) {
+            if (*f == AV_SAMPLE_FMT_S16) sampleFormat = AV_SAMPLE_FMT_S16;
+        }
+    }
+    m_context->sample_fmt = sampleFormat;
+    m_context->sample_rate = SAMPLE_RATE;
+    av_channel_layout_default(&m_context->ch_layout, 2);
+    m_context->bit_rate = 192000;
+    m_context->time_base = {1, int(SAMPLE_RATE)};
+    if (format->oformat->flags & AVFMT_GLOBALHEADER) m_context->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    if (avcodec_open2(m_context, codec, nullptr) < 0) {
+        return fmt::format("Unable to open the {} audio encoder", codec->name);
+    }
+    avcodec_parameters_from_context(m_stream->codecpar, m_context);
+    m_stream->time_base = m_context->time_base;
+    const bool variable = codec->capabilities & AV_CODEC_CAP_VARIABLE_FRAME_SIZE;
+    m_frameSize = (variable || !m_context->frame_size) ? 1024 : m_context->frame_size;
+
+    AVChannelLayout stereo;
+    av_channel_layout_default(&stereo, 2);
+    if ((swr_alloc_set_opts2(&m_resampler, &m_context->ch_layout, sampleFormat, SAMPLE_RATE, &stereo,
+                             AV_SAMPLE_FMT_S16, SAMPLE_RATE, 0, nullptr) < 0) ||
+        (swr_init(m_resampler) < 0)) {
+        return "Unable to initialize the audio converter";
+    }
+    m_frame = av_frame_alloc();
+    m_packet = av_packet_alloc();
+    if (!m_frame || !m_packet) return "Out of memory";
+    m_frame->format = sampleFormat;
+    m_frame->sample_rate = SAMPLE_RATE;
+    m_frame->nb_samples = m_frameSize;
+    av_channel_layout_copy(&m_frame->ch_layout, &m_context->ch_layout);
+    if (av_frame_get_buffer(m_frame, 0) < 0) return "Out of memory";
+    m_pts = 0;
+    m_pending.clear();
+    return "";
+}
+
+void PCSX::AudioEncoder::write(const int16_t *samples, size_t frames) {
+    m_pending.insert(m_pending.end(), samples, samples + frames * 2);
+    encodePending(false);
+}
+
+void PCSX::AudioEncoder::flush() {
+    if (!opened()) return;
+    encodePending(true);
+    encode(nullptr);
+}
+
+void PCSX::AudioEncoder::encodePending(bool flush) {
+    const size_t frameSamples = m_frameSize * 2;
+    // The last frame gets padded with silence.
+    if (flush && (m_pending.size() % frameSamples)) {
+        m_pending.resize(m_pending.size() + frameSamples - (m_pending.size() % frameSamples), 0);
+    }
+    size_t offset = 0;
+    while ((m_pending.size() - offset) >= frameSamples) {
+        if (av_frame_make_writable(m_frame) < 0) break;
+        const uint8_t *in[] = {reinterpret_cast<const uint8_t *>(m_pending.data() + offset)};
+        swr_convert(m_resampler, m_frame->data, m_frameSize, in, m_frameSize);
+        m_frame->pts = m_pts;
+        m_pts += m_frameSize;
+        encode(m_frame);
+        offset += frameSamples;
+    }
+    m_pending.erase(m_pending.begin(), m_pending.begin() + offset);
+}
+
+void PCSX::AudioEncoder::encode(AVFrame *frame) {
+    if (avcodec_send_frame(m_context, frame) < 0) return;
+    while (avcodec_receive_packet(m_context, m_packet) >= 0) {
+        av_packet_rescale_ts(m_packet, m_context->time_base, m_stream->time_base);
+        m_packet->stream_index = m_stream->index;
+        // This takes over the packet's data, and resets it.
+        av_interleaved_write_frame(m_format, m_packet);
+    }
+}
+
+void PCSX::AudioEncoder::close() {
+    if (m_context) avcodec_free_context(&m_context);
+    if (m_frame) av_frame_free(&m_frame);
+    if (m_packet) av_packet_free(&m_packet);
+    if (m_resampler) swr_free(&m_resampler);
+    m_format = nullptr;
+    m_stream = nullptr;
+    m_pending.clear();
+}
+
+void PCSX::CDAudioMix::queue(const int16_t *samples, size_t frames) {
+    constexpr size_t maxSamples = AudioEncoder::SAMPLE_RATE * 2;
+    const size_t room = maxSamples - std::min(m_samples.size(), maxSamples);
+    m_samples.insert(m_samples.end(), samples, samples + std::min(frames * 2, room));
+}
+
+void PCSX::CDAudioMix::mix(int16_t *samples, size_t frames) {
+    const size_t mixed = std::min(frames * 2, m_samples.size());
+    for (size_t i = 0; i < mixed; i++) samples[i] = std::clamp(int(samples[i]) + int(m_samples[i]), -32768, 32767);
+    m_samples.erase(m_samples.begin(), m_samples.begin() + mixed);
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+struct AVCodec;
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVPacket;
+struct AVStream;
+struct SwrContext;
+
+namespace PCSX {
+
+// The audio stream of a libavformat output, fed with the SPU's 44.1kHz stereo samples, and shared by
+// the video recorder and the audio dumps. The format context belongs to the caller, who writes its
+// header once the stream is open, and its trailer once the stream is flushed.
+class AudioEncoder {
+  public:
+    static constexpr unsigned SAMPLE_RATE = 44100;
+
+    ~AudioEncoder() { close(); }
+
+    // The default audio encoder of the format, if it has any, and if it's available.
+    static const AVCodec *findCodec(const AVFormatContext *format);
+    // Adds the audio stream to the format. Returns an error message if anything fails.
+    std::string open(AVFormatContext *format, const AVCodec *codec);
+    bool opened() const { return m_context; }
+    // Interleaved stereo samples, which get encoded as soon as there are enough for a codec frame.
+    void write(const int16_t *samples, size_t frames);
+    // Encodes whatever is left, padded with silence, and drains the encoder.
+    void flush();
+    void close();
+
+  private:
+    void encodePending(bool flush);
+    void encode(AVFrame *frame);
+
+    AVFormatContext *m_format = nullptr;
+    AVCodecContext *m_context = nullptr;
+    AVStream *m_stream = nullptr;
+    AVFrame *m_frame = nullptr;
+    AVPacket *m_packet = nullptr;
+    SwrContext *m_resampler = nullptr;
+    int m_frameSize = 0;
+    int64_t m_pts = 0;
+    std::vector<int16_t> m_pending;
+};
+
+// The SPU output comes as two streams: the voices, and the CD audio, which arrives on its own
+// schedule. This holds the latter until the voices samples it goes with show up.
+class CDAudioMix {
+  public:
+    // Only ever keeping a second of it, in case the voices stopped flowing.
+    void queue(const int16_t *samples, size_t frames);
+    // Adds the queued CD audio into the voices samples, in place.
+    void mix(int16_t *samples, size_t frames);
+    void clear() { m_samples.clear(); }
+
+  private:
+    std::vector<int16_t> m_samples;
+};
+
+}  // namespace PCSX
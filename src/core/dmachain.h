@@ -0,0 +1,84 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace PCSX {
+
+// Walks the linked lists of packets the GPU chained DMA mode transfers, such as ordering tables.
+// Every node starts with a header word, holding the number of packet words following it in its
+// top 8 bits, and the address of the next node in its low 24 bits. Contrary to some documentation,
+// the end of the list isn't only marked by 0xffffff: any next address with bit 23 set will do.
+//
+// A list looping back onto itself is cut at the first node it visits twice. The nodes visited
+// by a walk are stamped with its generation, one stamp per RAM word, so that detecting loops is
+// exact, and that starting a new walk doesn't need to clear anything.
+class DMAChain {
+  public:
+    // Calls packet(words, count, addr) for every node with a payload, in list order, with addr
+    // being the address of its header, and returns how many words the DMA transfers in total,
+    // which is what its timing is based on. The mask wraps the addresses within the RAM.
+    template <typename Packet>
+    uint32_t walk(const uint32_t *memory, uint32_t addr, uint32_t mask, Packet &&packet) {
+        const uint16_t generation = nextGeneration(mask);
+        const auto visited = m_visited.get();
+        uint32_t size = 1;
+
+        do {
+            const uint32_t index = (addr & mask) >> 2;
+            if (visited[index] == generation) break;
+            visited[index] = generation;
+            const uint32_t header = memory[index];
+            const uint32_t count = header >> 24;
+            // Most of the nodes of an ordering table are usually the empty ones an OTC clear
+            // leaves behind, which only need to be followed.
+            if (count != 0) packet(memory + index + 1, count, index << 2);
+            size += count + 1;
+            addr = header & 0xfffffc;
+        } while (!(addr & 0x800000));
+
+        return size;
+    }
+
+  private:
+    uint16_t nextGeneration(uint32_t mask) {
+        const uint32_t words = (mask >> 2) + 1;
+        if (words > m_words) {
+            m_visited.reset(new uint16_t[words]());
+            m_words = words;
+            m_generation = 0;
+        }
+        if (++m_generation == 0) {
+            std::fill_n(m_visited.get(), m_words, 0);
+            m_generation = 1;
+        }
+        return m_generation;
+    }
+
+    std::unique_ptr<uint16_t[]> m_visited;
+    uint32_t m_words = 0;
+    uint16_t m_generation = 0;
+};
+
+}  // namespace PCSX
@@ -65,6 +65,20 @@ void pushEvent(PCSX::Lua L, const PCSX::Events::GUI::JumpToMemory& e) {
     L.settable();
 }
 
+template <>
+void pushEvent(PCSX::Lua L, const PCSX::Events::SPU::Samples& e) {
+    L.newtable();
+    L.push("samples");
+    L.push(reinterpret_cast<const char*>(e.samples), e.frames * 2 * sizeof(int16_t));
+    L.settable();
+    L.push("frames");
+    L.push(lua_Number(e.frames));
+    L.settable();
+    L.push("voice");
+    L.push(lua_Number(e.voice));
+    L.settable();
+}
+
 template <>
 void pushEvent(PCSX::Lua L, const PCSX::Events::Keyboard& e) {
     L.newtable();
@@ -187,6 +201,8 @@ void PCSX::LuaBindings::open_events(Lua L) {
                 createListener<Events::IsoMounted>(L);
             } else if (name == "GPU::Vsync") {
                 createListener<Events::GPU::VSync>(L);
+            } else if (name == "SPU::Samples") {
+                createListener<Events::SPU::Samples>(L);
             } else if (name == "ExecutionFlow::ShellReached") {
                 createListener<Events::ExecutionFlow::ShellReached>(L);
             } else if (name == "ExecutionFlow::Run") {
@@ -0,0 +1,56 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/framecounters.h"
+
+#include "core/system.h"
+#include "fmt/format.h"
+
+PCSX::FrameCountersBase::FrameCountersBase() : m_listener(g_system->m_eventBus) {
+    m_listener.listen<Events::GPU::VSync>([this](auto event) {
+        if (!m_enabled) return;
+        std::string line = endFrame();
+        if (!m_output) return;
+        line += '\n';
+        m_output->write(line.data(), line.size());
+    });
+    m_listener.listen<Events::Quitting>([this](auto event) { stop(); });
+}
+
+std::string PCSX::FrameCountersBase::start(const std::filesystem::path& csv) {
+    stop();
+    if (!csv.empty()) {
+        IO<File> file = new PosixFile(csv, FileOps::TRUNCATE);
+        if (file->failed()) return fmt::format("Unable to create {}", csv.string());
+        std::string header = csvHeader() + '\n';
+        file->write(header.data(), header.size());
+        m_output = file;
+    }
+    clear();
+    m_enabled = true;
+    toggled();
+    return "";
+}
+
+void PCSX::FrameCountersBase::stop() {
+    m_output.reset();
+    if (!m_enabled) return;
+    m_enabled = false;
+    toggled();
+}
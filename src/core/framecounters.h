@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include "support/eventbus.h"
+#include "support/file.h"
+
+namespace PCSX {
+
+// What the per frame profilers have in common: they get started and stopped, count into the
+// frame being emulated, move on to the next one at each VSync, and optionally write each frame
+// as a line of a CSV file. The counters themselves are up to the Frame type of FrameCounters.
+class FrameCountersBase {
+  public:
+    // Starts counting from scratch, and maybe logging to a CSV file. Returns an error message,
+    // or an empty string on success.
+    std::string start(const std::filesystem::path& csv = {});
+    void stop();
+    bool enabled() const { return m_enabled; }
+
+  protected:
+    FrameCountersBase();
+    virtual ~FrameCountersBase() = default;
+    // Called once the counters have been turned on or off.
+    virtual void toggled() {}
+
+  private:
+    virtual void clear() = 0;
+    virtual std::string csvHeader() const = 0;
+    // Closes the current frame, and returns its CSV line.
+    virtual std::string endFrame() = 0;
+
+    EventBus::Listener m_listener;
+    bool m_enabled = false;
+    IO<File> m_output;
+};
+
+// The frames themselves. A Frame has a frame field, which is its number, an operator+= to sum
+// them up, a static csvHeader() and a csvLine(), both without the line feed.
+template <typename Frame>
+class FrameCounters : public FrameCountersBase {
+  public:
+    // The frame being counted, the last complete one, and the sum of all of them since start(),
+    // in which the frame field is the number of frames counted.
+    const Frame& current() const { return m_current; }
+    const Frame& lastFrame() const { return m_last; }
+    const Frame& total() const { return m_total; }
+
+  protected:
+    // Called right before the current frame is closed, for any last counting.
+    virtual void endingFrame() {}
+
+    Frame m_current, m_last, m_total;
+
+  private:
+    void clear() override {
+        m_current = {};
+        m_last = {};
+        m_total = {};
+    }
+    std::string csvHeader() const override { return Frame::csvHeader(); }
+    std::string endFrame() override {
+        endingFrame();
+        m_total += m_current;
+        m_total.frame = m_current.frame + 1;
+        std::string line = m_current.csvLine();
+        m_last = m_current;
+        m_current = {};
+        m_current.frame = m_last.frame + 1;
+        return line;
+    }
+};
+
+}  // namespace PCSX
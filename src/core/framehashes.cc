@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "core/framehashes.h"
+
+#include <sstream>
+
+#include "core/gpu.h"
+#include "core/psxemulator.h"
+#include "core/system.h"
+#include "fmt/format.h"
+
+PCSX::FrameHashes::FrameHashes() : m_listener(g_system->m_eventBus) {
+    m_listener.listen<Events::GPU::VSync>([this](auto event) {
+        if (m_enabled) hashFrame();
+    });
+    m_listener.listen<Events::Quitting>([this](auto event) { stop(); });
+}
+
+std::string PCSX::FrameHashes::start(const std::filesystem::path& output) {
+    stop();
+    try {
+        g_emulator->m_gpu->hashDisplay();
+    } catch (std::runtime_error&) {
+        return "The current GPU can't hash its display";
+    }
+    if (!output.empty()) {
+        IO<File> file = new PosixFile(output, FileOps::TRUNCATE);
+        if (file->failed()) return fmt::format("Unable to create {}", output.string());
+        m_output = file;
+    }
+    m_frame = 0;
+    m_log.clear();
+    m_goldenPosition = 0;
+    m_divergence.reset();
+    m_enabled = true;
+    return "";
+}
+
+void PCSX::FrameHashes::stop() {
+    m_enabled = false;
+    m_output.reset();
+}
+
+std::string PCSX::FrameHashes::loadGolden(const std::filesystem::path& path) {
+    IO<File> file = new PosixFile(path);
+    if (file->failed()) return fmt::format("Unable to open {}", path.string());
+    std::string contents(file->size(), '\0');
+    if (file->read(contents.data(), contents.size()) != ssize_t(contents.size())) {
+        return fmt::format("Unable to read {}", path.string());
+    }
+
+    std::vector<Entry> golden;
+    std::istringstream lines(contents);
+    std::string line;
+    for (unsigned number = 1; std::getline(lines, line); number++) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        std::istringstream fields(line);
+        Entry entry;
+        if (!(fields >> entry.frame >> std::hex >> entry.hash)) {
+            return fmt::format("{}:{}: expected a frame number and a hash", path.string(), number);
+        }
+        if (!golden.empty() && (entry.frame <= golden.back().frame)) {
+            return fmt::format("{}:{}: frames out of order", path.string(), number);
+        }
+        golden.push_back(entry);
+    }
+    m_golden = std::move(golden);
+    m_goldenPosition = 0;
+    m_divergence.reset();
+    return "";
+}
+
+void PCSX::FrameHashes::hashFrame() {
+    const Entry entry = {m_frame++, g_emulator->m_gpu->hashDisplay()};
+    m_log.push_back(entry);
+    if (m_output) {
+        const auto line = fmt::format("{} {:016x}\n", entry.frame, entry.hash);
+        m_output->write(line.data(), line.size());
+    }
+
+    // The golden log may skip some frames, such as the boot ones.
+    if (m_divergence || (m_goldenPosition >= m_golden.size())) return;
+    const auto& expected = m_golden[m_goldenPosition];
+    if (expected.frame != entry.frame) return;
+    m_goldenPosition++;
+    const bool hasUI = !g_system->getArgs().isUIDisabled();
+    if (expected.hash != entry.hash) {
+        m_divergence = Divergence{entry.frame, expected.hash, entry.hash};
+        g_system->log(LogClass::GPU, "Frame %u diverges from the golden log: expected %016x, got %016x\n", entry.frame,
+                      expected.hash, entry.hash);
+        if (hasUI) {
+            g_system->pause();
+        } else {
+            g_system->quit(1);
+        }
+    } else if (m_goldenPosition == m_golden.size()) {
+        g_system->log(LogClass::GPU, "All of the %u frames of the golden log matched\n", m_golden.size());
+        if (!hasUI) g_system->quit(0);
+    }
+}
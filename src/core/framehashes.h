@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "support/eventbus.h"
+#include "support/file.h"
+
+namespace PCSX {
+
+// Hashes the displayed frame at each vsync, so that runs can be compared with each other as lists
+// of integers instead of screenshots. The log can be written to a file as it's produced, and can
+// be checked against a golden log, in which case the emulation stops at the first frame which
+// doesn't match: it pauses with a UI, and exits with code 1 without one. Without a UI, matching all
+// of the golden frames exits with code 0. Both files are text, one "<frame> <hash>" line per frame,
+// the hash being 16 hexadecimal digits. The frames are numbered from the start of the hashing.
+class FrameHashes {
+  public:
+    struct Entry {
+        uint32_t frame;
+        uint64_t hash;
+    };
+    struct Divergence {
+        uint32_t frame;
+        uint64_t expected, actual;
+    };
+
+    FrameHashes();
+    ~FrameHashes() { stop(); }
+
+    // Both return an error message, or an empty string on success.
+    std::string start(const std::filesystem::path& output = {});
+    std::string loadGolden(const std::filesystem::path& path);
+    void stop();
+    bool enabled() const { return m_enabled; }
+
+    const std::vector<Entry>& log() const { return m_log; }
+    const std::optional<Divergence>& divergence() const { return m_divergence; }
+    size_t goldenFrames() const { return m_golden.size(); }
+    size_t goldenMatched() const { return m_goldenPosition; }
+
+  private:
+    void hashFrame();
+
+    EventBus::Listener m_listener;
+    bool m_enabled = false;
+    uint32_t m_frame = 0;
+    std::vector<Entry> m_log;
+    IO<File> m_output;
+    std::vector<Entry> m_golden;
+    size_t m_goldenPosition = 0;
+    std::optional<Divergence> m_divergence;
+};
+
+}  // namespace PCSX
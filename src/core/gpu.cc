@@ -20,8 +20,9 @@
 #include "core/gpu.h"
 
 #include "core/debug.h"
+#include "core/gpucapture.h"
+#include "core/gpucounters.h"
 #include "core/gpulogger.h"
-#include "core/pgxp_mem.h"
 #include "core/psxdma.h"
 #include "core/psxhw.h"
 #include "imgui/imgui.h"
@@ -410,49 +411,6 @@ int PCSX::GPU::init(UI *ui) {
     return initBackend(ui);
 }
 
-inline bool PCSX::GPU::CheckForEndlessLoop(uint32_t laddr) {
-    if (laddr == s_usedAddr[1]) return true;
-    if (laddr == s_usedAddr[2]) return true;
-
-    if (laddr < s_usedAddr[0]) {
-        s_usedAddr[1] = laddr;
-    } else {
-        s_usedAddr[2] = laddr;
-    }
-
-    s_usedAddr[0] = laddr;
-
-    return false;
-}
-
-uint32_t PCSX::GPU::gpuDmaChainSize(uint32_t addr) {
-    uint32_t size;
-    uint32_t DMACommandCounter = 0;
-
-    s_usedAddr[0] = s_usedAddr[1] = s_usedAddr[2] = 0xffffff;
-
-    // initial linked list s_ptr (word)
-    size = 1;
-
-    do {
-        addr &= 0x7ffffc;
-
-        if (DMACommandCounter++ > 2000000) break;
-        if (CheckForEndlessLoop(addr)) break;
-
-        uint32_t head = SWAP_LEu32(*g_emulator->m_mem->getPointer<uint32_t>(addr));
-
-        // # 32-bit blocks to transfer
-        size += head >> 24;
-
-        // next 32-bit pointer
-        addr = head & 0xfffffc;
-        size += 1;
-    } while (!(addr & 0x800000));  // contrary to some documentation, the end-of-linked-list marker is not actually
-                                   // 0xFF'FFFF any pointer with bit 23 set will do.
-    return size;
-}
-
 uint32_t PCSX::GPU::readStatus() {
     uint32_t ret = readStatusInternal();  // Get status from GPU core
 
@@ -508,7 +466,6 @@ void PCSX::GPU::dma(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // GPU
             if (g_emulator->settings.get<Emulator::SettingDebugSettings>().get<Emulator::DebugSettings::Debug>()) {
                 g_emulator->m_debug->checkDMAread(2, madr, size * 4);
             }
-            pgxpMemory(PGXP_ConvertAddress(madr), PGXP_GetMem());
             directDMAWrite(ptr, size, madr);
 
 #if 0
@@ -524,8 +481,7 @@ void PCSX::GPU::dma(uint32_t madr, uint32_t bcr, uint32_t chcr) {  // GPU
         case 0x01000401:  // dma chain
             PSXDMA_LOG("*** DMA 2 - GPU dma chain *** %8.8lx addr = %lx size = %lx\n", chcr, madr, bcr);
 
-            size = gpuDmaChainSize(madr);
-            chainedDMAWrite((uint32_t *)PCSX::g_emulator->m_mem->m_wram, madr & 0x1fffff);
+            size = chainedDMAWrite((uint32_t *)PCSX::g_emulator->m_mem->m_wram, madr & 0x1fffff);
 
             // Tekken 3 = use 1.0 only (not 1.5x)
 
@@ -555,6 +511,7 @@ void PCSX::GPU::writeStatus(uint32_t value) {
     bool gotUnknown = false;
 
     m_statusControl[cmd] = value;
+    g_emulator->m_gpuCapture->gp1(value);
 
     switch (cmd) {
         case 0: {
@@ -623,11 +580,16 @@ void PCSX::GPU::writeStatus(uint32_t value) {
 uint32_t PCSX::GPU::readData() { return m_readFifo.asA<File>()->read<uint32_t>(); }
 
 void PCSX::GPU::writeData(uint32_t value) {
+    GPUCounters::Timer timer(g_emulator->m_gpuCounters.get());
+    g_emulator->m_gpuCapture->gp0(&value, 1, Logged::Origin::DATAWRITE, value);
     Buffer buf(value);
     m_processor->processWrite(buf, Logged::Origin::DATAWRITE, value, 1);
 }
 
 void PCSX::GPU::directDMAWrite(const uint32_t *feed, int transferSize, uint32_t hwAddr) {
+    GPUCounters::Timer timer(g_emulator->m_gpuCounters.get());
+    g_emulator->m_gpuCounters->countDMA(transferSize);
+    g_emulator->m_gpuCapture->gp0(feed, transferSize, Logged::Origin::DIRECT_DMA, hwAddr);
     Buffer buf(feed, transferSize);
     while (!buf.isEmpty()) {
         m_processor->processWrite(buf, Logged::Origin::DIRECT_DMA, hwAddr, transferSize);
@@ -635,37 +597,25 @@ void PCSX::GPU::directDMAWrite(const uint32_t *feed, int transferSize, uint32_t
 }
 
 void PCSX::GPU::directDMARead(uint32_t *dest, int transferSize, uint32_t hwAddr) {
+    g_emulator->m_gpuCounters->countDMA(transferSize);
     m_readFifo->read(dest, transferSize * 4);
 }
 
-void PCSX::GPU::chainedDMAWrite(const uint32_t *memory, uint32_t hwAddr) {
-    uint32_t addr = hwAddr;
-    uint32_t DMACommandCounter = 0;
-
-    s_usedAddr[0] = s_usedAddr[1] = s_usedAddr[2] = 0xffffff;
-
+uint32_t PCSX::GPU::chainedDMAWrite(const uint32_t *memory, uint32_t hwAddr) {
     const bool ramExpansion = PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>();
-
-    do {
-        addr &= ramExpansion ? 0x7ffffc : 0x1ffffc;
-
-        if (DMACommandCounter++ > 2000000) break;
-        if (CheckForEndlessLoop(addr)) break;
-
-        // # 32-bit blocks to transfer
-        addr >>= 2;
-        uint32_t header = memory[addr];
-        uint32_t transferSize = header >> 24;
-        const uint32_t *feed = memory + addr + 1;
-        Buffer buf(feed, transferSize);
-        while (!buf.isEmpty()) {
-            m_processor->processWrite(buf, Logged::Origin::CHAIN_DMA, addr << 2, transferSize);
-        }
-
-        // next 32-bit pointer
-        addr = header & 0xfffffc;
-    } while (!(addr & 0x800000));  // contrary to some documentation, the end-of-linked-list marker is not actually
-                                   // 0xFF'FFFF any pointer with bit 23 set will do.
+    GPUCounters::Timer timer(g_emulator->m_gpuCounters.get());
+
+    const uint32_t words =
+        m_dmaChain.walk(memory, hwAddr, ramExpansion ? 0x7ffffc : 0x1ffffc,
+                        [this](const uint32_t *feed, uint32_t transferSize, uint32_t addr) {
+                            g_emulator->m_gpuCapture->gp0(feed, transferSize, Logged::Origin::CHAIN_DMA, addr);
+                            Buffer buf(feed, transferSize);
+                            while (!buf.isEmpty()) {
+                                m_processor->processWrite(buf, Logged::Origin::CHAIN_DMA, addr, transferSize);
+                            }
+                        });
+    g_emulator->m_gpuCounters->countDMA(words);
+    return words;
 }
 
 void PCSX::GPU::Command::processWrite(Buffer &buf, Logged::Origin origin, uint32_t originValue, uint32_t length) {
@@ -894,7 +844,7 @@ void PCSX::GPU::BlitRamVram::processWrite(Buffer &buf, Logged::Origin origin, ui
         m_state = READ_COMMAND;
         m_gpu->m_defaultProcessor.setActive();
         g_emulator->m_gpuLogger->addNode(*this, origin, origvalue, length);
-        m_gpu->partialUpdateVRAM(x, y, w, h, data.data<uint16_t>(), PartialUpdateVram::Synchronous);
+        m_gpu->write0(this);
     }
 }
 
@@ -1027,6 +977,10 @@ void PCSX::GPU::write0(BlitVramVram *prim) {
     partialUpdateVRAM(dX, dY, w, h, rect.data(), PartialUpdateVram::Synchronous);
 }
 
+void PCSX::GPU::write0(BlitRamVram *prim) {
+    partialUpdateVRAM(prim->x, prim->y, prim->w, prim->h, prim->data.data<uint16_t>(), PartialUpdateVram::Synchronous);
+}
+
 // These technically belong to gpulogger.cc, but due to the templatisation instanciation, they need to be here
 
 template <PCSX::GPU::Shading shading, PCSX::GPU::Shape shape, PCSX::GPU::Textured textured, PCSX::GPU::Blend blend,
@@ -1251,12 +1205,15 @@ void PCSX::GPU::Poly<shading, shape, textured, blend, modulation>::generateStats
     stats.pixelWrites = pixelArea;
     if constexpr (blend == Blend::Semi) {
         stats.pixelReads = pixelArea;
+        stats.semiTransparentPixels = pixelArea;
     }
     stats.texelReads = textureArea;
 }
 
 template <PCSX::GPU::Shading shading, PCSX::GPU::LineType lineType, PCSX::GPU::Blend blend>
 void PCSX::GPU::Line<shading, lineType, blend>::generateStatsInfo() {
+    // The command processors get counted too, not just their logged copies, so start over each time.
+    stats = {};
     unsigned pixels = 0;
     for (unsigned i = 1; i < colors.size(); i++) {
         auto dx = std::abs(x[i] - x[i - 1]);
@@ -1268,9 +1225,11 @@ void PCSX::GPU::Line<shading, lineType, blend>::generateStatsInfo() {
         }
     }
 
+    stats.lines += colors.size() - 1;
     stats.pixelWrites += pixels;
     if constexpr (blend == Blend::Semi) {
         stats.pixelReads += pixels;
+        stats.semiTransparentPixels += pixels;
     }
 }
 
@@ -1298,6 +1257,7 @@ void PCSX::GPU::Rect<size, textured, blend, modulation>::cumulateStats(GPUStats
     }
     if constexpr (blend == Blend::Semi) {
         stats->pixelReads += s;
+        stats->semiTransparentPixels += s;
     }
 }
 
@@ -29,6 +29,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "core/dmachain.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "magic_enum/include/magic_enum/magic_enum_all.hpp"
@@ -71,9 +72,7 @@ class GPU {
     void deserialize(const SaveStateWrapper *);
 
   private:
-    uint32_t s_usedAddr[3];
-    bool CheckForEndlessLoop(uint32_t laddr);
-    uint32_t gpuDmaChainSize(uint32_t addr);
+    DMAChain m_dmaChain;
     virtual void resetBackend() = 0;
 
   public:
@@ -86,8 +85,11 @@ class GPU {
     void writeData(uint32_t gdata);
     void directDMAWrite(const uint32_t *feed, int transferSize, uint32_t hwAddr);
     void directDMARead(uint32_t *dest, int transferSize, uint32_t hwAddr);
-    void chainedDMAWrite(const uint32_t *memory, uint32_t hwAddr);
+    // Returns the number of words transferred, for the DMA timing.
+    uint32_t chainedDMAWrite(const uint32_t *memory, uint32_t hwAddr);
     void writeStatus(uint32_t gdata);
+    // Last word written to GP1 for a given command.
+    uint32_t getStatusControl(uint8_t cmd) const { return m_statusControl[cmd]; }
     virtual void setOpenGLContext() {}
 
     virtual void restoreStatus(uint32_t status) = 0;
@@ -96,7 +98,6 @@ class GPU {
     virtual void addVertex(short sx, short sy, int64_t fx, int64_t fy, int64_t fz) {
         throw std::runtime_error("Not yet implemented");
     }
-    virtual void pgxpMemory(unsigned int addr, unsigned char *pVRAM) {}
     virtual void pgxpCacheVertex(short sx, short sy, const unsigned char *_pVertex) {
         throw std::runtime_error("Not yet implemented");
     }
@@ -115,6 +116,9 @@ class GPU {
 
     static std::unique_ptr<GPU> getSoft();
     static std::unique_ptr<GPU> getOpenGL();
+    // The software renderer, displaying into host memory only, which needs neither a window nor
+    // an OpenGL context.
+    static std::unique_ptr<GPU> getHeadless();
 
     enum class Ownership { BORROW, ACQUIRE };
     virtual Slice getVRAM(Ownership = Ownership::BORROW) = 0;
@@ -128,23 +132,49 @@ class GPU {
         enum { BPP_16, BPP_24 } bpp;
     };
     virtual ScreenShot takeScreenShot() { throw std::runtime_error("Not yet implemented"); }
+    // A hash of the displayed part of the VRAM at its native resolution, along with the size and
+    // depth of the display, so it doesn't depend on the rendering settings.
+    virtual uint64_t hashDisplay() { throw std::runtime_error("Not yet implemented"); }
+
+    // The last frame displayed, as 32 bits pixels with the red component in the lowest byte, for
+    // the backends displaying into host memory. Empty for the others.
+    struct Frame {
+        const uint32_t *pixels = nullptr;
+        unsigned width = 0, height = 0;
+    };
+    virtual Frame getFrame() { return {}; }
+    // The host time spent so far by the backend's own threads, for the backends drawing in the
+    // background, since the backend was started.
+    virtual uint64_t workerNanoseconds() { return 0; }
 
     struct GPUStats {
         unsigned triangles = 0;
         unsigned texturedTriangles = 0;
         unsigned rectangles = 0;
         unsigned sprites = 0;
+        unsigned lines = 0;
+        unsigned fills = 0;
+        unsigned blits = 0;
         unsigned pixelWrites = 0;
         unsigned pixelReads = 0;
         unsigned texelReads = 0;
+        unsigned semiTransparentPixels = 0;
+        unsigned uploadedPixels = 0;
+        unsigned downloadedPixels = 0;
         GPUStats &operator+=(const GPUStats &stats) {
             triangles += stats.triangles;
             texturedTriangles += stats.texturedTriangles;
             rectangles += stats.rectangles;
             sprites += stats.sprites;
+            lines += stats.lines;
+            fills += stats.fills;
+            blits += stats.blits;
             pixelWrites += stats.pixelWrites;
             pixelReads += stats.pixelReads;
             texelReads += stats.texelReads;
+            semiTransparentPixels += stats.semiTransparentPixels;
+            uploadedPixels += stats.uploadedPixels;
+            downloadedPixels += stats.downloadedPixels;
             return *this;
         }
     };
@@ -882,6 +912,9 @@ class GPU {
     virtual void write0(Rect<Size::S16, Textured::Yes, Blend::Semi, Modulation::On> *) = 0;
 
     virtual void write0(BlitVramVram *);
+    // The transfers from the CPU, as opposed to partialUpdateVRAM, which the debugging tools use,
+    // and which isn't subject to the mask bit settings.
+    virtual void write0(BlitRamVram *);
 
     virtual void write0(TPage *) = 0;
     virtual void write0(TWindow *) = 0;
@@ -0,0 +1,236 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/gpucapture.h"
+
+#include <chrono>
+#include <cstring>
+
+#include "core/gpulogger.h"
+#include "core/psxemulator.h"
+#include "core/r3000a.h"
+#include "core/system.h"
+#include "fmt/format.h"
+#include "support/md5.h"
+
+namespace {
+
+// GP1 commands whose last value makes up the display state.
+constexpr uint8_t c_displayControls[] = {3, 4, 5, 6, 7, 8};
+constexpr size_t c_vramSize = 1024 * 512 * sizeof(uint16_t);
+constexpr size_t c_flushThreshold = 1024 * 1024;
+
+}  // namespace
+
+PCSX::GPUCapture::GPUCapture() : m_listener(g_system->m_eventBus) {
+    m_listener.listen<Events::GPU::VSync>([this](auto event) {
+        if (capturing()) recordVBlank();
+    });
+}
+
+bool PCSX::GPUCapture::start(const std::filesystem::path& path) {
+    stop();
+    IO<File> file = new PosixFile(path, FileOps::TRUNCATE);
+    if (file->failed()) return false;
+    m_file = file;
+    m_lastCycle = g_emulator->m_cpu->m_regs.cycle;
+
+    auto& gpu = g_emulator->m_gpu;
+    std::vector<uint32_t> controls;
+    for (auto cmd : c_displayControls) {
+        const uint32_t value = gpu->getStatusControl(cmd);
+        // Only the ones written to since the last reset, which hold their command in the top byte.
+        if ((value >> 24) == cmd) controls.push_back(value);
+    }
+    write32(MAGIC);
+    write32(VERSION);
+    write32(controls.size());
+    for (auto value : controls) write32(value);
+    Slice vram = gpu->getVRAM(GPU::Ownership::BORROW);
+    const auto data = vram.data<uint8_t>();
+    m_buffer.insert(m_buffer.end(), data, data + c_vramSize);
+    flush();
+    return true;
+}
+
+void PCSX::GPUCapture::stop() {
+    if (!capturing()) return;
+    flush();
+    m_file.reset();
+}
+
+void PCSX::GPUCapture::write32(uint32_t value) {
+    for (unsigned i = 0; i < 4; i++) m_buffer.push_back(value >> (i * 8));
+}
+
+void PCSX::GPUCapture::flush() {
+    if (m_buffer.empty()) return;
+    m_file->write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+}
+
+void PCSX::GPUCapture::recordHeader(Record type) {
+    const uint32_t cycle = g_emulator->m_cpu->m_regs.cycle;
+    m_buffer.push_back(uint8_t(type));
+    write32(cycle - m_lastCycle);
+    m_lastCycle = cycle;
+}
+
+void PCSX::GPUCapture::recordGP0(const uint32_t* words, uint32_t count, GPU::Logged::Origin origin, uint32_t value) {
+    recordHeader(Record::GP0);
+    m_buffer.push_back(uint8_t(origin));
+    write32(value);
+    write32(count);
+    for (uint32_t i = 0; i < count; i++) write32(words[i]);
+    if (m_buffer.size() >= c_flushThreshold) flush();
+}
+
+void PCSX::GPUCapture::recordGP1(uint32_t value) {
+    recordHeader(Record::GP1);
+    write32(value);
+}
+
+void PCSX::GPUCapture::recordVBlank() {
+    recordHeader(Record::VBLANK);
+    if (m_buffer.size() >= c_flushThreshold) flush();
+}
+
+std::string PCSX::GPUCapture::replay(GPU* gpu, const std::filesystem::path& path,
+                                     std::function<void(unsigned frame)> vblank) {
+    IO<File> file = new PosixFile(path);
+    if (file->failed()) return fmt::format("Unable to open {}", path.string());
+    std::vector<uint8_t> capture(file->size());
+    if (file->read(capture.data(), capture.size()) != ssize_t(capture.size())) {
+        return fmt::format("Unable to read {}", path.string());
+    }
+
+    size_t ptr = 0;
+    auto available = [&](size_t size) { return (capture.size() - ptr) >= size; };
+    auto read8 = [&]() { return capture[ptr++]; };
+    auto read32 = [&]() {
+        uint32_t value = 0;
+        for (unsigned i = 0; i < 4; i++) value |= uint32_t(capture[ptr++]) << (i * 8);
+        return value;
+    };
+
+    if (!available(12) || (read32() != MAGIC)) return "Not a GPU capture";
+    if (read32() != VERSION) return "Unsupported GPU capture version";
+    const uint32_t controls = read32();
+    if (!available(controls * 4 + c_vramSize)) return "Truncated GPU capture";
+    for (uint32_t i = 0; i < controls; i++) gpu->writeStatus(read32());
+    gpu->partialUpdateVRAM(0, 0, 1024, 512, reinterpret_cast<const uint16_t*>(capture.data() + ptr),
+                           GPU::PartialUpdateVram::Synchronous);
+    ptr += c_vramSize;
+
+    std::vector<uint32_t> words;
+    unsigned frame = 0;
+    while (available(5)) {
+        const auto type = Record(read8());
+        // The timing is only informative for now: the stream is replayed as fast as possible.
+        read32();
+        switch (type) {
+            case Record::GP0: {
+                if (!available(9)) return "Truncated GPU capture";
+                const auto origin = GPU::Logged::Origin(read8());
+                const uint32_t value = read32();
+                const uint32_t count = read32();
+                if (!available(size_t(count) * 4)) return "Truncated GPU capture";
+                words.resize(count);
+                for (auto& word : words) word = read32();
+                if (origin == GPU::Logged::Origin::DATAWRITE) {
+                    for (auto word : words) gpu->writeData(word);
+                } else {
+                    gpu->directDMAWrite(words.data(), count, value);
+                }
+                break;
+            }
+            case Record::GP1:
+                if (!available(4)) return "Truncated GPU capture";
+                gpu->writeStatus(read32());
+                break;
+            case Record::VBLANK:
+                if (vblank) vblank(frame);
+                frame++;
+                break;
+            default:
+                return fmt::format("Unknown record type {} in GPU capture", int(type));
+        }
+    }
+
+    return "";
+}
+
+int PCSX::GPUCapture::benchmark(GPU* gpu, const std::filesystem::path& path, unsigned loops) {
+    auto& logger = g_emulator->m_gpuLogger;
+    auto& eventBus = g_system->m_eventBus;
+
+    // A first pass, with the logger on, to count the pixels each frame draws. The logger
+    // follows the frames through the vsync events.
+    std::vector<uint64_t> pixels;
+    logger->setLogging(true);
+    auto error = replay(gpu, path, [&](unsigned frame) {
+        pixels.push_back(logger->frameStats().pixelWrites);
+        gpu->vblank();
+        eventBus->signal<Events::GPU::VSync>({});
+    });
+    logger->setLogging(false);
+    logger->clearFrameLog();
+    if (!error.empty()) {
+        fmt::print(stderr, "{}\n", error);
+        return 1;
+    }
+
+    // Then the timed passes, with everything rasterized by the end of each frame.
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> times(pixels.size(), 0.0);
+    for (unsigned loop = 0; loop < loops; loop++) {
+        auto start = Clock::now();
+        replay(gpu, path, [&](unsigned frame) {
+            gpu->getVRAM(GPU::Ownership::BORROW);
+            const auto now = Clock::now();
+            times[frame] += std::chrono::duration<double, std::milli>(now - start).count();
+            gpu->vblank();
+            start = Clock::now();
+        });
+    }
+
+    double totalTime = 0.0;
+    uint64_t totalPixels = 0;
+    for (size_t frame = 0; frame < times.size(); frame++) {
+        const double ms = times[frame] / loops;
+        fmt::print("frame {:5}: {:8.3f} ms, {:9} pixels, {:8.2f} Mpixels/s\n", frame, ms, pixels[frame],
+                   ms > 0.0 ? pixels[frame] / (ms * 1000.0) : 0.0);
+        totalTime += ms;
+        totalPixels += pixels[frame];
+    }
+
+    Slice vram = gpu->getVRAM(GPU::Ownership::BORROW);
+    MD5 md5;
+    md5.update(vram);
+    uint8_t digest[16];
+    md5.finish(digest);
+    std::string hash;
+    for (auto byte : digest) hash += fmt::format("{:02x}", byte);
+
+    fmt::print("{} frames, {:.3f} ms per frame on average, {:.2f} Mpixels/s\n", times.size(),
+               times.empty() ? 0.0 : totalTime / times.size(),
+               totalTime > 0.0 ? totalPixels / (totalTime * 1000.0) : 0.0);
+    fmt::print("VRAM md5: {}\n", hash);
+    return 0;
+}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/gpu.h"
+#include "support/eventbus.h"
+#include "support/file.h"
+
+namespace PCSX {
+
+// Records everything sent to the GPU into a file, which can then be replayed without the
+// game, the BIOS, or the rest of the emulated machine. A capture is laid out as:
+//
+//   - a header: the 'PGPU' magic, the format version, and the number of GP1 state words,
+//   - the GP1 state words, as last written for the display settings, replayed first,
+//   - the whole 1024x512 VRAM at the start of the capture,
+//   - a stream of records, each starting with its type and the number of CPU cycles elapsed
+//     since the previous record:
+//       - GP0: the Logged::Origin of the words and its value, the word count, and the words,
+//       - GP1: the written word,
+//       - VBLANK: nothing more.
+//
+// All of the fields are little endian 32 bits words, except for the record types and the
+// origins, which are single bytes. The GP0 drawing state, such as the drawing area or the
+// texture page, isn't part of the header, so captures are best started on a frame boundary,
+// since games usually set all of it up again at the start of every frame.
+class GPUCapture {
+  public:
+    static constexpr uint32_t MAGIC = 0x55504750;
+    static constexpr uint32_t VERSION = 1;
+    enum class Record : uint8_t { GP0, GP1, VBLANK };
+
+    GPUCapture();
+    ~GPUCapture() { stop(); }
+
+    bool capturing() const { return m_file; }
+    bool start(const std::filesystem::path& path);
+    void stop();
+
+    void gp0(const uint32_t* words, uint32_t count, GPU::Logged::Origin origin, uint32_t value) {
+        if (capturing()) recordGP0(words, count, origin, value);
+    }
+    void gp1(uint32_t value) {
+        if (capturing()) recordGP1(value);
+    }
+
+    // Feeds a capture file through a GPU, as fast as possible, calling back at each vblank.
+    // Returns an error message if the file can't be replayed.
+    static std::string replay(GPU* gpu, const std::filesystem::path& path,
+                              std::function<void(unsigned frame)> vblank = nullptr);
+    // Replays a capture a number of times, printing the time each frame took to render, the
+    // pixel throughput, and a hash of the resulting VRAM. Returns a process exit code.
+    static int benchmark(GPU* gpu, const std::filesystem::path& path, unsigned loops);
+
+  private:
+    void recordGP0(const uint32_t* words, uint32_t count, GPU::Logged::Origin origin, uint32_t value);
+    void recordGP1(uint32_t value);
+    void recordVBlank();
+    void recordHeader(Record type);
+    void write32(uint32_t value);
+    void flush();
+
+    EventBus::Listener m_listener;
+    IO<File> m_file;
+    std::vector<uint8_t> m_buffer;
+    uint32_t m_lastCycle = 0;
+};
+
+}  // namespace PCSX
@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/gpucounters.h"
+
+#include "core/psxemulator.h"
+#include "fmt/format.h"
+
+PCSX::GPUCountersFrame& PCSX::GPUCountersFrame::operator+=(const GPU::GPUStats& stats) {
+    triangles += stats.triangles;
+    texturedTriangles += stats.texturedTriangles;
+    rectangles += stats.rectangles;
+    sprites += stats.sprites;
+    lines += stats.lines;
+    fills += stats.fills;
+    copies += stats.blits;
+    pixelsWritten += stats.pixelWrites;
+    pixelsRead += stats.pixelReads;
+    texelsFetched += stats.texelReads;
+    semiTransparentPixels += stats.semiTransparentPixels;
+    bytesUploaded += uint64_t(stats.uploadedPixels) * 2;
+    bytesDownloaded += uint64_t(stats.downloadedPixels) * 2;
+    return *this;
+}
+
+PCSX::GPUCountersFrame& PCSX::GPUCountersFrame::operator+=(const GPUCountersFrame& other) {
+    triangles += other.triangles;
+    texturedTriangles += other.texturedTriangles;
+    rectangles += other.rectangles;
+    sprites += other.sprites;
+    lines += other.lines;
+    fills += other.fills;
+    copies += other.copies;
+    pixelsWritten += other.pixelsWritten;
+    pixelsRead += other.pixelsRead;
+    texelsFetched += other.texelsFetched;
+    semiTransparentPixels += other.semiTransparentPixels;
+    bytesUploaded += other.bytesUploaded;
+    bytesDownloaded += other.bytesDownloaded;
+    dmaWords += other.dmaWords;
+    hostMilliseconds += other.hostMilliseconds;
+    return *this;
+}
+
+std::string PCSX::GPUCountersFrame::csvHeader() {
+    std::string header;
+    GPUCountersFrame().forEach([&header](const char* name, double) {
+        if (!header.empty()) header += ',';
+        header += name;
+    });
+    return header;
+}
+
+std::string PCSX::GPUCountersFrame::csvLine() const {
+    std::string line;
+    forEach([&line](const char* name, double value) {
+        if (!line.empty()) line += ',';
+        line += fmt::format("{}", value);
+    });
+    return line;
+}
+
+// The GPU may have been switched while the counters were stopped, so its workers' time is picked back up here.
+void PCSX::GPUCounters::toggled() {
+    if (enabled()) m_workerNanoseconds = workerNanoseconds();
+}
+
+uint64_t PCSX::GPUCounters::workerNanoseconds() {
+    auto& gpu = g_emulator->m_gpu;
+    return gpu ? gpu->workerNanoseconds() : 0;
+}
+
+void PCSX::GPUCounters::endingFrame() {
+    // The workers may still be drawing the end of this frame, which then counts towards the next one.
+    const uint64_t nanoseconds = workerNanoseconds();
+    if (nanoseconds > m_workerNanoseconds) m_current.hostMilliseconds += (nanoseconds - m_workerNanoseconds) / 1e6;
+    m_workerNanoseconds = nanoseconds;
+}
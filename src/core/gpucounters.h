@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+
+#include "core/framecounters.h"
+#include "core/gpu.h"
+
+namespace PCSX {
+
+// The counters of one frame, or the sum of several.
+struct GPUCountersFrame {
+    uint64_t frame = 0;
+    uint64_t triangles = 0;
+    uint64_t texturedTriangles = 0;
+    uint64_t rectangles = 0;
+    uint64_t sprites = 0;
+    uint64_t lines = 0;
+    uint64_t fills = 0;
+    uint64_t copies = 0;
+    uint64_t pixelsWritten = 0;
+    uint64_t pixelsRead = 0;
+    uint64_t texelsFetched = 0;
+    uint64_t semiTransparentPixels = 0;
+    uint64_t bytesUploaded = 0;
+    uint64_t bytesDownloaded = 0;
+    uint64_t dmaWords = 0;
+    double hostMilliseconds = 0.0;
+
+    GPUCountersFrame& operator+=(const GPU::GPUStats& stats);
+    GPUCountersFrame& operator+=(const GPUCountersFrame& other);
+    // Calls f(name, value) for all of the counters, in the order of the CSV columns.
+    template <typename F>
+    void forEach(F&& f) const {
+        f("frame", double(frame));
+        f("triangles", double(triangles));
+        f("textured_triangles", double(texturedTriangles));
+        f("rectangles", double(rectangles));
+        f("sprites", double(sprites));
+        f("lines", double(lines));
+        f("fills", double(fills));
+        f("copies", double(copies));
+        f("pixels_written", double(pixelsWritten));
+        f("pixels_read", double(pixelsRead));
+        f("texels_fetched", double(texelsFetched));
+        f("semi_transparent_pixels", double(semiTransparentPixels));
+        f("bytes_uploaded", double(bytesUploaded));
+        f("bytes_downloaded", double(bytesDownloaded));
+        f("dma_words", double(dmaWords));
+        f("host_ms", hostMilliseconds);
+    }
+    static std::string csvHeader();
+    std::string csvLine() const;
+};
+
+// Per frame counters of the work sent to the GPU, independent from the GPU logger, and cheap
+// enough to be left on. The pixel and texel counts are estimated from the primitives' areas,
+// the same way the logger does, rather than counted by the rasterizers, so they mean the same
+// thing for every GPU backend. The host time is the time the emulation thread spent processing
+// GP0 words, plus the time the GPU's own threads spent working for it, such as the software
+// GPU's band workers, so it can add up to more than the frame's wall clock time.
+class GPUCounters : public FrameCounters<GPUCountersFrame> {
+  public:
+    using Frame = GPUCountersFrame;
+
+    // Measures the host time of a GP0 entry point. Nested timers only count once.
+    class Timer {
+      public:
+        Timer(GPUCounters* counters) : m_counters(counters->enabled() && !counters->m_timing ? counters : nullptr) {
+            if (!m_counters) return;
+            m_counters->m_timing = true;
+            m_start = std::chrono::steady_clock::now();
+        }
+        ~Timer() {
+            if (!m_counters) return;
+            const auto elapsed = std::chrono::steady_clock::now() - m_start;
+            m_counters->m_current.hostMilliseconds += std::chrono::duration<double, std::milli>(elapsed).count();
+            m_counters->m_timing = false;
+        }
+
+      private:
+        GPUCounters* m_counters;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    template <typename T>
+    void count(T& prim) {
+        if (!enabled()) return;
+        GPU::GPUStats stats;
+        prim.generateStatsInfo();
+        prim.cumulateStats(&stats);
+        m_current += stats;
+    }
+    void countDMA(uint32_t words) {
+        if (enabled()) m_current.dmaWords += words;
+    }
+
+  private:
+    void toggled() override;
+    void endingFrame() override;
+    static uint64_t workerNanoseconds();
+
+    bool m_timing = false;
+    // The GPU's workerNanoseconds() as of the end of the last frame.
+    uint64_t m_workerNanoseconds = 0;
+};
+
+}  // namespace PCSX
@@ -136,7 +136,7 @@ void PCSX::GPULogger::addNodeInternal(GPU::Logged* node, GPU::Logged::Origin ori
 
     bool gotNewFrame = false;
     for (auto i = m_list.begin(); (i != m_list.end()) && (i->frame != frame); i = m_list.begin()) {
-        delete &*i;
+        i->~Logged();
         gotNewFrame = true;
     }
     if (gotNewFrame) startNewFrame();
@@ -426,14 +426,26 @@ void PCSX::GPU::CtrlQuery::drawLogNode(unsigned n) {
     }
 }
 
-void PCSX::GPU::FastFill::cumulateStats(GPUStats* stats) { stats->pixelWrites += h * w; }
+void PCSX::GPU::FastFill::cumulateStats(GPUStats* stats) {
+    stats->fills++;
+    stats->pixelWrites += h * w;
+}
 void PCSX::GPU::BlitVramVram::cumulateStats(GPUStats* stats) {
     auto s = h * w;
+    stats->blits++;
     stats->pixelWrites += s;
     stats->pixelReads += s;
 }
-void PCSX::GPU::BlitRamVram::cumulateStats(GPUStats* stats) { stats->pixelWrites += h * w; }
-void PCSX::GPU::BlitVramRam::cumulateStats(GPUStats* stats) { stats->pixelReads += h * w; }
+void PCSX::GPU::BlitRamVram::cumulateStats(GPUStats* stats) {
+    auto s = h * w;
+    stats->pixelWrites += s;
+    stats->uploadedPixels += s;
+}
+void PCSX::GPU::BlitVramRam::cumulateStats(GPUStats* stats) {
+    auto s = h * w;
+    stats->pixelReads += s;
+    stats->downloadedPixels += s;
+}
 
 void PCSX::GPU::FastFill::getVertices(AddTri&& add, PixelOp op) {
     if (op == PixelOp::READ) return;
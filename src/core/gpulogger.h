@@ -24,6 +24,8 @@
 #include <array>
 
 #include "core/gpu.h"
+#include "core/gpucounters.h"
+#include "support/arena.h"
 #include "support/eventbus.h"
 #include "support/opengl.h"
 #include "support/slice.h"
@@ -37,13 +39,28 @@ class GPULogger;
 class GPULogger {
   public:
     GPULogger();
-    void clearFrameLog() { m_list.destroyAll(); }
+    ~GPULogger() { clearFrameLog(); }
+    void clearFrameLog() {
+        // The nodes live in the arenas, so only their destructors need to run.
+        while (!m_list.empty()) m_list.begin()->~Logged();
+    }
+    // Every command goes through here, logged or not, so this is also where they get counted.
     template <typename T>
-    void addNode(const T& data, GPU::Logged::Origin origin, uint32_t value, uint32_t length) {
+    void addNode(T& data, GPU::Logged::Origin origin, uint32_t value, uint32_t length) {
+        g_emulator->m_gpuCounters->count(data);
         if (m_enabled) {
-            addNodeInternal(new T(data), origin, value, length);
+            addNodeInternal(frameArena().create<T>(data), origin, value, length);
         }
     }
+    // Logs without drawing the heatmaps, for when there's no UI to show them.
+    void setLogging(bool logging) { m_enabled = logging; }
+    GPU::GPUStats frameStats() {
+        GPU::GPUStats stats;
+        for (auto& node : m_list) node.cumulateStats(&stats);
+        return stats;
+    }
+    // Bytes taken by the nodes of the frame being logged.
+    size_t frameBytes() const { return m_arenas[m_arena].used(); }
     void replay(GPU*);
     void highlight(GPU::Logged* node, bool only = false);
     void enable();
@@ -55,6 +72,17 @@ class GPULogger {
 
   private:
     void startNewFrame();
+    // The nodes of a frame are allocated from one arena, and those of the next one from the
+    // other, so that the previous frame stays intact until its nodes get purged, which only
+    // happens once the first node of the new frame has been created.
+    Arena<>& frameArena() {
+        if (m_arenaFrame != m_frameCounter) {
+            m_arenaFrame = m_frameCounter;
+            m_arena ^= 1;
+            m_arenas[m_arena].reset();
+        }
+        return m_arenas[m_arena];
+    }
     void addNodeInternal(GPU::Logged* node, GPU::Logged::Origin, uint32_t value, uint32_t length);
 
     EventBus::Listener m_listener;
@@ -62,6 +90,9 @@ class GPULogger {
     bool m_breakOnVSync = false;
     bool m_hasFramebuffers = false;
     uint64_t m_frameCounter = 0;
+    Arena<> m_arenas[2];
+    unsigned m_arena = 0;
+    uint64_t m_arenaFrame = 0;
     GPU::LoggedList m_list;
     Slice m_vram;
     float m_impact = 1.0f / 256.0f;
@@ -147,127 +147,127 @@
 #define GTE_LM(op) ((op >> 10) & 1)
 #define GTE_FUNCT(op) (op & 63)
 
-#define VX0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[0].sw.l)
-#define VY0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[0].sw.h)
-#define VZ0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[1].sw.l)
-#define VX1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[2].w.l)
-#define VY1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[2].w.h)
-#define VZ1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[3].w.l)
-#define VX2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[4].w.l)
-#define VY2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[4].w.h)
-#define VZ2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[5].w.l)
-#define R (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[6].b.l)
-#define G (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[6].b.h)
-#define B (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[6].b.h2)
-#define CODE (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[6].b.h3)
-#define OTZ (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[7].w.l)
-#define IR0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[8].sw.l)
-#define IR1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[9].sw.l)
-#define IR2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[10].sw.l)
-#define IR3 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[11].sw.l)
-#define SXY0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[12].d)
-#define SX0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[12].sw.l)
-#define SY0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[12].sw.h)
-#define SXY1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[13].d)
-#define SX1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[13].sw.l)
-#define SY1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[13].sw.h)
-#define SXY2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[14].d)
-#define SX2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[14].sw.l)
-#define SY2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[14].sw.h)
-#define SXYP (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[15].d)
-#define SXP (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[15].sw.l)
-#define SYP (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[15].sw.h)
-#define SZ0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[16].w.l)
-#define SZ1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[17].w.l)
-#define SZ2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[18].w.l)
-#define SZ3 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[19].w.l)
-#define RGB0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[20].d)
-#define R0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[20].b.l)
-#define G0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[20].b.h)
-#define B0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[20].b.h2)
-#define CD0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[20].b.h3)
-#define RGB1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[21].d)
-#define R1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[21].b.l)
-#define G1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[21].b.h)
-#define B1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[21].b.h2)
-#define CD1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[21].b.h3)
-#define RGB2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[22].d)
-#define R2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[22].b.l)
-#define G2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[22].b.h)
-#define B2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[22].b.h2)
-#define CD2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[22].b.h3)
-#define RES1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[23].d)
-#define MAC0 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[24].sd)
-#define MAC1 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[25].sd)
-#define MAC2 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[26].sd)
-#define MAC3 (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[27].sd)
-#define IRGB (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[28].d)
-#define ORGB (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[29].d)
-#define LZCS (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[30].d)
-#define LZCR (PCSX::g_emulator->m_cpu->m_regs.CP2D.p[31].d)
-
-#define R11 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[0].sw.l)
-#define R12 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[0].sw.h)
-#define R13 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[1].sw.l)
-#define R21 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[1].sw.h)
-#define R22 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[2].sw.l)
-#define R23 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[2].sw.h)
-#define R31 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[3].sw.l)
-#define R32 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[3].sw.h)
-#define R33 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[4].sw.l)
-#define TRX (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[5].sd)
-#define TRY (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[6].sd)
-#define TRZ (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[7].sd)
-#define L11 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[8].sw.l)
-#define L12 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[8].sw.h)
-#define L13 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[9].sw.l)
-#define L21 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[9].sw.h)
-#define L22 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[10].sw.l)
-#define L23 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[10].sw.h)
-#define L31 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[11].sw.l)
-#define L32 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[11].sw.h)
-#define L33 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[12].sw.l)
-#define RBK (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[13].sd)
-#define GBK (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[14].sd)
-#define BBK (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[15].sd)
-#define LR1 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[16].sw.l)
-#define LR2 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[16].sw.h)
-#define LR3 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[17].sw.l)
-#define LG1 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[17].sw.h)
-#define LG2 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[18].sw.l)
-#define LG3 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[18].sw.h)
-#define LB1 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[19].sw.l)
-#define LB2 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[19].sw.h)
-#define LB3 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[20].sw.l)
-#define RFC (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[21].sd)
-#define GFC (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[22].sd)
-#define BFC (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[23].sd)
-#define OFX (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[24].sd)
-#define OFY (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[25].sd)
-#define H (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[26].sw.l)
-#define DQA (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[27].sw.l)
-#define DQB (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[28].sd)
-#define ZSF3 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[29].sw.l)
-#define ZSF4 (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[30].sw.l)
-#define FLAG (PCSX::g_emulator->m_cpu->m_regs.CP2C.p[31].d)
-
-#define VX(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2D.p[n << 1].sw.l : IR1)
-#define VY(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2D.p[n << 1].sw.h : IR2)
-#define VZ(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2D.p[(n << 1) + 1].sw.l : IR3)
-#define MX11(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3)].sw.l : -R << 4)
-#define MX12(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3)].sw.h : R << 4)
-#define MX13(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 1].sw.l : IR0)
-#define MX21(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 1].sw.h : R13)
-#define MX22(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 2].sw.l : R13)
-#define MX23(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 2].sw.h : R13)
-#define MX31(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 3].sw.l : R22)
-#define MX32(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 3].sw.h : R22)
-#define MX33(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 4].sw.l : R22)
-#define CV1(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 5].sd : 0)
-#define CV2(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 6].sd : 0)
-#define CV3(n) (n < 3 ? PCSX::g_emulator->m_cpu->m_regs.CP2C.p[(n << 3) + 7].sd : 0)
-
-static int32_t LIM(int32_t value, int32_t max, int32_t min, uint32_t flag) {
+#define VX0 (m_data->p[0].sw.l)
+#define VY0 (m_data->p[0].sw.h)
+#define VZ0 (m_data->p[1].sw.l)
+#define VX1 (m_data->p[2].w.l)
+#define VY1 (m_data->p[2].w.h)
+#define VZ1 (m_data->p[3].w.l)
+#define VX2 (m_data->p[4].w.l)
+#define VY2 (m_data->p[4].w.h)
+#define VZ2 (m_data->p[5].w.l)
+#define R (m_data->p[6].b.l)
+#define G (m_data->p[6].b.h)
+#define B (m_data->p[6].b.h2)
+#define CODE (m_data->p[6].b.h3)
+#define OTZ (m_data->p[7].w.l)
+#define IR0 (m_data->p[8].sw.l)
+#define IR1 (m_data->p[9].sw.l)
+#define IR2 (m_data->p[10].sw.l)
+#define IR3 (m_data->p[11].sw.l)
+#define SXY0 (m_data->p[12].d)
+#define SX0 (m_data->p[12].sw.l)
+#define SY0 (m_data->p[12].sw.h)
+#define SXY1 (m_data->p[13].d)
+#define SX1 (m_data->p[13].sw.l)
+#define SY1 (m_data->p[13].sw.h)
+#define SXY2 (m_data->p[14].d)
+#define SX2 (m_data->p[14].sw.l)
+#define SY2 (m_data->p[14].sw.h)
+#define SXYP (m_data->p[15].d)
+#define SXP (m_data->p[15].sw.l)
+#define SYP (m_data->p[15].sw.h)
+#define SZ0 (m_data->p[16].w.l)
+#define SZ1 (m_data->p[17].w.l)
+#define SZ2 (m_data->p[18].w.l)
+#define SZ3 (m_data->p[19].w.l)
+#define RGB0 (m_data->p[20].d)
+#define R0 (m_data->p[20].b.l)
+#define G0 (m_data->p[20].b.h)
+#define B0 (m_data->p[20].b.h2)
+#define CD0 (m_data->p[20].b.h3)
+#define RGB1 (m_data->p[21].d)
+#define R1 (m_data->p[21].b.l)
+#define G1 (m_data->p[21].b.h)
+#define B1 (m_data->p[21].b.h2)
+#define CD1 (m_data->p[21].b.h3)
+#define RGB2 (m_data->p[22].d)
+#define R2 (m_data->p[22].b.l)
+#define G2 (m_data->p[22].b.h)
+#define B2 (m_data->p[22].b.h2)
+#define CD2 (m_data->p[22].b.h3)
+#define RES1 (m_data->p[23].d)
+#define MAC0 (m_data->p[24].sd)
+#define MAC1 (m_data->p[25].sd)
+#define MAC2 (m_data->p[26].sd)
+#define MAC3 (m_data->p[27].sd)
+#define IRGB (m_data->p[28].d)
+#define ORGB (m_data->p[29].d)
+#define LZCS (m_data->p[30].d)
+#define LZCR (m_data->p[31].d)
+
+#define R11 (m_ctrl->p[0].sw.l)
+#define R12 (m_ctrl->p[0].sw.h)
+#define R13 (m_ctrl->p[1].sw.l)
+#define R21 (m_ctrl->p[1].sw.h)
+#define R22 (m_ctrl->p[2].sw.l)
+#define R23 (m_ctrl->p[2].sw.h)
+#define R31 (m_ctrl->p[3].sw.l)
+#define R32 (m_ctrl->p[3].sw.h)
+#define R33 (m_ctrl->p[4].sw.l)
+#define TRX (m_ctrl->p[5].sd)
+#define TRY (m_ctrl->p[6].sd)
+#define TRZ (m_ctrl->p[7].sd)
+#define L11 (m_ctrl->p[8].sw.l)
+#define L12 (m_ctrl->p[8].sw.h)
+#define L13 (m_ctrl->p[9].sw.l)
+#define L21 (m_ctrl->p[9].sw.h)
+#define L22 (m_ctrl->p[10].sw.l)
+#define L23 (m_ctrl->p[10].sw.h)
+#define L31 (m_ctrl->p[11].sw.l)
+#define L32 (m_ctrl->p[11].sw.h)
+#define L33 (m_ctrl->p[12].sw.l)
+#define RBK (m_ctrl->p[13].sd)
+#define GBK (m_ctrl->p[14].sd)
+#define BBK (m_ctrl->p[15].sd)
+#define LR1 (m_ctrl->p[16].sw.l)
+#define LR2 (m_ctrl->p[16].sw.h)
+#define LR3 (m_ctrl->p[17].sw.l)
+#define LG1 (m_ctrl->p[17].sw.h)
+#define LG2 (m_ctrl->p[18].sw.l)
+#define LG3 (m_ctrl->p[18].sw.h)
+#define LB1 (m_ctrl->p[19].sw.l)
+#define LB2 (m_ctrl->p[19].sw.h)
+#define LB3 (m_ctrl->p[20].sw.l)
+#define RFC (m_ctrl->p[21].sd)
+#define GFC (m_ctrl->p[22].sd)
+#define BFC (m_ctrl->p[23].sd)
+#define OFX (m_ctrl->p[24].sd)
+#define OFY (m_ctrl->p[25].sd)
+#define H (m_ctrl->p[26].sw.l)
+#define DQA (m_ctrl->p[27].sw.l)
+#define DQB (m_ctrl->p[28].sd)
+#define ZSF3 (m_ctrl->p[29].sw.l)
+#define ZSF4 (m_ctrl->p[30].sw.l)
+#define FLAG (m_ctrl->p[31].d)
+
+#define VX(n) (n < 3 ? m_data->p[n << 1].sw.l : IR1)
+#define VY(n) (n < 3 ? m_data->p[n << 1].sw.h : IR2)
+#define VZ(n) (n < 3 ? m_data->p[(n << 1) + 1].sw.l : IR3)
+#define MX11(n) (n < 3 ? m_ctrl->p[(n << 3)].sw.l : -R << 4)
+#define MX12(n) (n < 3 ? m_ctrl->p[(n << 3)].sw.h : R << 4)
+#define MX13(n) (n < 3 ? m_ctrl->p[(n << 3) + 1].sw.l : IR0)
+#define MX21(n) (n < 3 ? m_ctrl->p[(n << 3) + 1].sw.h : R13)
+#define MX22(n) (n < 3 ? m_ctrl->p[(n << 3) + 2].sw.l : R13)
+#define MX23(n) (n < 3 ? m_ctrl->p[(n << 3) + 2].sw.h : R13)
+#define MX31(n) (n < 3 ? m_ctrl->p[(n << 3) + 3].sw.l : R22)
+#define MX32(n) (n < 3 ? m_ctrl->p[(n << 3) + 3].sw.h : R22)
+#define MX33(n) (n < 3 ? m_ctrl->p[(n << 3) + 4].sw.l : R22)
+#define CV1(n) (n < 3 ? m_ctrl->p[(n << 3) + 5].sd : 0)
+#define CV2(n) (n < 3 ? m_ctrl->p[(n << 3) + 6].sd : 0)
+#define CV3(n) (n < 3 ? m_ctrl->p[(n << 3) + 7].sd : 0)
+
+int32_t PCSX::GTE::LIM(int32_t value, int32_t max, int32_t min, uint32_t flag) {
     if (value > max) {
         FLAG |= flag;
         return max;
@@ -288,7 +288,7 @@ uint32_t PCSX::GTE::MFC2_internal(int reg) {
         case 9:
         case 10:
         case 11:
-            PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].d = (int32_t)PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].sw.l;
+            m_data->p[reg].d = (int32_t)m_data->p[reg].sw.l;
             break;
 
         case 7:
@@ -296,21 +296,21 @@ uint32_t PCSX::GTE::MFC2_internal(int reg) {
         case 17:
         case 18:
         case 19:
-            PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].d = (uint32_t)PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].w.l;
+            m_data->p[reg].d = (uint32_t)m_data->p[reg].w.l;
             break;
 
         case 15:
-            PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].d = SXY2;
+            m_data->p[reg].d = SXY2;
             break;
 
         case 28:
         case 29:
-            PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].d =
+            m_data->p[reg].d =
                 LIM(IR1 >> 7, 0x1f, 0, 0) | (LIM(IR2 >> 7, 0x1f, 0, 0) << 5) | (LIM(IR3 >> 7, 0x1f, 0, 0) << 10);
             break;
     }
 
-    return PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].d;
+    return m_data->p[reg].d;
 }
 
 void PCSX::GTE::MTC2_internal(uint32_t value, int reg) {
@@ -335,7 +335,7 @@ void PCSX::GTE::MTC2_internal(uint32_t value, int reg) {
             return;
     }
 
-    PCSX::g_emulator->m_cpu->m_regs.CP2D.p[reg].d = value;
+    m_data->p[reg].d = value;
 }
 
 void PCSX::GTE::CTC2_internal(uint32_t value, int reg) {
@@ -356,7 +356,7 @@ void PCSX::GTE::CTC2_internal(uint32_t value, int reg) {
             break;
     }
 
-    PCSX::g_emulator->m_cpu->m_regs.CP2C.p[reg].d = value;
+    m_ctrl->p[reg].d = value;
 }
 
 // Push a Z value to the Z-coordinate FIFO
@@ -379,7 +379,7 @@ int32_t PCSX::GTE::BOUNDS(int44 value, int max_flag, int min_flag) {
     return gte_shift(value.value(), s_sf);
 }
 
-static uint32_t gte_divide(uint16_t numerator, uint16_t denominator) {
+uint32_t PCSX::GTE::gte_divide(uint16_t numerator, uint16_t denominator) {
     if (numerator >= denominator * 2) {  // Division overflow
         FLAG |= (1 << 31) | (1 << 17);
         return 0x1ffff;
@@ -423,11 +423,11 @@ int32_t PCSX::GTE::A3(int44 a) {
     s_mac3 = a.value();
     return BOUNDS(a, (1 << 31) | (1 << 28), (1 << 31) | (1 << 25));
 }
-static int32_t Lm_B1(int32_t a, int lm) { return LIM(a, 0x7fff, -0x8000 * !lm, (1 << 31) | (1 << 24)); }
-static int32_t Lm_B2(int32_t a, int lm) { return LIM(a, 0x7fff, -0x8000 * !lm, (1 << 31) | (1 << 23)); }
-static int32_t Lm_B3(int32_t a, int lm) { return LIM(a, 0x7fff, -0x8000 * !lm, (1 << 22)); }
+int32_t PCSX::GTE::Lm_B1(int32_t a, int lm) { return LIM(a, 0x7fff, -0x8000 * !lm, (1 << 31) | (1 << 24)); }
+int32_t PCSX::GTE::Lm_B2(int32_t a, int lm) { return LIM(a, 0x7fff, -0x8000 * !lm, (1 << 31) | (1 << 23)); }
+int32_t PCSX::GTE::Lm_B3(int32_t a, int lm) { return LIM(a, 0x7fff, -0x8000 * !lm, (1 << 22)); }
 
-static int32_t Lm_B3_sf(int64_t value, int sf, int lm) {
+int32_t PCSX::GTE::Lm_B3_sf(int64_t value, int sf, int lm) {
     int32_t value_sf = gte_shift(value, sf);
     int32_t value_12 = gte_shift(value, 1);
     constexpr int32_t max = 0x7fff;
@@ -438,10 +438,10 @@ static int32_t Lm_B3_sf(int64_t value, int sf, int lm) {
     return std::clamp<int32_t>(value_sf, min, max);
 }
 
-static int32_t Lm_C1(int32_t a) { return LIM(a, 0x00ff, 0x0000, (1 << 21)); }
-static int32_t Lm_C2(int32_t a) { return LIM(a, 0x00ff, 0x0000, (1 << 20)); }
-static int32_t Lm_C3(int32_t a) { return LIM(a, 0x00ff, 0x0000, (1 << 19)); }
-static int32_t Lm_D(int64_t a, int sf) { return LIM(gte_shift(a, sf), 0xffff, 0x0000, (1 << 31) | (1 << 18)); }
+int32_t PCSX::GTE::Lm_C1(int32_t a) { return LIM(a, 0x00ff, 0x0000, (1 << 21)); }
+int32_t PCSX::GTE::Lm_C2(int32_t a) { return LIM(a, 0x00ff, 0x0000, (1 << 20)); }
+int32_t PCSX::GTE::Lm_C3(int32_t a) { return LIM(a, 0x00ff, 0x0000, (1 << 19)); }
+int32_t PCSX::GTE::Lm_D(int64_t a, int sf) { return LIM(gte_shift(a, sf), 0xffff, 0x0000, (1 << 31) | (1 << 18)); }
 
 int64_t PCSX::GTE::F(int64_t a) {
     s_mac0 = a;
@@ -453,7 +453,7 @@ int64_t PCSX::GTE::F(int64_t a) {
     return a;
 }
 
-static int32_t Lm_G1(int64_t a) {
+int32_t PCSX::GTE::Lm_G1(int64_t a) {
     if (a > 0x3ff) {
         FLAG |= (1 << 31) | (1 << 14);
         return 0x3ff;
@@ -466,7 +466,7 @@ static int32_t Lm_G1(int64_t a) {
     return a;
 }
 
-static int32_t Lm_G2(int64_t a) {
+int32_t PCSX::GTE::Lm_G2(int64_t a) {
     if (a > 0x3ff) {
         FLAG |= (1 << 31) | (1 << 13);
         return 0x3ff;
@@ -483,7 +483,7 @@ static int32_t Lm_G2(int64_t a) {
 static int32_t Lm_G1_ia(int64_t a) { return std::clamp<int64_t>(a, -0x4000000, 0x3ffffff); }
 static int32_t Lm_G2_ia(int64_t a) { return std::clamp<int64_t>(a, -0x4000000, 0x3ffffff); }
 
-static int32_t Lm_H(int64_t value, int sf) {
+int32_t PCSX::GTE::Lm_H(int64_t value, int sf) {
     int64_t value_sf = gte_shift(value, sf);
     int32_t value_12 = gte_shift(value, 1);
     constexpr int32_t max = 0x1000;
@@ -493,7 +493,8 @@ static int32_t Lm_H(int64_t value, int sf) {
     return std::clamp<int32_t>(value_12, min, max);
 }
 
-void PCSX::GTE::RTPS(uint32_t op) {
+template <bool pgxp>
+void PCSX::GTE::rtps(uint32_t op) {
     GTE_LOG("%08x GTE: RTPS|", op);
 
     const int lm = GTE_LM(gteop(op));
@@ -516,9 +517,11 @@ void PCSX::GTE::RTPS(uint32_t op) {
 
     SY2 = Lm_G2(F((int64_t)OFY + ((int64_t)IR2 * h_over_sz3)) >> 16);
 
-    PGXP_pushSXYZ2s(
-        Lm_G1_ia((int64_t)OFX + (int64_t)(IR1 * h_over_sz3) * (PCSX::g_emulator->config().Widescreen ? 0.75 : 1)),
-        Lm_G2_ia((int64_t)OFY + (int64_t)(IR2 * h_over_sz3)), std::max((int)SZ3, H / 2), SXY2);
+    if constexpr (pgxp) {
+        PGXP_pushSXYZ2s(
+            Lm_G1_ia((int64_t)OFX + (int64_t)(IR1 * h_over_sz3) * (PCSX::g_emulator->config().Widescreen ? 0.75 : 1)),
+            Lm_G2_ia((int64_t)OFY + (int64_t)(IR2 * h_over_sz3)), std::max((int)SZ3, H / 2), SXY2);
+    }
 
     // PGXP_RTPS(0, SXY2);
 
@@ -526,16 +529,25 @@ void PCSX::GTE::RTPS(uint32_t op) {
     IR0 = Lm_H(s_mac0, 1);
 }
 
-void PCSX::GTE::NCLIP(uint32_t op) {
+template <bool pgxp>
+void PCSX::GTE::nclip(uint32_t op) {
     GTE_LOG("%08x GTE: NCLIP|", op);
     FLAG = 0;
 
-    if (PGXP_NLCIP_valid(SXY0, SXY1, SXY2))
-        MAC0 = F(PGXP_NCLIP());
-    else
-        MAC0 = F((int64_t)(SX0 * SY1) + (SX1 * SY2) + (SX2 * SY0) - (SX0 * SY2) - (SX1 * SY0) - (SX2 * SY1));
+    if constexpr (pgxp) {
+        if (PGXP_NLCIP_valid(SXY0, SXY1, SXY2)) {
+            MAC0 = F(PGXP_NCLIP());
+            return;
+        }
+    }
+    MAC0 = F((int64_t)(SX0 * SY1) + (SX1 * SY2) + (SX2 * SY0) - (SX0 * SY2) - (SX1 * SY0) - (SX2 * SY1));
 }
 
+void PCSX::GTE::RTPS(uint32_t op) { rtps<false>(op); }
+void PCSX::GTE::NCLIP(uint32_t op) { nclip<false>(op); }
+void PCSX::GTE::pgxpRTPS(uint32_t op) { rtps<true>(op); }
+void PCSX::GTE::pgxpNCLIP(uint32_t op) { nclip<true>(op); }
+
 void PCSX::GTE::OP(uint32_t op) {
     GTE_LOG("%08x GTE: OP|", op);
 
@@ -689,9 +701,14 @@ void PCSX::GTE::CDP(uint32_t op) {
 void PCSX::GTE::NCDT(uint32_t op) {
     GTE_LOG("%08x GTE: NCDT|", op);
 
+    FLAG = 0;
+    if (GTEKernels::vectorized()) {
+        GTEKernels::NCDT(registers(), gteop(op));
+        return;
+    }
+
     const int lm = GTE_LM(gteop(op));
     s_sf = GTE_SF(gteop(op));
-    FLAG = 0;
 
     for (int v = 0; v < 3; v++) {
         MAC1 = A1((int64_t)(L11 * VX(v)) + (L12 * VY(v)) + (L13 * VZ(v)));
@@ -812,9 +829,14 @@ void PCSX::GTE::NCS(uint32_t op) {
 void PCSX::GTE::NCT(uint32_t op) {
     GTE_LOG("%08x GTE: NCT|", op);
 
+    FLAG = 0;
+    if (GTEKernels::vectorized()) {
+        GTEKernels::NCT(registers(), gteop(op));
+        return;
+    }
+
     const int lm = GTE_LM(gteop(op));
     s_sf = GTE_SF(gteop(op));
-    FLAG = 0;
 
     for (int v = 0; v < 3; v++) {
         MAC1 = A1((int64_t)(L11 * VX(v)) + (L12 * VY(v)) + (L13 * VZ(v)));
@@ -877,9 +899,14 @@ void PCSX::GTE::DCPL(uint32_t op) {
 void PCSX::GTE::DPCT(uint32_t op) {
     GTE_LOG("%08x GTE: DPCT|", op);
 
+    FLAG = 0;
+    if (GTEKernels::vectorized()) {
+        GTEKernels::DPCT(registers(), gteop(op));
+        return;
+    }
+
     const int lm = GTE_LM(gteop(op));
     s_sf = GTE_SF(gteop(op));
-    FLAG = 0;
 
     for (int v = 0; v < 3; v++) {
         MAC1 = A1((R0 << 16) + (IR0 * Lm_B1(A1(((int64_t)RFC << 12) - (R0 << 16)), 0)));
@@ -913,7 +940,8 @@ void PCSX::GTE::AVSZ4(uint32_t op) {
     OTZ = Lm_D(s_mac0, 1);
 }
 
-void PCSX::GTE::RTPT(uint32_t op) {
+template <bool pgxp>
+void PCSX::GTE::rtpt(uint32_t op) {
     GTE_LOG("%08x GTE: RTPT|", op);
 
     int32_t h_over_sz3;
@@ -937,9 +965,11 @@ void PCSX::GTE::RTPT(uint32_t op) {
             F((int64_t)OFX + ((int64_t)IR1 * h_over_sz3) * (PCSX::g_emulator->config().Widescreen ? 0.75 : 1)) >> 16);
         SY2 = Lm_G2(F((int64_t)OFY + ((int64_t)IR2 * h_over_sz3)) >> 16);
 
-        PGXP_pushSXYZ2s(
-            Lm_G1_ia((int64_t)OFX + (int64_t)(IR1 * h_over_sz3) * (PCSX::g_emulator->config().Widescreen ? 0.75 : 1)),
-            Lm_G2_ia((int64_t)OFY + (int64_t)(IR2 * h_over_sz3)), std::max((int)SZ3, H / 2), SXY2);
+        if constexpr (pgxp) {
+            PGXP_pushSXYZ2s(Lm_G1_ia((int64_t)OFX + (int64_t)(IR1 * h_over_sz3) *
+                                                        (PCSX::g_emulator->config().Widescreen ? 0.75 : 1)),
+                            Lm_G2_ia((int64_t)OFY + (int64_t)(IR2 * h_over_sz3)), std::max((int)SZ3, H / 2), SXY2);
+        }
 
         // PGXP_RTPS(v, SXY2);
     }
@@ -948,6 +978,9 @@ void PCSX::GTE::RTPT(uint32_t op) {
     IR0 = Lm_H(s_mac0, 1);
 }
 
+void PCSX::GTE::RTPT(uint32_t op) { rtpt<false>(op); }
+void PCSX::GTE::pgxpRTPT(uint32_t op) { rtpt<true>(op); }
+
 void PCSX::GTE::GPL(uint32_t op) {
     GTE_LOG("%08x GTE: GPL|", op);
 
@@ -993,9 +1026,14 @@ void PCSX::GTE::GPF(uint32_t op) {
 void PCSX::GTE::NCCT(uint32_t op) {
     GTE_LOG("%08x GTE: NCCT|", op);
 
+    FLAG = 0;
+    if (GTEKernels::vectorized()) {
+        GTEKernels::NCCT(registers(), gteop(op));
+        return;
+    }
+
     const int lm = GTE_LM(gteop(op));
     s_sf = GTE_SF(gteop(op));
-    FLAG = 0;
 
     for (int v = 0; v < 3; v++) {
         MAC1 = A1((int64_t)(L11 * VX(v)) + (L12 * VY(v)) + (L13 * VZ(v)));
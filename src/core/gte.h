@@ -20,6 +20,7 @@
 #pragma once
 #include <bit>
 
+#include "core/gtekernels.h"
 #include "core/psxemulator.h"
 #include "core/r3000a.h"
 
@@ -42,7 +43,7 @@ class GTE {
 
     uint32_t CFC2(uint32_t code) {
         // CPU[Rt] = GTE_C[Rd]
-        return PCSX::g_emulator->m_cpu->m_regs.CP2C.p[_Rd_].d;
+        return m_ctrl->p[_Rd_].d;
     }
 
     void CTC2(uint32_t value, int reg) { CTC2_internal(value, reg); }
@@ -54,6 +55,13 @@ class GTE {
     void LWC2(uint32_t code) { MTC2_internal(PCSX::g_emulator->m_mem->read32(gteoB), _Rt_); }
     void SWC2(uint32_t code) { PCSX::g_emulator->m_mem->write32(gteoB, MFC2_internal(_Rt_)); }
 
+    // The coprocessor registers the commands run on, the CPU's ones once it's been created. Other
+    // ones can be given, for the commands to run without an emulator around them.
+    void setRegisters(psxCP2Data *data, psxCP2Ctrl *ctrl) {
+        m_data = data;
+        m_ctrl = ctrl;
+    }
+
     void RTPS(uint32_t code);
     void NCLIP(uint32_t code);
     void OP(uint32_t code);
@@ -77,6 +85,12 @@ class GTE {
     void GPL(uint32_t code);
     void NCCT(uint32_t code);
 
+    // The same as RTPS, RTPT and NCLIP, with the PGXP tracking of the vertices on top. The plain
+    // versions don't have any of it compiled in, and only the PGXP interpreter tables use these.
+    void pgxpRTPS(uint32_t code);
+    void pgxpRTPT(uint32_t code);
+    void pgxpNCLIP(uint32_t code);
+
     // If MSB is set, return the number of leading ones, else return the number of leading zeroes
     // For an input of 0, 32 is returned
     static uint32_t countLeadingBits(uint32_t value) {
@@ -94,29 +108,11 @@ class GTE {
     }
 
   private:
-    class int44 {
-      public:
-        int44(int64_t value)
-            : m_value(value), m_positive_overflow(value > 0x7ffffffffff), m_negative_overflow(value < -0x80000000000) {}
-
-        int44(int64_t value, bool positive_overflow, bool negative_overflow)
-            : m_value(value), m_positive_overflow(positive_overflow), m_negative_overflow(negative_overflow) {}
-
-        int44 operator+(int64_t rhs) {
-            int64_t value = ((m_value + rhs) << 20) >> 20;
-            return int44(value, m_positive_overflow || (value < 0 && m_value >= 0 && rhs >= 0),
-                         m_negative_overflow || (value >= 0 && m_value < 0 && rhs < 0));
-        }
-
-        bool positiveOverflow() { return m_positive_overflow; }
-        bool negativeOverflow() { return m_negative_overflow; }
-        int64_t value() { return m_value; }
+    using int44 = GTEKernels::int44;
+    GTEKernels::Registers registers() { return {m_data->r, m_ctrl->r}; }
 
-      private:
-        int64_t m_value;
-        bool m_positive_overflow;
-        bool m_negative_overflow;
-    };
+    psxCP2Data *m_data = nullptr;
+    psxCP2Ctrl *m_ctrl = nullptr;
 
     int s_sf;
     int64_t s_mac0;
@@ -127,6 +123,26 @@ class GTE {
     int32_t A2(int44 a);
     int32_t A3(int44 a);
     int64_t F(int64_t a);
+    int32_t LIM(int32_t value, int32_t max, int32_t min, uint32_t flag);
+    uint32_t gte_divide(uint16_t numerator, uint16_t denominator);
+    int32_t Lm_B1(int32_t a, int lm);
+    int32_t Lm_B2(int32_t a, int lm);
+    int32_t Lm_B3(int32_t a, int lm);
+    int32_t Lm_B3_sf(int64_t value, int sf, int lm);
+    int32_t Lm_C1(int32_t a);
+    int32_t Lm_C2(int32_t a);
+    int32_t Lm_C3(int32_t a);
+    int32_t Lm_D(int64_t a, int sf);
+    int32_t Lm_G1(int64_t a);
+    int32_t Lm_G2(int64_t a);
+    int32_t Lm_H(int64_t value, int sf);
+
+    template <bool pgxp>
+    void rtps(uint32_t op);
+    template <bool pgxp>
+    void rtpt(uint32_t op);
+    template <bool pgxp>
+    void nclip(uint32_t op);
 
     uint32_t MFC2_internal(int reg);
     void MTC2_internal(uint32_t value, int reg);
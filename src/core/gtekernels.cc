@@ -0,0 +1,407 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "core/gtekernels.h"
+
+#include "support/simd.h"
+
+namespace {
+
+using int44 = PCSX::GTEKernels::int44;
+using Registers = PCSX::GTEKernels::Registers;
+
+// Data registers.
+constexpr unsigned RGBC = 6;
+constexpr unsigned IR0 = 8;
+constexpr unsigned IR1 = 9;
+constexpr unsigned RGB0 = 20;
+constexpr unsigned RGB1 = 21;
+constexpr unsigned RGB2 = 22;
+constexpr unsigned MAC1 = 25;
+// Control registers: each matrix takes 5 words, and is followed by the 3 words of a vector.
+constexpr unsigned BK = 13;
+constexpr unsigned FC = 21;
+constexpr unsigned FLAG = 31;
+
+// The matrices, in the order of the control registers.
+enum { ROTATION, LIGHT, COLOR };
+
+// The flags of each of the three rows. Setting bits 19-22 in FLAG does not set bit 31.
+constexpr uint32_t c_macMaxFlags[3] = {(1u << 31) | (1 << 30), (1u << 31) | (1 << 29), (1u << 31) | (1 << 28)};
+constexpr uint32_t c_macMinFlags[3] = {(1u << 31) | (1 << 27), (1u << 31) | (1 << 26), (1u << 31) | (1 << 25)};
+constexpr uint32_t c_irFlags[3] = {(1u << 31) | (1 << 24), (1u << 31) | (1 << 23), 1 << 22};
+constexpr uint32_t c_colorFlags[3] = {1 << 21, 1 << 20, 1 << 19};
+
+int sf(uint32_t op) { return (op >> 19) & 1; }
+int lm(uint32_t op) { return (op >> 10) & 1; }
+
+int32_t lo(uint32_t word) { return int16_t(word); }
+int32_t hi(uint32_t word) { return int16_t(word >> 16); }
+int32_t byte(uint32_t word, unsigned index) { return (word >> (index * 8)) & 0xff; }
+
+struct Matrix {
+    // The 3x3 matrix of halfwords starting at a control register.
+    Matrix(const Registers &regs, int matrix) {
+        const uint32_t *words = regs.ctrl + matrix * 8;
+        for (unsigned i = 0; i < 9; i++) m[i / 3][i % 3] = i & 1 ? hi(words[i / 2]) : lo(words[i / 2]);
+    }
+    int32_t m[3][3];
+};
+
+// The three components of a vertex.
+void vertex(const Registers &regs, int v, int32_t components[3]) {
+    components[0] = lo(regs.data[v * 2]);
+    components[1] = hi(regs.data[v * 2]);
+    components[2] = lo(regs.data[v * 2 + 1]);
+}
+
+void pushColor(const Registers &regs, const int32_t colors[3]) {
+    regs.data[RGB0] = regs.data[RGB1];
+    regs.data[RGB1] = regs.data[RGB2];
+    regs.data[RGB2] = colors[0] | (colors[1] << 8) | (colors[2] << 16) | (regs.data[RGBC] & 0xff000000);
+}
+
+void store(const Registers &regs, const int32_t mac[3], const int32_t ir[3]) {
+    for (unsigned row = 0; row < 3; row++) {
+        regs.data[MAC1 + row] = mac[row];
+        regs.data[IR1 + row] = (regs.data[IR1 + row] & 0xffff0000) | uint16_t(ir[row]);
+    }
+}
+
+// The reference versions, which follow the interpreter's formulas row by row.
+class Scalar {
+  public:
+    Scalar(Registers regs, uint32_t op) : m_regs(regs), m_sf(sf(op)), m_lm(lm(op)) {}
+
+    void NCT() {
+        for (int v = 0; v < 3; v++) {
+            lightVector(v);
+            lightColor();
+            pushColor();
+        }
+        store();
+    }
+    void NCCT() {
+        for (int v = 0; v < 3; v++) {
+            lightVector(v);
+            lightColor();
+            colorMultiply();
+            pushColor();
+        }
+        store();
+    }
+    void NCDT() {
+        for (int v = 0; v < 3; v++) {
+            lightVector(v);
+            lightColor();
+            colorDepthCue();
+            pushColor();
+        }
+        store();
+    }
+    void DPCT() {
+        for (int v = 0; v < 3; v++) {
+            depthCue();
+            pushColor();
+        }
+        store();
+    }
+
+  private:
+    void lightVector(int v) {
+        int32_t vector[3];
+        vertex(m_regs, v, vector);
+        const Matrix light(m_regs, LIGHT);
+        for (unsigned row = 0; row < 3; row++) {
+            m_mac[row] = A(row, (int64_t)(light.m[row][0] * vector[0]) + (light.m[row][1] * vector[1]) +
+                                    (light.m[row][2] * vector[2]));
+        }
+        limitIR();
+    }
+    void lightColor() {
+        const Matrix color(m_regs, COLOR);
+        for (unsigned row = 0; row < 3; row++) {
+            m_mac[row] = A(row, int44((int64_t)int32_t(m_regs.ctrl[BK + row]) << 12) + (color.m[row][0] * m_ir[0]) +
+                                    (color.m[row][1] * m_ir[1]) + (color.m[row][2] * m_ir[2]));
+        }
+        limitIR();
+    }
+    void colorMultiply() {
+        for (unsigned row = 0; row < 3; row++) m_mac[row] = A(row, (color(row) << 4) * m_ir[row]);
+        limitIR();
+    }
+    void colorDepthCue() {
+        for (unsigned row = 0; row < 3; row++) {
+            const int32_t c = (color(row) << 4) * m_ir[row];
+            m_mac[row] = A(row, c + (ir0() * LmB(row, A(row, ((int64_t)farColor(row) << 12) - c), 0)));
+        }
+        limitIR();
+    }
+    void depthCue() {
+        for (unsigned row = 0; row < 3; row++) {
+            const int32_t c = byte(m_regs.data[RGB0], row) << 16;
+            m_mac[row] = A(row, c + (ir0() * LmB(row, A(row, ((int64_t)farColor(row) << 12) - c), 0)));
+        }
+        limitIR();
+    }
+    void pushColor() {
+        int32_t colors[3];
+        for (unsigned row = 0; row < 3; row++) colors[row] = lim(m_mac[row] >> 4, 0xff, 0, c_colorFlags[row]);
+        ::pushColor(m_regs, colors);
+    }
+
+    int32_t ir0() { return lo(m_regs.data[IR0]); }
+    int32_t color(unsigned row) { return byte(m_regs.data[RGBC], row); }
+    int32_t farColor(unsigned row) { return m_regs.ctrl[FC + row]; }
+
+    int32_t A(unsigned row, int44 a) {
+        if (a.positiveOverflow()) m_flag |= c_macMaxFlags[row];
+        if (a.negativeOverflow()) m_flag |= c_macMinFlags[row];
+        return m_sf == 0 ? a.value() : a.value() >> 12;
+    }
+    int32_t lim(int32_t value, int32_t max, int32_t min, uint32_t flag) {
+        if (value > max) {
+            m_flag |= flag;
+            return max;
+        } else if (value < min) {
+            m_flag |= flag;
+            return min;
+        }
+        return value;
+    }
+    int32_t LmB(unsigned row, int32_t a, int lm) { return lim(a, 0x7fff, -0x8000 * !lm, c_irFlags[row]); }
+    void limitIR() {
+        for (unsigned row = 0; row < 3; row++) m_ir[row] = LmB(row, m_mac[row], m_lm);
+    }
+    void store() {
+        ::store(m_regs, m_mac, m_ir);
+        m_regs.ctrl[FLAG] |= m_flag;
+    }
+
+    const Registers m_regs;
+    const int m_sf;
+    const int m_lm;
+    int32_t m_mac[3];
+    int32_t m_ir[3];
+    uint32_t m_flag = 0;
+};
+
+#ifdef PCSX_SIMD_X86
+
+// The three rows go into the first three 64 bits lanes; the fourth one never raises any flag.
+AVX2_FUNC inline __m256i rows(int64_t row1, int64_t row2, int64_t row3) {
+    return _mm256_set_epi64x(0, row3, row2, row1);
+}
+AVX2_FUNC inline __m256i rows(const uint32_t flags[3]) { return rows(flags[0], flags[1], flags[2]); }
+AVX2_FUNC inline __m256i broadcast(int64_t x) { return _mm256_set1_epi64x(x); }
+// All of the products are of 16 bits values, or not much more, so the low halves of the lanes are enough.
+AVX2_FUNC inline __m256i multiply(__m256i a, __m256i b) { return _mm256_mul_epi32(a, b); }
+
+// The MAC units wrap their sums around 44 bits and raise sticky flags when they do, which is
+// costly to emulate in vector lanes. It also almost never happens, so this works on the sums
+// as plain 64 bits values, and only checks that none of them left the 44 bits range along the
+// way. If one did, nothing has been written yet, and the scalar version runs the command again.
+// Past the MAC units, every value fits in 32 bits, and only the low half of each lane is kept
+// up to date.
+class Vector {
+  public:
+    AVX2_FUNC Vector(Registers regs, uint32_t op)
+        : m_regs(regs),
+          m_sf(sf(op)),
+          m_irMin(broadcast(lm(op) ? 0 : -0x8000)),
+          m_irFlags(rows(c_irFlags)),
+          m_flags(_mm256_setzero_si256()),
+          m_range(_mm256_setzero_si256()) {}
+
+    AVX2_FUNC bool NCT() {
+        matrix(m_light, LIGHT);
+        matrix(m_color, COLOR);
+        for (int v = 0; v < 3; v++) {
+            lightVector(v);
+            lightColor();
+            pushColor(v);
+        }
+        return store();
+    }
+    AVX2_FUNC bool NCCT() {
+        matrix(m_light, LIGHT);
+        matrix(m_color, COLOR);
+        for (int v = 0; v < 3; v++) {
+            lightVector(v);
+            lightColor();
+            m_mac = A(multiply(colors(4), m_ir));
+            m_ir = LmB(m_mac, m_irMin);
+            pushColor(v);
+        }
+        return store();
+    }
+    AVX2_FUNC bool NCDT() {
+        matrix(m_light, LIGHT);
+        matrix(m_color, COLOR);
+        for (int v = 0; v < 3; v++) {
+            lightVector(v);
+            lightColor();
+            depthCue(multiply(colors(4), m_ir));
+            pushColor(v);
+        }
+        return store();
+    }
+    AVX2_FUNC bool DPCT() {
+        // Each vertex starts from the color at the bottom of the FIFO, which is always one of the initial three.
+        for (int v = 0; v < 3; v++) {
+            const uint32_t rgb = m_regs.data[RGB0 + v];
+            depthCue(_mm256_slli_epi64(rows(byte(rgb, 0), byte(rgb, 1), byte(rgb, 2)), 16));
+            pushColor(v);
+        }
+        return store();
+    }
+
+  private:
+    // The columns of a matrix, each holding the three rows. The nine halfwords are every third one
+    // from the start, for the first two columns, and from one halfword further for the last one.
+    AVX2_FUNC void matrix(__m256i *columns, int matrix) {
+        const auto halfwords = reinterpret_cast<const int16_t *>(m_regs.ctrl + matrix * 8);
+        const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(halfwords));
+        const __m128i last = _mm_loadu_si128(reinterpret_cast<const __m128i *>(halfwords + 1));
+        const __m128i column0 = _mm_setr_epi8(0, 1, 6, 7, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i column1 = _mm_setr_epi8(2, 3, 8, 9, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        columns[0] = _mm256_cvtepi16_epi64(_mm_shuffle_epi8(first, column0));
+        columns[1] = _mm256_cvtepi16_epi64(_mm_shuffle_epi8(first, column1));
+        columns[2] = _mm256_cvtepi16_epi64(_mm_shuffle_epi8(last, column1));
+    }
+    AVX2_FUNC __m256i vectorRegister(unsigned reg) {
+        return rows(int32_t(m_regs.ctrl[reg]), int32_t(m_regs.ctrl[reg + 1]), int32_t(m_regs.ctrl[reg + 2]));
+    }
+    AVX2_FUNC __m256i colors(int shift) {
+        const uint32_t rgb = m_regs.data[RGBC];
+        return _mm256_slli_epi64(rows(byte(rgb, 0), byte(rgb, 1), byte(rgb, 2)), shift);
+    }
+
+    AVX2_FUNC void lightVector(int v) {
+        int32_t vector[3];
+        vertex(m_regs, v, vector);
+        __m256i sum = multiply(m_light[0], broadcast(vector[0]));
+        sum = _mm256_add_epi64(sum, multiply(m_light[1], broadcast(vector[1])));
+        sum = _mm256_add_epi64(sum, multiply(m_light[2], broadcast(vector[2])));
+        m_mac = A(sum);
+        m_ir = LmB(m_mac, m_irMin);
+    }
+    AVX2_FUNC void lightColor() {
+        __m256i sum = _mm256_slli_epi64(vectorRegister(BK), 12);
+        sum = checked(_mm256_add_epi64(sum, multiply(m_color[0], _mm256_permute4x64_epi64(m_ir, 0x00))));
+        sum = checked(_mm256_add_epi64(sum, multiply(m_color[1], _mm256_permute4x64_epi64(m_ir, 0x55))));
+        sum = checked(_mm256_add_epi64(sum, multiply(m_color[2], _mm256_permute4x64_epi64(m_ir, 0xaa))));
+        m_mac = A(sum);
+        m_ir = LmB(m_mac, m_irMin);
+    }
+    // Interpolates from c towards the far color, by IR0.
+    AVX2_FUNC void depthCue(__m256i c) {
+        const __m256i far = _mm256_slli_epi64(vectorRegister(FC), 12);
+        const __m256i fraction = LmB(A(checked(_mm256_sub_epi64(far, c))), broadcast(-0x8000));
+        m_mac = A(_mm256_add_epi64(c, multiply(broadcast(lo(m_regs.data[IR0])), fraction)));
+        m_ir = LmB(m_mac, m_irMin);
+    }
+    AVX2_FUNC void pushColor(int v) {
+        const __m256i colors = lim(_mm256_srai_epi32(m_mac, 4), broadcast(0xff), _mm256_setzero_si256(),
+                                   rows(c_colorFlags));
+        const __m128i low = _mm256_castsi256_si128(colors);
+        m_rgb[v] = _mm_cvtsi128_si32(low) | (_mm_extract_epi32(low, 2) << 8) |
+                   (_mm_cvtsi128_si32(_mm256_extracti128_si256(colors, 1)) << 16) |
+                   (m_regs.data[RGBC] & 0xff000000);
+    }
+
+    // Writes the results out, along with the colors pushed into the FIFO, unless a sum overflowed.
+    AVX2_FUNC bool store() {
+        if (!_mm256_testz_si256(m_range, broadcast(~((int64_t(1) << 44) - 1)))) return false;
+        const __m256i lanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+        const __m128i mac = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(m_mac, lanes));
+        const __m128i ir = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(m_ir, lanes));
+        const int32_t macs[3] = {_mm_cvtsi128_si32(mac), _mm_extract_epi32(mac, 1), _mm_extract_epi32(mac, 2)};
+        const int32_t irs[3] = {_mm_cvtsi128_si32(ir), _mm_extract_epi32(ir, 1), _mm_extract_epi32(ir, 2)};
+        ::store(m_regs, macs, irs);
+        for (int v = 0; v < 3; v++) m_regs.data[RGB0 + v] = m_rgb[v];
+        // The flags of all of the lanes, folded into the first one.
+        __m256i flags = _mm256_or_si256(m_flags, _mm256_permute4x64_epi64(m_flags, 0x4e));
+        flags = _mm256_or_si256(flags, _mm256_shuffle_epi32(flags, 0x4e));
+        m_regs.ctrl[FLAG] |= _mm_cvtsi128_si32(_mm256_castsi256_si128(flags));
+        return true;
+    }
+
+    // Keeps track of the 44 bits range: adding 2^43 moves it to [0, 2^44), so any higher bit
+    // set in any of the sums is an overflow.
+    AVX2_FUNC __m256i checked(__m256i sum) {
+        m_range = _mm256_or_si256(m_range, _mm256_add_epi64(sum, broadcast(int64_t(1) << 43)));
+        return sum;
+    }
+    // Only the low 32 bits are kept, for which a logical shift does as well as an arithmetic one.
+    AVX2_FUNC __m256i A(__m256i sum) { return m_sf ? _mm256_srli_epi64(sum, 12) : sum; }
+    AVX2_FUNC __m256i lim(__m256i value, __m256i max, __m256i min, __m256i flags) {
+        const __m256i out = _mm256_or_si256(_mm256_cmpgt_epi32(value, max), _mm256_cmpgt_epi32(min, value));
+        m_flags = _mm256_or_si256(m_flags, _mm256_and_si256(out, flags));
+        return _mm256_max_epi32(_mm256_min_epi32(value, max), min);
+    }
+    AVX2_FUNC __m256i LmB(__m256i value, __m256i min) { return lim(value, broadcast(0x7fff), min, m_irFlags); }
+
+    const Registers m_regs;
+    const int m_sf;
+    const __m256i m_irMin;
+    const __m256i m_irFlags;
+    __m256i m_flags;
+    __m256i m_range;
+    __m256i m_mac;
+    __m256i m_ir;
+    __m256i m_light[3];
+    __m256i m_color[3];
+    uint32_t m_rgb[3];
+};
+
+#endif
+
+}  // namespace
+
+bool PCSX::GTEKernels::vectorized() {
+#ifdef PCSX_SIMD_X86
+    return PCSX::SIMD::hasAVX2;
+#else
+    return false;
+#endif
+}
+
+#ifdef PCSX_SIMD_X86
+#define VECTOR(call) (PCSX::SIMD::hasAVX2 && !forceScalar && Vector(regs, op).call)
+#else
+#define VECTOR(call) false
+#endif
+
+void PCSX::GTEKernels::NCT(Registers regs, uint32_t op, bool forceScalar) {
+    if (!VECTOR(NCT())) Scalar(regs, op).NCT();
+}
+
+void PCSX::GTEKernels::NCCT(Registers regs, uint32_t op, bool forceScalar) {
+    if (!VECTOR(NCCT())) Scalar(regs, op).NCCT();
+}
+
+void PCSX::GTEKernels::NCDT(Registers regs, uint32_t op, bool forceScalar) {
+    if (!VECTOR(NCDT())) Scalar(regs, op).NCDT();
+}
+
+void PCSX::GTEKernels::DPCT(Registers regs, uint32_t op, bool forceScalar) {
+    if (!VECTOR(DPCT())) Scalar(regs, op).DPCT();
+}
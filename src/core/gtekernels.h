@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+namespace PCSX {
+
+// The GTE commands which run the same computation over the three rows of a matrix, for three
+// vertices in a row. The rows are computed side by side, in 64 bits vector lanes, when the host
+// can, and one after the other in plain C++ otherwise; both give the same registers and the same
+// FLAG, bit for bit. They work on the raw coprocessor register files, 32 data words followed by
+// 32 control words, so the two versions can be checked against each other without an emulator
+// around them. The flag register is expected to have been cleared by the caller.
+class GTEKernels {
+  public:
+    // The 44 bits accumulator of the MAC units, with its sticky overflow flags.
+    class int44 {
+      public:
+        int44(int64_t value)
+            : m_value(value), m_positive_overflow(value > 0x7ffffffffff), m_negative_overflow(value < -0x80000000000) {}
+
+        int44(int64_t value, bool positive_overflow, bool negative_overflow)
+            : m_value(value), m_positive_overflow(positive_overflow), m_negative_overflow(negative_overflow) {}
+
+        int44 operator+(int64_t rhs) {
+            int64_t value = ((m_value + rhs) << 20) >> 20;
+            return int44(value, m_positive_overflow || (value < 0 && m_value >= 0 && rhs >= 0),
+                         m_negative_overflow || (value >= 0 && m_value < 0 && rhs < 0));
+        }
+
+        bool positiveOverflow() { return m_positive_overflow; }
+        bool negativeOverflow() { return m_negative_overflow; }
+        int64_t value() { return m_value; }
+
+      private:
+        int64_t m_value;
+        bool m_positive_overflow;
+        bool m_negative_overflow;
+    };
+
+    struct Registers {
+        uint32_t *data;
+        uint32_t *ctrl;
+    };
+
+    // Whether the vectorized versions are going to be used on this host. The interpreter only calls
+    // into these when they are, and keeps running its own code otherwise.
+    static bool vectorized();
+
+    // The full commands, minus the clearing of FLAG; op is the command word.
+    static void NCT(Registers regs, uint32_t op, bool forceScalar = false);
+    static void NCCT(Registers regs, uint32_t op, bool forceScalar = false);
+    static void NCDT(Registers regs, uint32_t op, bool forceScalar = false);
+    static void DPCT(Registers regs, uint32_t op, bool forceScalar = false);
+};
+
+}  // namespace PCSX
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/gteprofiler.h"
+
+#include "core/psxemulator.h"
+#include "core/r3000a.h"
+#include "fmt/format.h"
+
+namespace {
+
+struct Command {
+    const char* name;
+    unsigned latency;
+};
+
+// The COP2 function fields, with the latencies of the commands as documented in psx-spx.
+constexpr Command c_commands[64] = {
+    {},           {"RTPS", 15}, {},           {},            // 00
+    {},           {},           {"NCLIP", 8}, {},            // 04
+    {},           {},           {},           {},            // 08
+    {"OP", 6},    {},           {},           {},            // 0c
+    {"DPCS", 8},  {"INTPL", 8}, {"MVMVA", 8}, {"NCDS", 19},  // 10
+    {"CDP", 13},  {},           {"NCDT", 44}, {},            // 14
+    {},           {},           {},           {"NCCS", 17},  // 18
+    {"CC", 11},   {},           {"NCS", 14},  {},            // 1c
+    {"NCT", 30},  {},           {},           {},            // 20
+    {},           {},           {},           {},            // 24
+    {"SQR", 5},   {"DCPL", 8},  {"DPCT", 17}, {},            // 28
+    {},           {"AVSZ3", 5}, {"AVSZ4", 6}, {},            // 2c
+    {"RTPT", 23}, {},           {},           {},            // 30
+    {},           {},           {},           {},            // 34
+    {},           {},           {},           {},            // 38
+    {},           {"GPF", 5},   {"GPL", 5},   {"NCCT", 39},  // 3c
+};
+
+}  // namespace
+
+PCSX::GTEProfilerFrame::Command& PCSX::GTEProfilerFrame::Command::operator+=(const Command& other) {
+    count += other.count;
+    cycles += other.cycles;
+    samples += other.samples;
+    sampledNanoseconds += other.sampledNanoseconds;
+    return *this;
+}
+
+PCSX::GTEProfilerFrame& PCSX::GTEProfilerFrame::operator+=(const GTEProfilerFrame& other) {
+    for (unsigned funct = 0; funct < 64; funct++) commands[funct] += other.commands[funct];
+    return *this;
+}
+
+const char* PCSX::GTEProfiler::name(unsigned funct) { return c_commands[funct & 0x3f].name; }
+unsigned PCSX::GTEProfiler::latency(unsigned funct) { return c_commands[funct & 0x3f].latency; }
+
+std::string PCSX::GTEProfilerFrame::csvHeader() {
+    std::string header = "frame";
+    GTEProfilerFrame().forEach([&header](const char* name, const Command&) {
+        header += fmt::format(",{0}_count,{0}_cycles,{0}_host_ns", name);
+    });
+    return header;
+}
+
+std::string PCSX::GTEProfilerFrame::csvLine() const {
+    std::string line = fmt::format("{}", frame);
+    forEach([&line](const char*, const Command& command) {
+        line += fmt::format(",{},{},{:.0f}", command.count, command.cycles, command.hostNanoseconds());
+    });
+    return line;
+}
+
+// Only the blocks compiled from RAM get thrown away; the few GTE commands the BIOS runs from
+// its ROM keep whichever version of their blocks they already had.
+void PCSX::GTEProfiler::toggled() {
+    m_timed = nullptr;
+    auto& cpu = g_emulator->m_cpu;
+    if (cpu && cpu->isDynarec()) cpu->invalidateCache();
+}
+
+void PCSX::GTEProfiler::enter(uint32_t code) {
+    const unsigned funct = code & 0x3f;
+    if (!c_commands[funct].name) {
+        m_timed = nullptr;
+        return;
+    }
+    auto& command = m_current.commands[funct];
+    command.count++;
+    command.cycles += c_commands[funct].latency;
+    m_timed = (command.count % SAMPLING) == 1 ? &command : nullptr;
+    if (m_timed) m_start = std::chrono::steady_clock::now();
+}
+
+void PCSX::GTEProfiler::leave() {
+    if (!m_timed) return;
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+    m_timed->samples++;
+    m_timed->sampledNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    m_timed = nullptr;
+}
+
+void PCSX::GTEProfiler::enterProbe(uint32_t code) { g_emulator->m_gteProfiler->enter(code); }
+void PCSX::GTEProfiler::leaveProbe() { g_emulator->m_gteProfiler->leave(); }
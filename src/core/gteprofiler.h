@@ -0,0 +1,95 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <string>
+
+#include "core/framecounters.h"
+
+namespace PCSX {
+
+// The statistics of one frame, or the sum of several.
+struct GTEProfilerFrame {
+    struct Command {
+        uint64_t count = 0;
+        uint64_t cycles = 0;
+        uint64_t samples = 0;
+        uint64_t sampledNanoseconds = 0;
+        // The host time of all of the runs, extrapolated from the timed ones.
+        double hostNanoseconds() const { return samples ? double(sampledNanoseconds) * count / samples : 0.0; }
+        Command& operator+=(const Command& other);
+    };
+
+    uint64_t frame = 0;
+    // Indexed by the function field of the COP2 instructions.
+    Command commands[64];
+    GTEProfilerFrame& operator+=(const GTEProfilerFrame& other);
+    // Calls f(name, command) for all of the GTE commands, in opcode order.
+    template <typename F>
+    void forEach(F&& f) const;
+    static std::string csvHeader();
+    std::string csvLine() const;
+};
+
+// Per frame statistics of the GTE commands, for the interpreter as well as the dynarec: how many
+// times each command ran, how many emulated cycles that is according to their documented
+// latencies, and how much host time went into them. Reading the host clock costs about as much
+// as the cheapest commands, so only one run out of SAMPLING of each command is timed, and the
+// total is extrapolated from these. When the profiler is off, the interpreter only tests a flag,
+// and the dynarec doesn't emit anything: the code blocks are thrown away when the profiler is
+// started or stopped, so they get recompiled with or without the probes.
+class GTEProfiler : public FrameCounters<GTEProfilerFrame> {
+  public:
+    static constexpr unsigned SAMPLING = 16;
+
+    using Command = GTEProfilerFrame::Command;
+    using Frame = GTEProfilerFrame;
+
+    // The name of the GTE command of a COP2 function field, or nullptr for the register moves
+    // and the unused ones, and its documented latency, in CPU cycles.
+    static const char* name(unsigned funct);
+    static unsigned latency(unsigned funct);
+
+    // Around the execution of a COP2 instruction, while enabled. Anything that isn't a GTE command
+    // is ignored.
+    void enter(uint32_t code);
+    void leave();
+    // The same, for the dynarec to call into.
+    static void enterProbe(uint32_t code);
+    static void leaveProbe();
+
+  private:
+    void toggled() override;
+
+    Command* m_timed = nullptr;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+template <typename F>
+void GTEProfilerFrame::forEach(F&& f) const {
+    for (unsigned funct = 0; funct < 64; funct++) {
+        if (auto n = GTEProfiler::name(funct)) f(n, commands[funct]);
+    }
+}
+
+}  // namespace PCSX
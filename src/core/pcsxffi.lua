@@ -82,6 +82,32 @@ typedef struct {
 
 LuaScreenShot takeScreenShot();
 
+const char* startFrameHashes(const char* output);
+void stopFrameHashes();
+bool frameHashesEnabled();
+const char* loadGoldenFrameHashes(const char* path);
+unsigned getFrameHashesCount();
+void getFrameHash(unsigned index, uint32_t* frame, uint32_t* hashHigh, uint32_t* hashLow);
+
+const char* startGPUCounters(const char* csv);
+void stopGPUCounters();
+bool gpuCountersEnabled();
+unsigned getGPUCountersCount();
+const char* getGPUCounterName(unsigned index);
+double getGPUCounter(unsigned which, unsigned index);
+
+const char* startGTEProfiler(const char* csv);
+void stopGTEProfiler();
+bool gteProfilerEnabled();
+unsigned getGTEProfilerCommandsCount();
+const char* getGTEProfilerCommandName(unsigned index);
+void getGTEProfilerCommand(unsigned which, unsigned index, double* count, double* cycles, double* hostNs);
+
+const char* startAudioDump(const char* path, bool stems);
+void stopAudioDump();
+bool audioDumpEnabled();
+double getAudioDumpFrames();
+
 LuaSlice* createSaveState();
 void loadSaveStateFromSlice(LuaSlice*);
 void loadSaveStateFromFile(LuaFile*);
@@ -159,6 +185,51 @@ local function printLike(callback, ...)
     callback(s)
 end
 
+local function checkErrorString(err)
+    err = ffi.string(err)
+    if err ~= '' then error(err) end
+end
+
+local function getFrameHashes(first)
+    if first == nil then first = 0 end
+    if type(first) ~= 'number' then error 'PCSX.GPU.getFrameHashes requires a numeric starting index' end
+    local frame = ffi.new('uint32_t[1]')
+    local high = ffi.new('uint32_t[1]')
+    local low = ffi.new('uint32_t[1]')
+    local ret = {}
+    for i = first, C.getFrameHashesCount() - 1 do
+        C.getFrameHash(i, frame, high, low)
+        ret[#ret + 1] = { frame = frame[0], hash = string.format('%08x%08x', high[0], low[0]) }
+    end
+    return ret
+end
+
+local function getGPUCounters(which)
+    local frames = { current = 0, last = 1, total = 2 }
+    if which == nil then which = 'last' end
+    if frames[which] == nil then error "PCSX.GPU.getCounters requires 'current', 'last' or 'total'" end
+    local ret = {}
+    for i = 0, C.getGPUCountersCount() - 1 do
+        ret[ffi.string(C.getGPUCounterName(i))] = C.getGPUCounter(frames[which], i)
+    end
+    return ret
+end
+
+local function getGTEProfile(which)
+    local frames = { current = 0, last = 1, total = 2 }
+    if which == nil then which = 'last' end
+    if frames[which] == nil then error "PCSX.GTE.getProfile requires 'current', 'last' or 'total'" end
+    local count = ffi.new('double[1]')
+    local cycles = ffi.new('double[1]')
+    local hostNs = ffi.new('double[1]')
+    local ret = {}
+    for i = 0, C.getGTEProfilerCommandsCount() - 1 do
+        C.getGTEProfilerCommand(frames[which], i, count, cycles, hostNs)
+        ret[ffi.string(C.getGTEProfilerCommandName(i))] = { count = count[0], cycles = cycles[0], hostNs = hostNs[0] }
+    end
+    return ret
+end
+
 local function jumpToPC(pc)
     if type(pc) ~= 'number' then error 'PCSX.GUI.jumpToPC requires a numeric address' end
     C.jumpToPC(pc)
@@ -204,6 +275,27 @@ PCSX = {
                 bpp = ss.bpp,
             }
         end,
+        startFrameHashes = function(output) checkErrorString(C.startFrameHashes(output or '')) end,
+        stopFrameHashes = function() C.stopFrameHashes() end,
+        frameHashesEnabled = function() return C.frameHashesEnabled() end,
+        loadGoldenFrameHashes = function(path) checkErrorString(C.loadGoldenFrameHashes(path)) end,
+        getFrameHashes = getFrameHashes,
+        startCounters = function(csv) checkErrorString(C.startGPUCounters(csv or '')) end,
+        stopCounters = function() C.stopGPUCounters() end,
+        countersEnabled = function() return C.gpuCountersEnabled() end,
+        getCounters = getGPUCounters,
+    },
+    GTE = {
+        startProfiler = function(csv) checkErrorString(C.startGTEProfiler(csv or '')) end,
+        stopProfiler = function() C.stopGTEProfiler() end,
+        profilerEnabled = function() return C.gteProfilerEnabled() end,
+        getProfile = getGTEProfile,
+    },
+    SPU = {
+        startAudioDump = function(path, stems) checkErrorString(C.startAudioDump(path or '', stems == true)) end,
+        stopAudioDump = function() C.stopAudioDump() end,
+        audioDumpEnabled = function() return C.audioDumpEnabled() end,
+        getAudioDumpFrames = function() return C.getAudioDumpFrames() end,
     },
     createSaveState = function()
         local slice = C.createSaveState()
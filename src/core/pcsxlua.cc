@@ -19,8 +19,12 @@
 
 #include "core/pcsxlua.h"
 
+#include "core/audiodump.h"
 #include "core/debug.h"
+#include "core/framehashes.h"
 #include "core/gpu.h"
+#include "core/gpucounters.h"
+#include "core/gteprofiler.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "core/r3000a.h"
@@ -104,6 +108,110 @@ LuaScreenShot takeScreenShot() {
     return ret;
 }
 
+// The error strings need to outlive the call, for the Lua side to copy them.
+const char* startFrameHashes(const char* output) {
+    static std::string error;
+    error = PCSX::g_emulator->m_frameHashes->start(output);
+    return error.c_str();
+}
+
+void stopFrameHashes() { PCSX::g_emulator->m_frameHashes->stop(); }
+bool frameHashesEnabled() { return PCSX::g_emulator->m_frameHashes->enabled(); }
+
+const char* loadGoldenFrameHashes(const char* path) {
+    static std::string error;
+    error = PCSX::g_emulator->m_frameHashes->loadGolden(path);
+    return error.c_str();
+}
+
+unsigned getFrameHashesCount() { return PCSX::g_emulator->m_frameHashes->log().size(); }
+
+void getFrameHash(unsigned index, uint32_t* frame, uint32_t* hashHigh, uint32_t* hashLow) {
+    const auto& entry = PCSX::g_emulator->m_frameHashes->log()[index];
+    *frame = entry.frame;
+    *hashHigh = entry.hash >> 32;
+    *hashLow = entry.hash;
+}
+
+const char* startGPUCounters(const char* csv) {
+    static std::string error;
+    error = PCSX::g_emulator->m_gpuCounters->start(csv);
+    return error.c_str();
+}
+
+void stopGPUCounters() { PCSX::g_emulator->m_gpuCounters->stop(); }
+bool gpuCountersEnabled() { return PCSX::g_emulator->m_gpuCounters->enabled(); }
+
+unsigned getGPUCountersCount() {
+    unsigned count = 0;
+    PCSX::GPUCounters::Frame().forEach([&count](const char*, double) { count++; });
+    return count;
+}
+
+const char* getGPUCounterName(unsigned index) {
+    const char* ret = "";
+    PCSX::GPUCounters::Frame().forEach([&](const char* name, double) {
+        if (index-- == 0) ret = name;
+    });
+    return ret;
+}
+
+// Which is 0 for the frame being counted, 1 for the last complete one, and 2 for the total.
+double getGPUCounter(unsigned which, unsigned index) {
+    auto& counters = PCSX::g_emulator->m_gpuCounters;
+    const auto& frame = which == 0 ? counters->current() : which == 1 ? counters->lastFrame() : counters->total();
+    double ret = 0.0;
+    frame.forEach([&](const char*, double value) {
+        if (index-- == 0) ret = value;
+    });
+    return ret;
+}
+
+const char* startGTEProfiler(const char* csv) {
+    static std::string error;
+    error = PCSX::g_emulator->m_gteProfiler->start(csv);
+    return error.c_str();
+}
+
+void stopGTEProfiler() { PCSX::g_emulator->m_gteProfiler->stop(); }
+bool gteProfilerEnabled() { return PCSX::g_emulator->m_gteProfiler->enabled(); }
+
+unsigned getGTEProfilerCommandsCount() {
+    unsigned count = 0;
+    PCSX::GTEProfiler::Frame().forEach([&count](const char*, const PCSX::GTEProfiler::Command&) { count++; });
+    return count;
+}
+
+const char* getGTEProfilerCommandName(unsigned index) {
+    const char* ret = "";
+    PCSX::GTEProfiler::Frame().forEach([&](const char* name, const PCSX::GTEProfiler::Command&) {
+        if (index-- == 0) ret = name;
+    });
+    return ret;
+}
+
+// Which is 0 for the frame being counted, 1 for the last complete one, and 2 for the total.
+void getGTEProfilerCommand(unsigned which, unsigned index, double* count, double* cycles, double* hostNs) {
+    auto& profiler = PCSX::g_emulator->m_gteProfiler;
+    const auto& frame = which == 0 ? profiler->current() : which == 1 ? profiler->lastFrame() : profiler->total();
+    frame.forEach([&](const char*, const PCSX::GTEProfiler::Command& command) {
+        if (index-- != 0) return;
+        *count = command.count;
+        *cycles = command.cycles;
+        *hostNs = command.hostNanoseconds();
+    });
+}
+
+const char* startAudioDump(const char* path, bool stems) {
+    static std::string error;
+    error = PCSX::g_emulator->m_audioDump->start(path, stems);
+    return error.c_str();
+}
+
+void stopAudioDump() { PCSX::g_emulator->m_audioDump->stop(); }
+bool audioDumpEnabled() { return PCSX::g_emulator->m_audioDump->enabled(); }
+double getAudioDumpFrames() { return PCSX::g_emulator->m_audioDump->frames(); }
+
 PCSX::Slice* createSaveState() {
     auto ss = PCSX::SaveStates::save();
     return new PCSX::Slice(std::move(ss));
@@ -159,6 +267,28 @@ static void registerAllSymbols(PCSX::Lua L) {
     REGISTER(L, jumpToMemory);
     REGISTER(L, invalidateCache);
     REGISTER(L, takeScreenShot);
+    REGISTER(L, startFrameHashes);
+    REGISTER(L, stopFrameHashes);
+    REGISTER(L, frameHashesEnabled);
+    REGISTER(L, loadGoldenFrameHashes);
+    REGISTER(L, getFrameHashesCount);
+    REGISTER(L, getFrameHash);
+    REGISTER(L, startGPUCounters);
+    REGISTER(L, stopGPUCounters);
+    REGISTER(L, gpuCountersEnabled);
+    REGISTER(L, getGPUCountersCount);
+    REGISTER(L, getGPUCounterName);
+    REGISTER(L, getGPUCounter);
+    REGISTER(L, startGTEProfiler);
+    REGISTER(L, stopGTEProfiler);
+    REGISTER(L, gteProfilerEnabled);
+    REGISTER(L, getGTEProfilerCommandsCount);
+    REGISTER(L, getGTEProfilerCommandName);
+    REGISTER(L, getGTEProfilerCommand);
+    REGISTER(L, startAudioDump);
+    REGISTER(L, stopAudioDump);
+    REGISTER(L, audioDumpEnabled);
+    REGISTER(L, getAudioDumpFrames);
     REGISTER(L, createSaveState);
     REGISTER(L, loadSaveStateFromSlice);
     REGISTER(L, loadSaveStateFromFile);
@@ -36,15 +36,9 @@ void InvalidLoad(uint32_t addr, uint32_t code, uint32_t value) {
     p.x = p.y = -1337;  // default values
 
     // p.valid = 0;
-    // p.count = value;
     pD = PGXP_ReadMem(addr);
 
-    if (pD) {
-        p.count = addr;
-        p = *pD;
-    } else {
-        p.count = value;
-    }
+    if (pD) p = *pD;
 
     p.flags = 0;
 
@@ -54,7 +48,6 @@ void InvalidLoad(uint32_t addr, uint32_t code, uint32_t value) {
 
 // invalidate memory address (invalid 8 bit write)
 void InvalidStore(uint32_t addr, uint32_t code, uint32_t value) {
-    uint32_t reg = ((code >> 16) & 0x1F);  // The rt part of the instruction register
     PGXP_value* pD = NULL;
     PGXP_value p;
 
@@ -65,7 +58,6 @@ void InvalidStore(uint32_t addr, uint32_t code, uint32_t value) {
     if (pD) p = *pD;
 
     p.flags = 0;
-    p.count = (reg * 1000) + value;
 
     // invalidate memory
     WriteMem(&p, addr);
@@ -426,16 +426,16 @@ void PrintOperands(char* szBuffer, uint32_t instr, uint32_t flags, const char* s
             }
 
             if (pReg) {
-                sprintf(szTempBuffer, "%s %s [%x(%d, %d) %x(%.2f, %.2f, %.2f)%x : %x:%x:%x:%x] ", szPre, szOpdName,
-                        psx_reg.d, psx_reg.sw.l, psx_reg.sw.h, pReg->value, pReg->x, pReg->y, pReg->z, pReg->count,
+                sprintf(szTempBuffer, "%s %s [%x(%d, %d) %x(%.2f, %.2f, %.2f) : %x:%x:%x:%x] ", szPre, szOpdName,
+                        psx_reg.d, psx_reg.sw.l, psx_reg.sw.h, pReg->value, pReg->x, pReg->y, pReg->z,
                         pReg->compFlags[0], pReg->compFlags[1], pReg->compFlags[2], pReg->compFlags[3]);
                 strcat(szBuffer, szTempBuffer);
             } else if (flag == fOp_Ad) {
                 pReg = PGXP_GetPtr(psx_reg.d);
                 if (pReg)
-                    sprintf(szTempBuffer, "%s %s [%x(%d, %d) (%x) %x(%.2f, %.2f, %.2f)%x : %x:%x:%x:%x] ", szPre,
+                    sprintf(szTempBuffer, "%s %s [%x(%d, %d) (%x) %x(%.2f, %.2f, %.2f) : %x:%x:%x:%x] ", szPre,
                             szOpdName, psx_reg.d, psx_reg.sw.l, psx_reg.sw.h, PGXP_ConvertAddress(psx_reg.d),
-                            pReg->value, pReg->x, pReg->y, pReg->z, pReg->count, pReg->compFlags[0], pReg->compFlags[1],
+                            pReg->value, pReg->x, pReg->y, pReg->z, pReg->compFlags[0], pReg->compFlags[1],
                             pReg->compFlags[2], pReg->compFlags[3]);
                 else
                     sprintf(szTempBuffer, "%s %s [%x(%d, %d) (%x) INVALID_ADDRESS!] ", szPre, szOpdName, psx_reg.d,
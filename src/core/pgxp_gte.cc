@@ -77,7 +77,6 @@ void PGXP_InitGTE() {
 #define SXYP (g_GTE_data_reg[15])
 
 void PGXP_pushSXYZ2f(float _x, float _y, float _z, unsigned int _v) {
-    static unsigned int uCount = 0;
     low_value temp;
     // push values down FIFO
     SXY0 = SXY1;
@@ -88,7 +87,6 @@ void PGXP_pushSXYZ2f(float _x, float _y, float _z, unsigned int _v) {
     SXY2.z = PCSX::g_emulator->config().PGXP_Texture ? _z : 1.f;
     SXY2.value = _v;
     SXY2.flags = VALID_ALL;
-    SXY2.count = uCount++;
 
     // cache value in GPU plugin
     temp.word = _v;
@@ -98,7 +96,7 @@ void PGXP_pushSXYZ2f(float _x, float _y, float _z, unsigned int _v) {
         PCSX::g_emulator->m_gpu->pgxpCacheVertex(0, 0, NULL);
     }
 
-    GTE_LOG("PGXP_PUSH (%f, %f) %u %u|", SXY2.x, SXY2.y, SXY2.flags, SXY2.count);
+    GTE_LOG("PGXP_PUSH (%f, %f) %u|", SXY2.x, SXY2.y, SXY2.flags);
 }
 
 void PGXP_pushSXYZ2s(int64_t _x, int64_t _y, int64_t _z, uint32_t v) {
@@ -1,16 +1,48 @@
 #include "core/pgxp_mem.h"
 
+#include <memory>
+#include <vector>
+
 #include "core/pgxp_cpu.h"
 #include "core/pgxp_gte.h"
 #include "core/pgxp_value.h"
 
-static PGXP_value s_mem[3 * 2048 * 1024 / 4];  // mirror 2MB in 32-bit words * 3
+// The shadow memory is split into pages, each covering 1KB of the PSX address space. A page is
+// only allocated on the first PGXP write to it, and reads from the pages nobody wrote to yet get
+// a blank value, which is what the whole shadow memory used to hold on startup. The RAM part is
+// sized from the actual RAM configuration, so that the 8MB mode doesn't alias its mirrors.
+static const uint32_t s_pageShift = 8;
+static const uint32_t s_pageSize = 1 << s_pageShift;
+static const uint32_t s_scratchSize = 1024 / 4;
+static const uint32_t s_registerSize = (0x10000 - 0x1000) / 4;
+
+static std::vector<std::unique_ptr<PGXP_value[]>> s_pages;
+static PGXP_value s_blank;
+static uint32_t s_ramMask = 0x1fffff;
 static const uint32_t s_userMemOffset = 0;
-static const uint32_t s_scratchOffset = 2048 * 1024 / 4;
-static const uint32_t s_registerOffset = 2 * 2048 * 1024 / 4;
-static const uint32_t s_invalidAddress = 3 * 2048 * 1024 / 4;
-
-void PGXP_InitMem() { memset(s_mem, 0, sizeof(s_mem)); }
+static uint32_t s_scratchOffset = 0;
+static uint32_t s_registerOffset = 0;
+static uint32_t s_invalidAddress = 0;
+
+void PGXP_InitMem() {
+    const bool ramExpansion = PCSX::g_emulator->settings.get<PCSX::Emulator::Setting8MB>();
+    const uint32_t ramSize = ramExpansion ? 8 * 1024 * 1024 : 2 * 1024 * 1024;
+    s_ramMask = ramSize - 1;
+    s_scratchOffset = s_userMemOffset + ramSize / 4;
+    s_registerOffset = s_scratchOffset + s_scratchSize;
+    s_invalidAddress = s_registerOffset + s_registerSize;
+
+    const size_t pages = s_invalidAddress >> s_pageShift;
+    if (s_pages.size() != pages) {
+        s_pages.clear();
+        s_pages.resize(pages);
+        return;
+    }
+    // Only the pages written to since the last reset need clearing.
+    for (auto& page : s_pages) {
+        if (page) memset(page.get(), 0, s_pageSize * sizeof(PGXP_value));
+    }
+}
 
 void PGXP_Init() {
     PGXP_InitMem();
@@ -18,10 +50,6 @@ void PGXP_Init() {
     PGXP_InitGTE();
 }
 
-uint8_t* PGXP_GetMem() {
-    return (uint8_t*)(s_mem);  // PCSX::g_emulator->config().PGXP_GTE ? (char*)(s_mem) : NULL;
-}
-
 /*  Playstation Memory Map (from Playstation doc by Joshua Walker)
 0x0000_0000-0x0000_ffff     Kernel (64K)
 0x0001_0000-0x001f_ffff     User Memory (1.9 Meg)
@@ -79,7 +107,7 @@ uint32_t PGXP_ConvertAddress(uint32_t addr) {
         case 0xa0:
         case 0x00:
             // RAM further mirrored over 8MB
-            paddr = ((paddr & 0x7FFFFF) % 0x200000) >> 2;
+            paddr = (paddr & s_ramMask) >> 2;
             paddr = s_userMemOffset + paddr;
             break;
         default:
@@ -107,13 +135,24 @@ uint32_t PGXP_ConvertAddress(uint32_t addr) {
     return paddr;
 }
 
-PGXP_value* PGXP_GetPtr(uint32_t addr) {
+static PGXP_value* GetPtr(uint32_t addr, bool commit) {
     addr = PGXP_ConvertAddress(addr);
-
-    if (addr != s_invalidAddress) return &s_mem[addr];
-    return NULL;
+    if (addr == s_invalidAddress) return NULL;
+
+    auto& page = s_pages[addr >> s_pageShift];
+    if (!page) {
+        // Callers are free to validate what they read, so the blank value is handed out fresh.
+        if (!commit) {
+            s_blank = {};
+            return &s_blank;
+        }
+        page = std::make_unique<PGXP_value[]>(s_pageSize);
+    }
+    return &page[addr & (s_pageSize - 1)];
 }
 
+PGXP_value* PGXP_GetPtr(uint32_t addr) { return GetPtr(addr, false); }
+
 PGXP_value* PGXP_ReadMem(uint32_t addr) { return PGXP_GetPtr(addr); }
 
 void ValidateAndCopyMem(PGXP_value* dest, uint32_t addr, uint32_t value) {
@@ -167,13 +206,13 @@ void ValidateAndCopyMem16(PGXP_value* dest, uint32_t addr, uint32_t value, int s
 }
 
 void WriteMem(PGXP_value* value, uint32_t addr) {
-    PGXP_value* pMem = PGXP_GetPtr(addr);
+    PGXP_value* pMem = GetPtr(addr, true);
 
     if (pMem) *pMem = *value;
 }
 
 void WriteMem16(PGXP_value* src, uint32_t addr) {
-    PGXP_value* dest = PGXP_GetPtr(addr);
+    PGXP_value* dest = GetPtr(addr, true);
     psx_value* pVal = NULL;
 
     if (dest) {
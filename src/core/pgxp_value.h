@@ -62,6 +62,7 @@ typedef union {
     int32_t sd;
 } psx_value;
 
+// Kept down to 24 bytes, without padding, since the shadow memory holds one of these per word.
 typedef struct PGXP_value_Tag {
     float x;
     float y;
@@ -71,7 +72,6 @@ typedef struct PGXP_value_Tag {
         unsigned char compFlags[4];
         unsigned short halfFlags[2];
     };
-    unsigned int count;
     unsigned int value;
 
     unsigned short gFlags;
@@ -106,8 +106,8 @@ typedef enum { VALID_HALF = (1 << 0) } PGXP_half_flags;
 #define INV_VALID_ALL (ALL ^ VALID_ALL)
 //} PGXP_value_flags;
 
-static const PGXP_value PGXP_value_invalid_address = {0.f, 0.f, 0.f, 0, 0, 0, INVALID_ADDRESS, 0, 0};
-static const PGXP_value PGXP_value_zero = {0.f, 0.f, 0.f, 0, 0, VALID_ALL, 0, 0, 0};
+static const PGXP_value PGXP_value_invalid_address = {0.f, 0.f, 0.f, 0, 0, INVALID_ADDRESS, 0, 0};
+static const PGXP_value PGXP_value_zero = {0.f, 0.f, 0.f, 0, VALID_ALL, 0, 0, 0};
 
 void SetValue(PGXP_value *pV, uint32_t psxV);
 void MakeValid(PGXP_value *pV, uint32_t psxV);
@@ -157,9 +157,10 @@ void PCSX::Counters::update() {
         uint32_t target = m_audioFrames + diff;
         uint32_t newFrames = g_emulator->m_spu->getCurrentFrames();
         int32_t framesDiff = target - newFrames;
-        if (framesDiff > 0) {
+        uint32_t goal;
+        if (SPU::RateControl::pacingGoal(target, newFrames, g_emulator->m_spu->getLatencyTarget(), goal)) {
             g_emulator->m_cpu->m_regs.previousCycles = cycle;
-            g_emulator->m_spu->waitForGoal(target);
+            g_emulator->m_spu->waitForGoal(goal);
             m_audioFrames = target;
         } else if (framesDiff < -2000000000) {
             m_audioFrames = newFrames;
@@ -19,14 +19,19 @@
 
 #include "core/psxemulator.h"
 
+#include "core/audiodump.h"
 #include "core/callstacks.h"
 #include "core/cdrom.h"
 #include "core/debug.h"
 #include "core/eventslua.h"
+#include "core/framehashes.h"
 #include "core/gdb-server.h"
 #include "core/gpu.h"
+#include "core/gpucapture.h"
+#include "core/gpucounters.h"
 #include "core/gpulogger.h"
 #include "core/gte.h"
+#include "core/gteprofiler.h"
 #include "core/luaiso.h"
 #include "core/mdec.h"
 #include "core/pad.h"
@@ -36,6 +41,7 @@
 #include "core/sio.h"
 #include "core/sio1-server.h"
 #include "core/sio1.h"
+#include "core/videorecorder.h"
 #include "core/web-server.h"
 #include "gpu/soft/interface.h"
 #include "lua/extra.h"
@@ -54,13 +60,18 @@ extern "C" {
 extern "C" int luaopen_lpeg(lua_State* L);
 
 PCSX::Emulator::Emulator()
-    : m_callStacks(new PCSX::CallStacks),
+    : m_audioDump(new PCSX::AudioDump()),
+      m_callStacks(new PCSX::CallStacks),
       m_cdrom(PCSX::CDRom::factory()),
       m_counters(new PCSX::Counters()),
       m_debug(new PCSX::Debug()),
+      m_frameHashes(new PCSX::FrameHashes()),
       m_gdbServer(new PCSX::GdbServer()),
+      m_gpuCapture(new PCSX::GPUCapture()),
+      m_gpuCounters(new PCSX::GPUCounters()),
       m_gpuLogger(new PCSX::GPULogger()),
       m_gte(new PCSX::GTE()),
+      m_gteProfiler(new PCSX::GTEProfiler()),
       m_hw(new PCSX::HW()),
       m_lua(new PCSX::Lua()),
       m_mdec(new PCSX::MDEC()),
@@ -72,6 +83,7 @@ PCSX::Emulator::Emulator()
       m_sio1Server(new PCSX::SIO1Server()),
       m_sio1Client(new PCSX::SIO1Client()),
       m_spu(new PCSX::SPU::impl()),
+      m_videoRecorder(new PCSX::VideoRecorder()),
       m_webServer(new PCSX::WebServer()) {
     auto L = *m_lua;
     L.openlibs();
@@ -135,7 +147,11 @@ int PCSX::Emulator::init() {
 
     const auto& args = g_system->getArgs();
 
-    m_gpu = settings.get<SettingHardwareRenderer>() ? GPU::getOpenGL() : GPU::getSoft();
+    if (args.isUIDisabled()) {
+        m_gpu = GPU::getHeadless();
+    } else {
+        m_gpu = settings.get<SettingHardwareRenderer>() ? GPU::getOpenGL() : GPU::getSoft();
+    }
 
     setPGXPMode(m_config.PGXP_Mode);
     m_sio->init();
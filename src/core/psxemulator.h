@@ -63,14 +63,19 @@
 
 namespace PCSX {
 
+class AudioDump;
 class CallStacks;
 class CDRom;
 class Counters;
 class Debug;
+class FrameHashes;
 class GdbServer;
 class GPU;
+class GPUCapture;
+class GPUCounters;
 class GPULogger;
 class GTE;
+class GTEProfiler;
 class HW;
 class Lua;
 class MDEC;
@@ -80,6 +85,7 @@ class R3000Acpu;
 class SIO;
 class SPUInterface;
 class System;
+class VideoRecorder;
 class WebServer;
 class SIO1;
 class SIO1Server;
@@ -170,6 +176,9 @@ class Emulator {
     typedef Setting<int, TYPESTRING("GUITheme"), 0> SettingGUITheme;
     typedef Setting<int, TYPESTRING("Dither"), 1> SettingDither;
     typedef Setting<bool, TYPESTRING("UseCachedDithering"), false> SettingCachedDithering;
+    typedef Setting<int, TYPESTRING("SoftGPUThreads"), 1> SettingSoftGPUThreads;
+    typedef Setting<bool, TYPESTRING("SoftGPUTextureCache"), true> SettingSoftGPUTextureCache;
+    typedef Setting<int, TYPESTRING("SoftGPUUpscale"), 0> SettingSoftGPUUpscale;
     typedef Setting<bool, TYPESTRING("ReportGLErrors"), false> SettingGLErrorReporting;
     typedef Setting<int, TYPESTRING("ReportGLErrorsSeverity"), 1> SettingGLErrorReportingSeverity;
     typedef Setting<bool, TYPESTRING("FullCaching"), false> SettingFullCaching;
@@ -193,7 +202,7 @@ class Emulator {
              SettingGLErrorReportingSeverity, SettingFullCaching, SettingHardwareRenderer, SettingShownAutoUpdateConfig,
              SettingAutoUpdate, SettingMSAA, SettingLinearFiltering, SettingKioskMode, SettingMcd1Pocketstation,
              SettingMcd2Pocketstation, SettingBiosBrowsePath, SettingEXP1Filepath, SettingEXP1BrowsePath,
-             SettingPIOConnected>
+             SettingPIOConnected, SettingSoftGPUThreads, SettingSoftGPUTextureCache, SettingSoftGPUUpscale>
         settings;
     class PcsxConfig {
       public:
@@ -236,14 +245,19 @@ class Emulator {
 
     PcsxConfig& config() { return m_config; }
 
+    std::unique_ptr<AudioDump> m_audioDump;
     std::unique_ptr<CallStacks> m_callStacks;
     std::unique_ptr<CDRom> m_cdrom;
     std::unique_ptr<Counters> m_counters;
     std::unique_ptr<Debug> m_debug;
+    std::unique_ptr<FrameHashes> m_frameHashes;
     std::unique_ptr<GdbServer> m_gdbServer;
     std::unique_ptr<GPU> m_gpu;
+    std::unique_ptr<GPUCapture> m_gpuCapture;
+    std::unique_ptr<GPUCounters> m_gpuCounters;
     std::unique_ptr<GPULogger> m_gpuLogger;
     std::unique_ptr<GTE> m_gte;
+    std::unique_ptr<GTEProfiler> m_gteProfiler;
     std::unique_ptr<HW> m_hw;
     std::unique_ptr<Lua> m_lua;
     std::unique_ptr<MDEC> m_mdec;
@@ -256,6 +270,7 @@ class Emulator {
     std::unique_ptr<SIO1Server> m_sio1Server;
     std::unique_ptr<SIO1Client> m_sio1Client;
     std::unique_ptr<SPUInterface> m_spu;
+    std::unique_ptr<VideoRecorder> m_videoRecorder;
     std::unique_ptr<WebServer> m_webServer;
 
   private:
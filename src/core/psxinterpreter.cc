@@ -21,6 +21,7 @@
 #include "core/debug.h"
 #include "core/disr3000a.h"
 #include "core/gte.h"
+#include "core/gteprofiler.h"
 #include "core/pgxp_cpu.h"
 #include "core/pgxp_debug.h"
 #include "core/pgxp_gte.h"
@@ -107,14 +108,24 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     typedef void (InterpretedCPU::*intFunc_t)(uint32_t code);
     typedef const intFunc_t cIntFunc_t;
 
-    cIntFunc_t *s_pPsxBSC = NULL;
-    cIntFunc_t *s_pPsxSPC = NULL;
-    cIntFunc_t *s_pPsxREG = NULL;
-    cIntFunc_t *s_pPsxCP0 = NULL;
-    cIntFunc_t *s_pPsxCP2 = NULL;
-    cIntFunc_t *s_pPsxCP2BSC = NULL;
+    // Each PGXP mode gets its own instance of the execution loop, with its dispatch tables picked
+    // at compile time, so that the disabled mode never goes anywhere near the PGXP code.
+    enum class PGXP { Disabled, Memory, Full };
+    PGXP m_pgxp = PGXP::Disabled;
+    template <PGXP pgxp>
+    static constexpr cIntFunc_t *bscTable() {
+        if constexpr (pgxp == PGXP::Full) {
+            return s_pgxpPsxBSC;
+        } else if constexpr (pgxp == PGXP::Memory) {
+            return s_pgxpPsxBSCMem;
+        } else {
+            return s_psxBSC;
+        }
+    }
 
-    template <bool debug, bool trace>
+    template <PGXP pgxp>
+    void execute();
+    template <bool debug, bool trace, PGXP pgxp>
     void execBlock();
     void doBranch(uint32_t target, bool fromLink);
 
@@ -226,6 +237,8 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     void psxCOP2(uint32_t code);
     void psxCOP3(uint32_t code);
     void gteMove(uint32_t code);
+    template <bool pgxp>
+    void cop2(uint32_t code);
 
     /* GTE wrappers */
 #define GTE_WRAPPER(n) \
@@ -248,15 +261,15 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     GTE_WRAPPER(NCCT);
     GTE_WRAPPER(NCDS);
     GTE_WRAPPER(NCDT);
-    GTE_WRAPPER(NCLIP);
     GTE_WRAPPER(NCS);
     GTE_WRAPPER(NCT);
     GTE_WRAPPER(OP);
-    GTE_WRAPPER(RTPS);
-    GTE_WRAPPER(RTPT);
     GTE_WRAPPER(SQR);
     GTE_WRAPPER(SWC2);
 #undef GTE_WRAPPER
+    void gteRTPS(uint32_t code) { PCSX::g_emulator->m_gte->RTPS(code); }
+    void gteRTPT(uint32_t code) { PCSX::g_emulator->m_gte->RTPT(code); }
+    void gteNCLIP(uint32_t code) { PCSX::g_emulator->m_gte->NCLIP(code); }
 
     static const intFunc_t s_psxBSC[64];
     static const intFunc_t s_psxSPC[64];
@@ -322,9 +335,18 @@ class InterpretedCPU final : public PCSX::R3000Acpu {
     void pgxpPsxCTC0(uint32_t code);
     void pgxpPsxRFE(uint32_t code);
 
+    void pgxpPsxSPECIAL(uint32_t code);
+    void pgxpPsxCOP0(uint32_t code);
+    void pgxpPsxCOP2(uint32_t code);
+    void pgxpGteMove(uint32_t code);
+    void pgxpGteRTPS(uint32_t code) { PCSX::g_emulator->m_gte->pgxpRTPS(code); }
+    void pgxpGteRTPT(uint32_t code) { PCSX::g_emulator->m_gte->pgxpRTPT(code); }
+    void pgxpGteNCLIP(uint32_t code) { PCSX::g_emulator->m_gte->pgxpNCLIP(code); }
+
     static const intFunc_t s_pgxpPsxBSC[64];
     static const intFunc_t s_pgxpPsxSPC[64];
     static const intFunc_t s_pgxpPsxCP0[32];
+    static const intFunc_t s_pgxpPsxCP2[64];
     static const intFunc_t s_pgxpPsxCP2BSC[32];
     static const intFunc_t s_pgxpPsxBSCMem[64];
 };
@@ -1095,11 +1117,11 @@ void InterpretedCPU::psxNULL(uint32_t code) {
     exception(Exception::ReservedInstruction, m_inDelaySlot);
 }
 
-void InterpretedCPU::psxSPECIAL(uint32_t code) { (*this.*(s_pPsxSPC[_Funct_]))(code); }
+void InterpretedCPU::psxSPECIAL(uint32_t code) { (*this.*(s_psxSPC[_Funct_]))(code); }
 
-void InterpretedCPU::psxREGIMM(uint32_t code) { (*this.*(s_pPsxREG[_Rt_]))(code); }
+void InterpretedCPU::psxREGIMM(uint32_t code) { (*this.*(s_psxREG[_Rt_]))(code); }
 
-void InterpretedCPU::psxCOP0(uint32_t code) { (*this.*(s_pPsxCP0[_Rs_]))(code); }
+void InterpretedCPU::psxCOP0(uint32_t code) { (*this.*(s_psxCP0[_Rs_]))(code); }
 
 void InterpretedCPU::psxCOP1(uint32_t code) {  // Accesses to the (nonexistent) FPU
     // TODO: Verify that COP1 doesn't throw a coprocessor unusable exception
@@ -1109,17 +1131,28 @@ void InterpretedCPU::psxCOP1(uint32_t code) {  // Accesses to the (nonexistent)
                         m_regs.pc - 4);
 }
 
-void InterpretedCPU::psxCOP2(uint32_t code) {
+template <bool pgxp>
+void InterpretedCPU::cop2(uint32_t code) {
     if ((m_regs.CP0.n.Status & 0x40000000) == 0) return;
 
-    (*this.*(s_pPsxCP2[_Funct_]))(code);
+    cIntFunc_t *table = pgxp ? s_pgxpPsxCP2 : s_psxCP2;
+    auto &profiler = PCSX::g_emulator->m_gteProfiler;
+    if (profiler->enabled()) {
+        profiler->enter(code);
+        (*this.*(table[_Funct_]))(code);
+        profiler->leave();
+        return;
+    }
+    (*this.*(table[_Funct_]))(code);
 }
 
+void InterpretedCPU::psxCOP2(uint32_t code) { cop2<false>(code); }
+
 void InterpretedCPU::psxCOP3(uint32_t code) {
     PCSX::g_system->log(PCSX::LogClass::CPU, _("Attempted to access COP3 from 0x%08x. Ignored\n"), m_regs.pc - 4);
 }
 
-void InterpretedCPU::gteMove(uint32_t code) { (*this.*(s_pPsxCP2BSC[_Rs_]))(code); }
+void InterpretedCPU::gteMove(uint32_t code) { (*this.*(s_psxCP2BSC[_Rs_]))(code); }
 
 const InterpretedCPU::intFunc_t InterpretedCPU::s_psxBSC[64] = {
     &InterpretedCPU::psxSPECIAL, &InterpretedCPU::psxREGIMM, &InterpretedCPU::psxJ,    &InterpretedCPU::psxJAL,    // 00
@@ -1220,6 +1253,11 @@ const InterpretedCPU::intFunc_t InterpretedCPU::s_psxCP2BSC[32] = {
 
 void InterpretedCPU::pgxpPsxNULL(uint32_t code) {}
 
+void InterpretedCPU::pgxpPsxSPECIAL(uint32_t code) { (*this.*(s_pgxpPsxSPC[_Funct_]))(code); }
+void InterpretedCPU::pgxpPsxCOP0(uint32_t code) { (*this.*(s_pgxpPsxCP0[_Rs_]))(code); }
+void InterpretedCPU::pgxpPsxCOP2(uint32_t code) { cop2<true>(code); }
+void InterpretedCPU::pgxpGteMove(uint32_t code) { (*this.*(s_pgxpPsxCP2BSC[_Rs_]))(code); }
+
 #define psxMTC2 gteMTC2
 #define psxCTC2 gteCTC2
 #define psxLWC2 gteLWC2
@@ -1404,38 +1442,38 @@ PGXP_INT_FUNC(CP0, RFE)
 
 // Trace all functions using PGXP
 const InterpretedCPU::intFunc_t InterpretedCPU::s_pgxpPsxBSC[64] = {
-    &InterpretedCPU::psxSPECIAL,  &InterpretedCPU::psxREGIMM,     // 00
-    &InterpretedCPU::psxJ,        &InterpretedCPU::psxJAL,        // 02
-    &InterpretedCPU::psxBEQ,      &InterpretedCPU::psxBNE,        // 04
-    &InterpretedCPU::psxBLEZ,     &InterpretedCPU::psxBGTZ,       // 06
-    &InterpretedCPU::pgxpPsxADDI, &InterpretedCPU::pgxpPsxADDIU,  // 08
-    &InterpretedCPU::pgxpPsxSLTI, &InterpretedCPU::pgxpPsxSLTIU,  // 0a
-    &InterpretedCPU::pgxpPsxANDI, &InterpretedCPU::pgxpPsxORI,    // 0c
-    &InterpretedCPU::pgxpPsxXORI, &InterpretedCPU::pgxpPsxLUI,    // 0e
-    &InterpretedCPU::psxCOP0,     &InterpretedCPU::psxNULL,       // 10
-    &InterpretedCPU::psxCOP2,     &InterpretedCPU::psxNULL,       // 12
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 14
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 16
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 18
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 1a
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 1c
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 1e
-    &InterpretedCPU::pgxpPsxLB,   &InterpretedCPU::pgxpPsxLH,     // 20
-    &InterpretedCPU::pgxpPsxLWL,  &InterpretedCPU::pgxpPsxLW,     // 22
-    &InterpretedCPU::pgxpPsxLBU,  &InterpretedCPU::pgxpPsxLHU,    // 24
-    &InterpretedCPU::pgxpPsxLWR,  &InterpretedCPU::pgxpPsxNULL,   // 26
-    &InterpretedCPU::pgxpPsxSB,   &InterpretedCPU::pgxpPsxSH,     // 28
-    &InterpretedCPU::pgxpPsxSWL,  &InterpretedCPU::pgxpPsxSW,     // 2a
-    &InterpretedCPU::pgxpPsxNULL, &InterpretedCPU::pgxpPsxNULL,   // 2c
-    &InterpretedCPU::pgxpPsxSWR,  &InterpretedCPU::pgxpPsxNULL,   // 2e
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 30
-    &InterpretedCPU::pgxpPsxLWC2, &InterpretedCPU::psxNULL,       // 32
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 34
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 36
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 38
-    &InterpretedCPU::pgxpPsxSWC2, &InterpretedCPU::psxNULL,       // 3a
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 3c
-    &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,       // 3e
+    &InterpretedCPU::pgxpPsxSPECIAL, &InterpretedCPU::psxREGIMM,     // 00
+    &InterpretedCPU::psxJ,           &InterpretedCPU::psxJAL,        // 02
+    &InterpretedCPU::psxBEQ,         &InterpretedCPU::psxBNE,        // 04
+    &InterpretedCPU::psxBLEZ,        &InterpretedCPU::psxBGTZ,       // 06
+    &InterpretedCPU::pgxpPsxADDI,    &InterpretedCPU::pgxpPsxADDIU,  // 08
+    &InterpretedCPU::pgxpPsxSLTI,    &InterpretedCPU::pgxpPsxSLTIU,  // 0a
+    &InterpretedCPU::pgxpPsxANDI,    &InterpretedCPU::pgxpPsxORI,    // 0c
+    &InterpretedCPU::pgxpPsxXORI,    &InterpretedCPU::pgxpPsxLUI,    // 0e
+    &InterpretedCPU::pgxpPsxCOP0,    &InterpretedCPU::psxNULL,       // 10
+    &InterpretedCPU::pgxpPsxCOP2,    &InterpretedCPU::psxNULL,       // 12
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 14
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 16
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 18
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 1a
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 1c
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 1e
+    &InterpretedCPU::pgxpPsxLB,      &InterpretedCPU::pgxpPsxLH,     // 20
+    &InterpretedCPU::pgxpPsxLWL,     &InterpretedCPU::pgxpPsxLW,     // 22
+    &InterpretedCPU::pgxpPsxLBU,     &InterpretedCPU::pgxpPsxLHU,    // 24
+    &InterpretedCPU::pgxpPsxLWR,     &InterpretedCPU::pgxpPsxNULL,   // 26
+    &InterpretedCPU::pgxpPsxSB,      &InterpretedCPU::pgxpPsxSH,     // 28
+    &InterpretedCPU::pgxpPsxSWL,     &InterpretedCPU::pgxpPsxSW,     // 2a
+    &InterpretedCPU::pgxpPsxNULL,    &InterpretedCPU::pgxpPsxNULL,   // 2c
+    &InterpretedCPU::pgxpPsxSWR,     &InterpretedCPU::pgxpPsxNULL,   // 2e
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 30
+    &InterpretedCPU::pgxpPsxLWC2,    &InterpretedCPU::psxNULL,       // 32
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 34
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 36
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 38
+    &InterpretedCPU::pgxpPsxSWC2,    &InterpretedCPU::psxNULL,       // 3a
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 3c
+    &InterpretedCPU::psxNULL,        &InterpretedCPU::psxNULL,       // 3e
 };
 
 const InterpretedCPU::intFunc_t InterpretedCPU::s_pgxpPsxSPC[64] = {
@@ -1492,6 +1530,41 @@ const InterpretedCPU::intFunc_t InterpretedCPU::s_pgxpPsxCP0[32] = {
     &InterpretedCPU::pgxpPsxNULL, &InterpretedCPU::pgxpPsxNULL,  // 1e
 };
 
+const InterpretedCPU::intFunc_t InterpretedCPU::s_pgxpPsxCP2[64] = {
+    &InterpretedCPU::pgxpGteMove,  &InterpretedCPU::pgxpGteRTPS,  // 00
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 02
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 04
+    &InterpretedCPU::pgxpGteNCLIP, &InterpretedCPU::psxNULL,      // 06
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 08
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 0a
+    &InterpretedCPU::gteOP,        &InterpretedCPU::psxNULL,      // 0c
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 0e
+    &InterpretedCPU::gteDPCS,      &InterpretedCPU::gteINTPL,     // 10
+    &InterpretedCPU::gteMVMVA,     &InterpretedCPU::gteNCDS,      // 12
+    &InterpretedCPU::gteCDP,       &InterpretedCPU::psxNULL,      // 14
+    &InterpretedCPU::gteNCDT,      &InterpretedCPU::psxNULL,      // 16
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 18
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::gteNCCS,      // 1a
+    &InterpretedCPU::gteCC,        &InterpretedCPU::psxNULL,      // 1c
+    &InterpretedCPU::gteNCS,       &InterpretedCPU::psxNULL,      // 1e
+    &InterpretedCPU::gteNCT,       &InterpretedCPU::psxNULL,      // 20
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 22
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 24
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 26
+    &InterpretedCPU::gteSQR,       &InterpretedCPU::gteDCPL,      // 28
+    &InterpretedCPU::gteDPCT,      &InterpretedCPU::psxNULL,      // 2a
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::gteAVSZ3,     // 2c
+    &InterpretedCPU::gteAVSZ4,     &InterpretedCPU::psxNULL,      // 2e
+    &InterpretedCPU::pgxpGteRTPT,  &InterpretedCPU::psxNULL,      // 30
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 32
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 34
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 36
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 38
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::psxNULL,      // 3a
+    &InterpretedCPU::psxNULL,      &InterpretedCPU::gteGPF,       // 3c
+    &InterpretedCPU::gteGPL,       &InterpretedCPU::gteNCCT,      // 3e
+};
+
 const InterpretedCPU::intFunc_t InterpretedCPU::s_pgxpPsxCP2BSC[32] = {
     &InterpretedCPU::pgxpPsxMFC2, &InterpretedCPU::pgxpPsxNULL,  // 00
     &InterpretedCPU::pgxpPsxCFC2, &InterpretedCPU::pgxpPsxNULL,  // 02
@@ -1521,8 +1594,8 @@ const InterpretedCPU::intFunc_t InterpretedCPU::s_pgxpPsxBSCMem[64] = {
     &InterpretedCPU::psxSLTI,     &InterpretedCPU::psxSLTIU,     // 0a
     &InterpretedCPU::psxANDI,     &InterpretedCPU::psxORI,       // 0c
     &InterpretedCPU::psxXORI,     &InterpretedCPU::psxLUI,       // 0e
-    &InterpretedCPU::psxCOP0,     &InterpretedCPU::psxNULL,      // 10
-    &InterpretedCPU::psxCOP2,     &InterpretedCPU::psxNULL,      // 12
+    &InterpretedCPU::pgxpPsxCOP0, &InterpretedCPU::psxNULL,      // 10
+    &InterpretedCPU::pgxpPsxCOP2, &InterpretedCPU::psxNULL,      // 12
     &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,      // 14
     &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,      // 16
     &InterpretedCPU::psxNULL,     &InterpretedCPU::psxNULL,      // 18
@@ -1561,6 +1634,20 @@ void InterpretedCPU::Reset() {
 }
 void InterpretedCPU::Execute() {
     ZoneScoped;
+    switch (m_pgxp) {
+        case PGXP::Disabled:
+            execute<PGXP::Disabled>();
+            break;
+        case PGXP::Memory:
+            execute<PGXP::Memory>();
+            break;
+        case PGXP::Full:
+            execute<PGXP::Full>();
+            break;
+    }
+}
+template <InterpretedCPU::PGXP pgxp>
+void InterpretedCPU::execute() {
     while (hasToRun()) {
         const bool &debug = PCSX::g_emulator->settings.get<PCSX::Emulator::SettingDebugSettings>()
                                 .get<PCSX::Emulator::DebugSettings::Debug>();
@@ -1570,15 +1657,15 @@ void InterpretedCPU::Execute() {
                                   .get<PCSX::Emulator::DebugSettings::SkipISR>();
         if (debug) {
             if (!trace || (skipISR && m_inISR)) {
-                execBlock<true, false>();
+                execBlock<true, false, pgxp>();
             } else {
-                execBlock<true, true>();
+                execBlock<true, true, pgxp>();
             }
         } else {
             if (!trace || (skipISR && m_inISR)) {
-                execBlock<false, false>();
+                execBlock<false, false, pgxp>();
             } else {
-                execBlock<false, true>();
+                execBlock<false, true, pgxp>();
             }
         }
     }
@@ -1586,7 +1673,7 @@ void InterpretedCPU::Execute() {
 void InterpretedCPU::Clear(uint32_t Addr, uint32_t Size) {}
 void InterpretedCPU::Shutdown() {}
 // interpreter execution
-template <bool debug, bool trace>
+template <bool debug, bool trace, InterpretedCPU::PGXP pgxp>
 inline void InterpretedCPU::execBlock() {
     bool ranDelaySlot = false;
     do {
@@ -1609,7 +1696,7 @@ inline void InterpretedCPU::execBlock() {
         m_regs.pc += 4;
         m_regs.cycle += PCSX::Emulator::BIAS;
 
-        cIntFunc_t func = s_pPsxBSC[code >> 26];
+        cIntFunc_t func = bscTable<pgxp>()[code >> 26];
         (*this.*func)(code);
 
         m_currentDelayedLoad ^= 1;
@@ -1639,28 +1726,13 @@ inline void InterpretedCPU::execBlock() {
 void InterpretedCPU::SetPGXPMode(uint32_t pgxpMode) {
     switch (pgxpMode) {
         case 0:  // PGXP_MODE_DISABLED:
-            s_pPsxBSC = s_psxBSC;
-            s_pPsxSPC = s_psxSPC;
-            s_pPsxREG = s_psxREG;
-            s_pPsxCP0 = s_psxCP0;
-            s_pPsxCP2 = s_psxCP2;
-            s_pPsxCP2BSC = s_psxCP2BSC;
+            m_pgxp = PGXP::Disabled;
             break;
         case 1:  // PGXP_MODE_MEM:
-            s_pPsxBSC = s_pgxpPsxBSCMem;
-            s_pPsxSPC = s_psxSPC;
-            s_pPsxREG = s_psxREG;
-            s_pPsxCP0 = s_pgxpPsxCP0;
-            s_pPsxCP2 = s_psxCP2;
-            s_pPsxCP2BSC = s_pgxpPsxCP2BSC;
+            m_pgxp = PGXP::Memory;
             break;
         case 2:  // PGXP_MODE_FULL:
-            s_pPsxBSC = s_pgxpPsxBSC;
-            s_pPsxSPC = s_pgxpPsxSPC;
-            s_pPsxREG = s_psxREG;
-            s_pPsxCP0 = s_pgxpPsxCP0;
-            s_pPsxCP2 = s_psxCP2;
-            s_pPsxCP2BSC = s_pgxpPsxCP2BSC;
+            m_pgxp = PGXP::Full;
             break;
     }
 
@@ -45,6 +45,7 @@ int PCSX::R3000Acpu::psxInit() {
     }
 
     if (!g_emulator->m_cpu) g_emulator->m_cpu = Cpus::Interpreted();
+    g_emulator->m_gte->setRegisters(&g_emulator->m_cpu->m_regs.CP2D, &g_emulator->m_cpu->m_regs.CP2C);
 
     PGXP_Init();
     g_system->printf(_("CPU type: %s\n"), g_emulator->m_cpu->getName().c_str());
@@ -58,6 +58,11 @@ class SPUInterface {
     virtual void load(const SaveStates::SPU &) = 0;
     virtual uint32_t getCurrentFrames() = 0;
     virtual void waitForGoal(uint32_t goal) = 0;
+    // How many frames the emulation may run ahead of the audio device.
+    virtual uint32_t getLatencyTarget() = 0;
+    // Without any audio device, for dumping the audio as fast as the emulation runs. Needs to be
+    // set before opening the SPU.
+    virtual void setHeadless(bool headless) = 0;
     virtual uint32_t getFrameCount() = 0;
     virtual void setLua(Lua L) = 0;
 
@@ -70,6 +70,14 @@ struct IsoMounted {};
 namespace GPU {
 struct VSync {};
 }  // namespace GPU
+namespace SPU {
+// Interleaved stereo samples, from the mix when voice is -1, otherwise from one of the voices.
+struct Samples {
+    const int16_t *samples;
+    unsigned frames;
+    int voice;
+};
+}  // namespace SPU
 namespace ExecutionFlow {
 struct ShellReached {};
 struct Run {};
@@ -0,0 +1,303 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "core/videorecorder.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/frame.h>
+}
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "core/psxemulator.h"
+#include "core/system.h"
+#include "fmt/format.h"
+#include "support/yuv.h"
+
+PCSX::VideoRecorder::VideoRecorder() : m_listener(g_system->m_eventBus) {
+    m_listener.listen<Events::GPU::VSync>([this](auto event) {
+        if (recording()) grabFrame();
+    });
+    m_listener.listen<Events::Quitting>([this](auto event) { stop(); });
+}
+
+std::string PCSX::VideoRecorder::start(const std::filesystem::path &path) {
+    stop();
+
+    GPU::ScreenShot screenshot;
+    try {
+        screenshot = g_emulator->m_gpu->takeScreenShot();
+    } catch (std::runtime_error &) {
+        return "The current GPU can't be recorded";
+    }
+    unsigned width = screenshot.width, height = screenshot.height;
+    // Nothing displayed yet, so going for the largest of the usual display modes.
+    if ((width < 2) || (height < 2)) {
+        width = 640;
+        height = 480;
+    }
+    // The 4:2:0 subsampling wants even sizes.
+    auto error = openOutput(path, (width + 1) & ~1, (height + 1) & ~1);
+    if (!error.empty()) {
+        closeOutput();
+        return error;
+    }
+
+    m_videoPts = 0;
+    m_cdAudio.clear();
+    m_stopping = false;
+    m_framesEncoded = 0;
+    m_framesDropped = 0;
+    m_audioDropped = 0;
+    m_maxQueueDepth = 0;
+    m_thread = std::thread([this]() { encoderLoop(); });
+    m_recording = true;
+    return "";
+}
+
+void PCSX::VideoRecorder::stop() {
+    if (!m_thread.joinable()) return;
+    m_recording = false;
+    {
+        std::unique_lock<std::mutex> l(m_mutex);
+        m_stopping = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+    closeOutput();
+}
+
+PCSX::VideoRecorder::Stats PCSX::VideoRecorder::stats() const {
+    Stats ret;
+    ret.framesEncoded = m_framesEncoded;
+    ret.framesDropped = m_framesDropped;
+    ret.audioDropped = m_audioDropped;
+    ret.maxQueueDepth = m_maxQueueDepth;
+    std::unique_lock<std::mutex> l(m_mutex);
+    ret.queueDepth = m_queue.size();
+    return ret;
+}
+
+void PCSX::VideoRecorder::grabFrame() {
+    Item item;
+    item.type = Item::Type::Video;
+    try {
+        item.screenshot = g_emulator->m_gpu->takeScreenShot();
+    } catch (std::runtime_error &e) {
+        // This runs from the VSync event, so there's nobody up the stack to handle the error.
+        stop();
+        g_system->printf(_("Video recording stopped: %s\n"), e.what());
+        return;
+    }
+    // Dropped frames still take their time slot, so that the video remains in sync with the audio.
+    item.pts = m_videoPts++;
+    push(std::move(item));
+}
+
+void PCSX::VideoRecorder::queueAudio(const int16_t *samples, size_t frames, unsigned stream) {
+    std::unique_lock<std::mutex> l(m_mutex);
+    if (stream != 0) {
+        m_cdAudio.queue(samples, frames);
+        return;
+    }
+
+    Item item;
+    item.type = Item::Type::Audio;
+    item.samples.assign(samples, samples + frames * 2);
+    m_cdAudio.mix(item.samples.data(), frames);
+    l.unlock();
+    push(std::move(item));
+}
+
+bool PCSX::VideoRecorder::push(Item &&item) {
+    std::unique_lock<std::mutex> l(m_mutex);
+    if (m_stopping) return false;
+    if (item.type == Item::Type::Video) {
+        if (m_queuedFrames >= MAX_QUEUED_FRAMES) {
+            m_framesDropped++;
+            return false;
+        }
+        m_queuedFrames++;
+    } else {
+        if (m_queuedAudio >= MAX_QUEUED_AUDIO) {
+            m_audioDropped += item.samples.size() / 2;
+            return false;
+        }
+        m_queuedAudio++;
+    }
+    m_queue.push_back(std::move(item));
+    const unsigned depth = m_queue.size();
+    if (depth > m_maxQueueDepth) m_maxQueueDepth = depth;
+    l.unlock();
+    m_cv.notify_one();
+    return true;
+}
+
+void PCSX::VideoRecorder::encoderLoop() {
+    while (true) {
+        std::unique_lock<std::mutex> l(m_mutex);
+        m_cv.wait(l, [this]() { return !m_queue.empty() || m_stopping; });
+        // Whatever got queued before stopping is still encoded.
+        if (m_queue.empty()) break;
+        Item item = std::move(m_queue.front());
+        m_queue.pop_front();
+        if (item.type == Item::Type::Video) {
+            m_queuedFrames--;
+        } else {
+            m_queuedAudio--;
+        }
+        l.unlock();
+
+        if (item.type == Item::Type::Video) {
+            encodeVideo(item);
+        } else {
+            encodeAudio(item.samples);
+        }
+    }
+
+    m_audio.flush();
+    encode(m_videoContext, m_videoStream, nullptr);
+    av_write_trailer(m_format);
+}
+
+void PCSX::VideoRecorder::encodeVideo(const Item &item) {
+    const auto &screenshot = item.screenshot;
+    AVFrame *frame = m_videoFrame;
+    if (av_frame_make_writable(frame) < 0) return;
+
+    const int width = screenshot.width, height = screenshot.height;
+    const int canvasWidth = m_videoContext->width, canvasHeight = m_videoContext->height;
+    if ((width != canvasWidth) || (height != canvasHeight)) {
+        for (int j = 0; j < canvasHeight; j++) std::memset(frame->data[0] + j * frame->linesize[0], 16, canvasWidth);
+        for (int j = 0; j < (canvasHeight / 2); j++) {
+            std::memset(frame->data[1] + j * frame->linesize[1], 128, canvasWidth / 2);
+            std::memset(frame->data[2] + j * frame->linesize[2], 128, canvasWidth / 2);
+        }
+    }
+
+    // Centered, on even coordinates so that the chroma blocks line up.
+    int dx = ((canvasWidth - width) / 2) & ~1, dy = ((canvasHeight - height) / 2) & ~1;
+    int sx = 0, sy = 0;
+    if (dx < 0) {
+        sx = -dx;
+        dx = 0;
+    }
+    if (dy < 0) {
+        sy = -dy;
+        dy = 0;
+    }
+    const int w = std::min(width - sx, canvasWidth - dx), h = std::min(height - sy, canvasHeight - dy);
+    if ((w > 0) && (h > 0)) {
+        YUV::Picture picture = {{frame->data[0] + dy * frame->linesize[0] + dx,
+                                 frame->data[1] + (dy / 2) * frame->linesize[1] + dx / 2,
+                                 frame->data[2] + (dy / 2) * frame->linesize[2] + dx / 2},
+                                {frame->linesize[0], frame->linesize[1], frame->linesize[2]}};
+        if (screenshot.bpp == GPU::ScreenShot::BPP_16) {
+            auto pixels = screenshot.data.data<uint16_t>();
+            YUV::convert15(pixels + sy * width + sx, width, w, h, picture);
+        } else {
+            auto pixels = screenshot.data.data<uint8_t>();
+            YUV::convert24(pixels + (sy * width + sx) * 3, width * 3, w, h, picture);
+        }
+    }
+
+    frame->pts = item.pts;
+    encode(m_videoContext, m_videoStream, frame);
+    m_framesEncoded++;
+}
+
+void PCSX::VideoRecorder::encodeAudio(const std::vector<int16_t> &samples) {
+    if (m_audio.opened()) m_audio.write(samples.data(), samples.size() / 2);
+}
+
+void PCSX::VideoRecorder::encode(AVCodecContext *context, AVStream *stream, AVFrame *frame) {
+    if (avcodec_send_frame(context, frame) < 0) return;
+    while (avcodec_receive_packet(context, m_packet) >= 0) {
+        av_packet_rescale_ts(m_packet, context->time_base, stream->time_base);
+        m_packet->stream_index = stream->index;
+        // This takes over the packet's data, and resets it.
+        av_interleaved_write_frame(m_format, m_packet);
+    }
+}
+
+std::string PCSX::VideoRecorder::openOutput(const std::filesystem::path &path, unsigned width, unsigned height) {
+    const auto filename = path.string();
+    if ((avformat_alloc_output_context2(&m_format, nullptr, nullptr, filename.c_str()) < 0) || !m_format) {
+        return fmt::format("Unable to find a container format for {}", filename);
+    }
+    const auto oformat = m_format->oformat;
+
+    const AVCodec *videoCodec = avcodec_find_encoder(oformat->video_codec);
+    if (!videoCodec) return fmt::format("No video encoder available for {}", filename);
+    const int fps = g_emulator->settings.get<Emulator::SettingVideo>() == Emulator::PSX_TYPE_PAL ? 50 : 60;
+    m_videoStream = avformat_new_stream(m_format, nullptr);
+    m_videoContext = avcodec_alloc_context3(videoCodec);
+    if (!m_videoStream || !m_videoContext) return "Out of memory";
+    m_videoContext->width = width;
+    m_videoContext->height = height;
+    m_videoContext->pix_fmt = AV_PIX_FMT_YUV420P;
+    m_videoContext->time_base = {1, fps};
+    m_videoContext->framerate = {fps, 1};
+    m_videoContext->gop_size = fps;
+    m_videoContext->bit_rate = 8000000;
+    if (oformat->flags & AVFMT_GLOBALHEADER) m_videoContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    if (avcodec_open2(m_videoContext, videoCodec, nullptr) < 0) {
+        return fmt::format("Unable to open the {} video encoder", videoCodec->name);
+    }
+    avcodec_parameters_from_context(m_videoStream->codecpar, m_videoContext);
+    m_videoStream->time_base = m_videoContext->time_base;
+
+    // Some containers, like gif, don't do audio at all.
+    const AVCodec *audioCodec = AudioEncoder::findCodec(m_format);
+    if (audioCodec) {
+        auto error = m_audio.open(m_format, audioCodec);
+        if (!error.empty()) return error;
+    }
+
+    m_videoFrame = av_frame_alloc();
+    m_packet = av_packet_alloc();
+    if (!m_videoFrame || !m_packet) return "Out of memory";
+    m_videoFrame->format = AV_PIX_FMT_YUV420P;
+    m_videoFrame->width = width;
+    m_videoFrame->height = height;
+    if (av_frame_get_buffer(m_videoFrame, 0) < 0) return "Out of memory";
+
+    if (!(oformat->flags & AVFMT_NOFILE) && (avio_open(&m_format->pb, filename.c_str(), AVIO_FLAG_WRITE) < 0)) {
+        return fmt::format("Unable to open {}", filename);
+    }
+    if (avformat_write_header(m_format, nullptr) < 0) return fmt::format("Unable to write the header of {}", filename);
+    return "";
+}
+
+void PCSX::VideoRecorder::closeOutput() {
+    if (m_format && !(m_format->oformat->flags & AVFMT_NOFILE)) avio_closep(&m_format->pb);
+    if (m_format) avformat_free_context(m_format);
+    if (m_videoContext) avcodec_free_context(&m_videoContext);
+    if (m_videoFrame) av_frame_free(&m_videoFrame);
+    if (m_packet) av_packet_free(&m_packet);
+    m_audio.close();
+    m_format = nullptr;
+    m_videoStream = nullptr;
+}
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/audioencoder.h"
+#include "core/gpu.h"
+#include "support/eventbus.h"
+
+struct AVCodecContext;
+struct AVFormatContext;
+struct AVFrame;
+struct AVPacket;
+struct AVStream;
+
+namespace PCSX {
+
+// Records the display and the SPU output into a video file, through libavcodec. The container is
+// picked from the file extension, along with its default codecs. The emulation only grabs the
+// frames and the samples, and hands them over to an encoding thread through a bounded queue: when
+// the encoder can't keep up, frames get dropped instead of slowing the emulation down.
+//
+// The video size is the one of the display when the recording starts. Later frames of another size
+// are centered into it, with black borders or cropped.
+class VideoRecorder {
+  public:
+    // Frames waiting for the encoder before new ones get dropped. Audio chunks have their own limit.
+    static constexpr size_t MAX_QUEUED_FRAMES = 16;
+    static constexpr size_t MAX_QUEUED_AUDIO = 256;
+    static constexpr unsigned SAMPLE_RATE = AudioEncoder::SAMPLE_RATE;
+
+    struct Stats {
+        uint64_t framesEncoded = 0;
+        uint64_t framesDropped = 0;
+        // Stereo samples.
+        uint64_t audioDropped = 0;
+        unsigned queueDepth = 0;
+        unsigned maxQueueDepth = 0;
+    };
+
+    VideoRecorder();
+    ~VideoRecorder() { stop(); }
+
+    bool recording() const { return m_recording.load(std::memory_order_relaxed); }
+    // Returns an error message if the recording can't start.
+    std::string start(const std::filesystem::path &path);
+    // Waits for the encoder to be done with the queue, and finalizes the file.
+    void stop();
+    Stats stats() const;
+
+    // Interleaved stereo samples, as fed to the audio output, either from the voices (stream 0) or
+    // from the CD (stream 1), which get mixed into the voices ones as they come in.
+    void audio(const int16_t *samples, size_t frames, unsigned stream) {
+        if (recording()) queueAudio(samples, frames, stream);
+    }
+
+  private:
+    struct Item {
+        enum class Type { Video, Audio } type;
+        GPU::ScreenShot screenshot;
+        std::vector<int16_t> samples;
+        int64_t pts = 0;
+    };
+
+    void grabFrame();
+    void queueAudio(const int16_t *samples, size_t frames, unsigned stream);
+    bool push(Item &&item);
+    void encoderLoop();
+    void encodeVideo(const Item &item);
+    void encodeAudio(const std::vector<int16_t> &samples);
+    void encode(AVCodecContext *context, AVStream *stream, AVFrame *frame);
+    std::string openOutput(const std::filesystem::path &path, unsigned width, unsigned height);
+    void closeOutput();
+
+    EventBus::Listener m_listener;
+    std::atomic<bool> m_recording = false;
+    int64_t m_videoPts = 0;
+
+    // Everything below is shared with the encoding thread, under the mutex.
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Item> m_queue;
+    size_t m_queuedFrames = 0;
+    size_t m_queuedAudio = 0;
+    bool m_stopping = false;
+    CDAudioMix m_cdAudio;
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_framesEncoded = 0;
+    std::atomic<uint64_t> m_framesDropped = 0;
+    std::atomic<uint64_t> m_audioDropped = 0;
+    std::atomic<unsigned> m_maxQueueDepth = 0;
+
+    // Only touched by the encoding thread once the recording has started.
+    AVFormatContext *m_format = nullptr;
+    AVCodecContext *m_videoContext = nullptr;
+    AVStream *m_videoStream = nullptr;
+    AVFrame *m_videoFrame = nullptr;
+    AVPacket *m_packet = nullptr;
+    AudioEncoder m_audio;
+};
+
+}  // namespace PCSX
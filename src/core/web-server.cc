@@ -30,7 +30,10 @@
 #include "cdrom/iso9660-builder.h"
 #include "cdrom/iso9660-reader.h"
 #include "core/cdrom.h"
+#include "core/framehashes.h"
 #include "core/gpu.h"
+#include "core/gpucounters.h"
+#include "core/gteprofiler.h"
 #include "core/psxemulator.h"
 #include "core/psxmem.h"
 #include "core/r3000a.h"
@@ -96,6 +99,186 @@ class VramExecutor : public PCSX::WebExecutor {
     virtual ~VramExecutor() = default;
 };
 
+class FrameHashesExecutor : public PCSX::WebExecutor {
+    virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
+        return urldata.path == "/api/v1/gpu/frame-hashes";
+    }
+    virtual bool execute(PCSX::WebClient* client, PCSX::RequestData& request) final {
+        auto& frameHashes = PCSX::g_emulator->m_frameHashes;
+        auto vars = parseQuery(request.urlData.query);
+        if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
+            // The hashes are strings, since JSON numbers can't hold 64 bits integers.
+            auto hex = [](uint64_t hash) { return fmt::format("{:016x}", hash); };
+            size_t first = 0;
+            auto ifirst = vars.find("first");
+            if (ifirst != vars.end()) first = std::stoul(ifirst->second);
+            const auto& log = frameHashes->log();
+            nlohmann::json j;
+            j["enabled"] = frameHashes->enabled();
+            j["count"] = log.size();
+            j["frames"] = nlohmann::json::array();
+            for (size_t i = first; i < log.size(); i++) {
+                j["frames"].push_back({{"frame", log[i].frame}, {"hash", hex(log[i].hash)}});
+            }
+            j["golden"] = {{"frames", frameHashes->goldenFrames()}, {"matched", frameHashes->goldenMatched()}};
+            const auto& divergence = frameHashes->divergence();
+            if (divergence) {
+                j["divergence"] = {{"frame", divergence->frame},
+                                   {"expected", hex(divergence->expected)},
+                                   {"actual", hex(divergence->actual)}};
+            } else {
+                j["divergence"] = nullptr;
+            }
+            write200(client, j);
+            return true;
+        } else if (request.method == PCSX::RequestData::Method::HTTP_POST) {
+            auto ifunction = vars.find("function");
+            if (ifunction == vars.end()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            std::string function = ifunction->second;
+            auto ipath = vars.find("path");
+            std::string error;
+            if (function.compare("start") == 0) {
+                error = frameHashes->start(ipath == vars.end() ? "" : ipath->second);
+            } else if (function.compare("stop") == 0) {
+                frameHashes->stop();
+            } else if ((function.compare("golden") == 0) && (ipath != vars.end())) {
+                error = frameHashes->loadGolden(ipath->second);
+            } else {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            if (!error.empty()) {
+                std::string message = fmt::format("HTTP/1.1 400 Bad Request\r\n\r\n{}", error);
+                client->write(std::move(message));
+                return true;
+            }
+            client->write("HTTP/1.1 200 OK\r\n\r\n");
+            return true;
+        }
+        return false;
+    }
+
+  public:
+    FrameHashesExecutor() = default;
+    virtual ~FrameHashesExecutor() = default;
+};
+
+class GPUCountersExecutor : public PCSX::WebExecutor {
+    virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
+        return urldata.path == "/api/v1/gpu/counters";
+    }
+    virtual bool execute(PCSX::WebClient* client, PCSX::RequestData& request) final {
+        auto& counters = PCSX::g_emulator->m_gpuCounters;
+        auto vars = parseQuery(request.urlData.query);
+        if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
+            auto toJson = [](const PCSX::GPUCounters::Frame& frame) {
+                nlohmann::json j;
+                frame.forEach([&j](const char* name, double value) { j[name] = value; });
+                return j;
+            };
+            nlohmann::json j;
+            j["enabled"] = counters->enabled();
+            j["current"] = toJson(counters->current());
+            j["last"] = toJson(counters->lastFrame());
+            j["total"] = toJson(counters->total());
+            write200(client, j);
+            return true;
+        } else if (request.method == PCSX::RequestData::Method::HTTP_POST) {
+            auto ifunction = vars.find("function");
+            if (ifunction == vars.end()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            std::string function = ifunction->second;
+            std::string error;
+            if (function.compare("start") == 0) {
+                auto ipath = vars.find("path");
+                error = counters->start(ipath == vars.end() ? "" : ipath->second);
+            } else if (function.compare("stop") == 0) {
+                counters->stop();
+            } else {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            if (!error.empty()) {
+                std::string message = fmt::format("HTTP/1.1 400 Bad Request\r\n\r\n{}", error);
+                client->write(std::move(message));
+                return true;
+            }
+            client->write("HTTP/1.1 200 OK\r\n\r\n");
+            return true;
+        }
+        return false;
+    }
+
+  public:
+    GPUCountersExecutor() = default;
+    virtual ~GPUCountersExecutor() = default;
+};
+
+class GTEProfilerExecutor : public PCSX::WebExecutor {
+    virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
+        return urldata.path == "/api/v1/gte/profiler";
+    }
+    virtual bool execute(PCSX::WebClient* client, PCSX::RequestData& request) final {
+        auto& profiler = PCSX::g_emulator->m_gteProfiler;
+        auto vars = parseQuery(request.urlData.query);
+        if (request.method == PCSX::RequestData::Method::HTTP_HTTP_GET) {
+            auto toJson = [](const PCSX::GTEProfiler::Frame& frame) {
+                nlohmann::json j;
+                j["frame"] = frame.frame;
+                frame.forEach([&j](const char* name, const PCSX::GTEProfiler::Command& command) {
+                    j["commands"][name] = {
+                        {"count", command.count},
+                        {"cycles", command.cycles},
+                        {"host_ns", command.hostNanoseconds()},
+                    };
+                });
+                return j;
+            };
+            nlohmann::json j;
+            j["enabled"] = profiler->enabled();
+            j["current"] = toJson(profiler->current());
+            j["last"] = toJson(profiler->lastFrame());
+            j["total"] = toJson(profiler->total());
+            write200(client, j);
+            return true;
+        } else if (request.method == PCSX::RequestData::Method::HTTP_POST) {
+            auto ifunction = vars.find("function");
+            if (ifunction == vars.end()) {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            std::string function = ifunction->second;
+            std::string error;
+            if (function.compare("start") == 0) {
+                auto ipath = vars.find("path");
+                error = profiler->start(ipath == vars.end() ? "" : ipath->second);
+            } else if (function.compare("stop") == 0) {
+                profiler->stop();
+            } else {
+                client->write("HTTP/1.1 400 Bad Request\r\n\r\n");
+                return true;
+            }
+            if (!error.empty()) {
+                std::string message = fmt::format("HTTP/1.1 400 Bad Request\r\n\r\n{}", error);
+                client->write(std::move(message));
+                return true;
+            }
+            client->write("HTTP/1.1 200 OK\r\n\r\n");
+            return true;
+        }
+        return false;
+    }
+
+  public:
+    GTEProfilerExecutor() = default;
+    virtual ~GTEProfilerExecutor() = default;
+};
+
 class RamExecutor : public PCSX::WebExecutor {
     virtual bool match(PCSX::WebClient* client, const PCSX::UrlData& urldata) final {
         return urldata.path == "/api/v1/cpu/ram/raw";
@@ -588,6 +771,9 @@ void PCSX::WebExecutor::write200(PCSX::WebClient* client, const nlohmann::json&
 
 PCSX::WebServer::WebServer() : m_listener(g_system->m_eventBus) {
     m_executors.push_back(new VramExecutor());
+    m_executors.push_back(new FrameHashesExecutor());
+    m_executors.push_back(new GPUCountersExecutor());
+    m_executors.push_back(new GTEProfilerExecutor());
     m_executors.push_back(new RamExecutor());
     m_executors.push_back(new AssemblyExecutor());
     m_executors.push_back(new CacheExecutor());
@@ -0,0 +1,226 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "gpu/soft/bands.h"
+
+#include <algorithm>
+
+void PCSX::SoftGPU::Bands::start(unsigned count) {
+    stop();
+    if (count < 2) return;
+    if (!m_jobs) m_jobs.reset(new Job[MAX_JOBS]);
+
+    m_exit = false;
+    for (unsigned i = 0; i < count; i++) {
+        auto worker = std::make_unique<Worker>();
+        worker->y0 = i * SoftRenderer::GPU_HEIGHT / count;
+        worker->y1 = (i + 1) * SoftRenderer::GPU_HEIGHT / count;
+        // The last band also catches whatever spills past the bottom of the VRAM.
+        if (i == (count - 1)) worker->y1 = SoftRenderer::GPU_HEIGHT * 2;
+        m_workers.push_back(std::move(worker));
+    }
+    for (auto &worker : m_workers) {
+        worker->thread = std::thread([this, worker = worker.get()]() { workerLoop(worker); });
+    }
+}
+
+void PCSX::SoftGPU::Bands::stop() {
+    if (!running()) return;
+    sync();
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_wake.notify_all();
+    for (auto &worker : m_workers) worker->thread.join();
+    m_workers.clear();
+}
+
+PCSX::SoftGPU::Bands::Tiles PCSX::SoftGPU::Bands::region(int x0, int y0, int x1, int y1) {
+    Tiles tiles;
+
+    // Columns past the right edge wrap around onto the next row, like linear VRAM addressing does.
+    if (x1 >= SoftRenderer::GPU_WIDTH) {
+        tiles = region(0, y0 + 1, x1 - SoftRenderer::GPU_WIDTH, y1 + 1);
+        x1 = SoftRenderer::GPU_WIDTH - 1;
+    }
+
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    y1 = std::min(y1, SoftRenderer::GPU_HEIGHT - 1);
+    if ((x0 > x1) || (y0 > y1)) return tiles;
+
+    for (int y = y0 >> TILE_SHIFT_Y; y <= (y1 >> TILE_SHIFT_Y); y++) {
+        for (int x = x0 >> TILE_SHIFT_X; x <= (x1 >> TILE_SHIFT_X); x++) {
+            tiles.set(y * TILES_X + x);
+        }
+    }
+
+    return tiles;
+}
+
+PCSX::SoftGPU::Bands::Tiles PCSX::SoftGPU::Bands::wrapped(int x, int y, int w, int h) {
+    constexpr int WIDTH = SoftRenderer::GPU_WIDTH;
+    constexpr int HEIGHT = SoftRenderer::GPU_HEIGHT;
+    if ((w <= 0) || (h <= 0)) return {};
+    x &= WIDTH - 1;
+    y &= HEIGHT - 1;
+    const int x1 = x + std::min(w, WIDTH) - 1;
+    const int y1 = y + std::min(h, HEIGHT) - 1;
+
+    Tiles tiles = region(x, y, std::min(x1, WIDTH - 1), std::min(y1, HEIGHT - 1));
+    if (x1 >= WIDTH) tiles |= region(0, y, x1 - WIDTH, std::min(y1, HEIGHT - 1));
+    if (y1 >= HEIGHT) tiles |= region(x, 0, std::min(x1, WIDTH - 1), y1 - HEIGHT);
+    if ((x1 >= WIDTH) && (y1 >= HEIGHT)) tiles |= region(0, 0, x1 - WIDTH, y1 - HEIGHT);
+    return tiles;
+}
+
+std::vector<PCSX::SoftGPU::Bands::Rect> PCSX::SoftGPU::Bands::rects(const Tiles &tiles) {
+    constexpr int TILE_W = 1 << TILE_SHIFT_X;
+    constexpr int TILE_H = 1 << TILE_SHIFT_Y;
+    std::vector<Rect> ret;
+    // Rectangles reaching down to the previous row of tiles, which the runs of the current one may extend.
+    std::vector<size_t> above, current;
+
+    for (int y = 0; y < TILES_Y; y++) {
+        current.clear();
+        for (int x = 0; x < TILES_X;) {
+            if (!tiles[y * TILES_X + x]) {
+                x++;
+                continue;
+            }
+            const int start = x;
+            while ((x < TILES_X) && tiles[y * TILES_X + x]) x++;
+            const Rect run = {start * TILE_W, y * TILE_H, (x - start) * TILE_W, TILE_H};
+            auto extended = std::find_if(above.begin(), above.end(), [&ret, &run](size_t i) {
+                return (ret[i].x == run.x) && (ret[i].w == run.w);
+            });
+            if (extended != above.end()) {
+                ret[*extended].h += TILE_H;
+                current.push_back(*extended);
+            } else {
+                current.push_back(ret.size());
+                ret.push_back(run);
+            }
+        }
+        std::swap(above, current);
+    }
+
+    return ret;
+}
+
+void PCSX::SoftGPU::Bands::submit(SoftRenderer &state, Clip clip, const Tiles &reads, const Tiles &writes,
+                                   Draw &&draw) {
+    if ((reads & writes).any()) {
+        // The primitive samples what it draws, and the order in which
+        // the rows are going to be drawn matters, so it can't be split.
+        claim(reads, writes);
+        draw(state);
+        return;
+    }
+
+    auto submitted = m_submitted.load();
+    if ((reads & m_writes).any() || (writes & m_reads).any() || (submitted == MAX_JOBS)) {
+        sync();
+        submitted = 0;
+    }
+
+    auto &job = m_jobs[submitted];
+    job.state = state;
+    job.clip = clip;
+    job.draw = std::move(draw);
+    m_writes |= writes;
+    m_reads |= reads;
+    m_submitted.store(submitted + 1);
+
+    // A sleeping worker increments m_sleeping before checking m_submitted,
+    // so it either sees the new job, or we see it and wake it up.
+    if (m_sleeping.load() != 0) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.notify_all();
+    }
+}
+
+void PCSX::SoftGPU::Bands::claim(const Tiles &reads, const Tiles &writes) {
+    if (((reads | writes) & m_writes).any() || (writes & m_reads).any()) sync();
+}
+
+void PCSX::SoftGPU::Bands::sync() {
+    if (m_submitted.load() == 0) return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() {
+        const auto submitted = m_submitted.load();
+        for (auto &worker : m_workers) {
+            if (worker->done != submitted) return false;
+        }
+        return true;
+    });
+
+    // All of the workers are now asleep, waiting on m_wake.
+    for (auto &worker : m_workers) worker->done = 0;
+    m_submitted.store(0);
+    m_writes.reset();
+    m_reads.reset();
+}
+
+void PCSX::SoftGPU::Bands::workerLoop(Worker *worker) {
+    size_t done = 0;
+
+    while (true) {
+        const auto submitted = m_submitted.load(std::memory_order_acquire);
+        if (done < submitted) {
+            // Timed per batch of jobs rather than per job, since the clock costs about as much as a small primitive.
+            const auto start = std::chrono::steady_clock::now();
+            while (done < submitted) worker->run(m_jobs[done++]);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            m_busyNanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                        std::memory_order_relaxed);
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        worker->done = done;
+        m_idle.notify_all();
+        m_sleeping++;
+        m_wake.wait(lock, [this, worker]() { return m_exit || (m_submitted.load() != worker->done); });
+        m_sleeping--;
+        if (m_exit) return;
+        done = worker->done;
+    }
+}
+
+void PCSX::SoftGPU::Bands::Worker::run(const Job &job) {
+    const auto &state = job.state;
+    const int shift = state.m_upscale;
+    const int drawY = std::max(state.m_drawY, y0 << shift);
+    const int drawH = std::min(state.m_drawH, (y1 << shift) - 1);
+    if (drawY > drawH) return;
+
+    renderer = state;
+    renderer.m_drawY = drawY;
+    renderer.m_drawH = drawH;
+    if (job.clip == Clip::Line) {
+        // Only the Bresenham functions use an exclusive bottom edge; straight lines are clamped like polygons.
+        if ((renderer.m_x0 != renderer.m_x1) && (renderer.m_y0 != renderer.m_y1)) {
+            renderer.m_drawH = std::min(state.m_drawH, y1 << shift);
+        }
+    }
+
+    job.draw(renderer);
+}
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gpu/soft/soft.h"
+
+namespace PCSX {
+
+namespace SoftGPU {
+
+// Band-parallel rasterization. The VRAM is split into horizontal bands, each one owned by
+// a worker thread. Every primitive is submitted to all of the workers alongside a snapshot
+// of the renderer state, and each worker draws it with its drawing area clipped to its own
+// band. Since a worker processes the primitives in submission order, and no two workers
+// ever write the same pixel, the result is identical to drawing everything on one thread.
+//
+// The remaining hazards are VRAM reads crossing band boundaries: texture and CLUT fetches,
+// and anything the caller does directly to the VRAM, such as fills, copies, uploads and
+// display. These are tracked at the granularity of 64x64 tiles, and resolved by waiting
+// for the workers to drain whenever a conflict is detected.
+class Bands {
+  public:
+    static constexpr int TILE_SHIFT_X = 6;
+    static constexpr int TILE_SHIFT_Y = 6;
+    static constexpr int TILES_X = SoftRenderer::GPU_WIDTH >> TILE_SHIFT_X;
+    static constexpr int TILES_Y = SoftRenderer::GPU_HEIGHT >> TILE_SHIFT_Y;
+    typedef std::bitset<TILES_X * TILES_Y> Tiles;
+    typedef std::function<void(SoftRenderer &)> Draw;
+
+    // How the drawing area gets narrowed down to a band. The Bresenham line
+    // functions test y < m_drawH, while everything else considers m_drawH inclusive.
+    enum class Clip { Area, Line };
+
+    ~Bands() { stop(); }
+
+    void start(unsigned count);
+    void stop();
+    bool running() const { return !m_workers.empty(); }
+    unsigned count() const { return m_workers.size(); }
+
+    // Inclusive VRAM rectangle to tiles, clamped to the VRAM boundaries.
+    static Tiles region(int x0, int y0, int x1, int y1);
+    // Rectangle to tiles, wrapping around the VRAM edges, like the blits and the uploads do.
+    static Tiles wrapped(int x, int y, int w, int h);
+    // Tiles back to VRAM rectangles, in pixels: the horizontal runs of every row of tiles, merged
+    // with the identical runs right above them.
+    struct Rect {
+        int x, y, w, h;
+    };
+    static std::vector<Rect> rects(const Tiles &tiles);
+
+    // Queues a primitive, which is going to read and write the tiles passed as arguments, within
+    // the drawing area of the state. Upscaled primitives, drawing into the shadow VRAM, pass the
+    // native tiles it mirrors. If the primitive reads what it draws, it can't be split, and is
+    // drawn on the calling thread directly.
+    void submit(SoftRenderer &state, Clip clip, const Tiles &reads, const Tiles &writes, Draw &&draw);
+    // Waits for the workers to be done with anything the caller wants to access directly.
+    void claim(const Tiles &reads, const Tiles &writes);
+    // Waits for the workers to drain their queues entirely.
+    void sync();
+    // The time the workers have spent drawing, added up over all of them.
+    uint64_t busyNanoseconds() const { return m_busyNanoseconds.load(std::memory_order_relaxed); }
+
+  private:
+    struct Job {
+        SoftRenderer state;
+        Clip clip;
+        Draw draw;
+    };
+
+    struct Worker {
+        std::thread thread;
+        SoftRenderer renderer;
+        int y0, y1;
+        size_t done = 0;
+        void run(const Job &job);
+    };
+
+    void workerLoop(Worker *worker);
+
+    static constexpr size_t MAX_JOBS = 2048;
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::unique_ptr<Job[]> m_jobs;
+    std::atomic<size_t> m_submitted = 0;
+    std::atomic<unsigned> m_sleeping = 0;
+    std::atomic<uint64_t> m_busyNanoseconds = 0;
+    bool m_exit = false;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+
+    // Tiles the queued primitives are going to write to, or read from.
+    Tiles m_writes;
+    Tiles m_reads;
+};
+
+}  // namespace SoftGPU
+
+}  // namespace PCSX
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "gpu/soft/blit.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_AMD64)
+#define VRAMBLIT_X86
+#include "immintrin.h"
+#endif
+
+namespace {
+
+using PCSX::SoftGPU::VRAMBlit;
+
+uint16_t blend(uint16_t dest, uint16_t src, VRAMBlit::Mask mask) {
+    return (mask.check && (dest & 0x8000)) ? dest : (src | mask.set);
+}
+
+bool copiesBackwards(const uint16_t *dest, const uint16_t *src, unsigned count) {
+    return (dest > src) && (dest < (src + count));
+}
+
+#ifdef VRAMBLIT_X86
+
+// The mask bit check is a sign check, which turns into a blend mask with an arithmetic shift.
+template <bool check>
+void blend8(uint16_t *dest, const uint16_t *src, __m128i set) {
+    __m128i s = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), set);
+    if constexpr (check) {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest));
+        const __m128i keep = _mm_srai_epi16(d, 15);
+        s = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, s));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), s);
+}
+
+template <bool check>
+void copyMasked(uint16_t *dest, const uint16_t *src, unsigned count, VRAMBlit::Mask mask) {
+    const __m128i set = _mm_set1_epi16(static_cast<int16_t>(mask.set));
+    // Each block of eight is loaded entirely before being stored, so going backwards when the
+    // destination is ahead of the source never reads anything already written.
+    if (copiesBackwards(dest, src, count)) {
+        unsigned i = count;
+        for (; i >= 8; i -= 8) blend8<check>(dest + i - 8, src + i - 8, set);
+        while (i-- > 0) dest[i] = blend(dest[i], src[i], mask);
+    } else {
+        unsigned i = 0;
+        for (; (i + 8) <= count; i += 8) blend8<check>(dest + i, src + i, set);
+        for (; i < count; i++) dest[i] = blend(dest[i], src[i], mask);
+    }
+}
+
+#endif
+
+}  // namespace
+
+void PCSX::SoftGPU::VRAMBlit::fillSpan(uint16_t *dest, unsigned count, uint16_t color) {
+#ifdef VRAMBLIT_X86
+    const __m128i c = _mm_set1_epi16(static_cast<int16_t>(color));
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), c);
+    for (; i < count; i++) dest[i] = color;
+#else
+    std::fill_n(dest, count, color);
+#endif
+}
+
+void PCSX::SoftGPU::VRAMBlit::copySpan(uint16_t *dest, const uint16_t *src, unsigned count, Mask mask) {
+    if (!mask.check && !mask.set) {
+        std::memmove(dest, src, count * sizeof(uint16_t));
+        return;
+    }
+#ifdef VRAMBLIT_X86
+    if (mask.check) {
+        copyMasked<true>(dest, src, count, mask);
+    } else {
+        copyMasked<false>(dest, src, count, mask);
+    }
+#else
+    copySpanScalar(dest, src, count, mask);
+#endif
+}
+
+void PCSX::SoftGPU::VRAMBlit::copySpanScalar(uint16_t *dest, const uint16_t *src, unsigned count, Mask mask) {
+    if (copiesBackwards(dest, src, count)) {
+        for (unsigned i = count; i-- > 0;) dest[i] = blend(dest[i], src[i], mask);
+    } else {
+        for (unsigned i = 0; i < count; i++) dest[i] = blend(dest[i], src[i], mask);
+    }
+}
+
+void PCSX::SoftGPU::VRAMBlit::copy(uint16_t *vram, int srcX, int srcY, int destX, int destY, int w, int h,
+                                   Mask mask) {
+    for (int j = 0; j < h; j++) {
+        const uint16_t *srcRow = vram + ((srcY + j) & (HEIGHT - 1)) * WIDTH;
+        uint16_t *destRow = vram + ((destY + j) & (HEIGHT - 1)) * WIDTH;
+        for (int i = 0; i < w;) {
+            const int sx = (srcX + i) & (WIDTH - 1);
+            const int dx = (destX + i) & (WIDTH - 1);
+            const int count = std::min({w - i, WIDTH - sx, WIDTH - dx});
+            copySpan(destRow + dx, srcRow + sx, count, mask);
+            i += count;
+        }
+    }
+}
+
+void PCSX::SoftGPU::VRAMBlit::upload(uint16_t *vram, int x, int y, int w, int h, const uint16_t *pixels,
+                                     Mask mask) {
+    for (int j = 0; j < h; j++) {
+        uint16_t *row = vram + ((y + j) & (HEIGHT - 1)) * WIDTH;
+        for (int i = 0; i < w;) {
+            const int dx = (x + i) & (WIDTH - 1);
+            const int count = std::min(w - i, WIDTH - dx);
+            copySpan(row + dx, pixels, count, mask);
+            pixels += count;
+            i += count;
+        }
+    }
+}
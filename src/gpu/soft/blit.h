@@ -0,0 +1,59 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+namespace PCSX {
+
+namespace SoftGPU {
+
+// The rectangle operations on the native VRAM: fills, VRAM to VRAM copies, and uploads from the
+// CPU. The rectangles wrap around the VRAM edges like on the hardware, and are split into spans
+// which don't, so that the spans can be processed eight pixels at a time with SSE2.
+struct VRAMBlit {
+    static constexpr int WIDTH = 1024;
+    static constexpr int HEIGHT = 512;
+
+    // The mask bit settings, as set by GP0(E6h), which the copies and uploads honour: with check,
+    // the pixels which have their mask bit set aren't overwritten, and set is or'ed into the
+    // pixels written.
+    struct Mask {
+        bool check = false;
+        uint16_t set = 0;
+    };
+
+    static void fillSpan(uint16_t *dest, unsigned count, uint16_t color);
+    // Behaves like memmove when the spans overlap: every pixel written only depends on the
+    // source and destination pixels from before the copy.
+    static void copySpan(uint16_t *dest, const uint16_t *src, unsigned count, Mask mask);
+    static void copySpanScalar(uint16_t *dest, const uint16_t *src, unsigned count, Mask mask);
+
+    // The rows are processed top to bottom, so overlapping rectangles read the rows they have
+    // already written to, if the destination is below the source.
+    static void copy(uint16_t *vram, int srcX, int srcY, int destX, int destY, int w, int h, Mask mask);
+    // The pixels are written in order, so rectangles larger than the VRAM overwrite themselves.
+    static void upload(uint16_t *vram, int x, int y, int w, int h, const uint16_t *pixels, Mask mask);
+};
+
+}  // namespace SoftGPU
+
+}  // namespace PCSX
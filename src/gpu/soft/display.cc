@@ -0,0 +1,190 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "gpu/soft/display.h"
+
+#include <algorithm>
+
+#include "support/simd.h"
+
+namespace {
+
+constexpr uint32_t expand5(uint32_t c) { return (c << 3) | (c >> 2); }
+
+#ifdef PCSX_SIMD_X86
+
+// All of the versions below return how many pixels they converted, the remaining ones being left
+// to the scalar versions.
+
+// The components get expanded in 16 bits lanes, then red and green, and blue and alpha, are paired
+// into 16 bits each, and interleaved into the final pixels. SSE2 is always there on x64.
+unsigned convert15SSE2(const uint16_t *src, uint32_t *dest, unsigned count) {
+    const __m128i mask = _mm_set1_epi16(0x1f);
+    const __m128i alpha = _mm_set1_epi16(int16_t(0xff00));
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i r = _mm_and_si128(pixels, mask);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(pixels, 5), mask);
+        __m128i b = _mm_and_si128(_mm_srli_epi16(pixels, 10), mask);
+        r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+        g = _mm_or_si128(_mm_slli_epi16(g, 3), _mm_srli_epi16(g, 2));
+        b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        const __m128i ba = _mm_or_si128(b, alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 4), _mm_unpackhi_epi16(rg, ba));
+    }
+    return i;
+}
+
+AVX2_FUNC unsigned convert15AVX2(const uint16_t *src, uint32_t *dest, unsigned count) {
+    const __m256i mask = _mm256_set1_epi16(0x1f);
+    const __m256i alpha = _mm256_set1_epi16(int16_t(0xff00));
+    unsigned i = 0;
+    for (; (i + 16) <= count; i += 16) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i r = _mm256_and_si256(pixels, mask);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi16(pixels, 5), mask);
+        __m256i b = _mm256_and_si256(_mm256_srli_epi16(pixels, 10), mask);
+        r = _mm256_or_si256(_mm256_slli_epi16(r, 3), _mm256_srli_epi16(r, 2));
+        g = _mm256_or_si256(_mm256_slli_epi16(g, 3), _mm256_srli_epi16(g, 2));
+        b = _mm256_or_si256(_mm256_slli_epi16(b, 3), _mm256_srli_epi16(b, 2));
+        const __m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+        const __m256i ba = _mm256_or_si256(b, alpha);
+        // The unpacks work within each 128 bits half, so the pixels come out as 0-3, 8-11 and 4-7, 12-15.
+        const __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+        const __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+    return i;
+}
+
+// Eight packed pixels are 24 bytes. The first four are shuffled out of the 16 bytes at their start,
+// and the last four out of the 16 bytes ending with them, so nothing past the pixels is ever read.
+SSSE3_FUNC unsigned convert24SSSE3(const uint8_t *src, uint32_t *dest, unsigned count) {
+    const auto z = char(0x80);
+    const __m128i first = _mm_setr_epi8(0, 1, 2, z, 3, 4, 5, z, 6, 7, 8, z, 9, 10, 11, z);
+    const __m128i last = _mm_setr_epi8(4, 5, 6, z, 7, 8, 9, z, 10, 11, 12, z, 13, 14, 15, z);
+    const __m128i alpha = _mm_set1_epi32(int32_t(0xff000000));
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const uint8_t *p = src + i * 3;
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i), _mm_or_si128(_mm_shuffle_epi8(a, first), alpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + i + 4), _mm_or_si128(_mm_shuffle_epi8(b, last), alpha));
+    }
+    return i;
+}
+
+// Same as above, with both halves shuffled at once.
+AVX2_FUNC unsigned convert24AVX2(const uint8_t *src, uint32_t *dest, unsigned count) {
+    const auto z = char(0x80);
+    const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, z, 3, 4, 5, z, 6, 7, 8, z, 9, 10, 11, z,  //
+                                             4, 5, 6, z, 7, 8, 9, z, 10, 11, 12, z, 13, 14, 15, z);
+    const __m256i alpha = _mm256_set1_epi32(int32_t(0xff000000));
+    unsigned i = 0;
+    for (; (i + 16) <= count; i += 16) {
+        const uint8_t *p = src + i * 3;
+        const __m256i a = _mm256_set_m128i(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8)),
+                                           _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+        const __m256i b = _mm256_set_m128i(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32)),
+                                           _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 24)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i),
+                            _mm256_or_si256(_mm256_shuffle_epi8(a, shuffle), alpha));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + i + 8),
+                            _mm256_or_si256(_mm256_shuffle_epi8(b, shuffle), alpha));
+    }
+    return i;
+}
+
+#endif
+
+}  // namespace
+
+void PCSX::SoftGPU::DisplayConverter::convert15(const uint16_t *src, uint32_t *dest, unsigned count) {
+    unsigned done = 0;
+#ifdef PCSX_SIMD_X86
+    done = PCSX::SIMD::hasAVX2 ? convert15AVX2(src, dest, count) : convert15SSE2(src, dest, count);
+#endif
+    convert15Scalar(src + done, dest + done, count - done);
+}
+
+void PCSX::SoftGPU::DisplayConverter::convert24(const uint8_t *src, uint32_t *dest, unsigned count) {
+    unsigned done = 0;
+#ifdef PCSX_SIMD_X86
+    if (PCSX::SIMD::hasAVX2) {
+        done = convert24AVX2(src, dest, count);
+    } else if (PCSX::SIMD::hasSSSE3) {
+        done = convert24SSSE3(src, dest, count);
+    }
+#endif
+    convert24Scalar(src + done * 3, dest + done, count - done);
+}
+
+void PCSX::SoftGPU::DisplayConverter::convert15Scalar(const uint16_t *src, uint32_t *dest, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        const uint32_t pixel = src[i];
+        dest[i] = expand5(pixel & 0x1f) | (expand5((pixel >> 5) & 0x1f) << 8) | (expand5((pixel >> 10) & 0x1f) << 16) |
+                  0xff000000;
+    }
+}
+
+void PCSX::SoftGPU::DisplayConverter::convert24Scalar(const uint8_t *src, uint32_t *dest, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        dest[i] = src[0] | (src[1] << 8) | (src[2] << 16) | 0xff000000;
+        src += 3;
+    }
+}
+
+void PCSX::SoftGPU::DisplayConverter::convert(const uint16_t *vram, int shift, int x, int y, int width, int height,
+                                              bool rgb24, uint32_t *dest) {
+    const int pitch = 1024 << shift;
+    const int rows = 512 << shift;
+    for (int j = 0; j < height; j++) {
+        const uint16_t *row = vram + ((y + j) & (rows - 1)) * pitch;
+        if (rgb24) {
+            // The rows are made of 2048 bytes, which isn't a multiple of 3, so a pixel may straddle the edge.
+            const auto bytes = reinterpret_cast<const uint8_t *>(row);
+            int start = (x & (pitch - 1)) * 2;
+            int done = 0;
+            while (done < width) {
+                const int count = std::min(width - done, (pitch * 2 - start) / 3);
+                convert24(bytes + start, dest + done, count);
+                done += count;
+                start += count * 3;
+                if (done == width) break;
+                uint8_t pixel[3];
+                for (int k = 0; k < 3; k++) pixel[k] = bytes[(start + k) & (pitch * 2 - 1)];
+                convert24(pixel, dest + done, 1);
+                done++;
+                start = (start + 3) & (pitch * 2 - 1);
+            }
+        } else {
+            const int start = x & (pitch - 1);
+            const int first = std::min(width, pitch - start);
+            convert15(row + start, dest, first);
+            if (first < width) convert15(row, dest + first, width - first);
+        }
+        dest += width;
+    }
+}
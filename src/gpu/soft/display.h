@@ -0,0 +1,50 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace PCSX {
+
+namespace SoftGPU {
+
+// Conversions of the display area of the VRAM into 32 bits pixels, with the red component in
+// the lowest byte and an opaque alpha, for the consumers working from host memory instead of
+// a texture, like the headless backend.
+struct DisplayConverter {
+    // 15 bits pixels, as the GPU stores them.
+    static void convert15(const uint16_t *src, uint32_t *dest, unsigned count);
+    // Packed 24 bits pixels, which don't have to start on a halfword boundary.
+    static void convert24(const uint8_t *src, uint32_t *dest, unsigned count);
+    // Both of the above use SSE2, SSSE3 or AVX2 when available, and these are their plain
+    // versions, which they match bit for bit.
+    static void convert15Scalar(const uint16_t *src, uint32_t *dest, unsigned count);
+    static void convert24Scalar(const uint8_t *src, uint32_t *dest, unsigned count);
+
+    // Converts a width x height area of a VRAM, (1024 x 512) << shift pixels large, wrapping around
+    // its edges like the display does. The coordinates are in pixels of that VRAM, except for 24 bits
+    // displays, which are only ever read from the native VRAM, and for which x is in halfwords.
+    static void convert(const uint16_t *vram, int shift, int x, int y, int width, int height, bool rgb24,
+                        uint32_t *dest);
+};
+
+}  // namespace SoftGPU
+
+}  // namespace PCSX
@@ -17,7 +17,9 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 #include "GL/gl3w.h"
 #include "gpu/soft/interface.h"
@@ -32,15 +34,21 @@ void PCSX::SoftGPU::impl::doBufferSwap(bool fromGui) {
     gui->setViewport();
     GLuint textureID;
 
+    m_bands.sync();
+
     if (m_softDisplay.RGB24) {
         auto offset = (m_softDisplay.DisplayPosition.x * 2) % 3;
         textureID = m_vramTexture24;
         glBindTexture(GL_TEXTURE_2D, textureID);
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 682, 512, GL_RGB, GL_UNSIGNED_BYTE, m_vram + offset);
+        m_uploadedBytes = 682 * 512 * 3;
+    } else if (m_shadowVRAM) {
+        if (m_shadowTextureShift != m_upscaleShift) resizeShadowTexture();
+        textureID = m_shadowTexture;
+        m_uploadedBytes = upload(textureID, m_dirtyShadow, m_shadowVRAM.get(), m_upscaleShift);
     } else {
         textureID = m_vramTexture16;
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1024, 512, GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, m_vram16);
+        m_uploadedBytes = upload(textureID, m_dirty16, m_vram16, 0);
     }
 
     float xRatio = m_softDisplay.RGB24 ? ((1.0f / 1.5f) * (1.0f / 1024.0f)) : (1.0f / 1024.0f);
@@ -53,28 +61,115 @@ void PCSX::SoftGPU::impl::doBufferSwap(bool fromGui) {
     // Temporary workaround until we make our Display struct work with the sw backend
     // Trim 1 pixel from the height and width when linear filtering is on to avoid artifacts due to wrong sampling
     if (g_emulator->settings.get<Emulator::SettingLinearFiltering>()) {
-        width -= 1.f / 1024.f;
-        height -= 1.f / 512.f;
+        const int shift = (m_shadowVRAM && !m_softDisplay.RGB24) ? m_upscaleShift : 0;
+        width -= 1.f / (1024 << shift);
+        height -= 1.f / (512 << shift);
     }
 
     gui->m_offscreenShaderEditor.render(gui, textureID, {startX, startY}, {width, height}, gui->getRenderSize());
     if (!fromGui) gui->flip();
 }
 
+GLuint PCSX::SoftGPU::impl::getVRAMTexture() {
+    if (m_headless) return 0;
+    // When upscaling, the frames only upload the shadow VRAM, so the native one is brought up to date
+    // here, for the VRAM viewers, which are the ones asking for it.
+    if (m_shadowVRAM) {
+        m_bands.sync();
+        upload(m_vramTexture16, m_dirty16, m_vram16, 0);
+    }
+    return m_vramTexture16;
+}
+
+size_t PCSX::SoftGPU::impl::upload(GLuint texture, Bands::Tiles &dirty, const uint16_t *vram, int shift) {
+    glBindTexture(GL_TEXTURE_2D, texture);
+    if (dirty.none()) return 0;
+
+    const auto rects = Bands::rects(dirty);
+    dirty.reset();
+    size_t size = 0;
+    for (auto &rect : rects) size += ((rect.w * rect.h) << (shift * 2)) * sizeof(uint16_t);
+
+    GLuint &buffer = m_uploadBuffers[m_uploadBuffer];
+    size_t &bufferSize = m_uploadBufferSizes[m_uploadBuffer];
+    m_uploadBuffer = (m_uploadBuffer + 1) % UPLOAD_BUFFERS;
+    if (!buffer) glGenBuffers(1, &buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    if (bufferSize < size) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        bufferSize = size;
+    }
+    // Invalidating the buffer lets the driver hand out fresh storage instead of waiting for the
+    // copies still pending from the frame it was last used for.
+    auto dest = reinterpret_cast<uint16_t *>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+    const int pitch = GPU_WIDTH << shift;
+    if (!dest) {
+        // Straight from the VRAM, if the buffer can't be mapped for some reason.
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+        for (auto &rect : rects) {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x << shift, rect.y << shift, rect.w << shift, rect.h << shift,
+                            GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV,
+                            vram + (rect.y << shift) * pitch + (rect.x << shift));
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        return size;
+    }
+
+    size_t offset = 0;
+    for (auto &rect : rects) {
+        const int x = rect.x << shift, y = rect.y << shift, w = rect.w << shift, h = rect.h << shift;
+        for (int row = 0; row < h; row++) {
+            std::memcpy(dest + offset + row * w, vram + (y + row) * pitch + x, w * sizeof(uint16_t));
+        }
+        offset += w * h;
+    }
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // With a buffer bound, the pixel pointers are offsets into it.
+    offset = 0;
+    for (auto &rect : rects) {
+        const int w = rect.w << shift, h = rect.h << shift;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x << shift, rect.y << shift, w, h, GL_RGBA,
+                        GL_UNSIGNED_SHORT_1_5_5_5_REV, reinterpret_cast<const void *>(offset * sizeof(uint16_t)));
+        offset += w * h;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return size;
+}
+
+void PCSX::SoftGPU::impl::clearDisplay() {
+    if (m_headless) {
+        std::fill(m_frame.begin(), m_frame.end(), 0xff000000);
+        return;
+    }
+    glClearColor(1, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
 void PCSX::SoftGPU::impl::clearVRAM() {
-    GUI *gui = dynamic_cast<GUI *>(m_ui);
-    if (!gui) return;
-    const auto oldTex = OpenGL::getTex2D();
+    m_bands.sync();
+    m_textureCache.clear();
     std::memset(m_allocatedVRAM, 0x00, (GPU_HEIGHT * 2) * 1024 + (1024 * 1024));
+    if (m_shadowVRAM) {
+        std::fill_n(m_shadowVRAM.get(), (GPU_WIDTH << m_upscaleShift) * (GPU_HEIGHT << m_upscaleShift), 0);
+    }
 
+    GUI *gui = dynamic_cast<GUI *>(m_ui);
+    if (m_headless || !gui) return;
+    const auto oldTex = OpenGL::getTex2D();
     glBindTexture(GL_TEXTURE_2D, m_vramTexture16);
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1024, 512, GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, m_allocatedVRAM);
     glBindTexture(GL_TEXTURE_2D, oldTex);
+    m_dirty16.reset();
+    m_dirtyShadow.set();
 }
 
 void PCSX::SoftGPU::impl::setLinearFiltering() {
     GUI *gui = dynamic_cast<GUI *>(m_ui);
-    if (!gui) return;
+    if (m_headless || !gui) return;
     const auto filter = g_emulator->settings.get<Emulator::SettingLinearFiltering>().value ? GL_LINEAR : GL_NEAREST;
     glBindTexture(GL_TEXTURE_2D, m_vramTexture24);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
@@ -83,11 +178,31 @@ void PCSX::SoftGPU::impl::setLinearFiltering() {
     glBindTexture(GL_TEXTURE_2D, m_vramTexture16);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+
+    if (m_shadowTexture) {
+        glBindTexture(GL_TEXTURE_2D, m_shadowTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    }
+}
+
+void PCSX::SoftGPU::impl::resizeShadowTexture() {
+    if (!m_shadowTexture) glGenTextures(1, &m_shadowTexture);
+    m_shadowTextureShift = m_upscaleShift;
+    m_dirtyShadow.set();
+    const auto filter = g_emulator->settings.get<Emulator::SettingLinearFiltering>().value ? GL_LINEAR : GL_NEAREST;
+    glBindTexture(GL_TEXTURE_2D, m_shadowTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, GPU_WIDTH << m_upscaleShift, GPU_HEIGHT << m_upscaleShift, 0, GL_RGBA,
+                 GL_UNSIGNED_SHORT_1_5_5_5_REV, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 }
 
 void PCSX::SoftGPU::impl::initDisplay() {
     GUI *gui = dynamic_cast<GUI *>(m_ui);
-    if (!gui) return;
+    if (m_headless || !gui) return;
     glGenTextures(1, &m_vramTexture24);
     glBindTexture(GL_TEXTURE_2D, m_vramTexture24);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1024, 512, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
@@ -99,6 +214,7 @@ void PCSX::SoftGPU::impl::initDisplay() {
     glGenTextures(1, &m_vramTexture16);
     glBindTexture(GL_TEXTURE_2D, m_vramTexture16);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1024, 512, 0, GL_RGBA, GL_UNSIGNED_SHORT_1_5_5_5_REV, nullptr);
+    m_dirty16.set();
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
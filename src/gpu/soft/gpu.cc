@@ -22,9 +22,12 @@
 
 #include "core/debug.h"
 #include "core/psxemulator.h"
+#include "gpu/soft/bands.h"
+#include "gpu/soft/display.h"
 #include "gpu/soft/interface.h"
 #include "gpu/soft/soft.h"
 #include "imgui.h"
+#include "support/hash64.h"
 #include "support/imgui-helpers.h"
 #include "tracy/Tracy.hpp"
 
@@ -50,6 +53,7 @@ int32_t PCSX::SoftGPU::impl::initBackend(UI *ui) {
     //!!! ATTENTION !!!
     m_vram = m_allocatedVRAM + 512 * 1024;  // security offset into double sized psx vram!
     m_vram16 = (uint16_t *)m_vram;
+    m_target16 = m_vram16;
 
     m_textureWindowRaw = 0;
     m_drawingStartRaw = 0;
@@ -78,24 +82,67 @@ int32_t PCSX::SoftGPU::impl::initBackend(UI *ui) {
     m_statusRet |= GPUSTATUS_IDLE;
     m_statusRet |= GPUSTATUS_READYFORCOMMANDS;
 
+    m_bands.start(g_emulator->settings.get<Emulator::SettingSoftGPUThreads>());
+    m_useTextureCache = g_emulator->settings.get<Emulator::SettingSoftGPUTextureCache>();
+    setUpscale(g_emulator->settings.get<Emulator::SettingSoftGPUUpscale>());
+
     return 0;
 }
 
 int32_t PCSX::SoftGPU::impl::shutdown() {
+    m_bands.stop();
+    m_shadowVRAM.reset();
     delete[] m_allocatedVRAM;
     return 0;
 }
 
+void PCSX::SoftGPU::impl::setUpscale(int shift) {
+    m_bands.sync();
+    m_upscaleShift = std::clamp(shift, 0, 3);
+    if (m_upscaleShift == 0) {
+        m_shadowVRAM.reset();
+        return;
+    }
+
+    // An extra row of slack, like the native VRAM has, for the rasterizers overshooting the last one.
+    m_shadowVRAM.reset(new uint16_t[((GPU_HEIGHT << m_upscaleShift) + 1) * (GPU_WIDTH << m_upscaleShift)]());
+    upsample(0, 0, GPU_WIDTH, GPU_HEIGHT);
+    m_dirtyShadow.set();
+}
+
+void PCSX::SoftGPU::impl::upsample(int x, int y, int w, int h) {
+    if (!m_shadowVRAM) return;
+
+    const int shift = m_upscaleShift;
+    const int size = 1 << shift;
+    const int pitch = GPU_WIDTH << shift;
+    for (int j = 0; j < h; j++) {
+        const int sy = (y + j) & GPU_HEIGHT_MASK;
+        const uint16_t *src = m_vram16 + (sy << 10);
+        uint16_t *dest = m_shadowVRAM.get() + ((sy << shift) * pitch);
+        for (int i = 0; i < w; i++) {
+            const int sx = (x + i) & (GPU_WIDTH - 1);
+            for (int k = 0; k < size; k++) std::fill_n(dest + k * pitch + (sx << shift), size, src[sx]);
+        }
+    }
+}
+
 std::unique_ptr<PCSX::GPU> PCSX::GPU::getSoft() { return std::unique_ptr<PCSX::GPU>(new PCSX::SoftGPU::impl()); }
+std::unique_ptr<PCSX::GPU> PCSX::GPU::getHeadless() {
+    return std::unique_ptr<PCSX::GPU>(new PCSX::SoftGPU::impl(true));
+}
 
 void PCSX::SoftGPU::impl::updateDisplay(bool fromGui) {
     if (m_softDisplay.Disabled) {
-        glClearColor(1, 0, 0, 0);
-        glClear(GL_COLOR_BUFFER_BIT);
+        clearDisplay();
         return;
     }
 
-    doBufferSwap(fromGui);
+    if (m_headless) {
+        updateFrame();
+    } else {
+        doBufferSwap(fromGui);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -131,8 +178,7 @@ void PCSX::SoftGPU::impl::changeDispOffsetsX() {
 
             m_previousDisplay.Range.x1 += (int16_t)(lx - l);
         }
-        glClearColor(1, 0, 0, 0);
-        glClear(GL_COLOR_BUFFER_BIT);
+        clearDisplay();
     }
 
     m_doVSyncUpdate = true;
@@ -177,8 +223,7 @@ void PCSX::SoftGPU::impl::changeDispOffsetsY() {
     }
 
     if (iO != m_previousDisplay.Range.y0) {
-        glClearColor(1, 0, 0, 0);
-        glClear(GL_COLOR_BUFFER_BIT);
+        clearDisplay();
     }
 }
 
@@ -263,6 +308,36 @@ bool PCSX::SoftGPU::impl::configure() {
             changed = true;
             setLinearFiltering();
         }
+
+        auto &threads = g_emulator->settings.get<Emulator::SettingSoftGPUThreads>().value;
+        if (ImGui::SliderInt(_("Rasterizer threads"), &threads, 1, 16)) {
+            changed = true;
+            m_bands.start(threads);
+        }
+        ImGuiHelpers::ShowHelpMarker(
+            _("Splits the VRAM into horizontal bands, each rasterized by its own thread. The output is identical to "
+              "the single threaded renderer, but scenes with a lot of large primitives will render faster."));
+
+        if (ImGui::Checkbox(_("Cache decoded texture pages"),
+                            &g_emulator->settings.get<Emulator::SettingSoftGPUTextureCache>().value)) {
+            changed = true;
+            m_useTextureCache = g_emulator->settings.get<Emulator::SettingSoftGPUTextureCache>();
+        }
+        ImGuiHelpers::ShowHelpMarker(
+            _("Keeps the 4 and 8 bits texture pages around, already looked up in their palette, for the flat "
+              "textured primitives to sample. Mostly helps 2D games, which draw a lot of sprites out of the same "
+              "pages. The output is identical either way."));
+
+        const char *upscaleValues[] = {_("Native (1x)"), "2x", "4x", "8x"};
+        auto &upscale = g_emulator->settings.get<Emulator::SettingSoftGPUUpscale>().value;
+        if (ImGui::Combo(_("Internal resolution"), &upscale, upscaleValues, 4)) {
+            changed = true;
+            setUpscale(upscale);
+        }
+        ImGuiHelpers::ShowHelpMarker(
+            _("Draws the polygons and lines at a multiple of the native resolution, for the display and the "
+              "screenshots. The VRAM the emulated machine sees is still rendered at the native resolution, so this "
+              "doesn't affect compatibility, but the CPU cost grows with the square of the factor."));
         ImGui::End();
     }
 
@@ -275,6 +350,16 @@ void PCSX::SoftGPU::impl::debug() {
             _("Debugging features are not supported when using the software renderer yet\nConsider enabling the "
               "OpenGL "
               "GPU option instead."));
+        ImGui::Separator();
+        const auto &stats = m_textureCache.stats();
+        const auto lookups = stats.hits + stats.misses;
+        ImGui::Text(_("Texture cache hits: %llu"), static_cast<unsigned long long>(stats.hits));
+        ImGui::Text(_("Texture cache misses: %llu"), static_cast<unsigned long long>(stats.misses));
+        ImGui::Text(_("Texture cache invalidations: %llu"), static_cast<unsigned long long>(stats.invalidations));
+        ImGui::Text(_("Texture cache hit rate: %.1f%%"), lookups ? 100.0 * stats.hits / lookups : 0.0);
+        if (ImGui::Button(_("Reset texture cache statistics"))) m_textureCache.resetStats();
+        ImGui::Separator();
+        ImGui::Text(_("VRAM bytes uploaded last frame: %zu"), m_uploadedBytes);
     }
     ImGui::End();
 }
@@ -301,11 +386,85 @@ void PCSX::SoftGPU::impl::write0(FastFill *prim) {
     sW += sX;
     sH += sY;
 
+    const auto writes = Bands::region(sX, sY, sW - 1, sH - 1);
+    m_bands.claim({}, writes);
+    written(writes);
     fillSoftwareArea(sX, sY, sW, sH, BGR24to16(prim->color));
+    if (m_shadowVRAM) {
+        SoftRenderer upscaled = *this;
+        upscaled.upscale(m_shadowVRAM.get(), m_upscaleShift);
+        upscaled.fillSoftwareArea(sX << m_upscaleShift, sY << m_upscaleShift, sW << m_upscaleShift,
+                                  sH << m_upscaleShift, BGR24to16(prim->color));
+    }
 
     m_doVSyncUpdate = true;
 }
 
+template <typename... Args>
+void PCSX::SoftGPU::impl::rasterize(Bands::Clip clip, const Bands::Tiles &reads, const Bands::Tiles &writes,
+                                    void (SoftRenderer::*draw)(Args...), std::type_identity_t<Args>... args) {
+    written(writes);
+    // The upscaled pass goes first, so that it samples the same texels as the native one.
+    if (m_shadowVRAM) {
+        SoftRenderer upscaled = *this;
+        upscaled.upscale(m_shadowVRAM.get(), m_upscaleShift);
+        if (!m_bands.running()) {
+            (upscaled.*draw)(args...);
+        } else {
+            m_bands.submit(upscaled, clip, reads, writes,
+                           [draw, args...](SoftRenderer &renderer) { (renderer.*draw)(args...); });
+        }
+    }
+    if (!m_bands.running()) {
+        (this->*draw)(args...);
+        return;
+    }
+    m_bands.submit(*this, clip, reads, writes, [draw, args...](SoftRenderer &renderer) { (renderer.*draw)(args...); });
+}
+
+void PCSX::SoftGPU::impl::decodeTexture(int clutX, int clutY) {
+    m_decodedTexture = m_useTextureCache ? m_textureCache.lookup(*this, clutX, clutY, m_bands) : nullptr;
+}
+
+PCSX::SoftGPU::Bands::Tiles PCSX::SoftGPU::impl::drawnTiles(int vertices) {
+    const int16_t xs[] = {m_x0, m_x1, m_x2, m_x3};
+    const int16_t ys[] = {m_y0, m_y1, m_y2, m_y3};
+    int x0 = xs[0], x1 = xs[0], y0 = ys[0], y1 = ys[0];
+    for (int i = 1; i < vertices; i++) {
+        x0 = std::min<int>(x0, xs[i]);
+        x1 = std::max<int>(x1, xs[i]);
+        y0 = std::min<int>(y0, ys[i]);
+        y1 = std::max<int>(y1, ys[i]);
+    }
+    // Inclusive on the right and bottom edges, which is conservative for the rasterizers that aren't.
+    return Bands::region(std::max(x0, m_drawX), std::max(y0, m_drawY), std::min(x1, m_drawW), std::min(y1, m_drawH));
+}
+
+PCSX::SoftGPU::Bands::Tiles PCSX::SoftGPU::impl::textureReads(int clutX, int clutY) {
+    if (!m_bands.running()) return {};
+
+    // VRAM footprint of a full texture page, and of its CLUT
+    int width = 256;
+    int entries = 0;
+    switch (m_globalTextTP) {
+        case GPU::TexDepth::Tex4Bits:
+            width = 64;
+            entries = 16;
+            break;
+        case GPU::TexDepth::Tex8Bits:
+            width = 128;
+            entries = 256;
+            break;
+        case GPU::TexDepth::Tex16Bits:
+            break;
+    }
+
+    auto reads = Bands::region(m_globalTextAddrX, m_globalTextAddrY, m_globalTextAddrX + width - 1,
+                               m_globalTextAddrY + 255);
+    if (entries) reads |= Bands::region(clutX, clutY, clutX + entries - 1, clutY);
+    return reads;
+}
+
 template <PCSX::GPU::Shading shading, PCSX::GPU::Shape shape, PCSX::GPU::Textured textured, PCSX::GPU::Blend blend,
           PCSX::GPU::Modulation modulation>
 void PCSX::SoftGPU::impl::polyExec(Poly<shading, shape, textured, blend, modulation> *prim) {
@@ -324,6 +483,7 @@ void PCSX::SoftGPU::impl::polyExec(Poly<shading, shape, textured, blend, modulat
         if (checkCoord3()) return;
         applyOffset3();
     }
+    const auto writes = drawnTiles(shape == Shape::Quad ? 4 : 3);
 
     m_drawSemiTrans = blend == Blend::Semi;
 
@@ -342,44 +502,22 @@ void PCSX::SoftGPU::impl::polyExec(Poly<shading, shape, textured, blend, modulat
                 prim->tpage.raw |= 0x200;
             }
             texturePage(&prim->tpage);
+            const auto reads = textureReads(prim->clutX(), prim->clutY());
+            decodeTexture(prim->clutX(), prim->clutY());
             if constexpr (shape == Shape::Quad) {
-                switch (m_globalTextTP) {
-                    case GPU::TexDepth::Tex4Bits:
-                        drawPoly4TEx4(m_x0, m_y0, m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0],
-                                      prim->u[1], prim->v[1], prim->u[3], prim->v[3], prim->u[2], prim->v[2],
-                                      prim->clutX(), prim->clutY());
-                        break;
-                    case GPU::TexDepth::Tex8Bits:
-                        drawPoly4TEx8(m_x0, m_y0, m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0],
-                                      prim->u[1], prim->v[1], prim->u[3], prim->v[3], prim->u[2], prim->v[2],
-                                      prim->clutX(), prim->clutY());
-                        break;
-                    case GPU::TexDepth::Tex16Bits:
-                        drawPoly4TD(m_x0, m_y0, m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1],
-                                    prim->v[1], prim->u[3], prim->v[3], prim->u[2], prim->v[2]);
-                        break;
-                }
+                rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPolyTextured4, m_x0, m_y0, m_x1, m_y1,
+                          m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1], prim->u[3],
+                          prim->v[3], prim->u[2], prim->v[2], prim->clutX(), prim->clutY());
             } else {
-                switch (m_globalTextTP) {
-                    case GPU::TexDepth::Tex4Bits:
-                        drawPoly3TEx4(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1],
-                                      prim->v[1], prim->u[2], prim->v[2], prim->clutX(), prim->clutY());
-                        break;
-                    case GPU::TexDepth::Tex8Bits:
-                        drawPoly3TEx8(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1],
-                                      prim->v[1], prim->u[2], prim->v[2], prim->clutX(), prim->clutY());
-                        break;
-                    case GPU::TexDepth::Tex16Bits:
-                        drawPoly3TD(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1],
-                                    prim->u[2], prim->v[2]);
-                        break;
-                }
+                rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPolyTextured3, m_x0, m_y0, m_x1, m_y1,
+                          m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1], prim->u[2], prim->v[2],
+                          prim->clutX(), prim->clutY());
             }
         } else {
             if constexpr (shape == Shape::Quad) {
-                drawPolyFlat4(prim->colors[0]);
+                rasterize(Bands::Clip::Area, {}, writes, &SoftRenderer::drawPolyFlat4, prim->colors[0]);
             } else {
-                drawPolyFlat3(prim->colors[0]);
+                rasterize(Bands::Clip::Area, {}, writes, &SoftRenderer::drawPolyFlat3, prim->colors[0]);
             }
         }
     } else {
@@ -389,49 +527,56 @@ void PCSX::SoftGPU::impl::polyExec(Poly<shading, shape, textured, blend, modulat
                 prim->tpage.raw |= 0x200;
             }
             texturePage(&prim->tpage);
+            const auto reads = textureReads(prim->clutX(), prim->clutY());
             if constexpr (shape == Shape::Quad) {
                 switch (m_globalTextTP) {
                     case GPU::TexDepth::Tex4Bits:
-                        drawPoly4TGEx4(m_x0, m_y0, m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0],
-                                       prim->u[1], prim->v[1], prim->u[3], prim->v[3], prim->u[2], prim->v[2],
-                                       prim->clutX(), prim->clutY(), prim->colors[0], prim->colors[1], prim->colors[2],
-                                       prim->colors[3]);
+                        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPoly4TGEx4, m_x0, m_y0, m_x1,
+                                  m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1],
+                                  prim->u[3], prim->v[3], prim->u[2], prim->v[2], prim->clutX(), prim->clutY(),
+                                  prim->colors[0], prim->colors[1], prim->colors[2], prim->colors[3]);
                         break;
                     case GPU::TexDepth::Tex8Bits:
-                        drawPoly4TGEx8(m_x0, m_y0, m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0],
-                                       prim->u[1], prim->v[1], prim->u[3], prim->v[3], prim->u[2], prim->v[2],
-                                       prim->clutX(), prim->clutY(), prim->colors[0], prim->colors[1], prim->colors[2],
-                                       prim->colors[3]);
+                        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPoly4TGEx8, m_x0, m_y0, m_x1,
+                                  m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1],
+                                  prim->u[3], prim->v[3], prim->u[2], prim->v[2], prim->clutX(), prim->clutY(),
+                                  prim->colors[0], prim->colors[1], prim->colors[2], prim->colors[3]);
                         break;
                     case GPU::TexDepth::Tex16Bits:
-                        drawPoly4TGD(m_x0, m_y0, m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1],
-                                     prim->v[1], prim->u[3], prim->v[3], prim->u[2], prim->v[2], prim->colors[0],
-                                     prim->colors[1], prim->colors[2], prim->colors[3]);
+                        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPoly4TGD, m_x0, m_y0, m_x1, m_y1,
+                                  m_x3, m_y3, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1], prim->u[3],
+                                  prim->v[3], prim->u[2], prim->v[2], prim->colors[0], prim->colors[1], prim->colors[2],
+                                  prim->colors[3]);
                         break;
                 }
             } else {
                 switch (m_globalTextTP) {
                     case GPU::TexDepth::Tex4Bits:
-                        drawPoly3TGEx4(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1],
-                                       prim->v[1], prim->u[2], prim->v[2], prim->clutX(), prim->clutY(),
-                                       prim->colors[0], prim->colors[1], prim->colors[2]);
+                        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPoly3TGEx4, m_x0, m_y0, m_x1,
+                                  m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1], prim->u[2],
+                                  prim->v[2], prim->clutX(), prim->clutY(), prim->colors[0], prim->colors[1],
+                                  prim->colors[2]);
                         break;
                     case GPU::TexDepth::Tex8Bits:
-                        drawPoly3TGEx8(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1],
-                                       prim->v[1], prim->u[2], prim->v[2], prim->clutX(), prim->clutY(),
-                                       prim->colors[0], prim->colors[1], prim->colors[2]);
+                        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPoly3TGEx8, m_x0, m_y0, m_x1,
+                                  m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1], prim->u[2],
+                                  prim->v[2], prim->clutX(), prim->clutY(), prim->colors[0], prim->colors[1],
+                                  prim->colors[2]);
                         break;
                     case GPU::TexDepth::Tex16Bits:
-                        drawPoly3TGD(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1],
-                                     prim->u[2], prim->v[2], prim->colors[0], prim->colors[1], prim->colors[2]);
+                        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPoly3TGD, m_x0, m_y0, m_x1, m_y1,
+                                  m_x2, m_y2, prim->u[0], prim->v[0], prim->u[1], prim->v[1], prim->u[2], prim->v[2],
+                                  prim->colors[0], prim->colors[1], prim->colors[2]);
                         break;
                 }
             }
         } else {
             if constexpr (shape == Shape::Quad) {
-                drawPolyShade4(prim->colors[0], prim->colors[1], prim->colors[2], prim->colors[3]);
+                rasterize(Bands::Clip::Area, {}, writes, &SoftRenderer::drawPolyShade4, prim->colors[0],
+                          prim->colors[1], prim->colors[2], prim->colors[3]);
             } else {
-                drawPolyShade3(prim->colors[0], prim->colors[1], prim->colors[2]);
+                rasterize(Bands::Clip::Area, {}, writes, &SoftRenderer::drawPolyShade3, prim->colors[0],
+                          prim->colors[1], prim->colors[2]);
             }
         }
     }
@@ -479,10 +624,11 @@ void PCSX::SoftGPU::impl::lineExec(Line<shading, lineType, blend> *prim) {
         m_x1 = x1;
 
         applyOffset2();
+        const auto writes = drawnTiles(2);
         if constexpr (shading == Shading::Gouraud) {
-            drawSoftwareLineShade(c0, c1);
+            rasterize(Bands::Clip::Line, {}, writes, &SoftRenderer::drawSoftwareLineShade, c0, c1);
         } else {
-            drawSoftwareLineFlat(c0);
+            rasterize(Bands::Clip::Line, {}, writes, &SoftRenderer::drawSoftwareLineFlat, c0);
         }
     }
     m_doVSyncUpdate = true;
@@ -520,6 +666,7 @@ void PCSX::SoftGPU::impl::rectExec(Rect<size, textured, blend, modulation> *prim
     m_x0 = m_x3 = m_x0 + m_softDisplay.DrawOffset.x;
     m_y2 = m_y3 = m_y0 + h + m_softDisplay.DrawOffset.y;
     m_y0 = m_y1 = m_y0 + m_softDisplay.DrawOffset.y;
+    const auto writes = drawnTiles(4);
 
     if constexpr (textured == Textured::Yes) {
         int16_t tx0, ty0, tx1, ty1, tx2, ty2, tx3, ty3;
@@ -528,92 +675,68 @@ void PCSX::SoftGPU::impl::rectExec(Rect<size, textured, blend, modulation> *prim
         ty0 = ty1 = prim->v;
         ty2 = ty3 = ty0 + h;
 
-        switch (m_globalTextTP) {
-            case GPU::TexDepth::Tex4Bits:
-                drawPoly4TEx4_S(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, m_x3, m_y3, tx0, ty0, tx1, ty1, tx2, ty2, tx3, ty3,
-                                prim->clutX(), prim->clutY());
-                break;
-            case GPU::TexDepth::Tex8Bits:
-                drawPoly4TEx8_S(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, m_x3, m_y3, tx0, ty0, tx1, ty1, tx2, ty2, tx3, ty3,
-                                prim->clutX(), prim->clutY());
-                break;
-            case GPU::TexDepth::Tex16Bits:
-                drawPoly4TD_S(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, m_x3, m_y3, tx0, ty0, tx1, ty1, tx2, ty2, tx3, ty3);
-                break;
-        }
+        const auto reads = textureReads(prim->clutX(), prim->clutY());
+        decodeTexture(prim->clutX(), prim->clutY());
+        rasterize(Bands::Clip::Area, reads, writes, &SoftRenderer::drawPolyTextured4, m_x0, m_y0, m_x1, m_y1, m_x2,
+                  m_y2, m_x3, m_y3, tx0, ty0, tx1, ty1, tx2, ty2, tx3, ty3, prim->clutX(), prim->clutY());
     } else {
-        fillSoftwareAreaTrans(m_x0, m_y0, m_x2, m_y2, BGR24to16(prim->color));
+        rasterize(Bands::Clip::Area, {}, writes, &SoftRenderer::fillSoftwareAreaTrans, m_x0, m_y0, m_x2, m_y2,
+                  BGR24to16(prim->color));
     }
 
     m_doVSyncUpdate = true;
 }
 
 void PCSX::SoftGPU::impl::write0(BlitVramVram *prim) {
-    int16_t imageY0, imageX0, imageY1, imageX1, imageSX, imageSY, i, j;
-
-    imageX0 = prim->sX;
-    imageY0 = prim->sY;
-    imageX1 = prim->dX;
-    imageY1 = prim->dY;
-    imageSX = prim->w;
-    imageSY = prim->h;
-
-    if ((imageX0 == imageX1) && (imageY0 == imageY1)) return;
-    if (imageSX <= 0) return;
-    if (imageSY <= 0) return;
-
-    if ((imageY0 + imageSY) > GPU_HEIGHT || (imageX0 + imageSX) > 1024 || (imageY1 + imageSY) > GPU_HEIGHT ||
-        (imageX1 + imageSX) > 1024) {
-        int i, j;
-        for (j = 0; j < imageSY; j++) {
-            for (i = 0; i < imageSX; i++) {
-                m_vram16[(1024 * ((imageY1 + j) & GPU_HEIGHT_MASK)) + ((imageX1 + i) & 0x3ff)] =
-                    m_vram16[(1024 * ((imageY0 + j) & GPU_HEIGHT_MASK)) + ((imageX0 + i) & 0x3ff)];
+    const int srcX = prim->sX & (GPU_WIDTH - 1);
+    const int srcY = prim->sY & GPU_HEIGHT_MASK;
+    const int destX = prim->dX & (GPU_WIDTH - 1);
+    const int destY = prim->dY & GPU_HEIGHT_MASK;
+    const int width = static_cast<int16_t>(prim->w);
+    const int height = static_cast<int16_t>(prim->h);
+
+    if ((srcX == destX) && (srcY == destY) && !m_setMask16) return;
+    if ((width <= 0) || (height <= 0)) return;
+
+    const auto writes = Bands::wrapped(destX, destY, width, height);
+    m_bands.claim(Bands::wrapped(srcX, srcY, width, height), writes);
+    written(writes);
+    VRAMBlit::copy(m_vram16, srcX, srcY, destX, destY, width, height, {m_checkMask, m_setMask16});
+
+    if (m_shadowVRAM) {
+        const bool wraps = ((srcX + width) > GPU_WIDTH) || ((srcY + height) > GPU_HEIGHT) ||
+                           ((destX + width) > GPU_WIDTH) || ((destY + height) > GPU_HEIGHT);
+        const bool overlaps = (srcX < (destX + width)) && (destX < (srcX + width)) && (srcY < (destY + height)) &&
+                              (destY < (srcY + height));
+        if (wraps || overlaps || m_checkMask || m_setMask16) {
+            // Simpler to replicate from the native result than to do all over again.
+            upsample(destX, destY, std::min(width, GPU_WIDTH), std::min(height, GPU_HEIGHT));
+        } else {
+            const int shift = m_upscaleShift;
+            const int pitch = GPU_WIDTH << shift;
+            auto shadow = m_shadowVRAM.get();
+            for (int row = 0; row < (height << shift); row++) {
+                std::memcpy(shadow + ((destY << shift) + row) * pitch + (destX << shift),
+                            shadow + ((srcY << shift) + row) * pitch + (srcX << shift),
+                            (width << shift) * sizeof(uint16_t));
             }
         }
-
-        m_doVSyncUpdate = true;
-
-        return;
     }
 
-    if (imageSX & 1) {
-        // not dword aligned? slower func
-        uint16_t *SRCPtr, *DSTPtr;
-        uint16_t LineOffset;
-
-        SRCPtr = m_vram16 + (1024 * imageY0) + imageX0;
-        DSTPtr = m_vram16 + (1024 * imageY1) + imageX1;
-
-        LineOffset = 1024 - imageSX;
-
-        for (j = 0; j < imageSY; j++) {
-            for (i = 0; i < imageSX; i++) *DSTPtr++ = *SRCPtr++;
-            SRCPtr += LineOffset;
-            DSTPtr += LineOffset;
-        }
-    } else {
-        // dword aligned
-        uint32_t *SRCPtr, *DSTPtr;
-        uint16_t LineOffset;
-        int dx = imageSX >> 1;
-
-        SRCPtr = (uint32_t *)(m_vram16 + (1024 * imageY0) + imageX0);
-        DSTPtr = (uint32_t *)(m_vram16 + (1024 * imageY1) + imageX1);
-
-        LineOffset = 512 - dx;
-
-        for (j = 0; j < imageSY; j++) {
-            for (i = 0; i < dx; i++) *DSTPtr++ = *SRCPtr++;
-            SRCPtr += LineOffset;
-            DSTPtr += LineOffset;
-        }
-    }
+    m_doVSyncUpdate = true;
+}
 
-    imageSX += imageX1;
-    imageSY += imageY1;
+void PCSX::SoftGPU::impl::write0(BlitRamVram *prim) {
+    uploadVRAM(prim->x, prim->y, prim->w, prim->h, prim->data.data<uint16_t>(), {m_checkMask, m_setMask16});
+}
 
-    m_doVSyncUpdate = true;
+void PCSX::SoftGPU::impl::uploadVRAM(int x, int y, int w, int h, const uint16_t *pixels, VRAMBlit::Mask mask) {
+    if ((w <= 0) || (h <= 0)) return;
+    const auto writes = Bands::wrapped(x, y, w, h);
+    m_bands.claim({}, writes);
+    written(writes);
+    VRAMBlit::upload(m_vram16, x, y, w, h, pixels, mask);
+    upsample(x, y, std::min(w, GPU_WIDTH), std::min(h, GPU_HEIGHT));
 }
 
 void PCSX::SoftGPU::impl::write0(TPage *prim) { texturePage(prim); }
@@ -623,40 +746,84 @@ void PCSX::SoftGPU::impl::write0(DrawingAreaEnd *prim) { drawingAreaEnd(prim); }
 void PCSX::SoftGPU::impl::write0(DrawingOffset *prim) { drawingOffset(prim); }
 void PCSX::SoftGPU::impl::write0(MaskBit *prim) { maskBit(prim); }
 
+void PCSX::SoftGPU::impl::updateFrame() {
+    m_bands.sync();
+    const int width = std::clamp(m_softDisplay.DisplayEnd.x - m_softDisplay.DisplayPosition.x, 0, GPU_WIDTH);
+    const int height = std::clamp(m_softDisplay.DisplayEnd.y - m_softDisplay.DisplayPosition.y, 0, GPU_HEIGHT);
+    // Same as for the screenshots, 24 bits displays are only ever shown from the native VRAM.
+    const int shift = (m_shadowVRAM && !m_softDisplay.RGB24) ? m_upscaleShift : 0;
+    m_frameWidth = width << shift;
+    m_frameHeight = height << shift;
+    m_frame.resize(m_frameWidth * m_frameHeight);
+    const uint16_t *vram = shift ? m_shadowVRAM.get() : m_vram16;
+    DisplayConverter::convert(vram, shift, m_softDisplay.DisplayPosition.x << shift,
+                              m_softDisplay.DisplayPosition.y << shift, m_frameWidth, m_frameHeight,
+                              m_softDisplay.RGB24, m_frame.data());
+}
+
 PCSX::GPU::ScreenShot PCSX::SoftGPU::impl::takeScreenShot() {
+    m_bands.sync();
     ScreenShot ss;
     auto startX = m_softDisplay.DisplayPosition.x;
     auto startY = m_softDisplay.DisplayPosition.y;
     auto width = m_softDisplay.DisplayEnd.x - m_softDisplay.DisplayPosition.x;
     auto height = m_softDisplay.DisplayEnd.y - m_softDisplay.DisplayPosition.y;
-    ss.width = width;
-    ss.height = height;
+    // 24 bits displays are only ever shown from the native VRAM.
+    const int shift = (m_shadowVRAM && !m_softDisplay.RGB24) ? m_upscaleShift : 0;
+    ss.width = width << shift;
+    ss.height = height << shift;
     unsigned factor = m_softDisplay.RGB24 ? 3 : 2;
     ss.bpp = m_softDisplay.RGB24 ? ScreenShot::BPP_24 : ScreenShot::BPP_16;
-    unsigned size = width * height * factor;
+    unsigned size = ss.width * ss.height * factor;
     char *pixels = reinterpret_cast<char *>(malloc(size));
     ss.data.acquire(pixels, size);
-    if (m_softDisplay.RGB24) {
-        auto ptr = m_allocatedVRAM;
-        ptr += startX * 3 + startY * 1024 * 2;
-        for (int i = 0; i < height; i++) {
-            std::memcpy(pixels, ptr, width * 3);
-            ptr += 1024 * 2;
-            pixels += width * 3;
-        }
-    } else {
-        auto ptr = m_vram16;
-        ptr += startY * 1024 + startX;
-        for (int i = 0; i < height; i++) {
-            std::memcpy(pixels, ptr, width * sizeof(uint16_t));
-            ptr += 1024;
-            pixels += width * 2;
+
+    // The display start is in halfwords for both depths, and the rows wrap around the VRAM edges.
+    const auto vram = reinterpret_cast<const char *>(shift ? m_shadowVRAM.get() : m_vram16);
+    const unsigned rowSize = (GPU_WIDTH << shift) * sizeof(uint16_t);
+    const unsigned left = (startX << shift) * sizeof(uint16_t);
+    const unsigned lineSize = ss.width * factor;
+    for (unsigned j = 0; j < ss.height; j++) {
+        const char *row = vram + (((startY << shift) + j) & ((GPU_HEIGHT << shift) - 1)) * rowSize;
+        for (unsigned done = 0; done < lineSize;) {
+            const unsigned start = (left + done) & (rowSize - 1);
+            const unsigned count = std::min(lineSize - done, rowSize - start);
+            std::memcpy(pixels + done, row + start, count);
+            done += count;
         }
+        pixels += lineSize;
     }
 
     return ss;
 }
 
+uint64_t PCSX::SoftGPU::impl::hashDisplay() {
+    m_bands.sync();
+    const int startX = m_softDisplay.DisplayPosition.x;
+    const int startY = m_softDisplay.DisplayPosition.y;
+    const int width = std::max(m_softDisplay.DisplayEnd.x - startX, 0);
+    const int height = std::max(m_softDisplay.DisplayEnd.y - startY, 0);
+    const bool rgb24 = m_softDisplay.RGB24;
+    const bool disabled = m_softDisplay.Disabled;
+    Hash64 hash(uint64_t(width) | (uint64_t(height) << 16) | (uint64_t(rgb24) << 32) | (uint64_t(disabled) << 33));
+    if (disabled) return hash.digest();
+
+    // The display start is in halfwords for both depths, and wraps around the VRAM edges.
+    constexpr unsigned rowSize = GPU_WIDTH * sizeof(uint16_t);
+    const unsigned left = startX * sizeof(uint16_t);
+    const unsigned size = width * (rgb24 ? 3 : 2);
+    for (int y = 0; y < height; y++) {
+        auto row = reinterpret_cast<const uint8_t *>(m_vram16 + ((startY + y) & (GPU_HEIGHT - 1)) * GPU_WIDTH);
+        for (unsigned offset = 0; offset < size;) {
+            const unsigned x = (left + offset) % rowSize;
+            const unsigned chunk = std::min(size - offset, rowSize - x);
+            hash.update(row + x, chunk);
+            offset += chunk;
+        }
+    }
+    return hash.digest();
+}
+
 void PCSX::SoftGPU::impl::write1(CtrlReset *) {
     m_textureWindowRaw = 0;
     m_drawingStartRaw = 0;
@@ -19,8 +19,15 @@
 
 #pragma once
 
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 #include "core/gpu.h"
+#include "gpu/soft/bands.h"
+#include "gpu/soft/blit.h"
 #include "gpu/soft/soft.h"
+#include "gpu/soft/texcache.h"
 
 namespace PCSX {
 
@@ -29,6 +36,11 @@ class UI;
 namespace SoftGPU {
 
 class impl final : public GPU, public SoftRenderer {
+  public:
+    impl(bool headless = false) : m_headless(headless) {}
+    ~impl() { disableCachedDithering(); }
+
+  private:
     int32_t initBackend(UI *) override;
     int32_t shutdown() override;
     uint32_t readStatusInternal() override;
@@ -42,9 +54,10 @@ class impl final : public GPU, public SoftRenderer {
         clearVRAM();
         m_display.reset();
     }
-    GLuint getVRAMTexture() override { return m_vramTexture16; }
+    GLuint getVRAMTexture() override;
     void setLinearFiltering() override;
     void setCachedDithering(bool value) override {
+        m_bands.sync();
         if (value) {
             enableCachedDithering();
         } else {
@@ -57,14 +70,18 @@ class impl final : public GPU, public SoftRenderer {
     void updateDisplay(bool fromGui);
     void initDisplay();
     void doBufferSwap(bool fromGui);
+    void clearDisplay();
 
     void changeDispOffsetsX();
     void changeDispOffsetsY();
     void updateDisplayIfChanged();
 
     Slice getVRAM(Ownership ownership) override {
+        m_bands.sync();
         Slice ret;
         if (ownership == Ownership::BORROW) {
+            // Whoever borrows the VRAM may write to it, without telling anyone.
+            written(Bands::Tiles().set());
             ret.borrow(m_vram16, 1024 * 512 * 2);
         } else {
             ret.copy(m_vram16, 1024 * 512 * 2);
@@ -73,16 +90,21 @@ class impl final : public GPU, public SoftRenderer {
     }
 
     void partialUpdateVRAM(int x, int y, int w, int h, const uint16_t *pixels, PartialUpdateVram) override {
-        auto ptr = m_vram16;
-        ptr += y * 1024 + x;
-        for (int i = 0; i < h; i++) {
-            std::memcpy(ptr, pixels, w * sizeof(uint16_t));
-            ptr += 1024;
-            pixels += w;
-        }
+        uploadVRAM(x, y, w, h, pixels, {});
     }
+    void uploadVRAM(int x, int y, int w, int h, const uint16_t *pixels, VRAMBlit::Mask mask);
 
     virtual ScreenShot takeScreenShot() override;
+    virtual uint64_t hashDisplay() override;
+    Frame getFrame() override { return {m_frame.data(), m_frameWidth, m_frameHeight}; }
+    uint64_t workerNanoseconds() override { return m_bands.busyNanoseconds(); }
+
+    // Without any OpenGL context, the display area is converted into m_frame at each vblank instead.
+    const bool m_headless;
+    std::vector<uint32_t> m_frame;
+    unsigned m_frameWidth = 0;
+    unsigned m_frameHeight = 0;
+    void updateFrame();
 
     GLuint m_vramTexture16;
     GLuint m_vramTexture24;
@@ -95,6 +117,54 @@ class impl final : public GPU, public SoftRenderer {
     unsigned char *m_allocatedVRAM;
     static constexpr int16_t s_displayWidths[] = {256, 320, 512, 640, 368, 384};
 
+    Bands m_bands;
+    // Draws on the calling thread, or queues the primitive to the bands when they are running,
+    // into the shadow VRAM first when upscaling, then into the native one.
+    template <typename... Args>
+    void rasterize(Bands::Clip clip, const Bands::Tiles &reads, const Bands::Tiles &writes,
+                   void (SoftRenderer::*draw)(Args...), std::type_identity_t<Args>... args);
+    Bands::Tiles textureReads(int clutX, int clutY);
+    // Tiles covered by the bounding box of the first vertices of the primitive, clipped to the drawing area.
+    Bands::Tiles drawnTiles(int vertices);
+
+    // Internal resolution, as a shift of the native one. When upscaling, every primitive is drawn
+    // twice: once into the shadow VRAM at the higher resolution, which is what gets displayed, and
+    // once into the native VRAM, which remains what the textures, the CPU and the DMA see.
+    int m_upscaleShift = 0;
+    std::unique_ptr<uint16_t[]> m_shadowVRAM;
+    GLuint m_shadowTexture = 0;
+    int m_shadowTextureShift = 0;
+    void setUpscale(int shift);
+    // Copies a rectangle of the native VRAM over to the shadow one, wrapping around its edges.
+    void upsample(int x, int y, int w, int h);
+    void resizeShadowTexture();
+
+    // VRAM tiles written to since each of the display textures was last uploaded. The 24 bits
+    // one is uploaded in full, since only movies use it, and they redraw the whole display anyway.
+    Bands::Tiles m_dirty16;
+    Bands::Tiles m_dirtyShadow;
+    // To be called for anything that writes to the VRAM, like the texture cache invalidation it includes.
+    void written(const Bands::Tiles &writes) {
+        m_textureCache.invalidate(writes);
+        m_dirty16 |= writes;
+        m_dirtyShadow |= writes;
+    }
+    // Uploads the dirty rectangles of a VRAM, at 2^shift times the native resolution, to its texture,
+    // and returns how many bytes that was. The pixels go through a ring of pixel buffers, so that the
+    // driver can copy them asynchronously.
+    size_t upload(GLuint texture, Bands::Tiles &dirty, const uint16_t *vram, int shift);
+    static constexpr unsigned UPLOAD_BUFFERS = 3;
+    GLuint m_uploadBuffers[UPLOAD_BUFFERS] = {};
+    size_t m_uploadBufferSizes[UPLOAD_BUFFERS] = {};
+    unsigned m_uploadBuffer = 0;
+    // Bytes uploaded for the last frame displayed.
+    size_t m_uploadedBytes = 0;
+
+    TextureCache m_textureCache;
+    bool m_useTextureCache = true;
+    // Points the renderer at the decoded texture page of the next flat textured primitive, if any.
+    void decodeTexture(int clutX, int clutY);
+
     void write0(ClearCache *) override;
     void write0(FastFill *) override;
 
@@ -180,6 +250,7 @@ class impl final : public GPU, public SoftRenderer {
     void write0(Rect<Size::S16, Textured::Yes, Blend::Semi, Modulation::On> *) override;
 
     void write0(BlitVramVram *) override;
+    void write0(BlitRamVram *) override;
 
     void write0(TPage *) override;
     void write0(TWindow *) override;
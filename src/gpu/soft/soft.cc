@@ -20,7 +20,10 @@
 #include "gpu/soft/soft.h"
 
 #include <algorithm>
+#include <array>
+#include <utility>
 
+#include "gpu/soft/blit.h"
 #include "gpu/soft/soft.h"
 
 #define XCOL1(x) (x & 0x1f)
@@ -54,6 +57,43 @@
 static constexpr int CHKMAX_X = 1024;
 static constexpr int CHKMAX_Y = 512;
 
+////////////////////////////////////////////////////////////////////////
+// compile-time variants of the pixel pipeline
+////////////////////////////////////////////////////////////////////////
+
+// The drawing functions are specialized over the blending and mask check state. The
+// 16 combinations are numbered as below, and each specialized function is dispatched
+// through a constexpr table of its instantiations, indexed from the renderer's state.
+template <unsigned index>
+struct Variant {
+    static constexpr PCSX::GPU::Blend blend = (index & 1) ? PCSX::GPU::Blend::Semi : PCSX::GPU::Blend::Off;
+    // Without blending, the blend function doesn't matter, so don't instantiate for it.
+    static constexpr PCSX::GPU::BlendFunction abr =
+        (index & 1) ? static_cast<PCSX::GPU::BlendFunction>((index >> 1) & 3)
+                    : PCSX::GPU::BlendFunction::HalfBackAndHalfFront;
+    static constexpr bool checkMask = (index & 8) != 0;
+};
+
+static constexpr unsigned VARIANTS = 16;
+
+static unsigned variantIndex(const PCSX::SoftGPU::SoftRenderer &r) {
+    return (r.m_drawSemiTrans ? 1 : 0) | (static_cast<unsigned>(r.m_globalTextABR) << 1) | (r.m_checkMask ? 8 : 0);
+}
+
+// The dithering Gouraud functions also come in two flavours, with and without the cached dithering table.
+template <unsigned index>
+struct DitherVariant : Variant<index % VARIANTS> {
+    static constexpr bool useCachedDither = index >= VARIANTS;
+};
+
+// The instantiations all have the same signature, which gives the type of the table.
+template <unsigned count, typename Maker>
+static constexpr auto makeVariants(Maker maker) {
+    return [maker]<unsigned... index>(std::integer_sequence<unsigned, index...>) {
+        return std::array{maker.template operator()<index>()...};
+    }(std::make_integer_sequence<unsigned, count>());
+}
+
 ////////////////////////////////////////////////////////////////////////
 // special checks... nascar, syphon filter 2, mgs
 ////////////////////////////////////////////////////////////////////////
@@ -213,15 +253,15 @@ void PCSX::SoftGPU::SoftRenderer::twindow(GPU::TWindow *prim) {
 }
 
 void PCSX::SoftGPU::SoftRenderer::drawingAreaStart(GPU::DrawingAreaStart *prim) {
-    m_drawX = prim->x;
-    m_drawY = prim->y;
+    m_drawX = m_areaX = prim->x;
+    m_drawY = m_areaY = prim->y;
 
     m_drawingStartRaw = prim->raw & 0xfffff;
 }
 
 void PCSX::SoftGPU::SoftRenderer::drawingAreaEnd(GPU::DrawingAreaEnd *prim) {
-    m_drawW = prim->x;
-    m_drawH = prim->y;
+    m_drawW = m_areaW = prim->x;
+    m_drawH = m_areaH = prim->y;
 
     m_drawingEndRaw = prim->raw & 0xfffff;
 }
@@ -251,6 +291,26 @@ void PCSX::SoftGPU::SoftRenderer::maskBit(GPU::MaskBit *prim) {
     m_checkMask = prim->check;
 }
 
+void PCSX::SoftGPU::SoftRenderer::upscale(uint16_t *target, int shift) {
+    m_target16 = target;
+    m_targetShift = 10 + shift;
+    m_upscale = shift;
+
+    // A native pixel covers a block of 2^shift by 2^shift pixels, so the inclusive ends of the
+    // drawing area move to the last pixel of their block. The degenerate area checks only compare
+    // its ends with one another, and keep seeing the same thing when both are shifted.
+    m_drawX <<= shift;
+    m_drawY <<= shift;
+    // Unlike the native VRAM, the target has no room past its bottom edge for the drawing area to spill into.
+    m_drawW = std::min(((m_drawW + 1) << shift) - 1, (GPU_WIDTH << shift) - 1);
+    m_drawH = std::min(((m_drawH + 1) << shift) - 1, (GPU_HEIGHT << shift) - 1);
+    m_areaX <<= shift;
+    m_areaY <<= shift;
+    m_areaW <<= shift;
+    m_areaH <<= shift;
+    scaleCoords(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, m_x3, m_y3);
+}
+
 void PCSX::SoftGPU::SoftRenderer::applyOffset2() {
     m_x0 += m_softDisplay.DrawOffset.x;
     m_y0 += m_softDisplay.DrawOffset.y;
@@ -278,8 +338,6 @@ void PCSX::SoftGPU::SoftRenderer::applyOffset4() {
     m_y3 += m_softDisplay.DrawOffset.y;
 }
 
-static constexpr uint8_t s_dithertable[16] = {7, 0, 6, 1, 2, 5, 3, 4, 1, 6, 0, 7, 4, 3, 5, 2};
-
 static uint16_t *s_ditherLUT = nullptr;
 
 static void prepareDitherLut() {
@@ -298,7 +356,7 @@ static void prepareDitherLut() {
                     gc = g;
                     bc = b;
 
-                    coeff = s_dithertable[s];
+                    coeff = PCSX::SoftGPU::SoftRenderer::s_dithertable[s];
 
                     rlow = rc & 7;
                     glow = gc & 7;
@@ -328,17 +386,17 @@ void PCSX::SoftGPU::SoftRenderer::disableCachedDithering() {
     s_ditherLUT = nullptr;
 }
 
-PCSX::SoftGPU::SoftRenderer::~SoftRenderer() {
-    if (s_ditherLUT) delete[] s_ditherLUT;
-    s_ditherLUT = nullptr;
+static unsigned ditherVariantIndex(const PCSX::SoftGPU::SoftRenderer &r) {
+    return (s_ditherLUT ? VARIANTS : 0) + variantIndex(r);
 }
 
-static void applyDitherCached(uint16_t *pdest, uint16_t *base, uint32_t r, uint32_t g, uint32_t b, uint16_t sM) {
+static void applyDitherCached(uint16_t *pdest, uint16_t *base, int shift, uint32_t r, uint32_t g, uint32_t b,
+                              uint16_t sM) {
     int x, y;
 
     x = pdest - base;
-    y = x >> 10;
-    x -= (y << 10);
+    y = x >> shift;
+    x -= (y << shift);
 
     uint32_t index = r;
     index <<= 8;
@@ -351,16 +409,17 @@ static void applyDitherCached(uint16_t *pdest, uint16_t *base, uint32_t r, uint3
     *pdest = s_ditherLUT[index] | sM;
 }
 
-static void applyDither(uint16_t *pdest, uint16_t *base, uint32_t r, uint32_t g, uint32_t b, uint16_t sM) {
+static void applyDither(uint16_t *pdest, uint16_t *base, int shift, uint32_t r, uint32_t g, uint32_t b,
+                        uint16_t sM) {
     uint8_t coeff;
     uint8_t rlow, glow, blow;
     int x, y;
 
     x = pdest - base;
-    y = x >> 10;
-    x -= (y << 10);
+    y = x >> shift;
+    x -= (y << shift);
 
-    coeff = s_dithertable[(y & 3) * 4 + (x & 3)];
+    coeff = PCSX::SoftGPU::SoftRenderer::s_dithertable[(y & 3) * 4 + (x & 3)];
 
     rlow = r & 7;
     glow = g & 7;
@@ -381,26 +440,26 @@ static void applyDither(uint16_t *pdest, uint16_t *base, uint32_t r, uint32_t g,
 /////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////
 
-template <bool useCachedDither>
+template <bool useCachedDither, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getShadeTransColDither(uint16_t *pdest, int32_t m1, int32_t m2, int32_t m3) {
     int32_t r, g, b;
 
-    if (m_checkMask && *pdest & 0x8000) return;
+    if (checkMask && *pdest & 0x8000) return;
 
-    if (m_drawSemiTrans) {
+    if constexpr (blend == GPU::Blend::Semi) {
         r = ((XCOL1D(*pdest)) << 3);
         b = ((XCOL2D(*pdest)) << 3);
         g = ((XCOL3D(*pdest)) << 3);
 
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
             r = (r >> 1) + (m1 >> 1);
             b = (b >> 1) + (m2 >> 1);
             g = (g >> 1) + (m3 >> 1);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r += m1;
             b += m2;
             g += m3;
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             r -= m1;
             b -= m2;
             g -= m3;
@@ -423,28 +482,41 @@ void PCSX::SoftGPU::SoftRenderer::getShadeTransColDither(uint16_t *pdest, int32_
     if (g & 0x7fffff00) g = 0xff;
 
     if constexpr (useCachedDither) {
-        applyDitherCached(pdest, m_vram16, r, b, g, m_setMask16);
+        applyDitherCached(pdest, m_target16, m_targetShift, r, b, g, m_setMask16);
     } else {
-        applyDither(pdest, m_vram16, r, b, g, m_setMask16);
+        applyDither(pdest, m_target16, m_targetShift, r, b, g, m_setMask16);
     }
 }
 
+template <bool useCachedDither>
+void PCSX::SoftGPU::SoftRenderer::getShadeTransColDither(uint16_t *pdest, int32_t m1, int32_t m2, int32_t m3) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::getShadeTransColDither<useCachedDither, V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(pdest, m1, m2, m3);
+}
+
+// The span kernels' fallback in spans.cc uses it.
+template void PCSX::SoftGPU::SoftRenderer::getShadeTransColDither<false>(uint16_t *, int32_t, int32_t, int32_t);
+
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getShadeTransCol(uint16_t *pdest, uint16_t color) {
-    if (m_checkMask && *pdest & 0x8000) return;
+    if (checkMask && *pdest & 0x8000) return;
 
-    if (m_drawSemiTrans) {
+    if constexpr (blend == GPU::Blend::Semi) {
         int32_t r, g, b;
 
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
             *pdest = ((((*pdest) & 0x7bde) >> 1) + ((color & 0x7bde) >> 1)) | m_setMask16;  // 0x8000;
             return;
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r = (XCOL1(*pdest)) + ((XCOL1(color)));
             b = (XCOL2(*pdest)) + ((XCOL2(color)));
             g = (XCOL3(*pdest)) + ((XCOL3(color)));
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             r = (XCOL1(*pdest)) - ((XCOL1(color)));
             b = (XCOL2(*pdest)) - ((XCOL2(color)));
             g = (XCOL3(*pdest)) - ((XCOL3(color)));
@@ -467,25 +539,34 @@ void PCSX::SoftGPU::SoftRenderer::getShadeTransCol(uint16_t *pdest, uint16_t col
     }
 }
 
+void PCSX::SoftGPU::SoftRenderer::getShadeTransCol(uint16_t *pdest, uint16_t color) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::getShadeTransCol<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(pdest, color);
+}
+
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getShadeTransCol32(uint32_t *pdest, uint32_t color) {
-    if (m_drawSemiTrans) {
+    if constexpr (blend == GPU::Blend::Semi) {
         int32_t r, g, b;
 
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
-            if (!m_checkMask) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
+            if constexpr (!checkMask) {
                 *pdest = ((((*pdest) & 0x7bde7bde) >> 1) + ((color & 0x7bde7bde) >> 1)) | m_setMask32;  // 0x80008000;
                 return;
             }
             r = (X32ACOL1(*pdest) >> 1) + ((X32ACOL1(color)) >> 1);
             b = (X32ACOL2(*pdest) >> 1) + ((X32ACOL2(color)) >> 1);
             g = (X32ACOL3(*pdest) >> 1) + ((X32ACOL3(color)) >> 1);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r = (X32COL1(*pdest)) + ((X32COL1(color)));
             b = (X32COL2(*pdest)) + ((X32COL2(color)));
             g = (X32COL3(*pdest)) + ((X32COL3(color)));
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             int32_t sr, sb, sg, src, sbc, sgc, c;
             src = XCOL1(color);
             sbc = XCOL2(color);
@@ -523,7 +604,7 @@ void PCSX::SoftGPU::SoftRenderer::getShadeTransCol32(uint32_t *pdest, uint32_t c
         if (g & 0x7fe00000) g = 0x1f0000 | (g & 0xffff);
         if (g & 0x7fe0) g = 0x1f | (g & 0xffff0000);
 
-        if (m_checkMask) {
+        if constexpr (checkMask) {
             uint32_t ma = *pdest;
             *pdest = (X32PSXCOL(r, g, b)) | m_setMask32;  // 0x80008000;
             if (ma & 0x80000000) *pdest = (ma & 0xffff0000) | (*pdest & 0xffff);
@@ -532,7 +613,7 @@ void PCSX::SoftGPU::SoftRenderer::getShadeTransCol32(uint32_t *pdest, uint32_t c
         }
         *pdest = (X32PSXCOL(r, g, b)) | m_setMask32;  // 0x80008000;
     } else {
-        if (m_checkMask) {
+        if constexpr (checkMask) {
             uint32_t ma = *pdest;
             *pdest = color | m_setMask32;  // 0x80008000;
             if (ma & 0x80000000) *pdest = (ma & 0xffff0000) | (*pdest & 0xffff);
@@ -544,31 +625,40 @@ void PCSX::SoftGPU::SoftRenderer::getShadeTransCol32(uint32_t *pdest, uint32_t c
     }
 }
 
+void PCSX::SoftGPU::SoftRenderer::getShadeTransCol32(uint32_t *pdest, uint32_t color) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::getShadeTransCol32<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(pdest, color);
+}
+
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade(uint16_t *pdest, uint16_t color) {
     int32_t r, g, b;
     uint16_t l;
 
     if (color == 0) return;
 
-    if (m_checkMask && *pdest & 0x8000) return;
+    if (checkMask && *pdest & 0x8000) return;
 
     l = m_setMask16 | (color & 0x8000);
 
-    if (m_drawSemiTrans && (color & 0x8000)) {
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
+    if ((blend == GPU::Blend::Semi) && (color & 0x8000)) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
             uint16_t d;
             d = ((*pdest) & 0x7bde) >> 1;
             color = (color & 0x7bde) >> 1;
             r = (XCOL1(d)) + ((((XCOL1(color))) * m_m1) >> 7);
             b = (XCOL2(d)) + ((((XCOL2(color))) * m_m2) >> 7);
             g = (XCOL3(d)) + ((((XCOL3(color))) * m_m3) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r = (XCOL1(*pdest)) + ((((XCOL1(color))) * m_m1) >> 7);
             b = (XCOL2(*pdest)) + ((((XCOL2(color))) * m_m2) >> 7);
             g = (XCOL3(*pdest)) + ((((XCOL3(color))) * m_m3) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             r = (XCOL1(*pdest)) - ((((XCOL1(color))) * m_m1) >> 7);
             b = (XCOL2(*pdest)) - ((((XCOL2(color))) * m_m2) >> 7);
             g = (XCOL3(*pdest)) - ((((XCOL3(color))) * m_m3) >> 7);
@@ -593,78 +683,17 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade(uint16_t *pdest, uint1
     *pdest = (XPSXCOL(r, g, b)) | l;
 }
 
-////////////////////////////////////////////////////////////////////////
-
-inline void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeSolid(uint16_t *pdest, uint16_t color) {
-    int32_t r, g, b;
-    uint16_t l;
-
-    if (color == 0) return;
-
-    l = m_setMask16 | (color & 0x8000);
-
-    r = ((XCOL1(color)) * m_m1) >> 7;
-    b = ((XCOL2(color)) * m_m2) >> 7;
-    g = ((XCOL3(color)) * m_m3) >> 7;
-
-    if (r & 0x7fffffe0) r = 0x1f;
-    if (b & 0x7ffffc00) b = 0x3e0;
-    if (g & 0x7fff8000) g = 0x7c00;
-
-    *pdest = (XPSXCOL(r, g, b)) | l;
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeSemi(uint16_t *pdest, uint16_t color) {
-    int32_t r, g, b;
-    uint16_t l;
-
-    if (color == 0) return;
-
-    if (m_checkMask && *pdest & 0x8000) return;
-
-    l = m_setMask16 | (color & 0x8000);
-
-    if (m_drawSemiTrans && (color & 0x8000)) {
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
-            uint16_t d;
-            d = ((*pdest) & 0x7bde) >> 1;
-            color = (color & 0x7bde) >> 1;
-            r = (XCOL1(d)) + ((((XCOL1(color))) * m_m1) >> 7);
-            b = (XCOL2(d)) + ((((XCOL2(color))) * m_m2) >> 7);
-            g = (XCOL3(d)) + ((((XCOL3(color))) * m_m3) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
-            r = (XCOL1(*pdest)) + ((((XCOL1(color))) * m_m1) >> 7);
-            b = (XCOL2(*pdest)) + ((((XCOL2(color))) * m_m2) >> 7);
-            g = (XCOL3(*pdest)) + ((((XCOL3(color))) * m_m3) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
-            r = (XCOL1(*pdest)) - ((((XCOL1(color))) * m_m1) >> 7);
-            b = (XCOL2(*pdest)) - ((((XCOL2(color))) * m_m2) >> 7);
-            g = (XCOL3(*pdest)) - ((((XCOL3(color))) * m_m3) >> 7);
-            if (r & 0x80000000) r = 0;
-            if (b & 0x80000000) b = 0;
-            if (g & 0x80000000) g = 0;
-        } else {
-            r = (XCOL1(*pdest)) + ((((XCOL1(color)) >> 2) * m_m1) >> 7);
-            b = (XCOL2(*pdest)) + ((((XCOL2(color)) >> 2) * m_m2) >> 7);
-            g = (XCOL3(*pdest)) + ((((XCOL3(color)) >> 2) * m_m3) >> 7);
-        }
-    } else {
-        r = ((XCOL1(color)) * m_m1) >> 7;
-        b = ((XCOL2(color)) * m_m2) >> 7;
-        g = ((XCOL3(color)) * m_m3) >> 7;
-    }
-
-    if (r & 0x7fffffe0) r = 0x1f;
-    if (b & 0x7ffffc00) b = 0x3e0;
-    if (g & 0x7fff8000) g = 0x7c00;
-
-    *pdest = (XPSXCOL(r, g, b)) | l;
+void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade(uint16_t *pdest, uint16_t color) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::getTextureTransColShade<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(pdest, color);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade32(uint32_t *pdest, uint32_t color) {
     int32_t r, g, b, l;
 
@@ -672,16 +701,16 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade32(uint32_t *pdest, uin
 
     l = m_setMask32 | (color & 0x80008000);
 
-    if (m_drawSemiTrans && (color & 0x80008000)) {
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
+    if ((blend == GPU::Blend::Semi) && (color & 0x80008000)) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
             r = ((((X32TCOL1(*pdest)) + ((X32COL1(color)) * m_m1)) & 0xff00ff00) >> 8);
             b = ((((X32TCOL2(*pdest)) + ((X32COL2(color)) * m_m2)) & 0xff00ff00) >> 8);
             g = ((((X32TCOL3(*pdest)) + ((X32COL3(color)) * m_m3)) & 0xff00ff00) >> 8);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r = (X32COL1(*pdest)) + (((((X32COL1(color))) * m_m1) & 0xff80ff80) >> 7);
             b = (X32COL2(*pdest)) + (((((X32COL2(color))) * m_m2) & 0xff80ff80) >> 7);
             g = (X32COL3(*pdest)) + (((((X32COL3(color))) * m_m3) & 0xff80ff80) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             int32_t t;
             r = (((((X32COL1(color))) * m_m1) & 0xff80ff80) >> 7);
             t = (*pdest & 0x001f0000) - (r & 0x003f0000);
@@ -733,7 +762,7 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade32(uint32_t *pdest, uin
     if (g & 0x7fe00000) g = 0x1f0000 | (g & 0xffff);
     if (g & 0x7fe0) g = 0x1f | (g & 0xffff0000);
 
-    if (m_checkMask) {
+    if constexpr (checkMask) {
         uint32_t ma = *pdest;
 
         *pdest = (X32PSXCOL(r, g, b)) | l;
@@ -757,157 +786,43 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade32(uint32_t *pdest, uin
     *pdest = (X32PSXCOL(r, g, b)) | l;
 }
 
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade32Solid(uint32_t *pdest, uint32_t color) {
-    int32_t r, g, b;
-
-    if (color == 0) return;
-
-    r = (((X32COL1(color)) * m_m1) & 0xff80ff80) >> 7;
-    b = (((X32COL2(color)) * m_m2) & 0xff80ff80) >> 7;
-    g = (((X32COL3(color)) * m_m3) & 0xff80ff80) >> 7;
-
-    if (r & 0x7fe00000) r = 0x1f0000 | (r & 0xffff);
-    if (r & 0x7fe0) r = 0x1f | (r & 0xffff0000);
-    if (b & 0x7fe00000) b = 0x1f0000 | (b & 0xffff);
-    if (b & 0x7fe0) b = 0x1f | (b & 0xffff0000);
-    if (g & 0x7fe00000) g = 0x1f0000 | (g & 0xffff);
-    if (g & 0x7fe0) g = 0x1f | (g & 0xffff0000);
-
-    if ((color & 0xffff) == 0) {
-        *pdest = (*pdest & 0xffff) | (((X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000)) & 0xffff0000);
-        return;
-    }
-    if ((color & 0xffff0000) == 0) {
-        *pdest = (*pdest & 0xffff0000) | (((X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000)) & 0xffff);
-        return;
-    }
-
-    *pdest = (X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000);
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::getTextureTransColG32Semi(uint32_t *pdest, uint32_t color) {
-    int32_t r, g, b;
-
-    if (color == 0) return;
-
-    if (m_drawSemiTrans && (color & 0x80008000)) {
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
-            r = ((((X32TCOL1(*pdest)) + ((X32COL1(color)) * m_m1)) & 0xff00ff00) >> 8);
-            b = ((((X32TCOL2(*pdest)) + ((X32COL2(color)) * m_m2)) & 0xff00ff00) >> 8);
-            g = ((((X32TCOL3(*pdest)) + ((X32COL3(color)) * m_m3)) & 0xff00ff00) >> 8);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
-            r = (X32COL1(*pdest)) + (((((X32COL1(color))) * m_m1) & 0xff80ff80) >> 7);
-            b = (X32COL2(*pdest)) + (((((X32COL2(color))) * m_m2) & 0xff80ff80) >> 7);
-            g = (X32COL3(*pdest)) + (((((X32COL3(color))) * m_m3) & 0xff80ff80) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
-            int32_t t;
-            r = (((((X32COL1(color))) * m_m1) & 0xff80ff80) >> 7);
-            t = (*pdest & 0x001f0000) - (r & 0x003f0000);
-            if (t & 0x80000000) t = 0;
-            r = (*pdest & 0x0000001f) - (r & 0x0000003f);
-            if (r & 0x80000000) r = 0;
-            r |= t;
-
-            b = (((((X32COL2(color))) * m_m2) & 0xff80ff80) >> 7);
-            t = ((*pdest >> 5) & 0x001f0000) - (b & 0x003f0000);
-            if (t & 0x80000000) t = 0;
-            b = ((*pdest >> 5) & 0x0000001f) - (b & 0x0000003f);
-            if (b & 0x80000000) b = 0;
-            b |= t;
-
-            g = (((((X32COL3(color))) * m_m3) & 0xff80ff80) >> 7);
-            t = ((*pdest >> 10) & 0x001f0000) - (g & 0x003f0000);
-            if (t & 0x80000000) t = 0;
-            g = ((*pdest >> 10) & 0x0000001f) - (g & 0x0000003f);
-            if (g & 0x80000000) g = 0;
-            g |= t;
-        } else {
-            r = (X32COL1(*pdest)) + (((((X32BCOL1(color)) >> 2) * m_m1) & 0xff80ff80) >> 7);
-            b = (X32COL2(*pdest)) + (((((X32BCOL2(color)) >> 2) * m_m2) & 0xff80ff80) >> 7);
-            g = (X32COL3(*pdest)) + (((((X32BCOL3(color)) >> 2) * m_m3) & 0xff80ff80) >> 7);
-        }
-
-        if (!(color & 0x8000)) {
-            r = (r & 0xffff0000) | ((((X32COL1(color)) * m_m1) & 0x0000ff80) >> 7);
-            b = (b & 0xffff0000) | ((((X32COL2(color)) * m_m2) & 0x0000ff80) >> 7);
-            g = (g & 0xffff0000) | ((((X32COL3(color)) * m_m3) & 0x0000ff80) >> 7);
-        }
-        if (!(color & 0x80000000)) {
-            r = (r & 0xffff) | ((((X32COL1(color)) * m_m1) & 0xFF800000) >> 7);
-            b = (b & 0xffff) | ((((X32COL2(color)) * m_m2) & 0xFF800000) >> 7);
-            g = (g & 0xffff) | ((((X32COL3(color)) * m_m3) & 0xFF800000) >> 7);
-        }
-
-    } else {
-        r = (((X32COL1(color)) * m_m1) & 0xff80ff80) >> 7;
-        b = (((X32COL2(color)) * m_m2) & 0xff80ff80) >> 7;
-        g = (((X32COL3(color)) * m_m3) & 0xff80ff80) >> 7;
-    }
-
-    if (r & 0x7fe00000) r = 0x1f0000 | (r & 0xffff);
-    if (r & 0x7fe0) r = 0x1f | (r & 0xffff0000);
-    if (b & 0x7fe00000) b = 0x1f0000 | (b & 0xffff);
-    if (b & 0x7fe0) b = 0x1f | (b & 0xffff0000);
-    if (g & 0x7fe00000) g = 0x1f0000 | (g & 0xffff);
-    if (g & 0x7fe0) g = 0x1f | (g & 0xffff0000);
-
-    if (m_checkMask) {
-        uint32_t ma = *pdest;
-
-        *pdest = (X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000);
-
-        if ((color & 0xffff) == 0) *pdest = (ma & 0xffff) | (*pdest & 0xffff0000);
-        if ((color & 0xffff0000) == 0) *pdest = (ma & 0xffff0000) | (*pdest & 0xffff);
-        if (ma & 0x80000000) *pdest = (ma & 0xffff0000) | (*pdest & 0xffff);
-        if (ma & 0x00008000) *pdest = (ma & 0xffff) | (*pdest & 0xffff0000);
-
-        return;
-    }
-    if ((color & 0xffff) == 0) {
-        *pdest = (*pdest & 0xffff) | (((X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000)) & 0xffff0000);
-        return;
-    }
-    if ((color & 0xffff0000) == 0) {
-        *pdest = (*pdest & 0xffff0000) | (((X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000)) & 0xffff);
-        return;
-    }
-
-    *pdest = (X32PSXCOL(r, g, b)) | m_setMask32 | (color & 0x80008000);
+void PCSX::SoftGPU::SoftRenderer::getTextureTransColShade32(uint32_t *pdest, uint32_t color) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::getTextureTransColShade32<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(pdest, color);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
-template <bool useCachedDither>
+template <bool useCachedDither, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeXDither(uint16_t *pdest, uint16_t color, int32_t m1,
                                                                  int32_t m2, int32_t m3) {
     int32_t r, g, b;
 
     if (color == 0) return;
 
-    if (m_checkMask && *pdest & 0x8000) return;
+    if (checkMask && *pdest & 0x8000) return;
 
     m1 = (((XCOL1D(color))) * m1) >> 4;
     m2 = (((XCOL2D(color))) * m2) >> 4;
     m3 = (((XCOL3D(color))) * m3) >> 4;
 
-    if (m_drawSemiTrans && (color & 0x8000)) {
+    if ((blend == GPU::Blend::Semi) && (color & 0x8000)) {
         r = ((XCOL1D(*pdest)) << 3);
         b = ((XCOL2D(*pdest)) << 3);
         g = ((XCOL3D(*pdest)) << 3);
 
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
             r = (r >> 1) + (m1 >> 1);
             b = (b >> 1) + (m2 >> 1);
             g = (g >> 1) + (m3 >> 1);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r += m1;
             b += m2;
             g += m3;
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             r -= m1;
             b -= m2;
             g -= m3;
@@ -930,14 +845,15 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeXDither(uint16_t *pdest
     if (g & 0x7fffff00) g = 0xff;
 
     if constexpr (useCachedDither) {
-        applyDitherCached(pdest, m_vram16, r, b, g, m_setMask16 | (color & 0x8000));
+        applyDitherCached(pdest, m_target16, m_targetShift, r, b, g, m_setMask16 | (color & 0x8000));
     } else {
-        applyDither(pdest, m_vram16, r, b, g, m_setMask16 | (color & 0x8000));
+        applyDither(pdest, m_target16, m_targetShift, r, b, g, m_setMask16 | (color & 0x8000));
     }
 }
 
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeX(uint16_t *pdest, uint16_t color, int16_t m1, int16_t m2,
                                                            int16_t m3) {
     int32_t r, g, b;
@@ -945,23 +861,23 @@ void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeX(uint16_t *pdest, uint
 
     if (color == 0) return;
 
-    if (m_checkMask && *pdest & 0x8000) return;
+    if (checkMask && *pdest & 0x8000) return;
 
     l = m_setMask16 | (color & 0x8000);
 
-    if (m_drawSemiTrans && (color & 0x8000)) {
-        if (m_globalTextABR == GPU::BlendFunction::HalfBackAndHalfFront) {
+    if ((blend == GPU::Blend::Semi) && (color & 0x8000)) {
+        if constexpr (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
             uint16_t d;
             d = ((*pdest) & 0x7bde) >> 1;
             color = (color & 0x7bde) >> 1;
             r = (XCOL1(d)) + ((((XCOL1(color))) * m1) >> 7);
             b = (XCOL2(d)) + ((((XCOL2(color))) * m2) >> 7);
             g = (XCOL3(d)) + ((((XCOL3(color))) * m3) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackAndFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackAndFullFront) {
             r = (XCOL1(*pdest)) + ((((XCOL1(color))) * m1) >> 7);
             b = (XCOL2(*pdest)) + ((((XCOL2(color))) * m2) >> 7);
             g = (XCOL3(*pdest)) + ((((XCOL3(color))) * m3) >> 7);
-        } else if (m_globalTextABR == GPU::BlendFunction::FullBackSubFullFront) {
+        } else if constexpr (abr == GPU::BlendFunction::FullBackSubFullFront) {
             r = (XCOL1(*pdest)) - ((((XCOL1(color))) * m1) >> 7);
             b = (XCOL2(*pdest)) - ((((XCOL2(color))) * m2) >> 7);
             g = (XCOL3(*pdest)) - ((((XCOL3(color))) * m3) >> 7);
@@ -1040,7 +956,13 @@ inline void PCSX::SoftGPU::SoftRenderer::getTextureTransColShadeX32Solid(uint32_
 // FILL FUNCS
 ////////////////////////////////////////////////////////////////////////
 
-void PCSX::SoftGPU::SoftRenderer::fillSoftwareAreaTrans(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col) {
+// Shared by all the variants of fillSoftwareAreaTransi.
+static int s_interlaceCheat = 0;
+
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
+void PCSX::SoftGPU::SoftRenderer::fillSoftwareAreaTransi(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col) {
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+    scaleCoords(x0, y0, x1, y1);
     int16_t j, i, dx, dy;
 
     if (y0 > y1) return;
@@ -1056,30 +978,36 @@ void PCSX::SoftGPU::SoftRenderer::fillSoftwareAreaTrans(int16_t x0, int16_t y0,
     x0 = std::max(x0, static_cast<int16_t>(m_drawX));
     y0 = std::max(y0, static_cast<int16_t>(m_drawY));
 
-    if (y0 >= GPU_HEIGHT) return;
-    if (x0 >= GPU_WIDTH) return;
+    const int width = 1 << m_targetShift;
+    const int height = GPU_HEIGHT << m_upscale;
+    if (y0 >= height) return;
+    if (x0 >= width) return;
 
-    if (y1 > GPU_HEIGHT) y1 = GPU_HEIGHT;
-    if (x1 > GPU_WIDTH) x1 = GPU_WIDTH;
+    if (y1 > height) y1 = height;
+    if (x1 > width) x1 = width;
 
     dx = x1 - x0;
     dy = y1 - y0;
 
     if (dx == 1 && dy == 1 && x0 == 1020 && y0 == 511) {
         // interlace hack - fix me
-        static int iCheat = 0;
-        col += iCheat;
-        iCheat ^= 1;
+        col += s_interlaceCheat;
+        s_interlaceCheat ^= 1;
+    }
+
+    if (m_vectorSpans) {
+        for (i = 0; i < dy; i++) spanFlat(m_target16 + (width * (y0 + i)) + x0, dx, col);
+        return;
     }
 
     if (dx & 1) {
         // slow fill
         uint16_t *DSTPtr;
         uint16_t LineOffset;
-        DSTPtr = m_vram16 + (GPU_WIDTH * y0) + x0;
-        LineOffset = GPU_WIDTH - dx;
+        DSTPtr = m_target16 + (width * y0) + x0;
+        LineOffset = width - dx;
         for (i = 0; i < dy; i++) {
-            for (j = 0; j < dx; j++) getShadeTransCol(DSTPtr++, col);
+            for (j = 0; j < dx; j++) getShadeTransCol<blend, abr, checkMask>(DSTPtr++, col);
             DSTPtr += LineOffset;
         }
     } else {
@@ -1088,64 +1016,47 @@ void PCSX::SoftGPU::SoftRenderer::fillSoftwareAreaTrans(int16_t x0, int16_t y0,
         uint16_t LineOffset;
         uint32_t lcol = m_setMask32 | (((uint32_t)(col)) << 16) | col;
         dx >>= 1;
-        DSTPtr = (uint32_t *)(m_vram16 + (GPU_WIDTH * y0) + x0);
-        LineOffset = 512 - dx;
+        DSTPtr = (uint32_t *)(m_target16 + (width * y0) + x0);
+        LineOffset = (width >> 1) - dx;
 
-        if (!m_checkMask && !m_drawSemiTrans) {
+        if constexpr (solid) {
             for (i = 0; i < dy; i++) {
                 for (j = 0; j < dx; j++) *DSTPtr++ = lcol;
                 DSTPtr += LineOffset;
             }
         } else {
             for (i = 0; i < dy; i++) {
-                for (j = 0; j < dx; j++) getShadeTransCol32(DSTPtr++, lcol);
+                for (j = 0; j < dx; j++) getShadeTransCol32<blend, abr, checkMask>(DSTPtr++, lcol);
                 DSTPtr += LineOffset;
             }
         }
     }
 }
 
+void PCSX::SoftGPU::SoftRenderer::fillSoftwareAreaTrans(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::fillSoftwareAreaTransi<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(x0, y0, x1, y1, col);
+}
+
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SoftGPU::SoftRenderer::fillSoftwareArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col) {
-    int16_t j, i, dx, dy;
-
     if (y0 > y1) return;
     if (x0 > x1) return;
 
-    if (y0 >= GPU_HEIGHT) return;
-    if (x0 >= GPU_WIDTH) return;
-
-    if (y1 > GPU_HEIGHT) y1 = GPU_HEIGHT;
-    if (x1 > GPU_WIDTH) x1 = GPU_WIDTH;
-
-    dx = x1 - x0;
-    dy = y1 - y0;
-    if (dx & 1) {
-        uint16_t *DSTPtr;
-        uint16_t LineOffset;
-
-        DSTPtr = m_vram16 + (GPU_WIDTH * y0) + x0;
-        LineOffset = GPU_WIDTH - dx;
-
-        for (i = 0; i < dy; i++) {
-            for (j = 0; j < dx; j++) *DSTPtr++ = col;
-            DSTPtr += LineOffset;
-        }
-    } else {
-        uint32_t *DSTPtr;
-        uint16_t LineOffset;
-        uint32_t lcol = (((int32_t)col) << 16) | col;
+    const int width = 1 << m_targetShift;
+    const int height = GPU_HEIGHT << m_upscale;
+    if (y0 >= height) return;
+    if (x0 >= width) return;
 
-        dx >>= 1;
-        DSTPtr = (uint32_t *)(m_vram16 + (GPU_WIDTH * y0) + x0);
-        LineOffset = 512 - dx;
+    if (y1 > height) y1 = height;
+    if (x1 > width) x1 = width;
 
-        for (i = 0; i < dy; i++) {
-            for (j = 0; j < dx; j++) *DSTPtr++ = lcol;
-            DSTPtr += LineOffset;
-        }
-    }
+    uint16_t *dest = m_target16 + (width * y0) + x0;
+    for (int i = y0; i < y1; i++, dest += width) VRAMBlit::fillSpan(dest, x1 - x0, col);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -2429,8 +2340,12 @@ bool PCSX::SoftGPU::SoftRenderer::setupSectionsShadeTextured4(int16_t x1, int16_
 // POLY 3/4 FLAT SHADED
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                               int32_t rgb) {
+    // Opaque primitives, which have loops of their own.
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+
     int i, j, xmin, xmax, ymin, ymax;
     uint16_t color;
     uint32_t lcolor;
@@ -2444,8 +2359,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2
     if (y1 > drawH && y2 > drawH && y3 > drawH) return;
     if (x1 < drawX && x2 < drawX && x3 < drawX) return;
     if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     if (!setupSectionsFlat3(x1, y1, x2, y2, x3, y3)) return;
 
@@ -2459,9 +2374,10 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2
     }
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
 
-    if (!m_checkMask && !m_drawSemiTrans) {
+    if constexpr (solid) {
         color |= m_setMask16;
         for (i = ymin; i <= ymax; i++) {
             xmin = m_leftX >> 16;
@@ -2470,9 +2386,9 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2
             if (drawW < xmax) xmax = drawW;
 
             for (j = xmin; j < xmax; j += 2) {
-                *((uint32_t *)&vram16[(i << 10) + j]) = lcolor;
+                *((uint32_t *)&target[(i << shift) + j]) = lcolor;
             }
-            if (j == xmax) vram16[(i << 10) + j] = color;
+            if (j == xmax) target[(i << shift) + j] = color;
 
             if (nextRowFlat3()) return;
         }
@@ -2485,10 +2401,14 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2
         xmax = (m_rightX >> 16) - 1;
         if (drawW < xmax) xmax = drawW;
 
-        for (j = xmin; j < xmax; j += 2) {
-            getShadeTransCol32((uint32_t *)&vram16[(i << 10) + j], lcolor);
+        if (m_vectorSpans) {
+            spanFlat(&target[(i << shift) + xmin], xmax - xmin + 1, color);
+        } else {
+            for (j = xmin; j < xmax; j += 2) {
+                getShadeTransCol32<blend, abr, checkMask>((uint32_t *)&target[(i << shift) + j], lcolor);
+            }
+            if (j == xmax) getShadeTransCol<blend, abr, checkMask>(&target[(i << shift) + j], color);
         }
-        if (j == xmax) getShadeTransCol(&vram16[(i << 10) + j], color);
 
         if (nextRowFlat3()) return;
     }
@@ -2496,988 +2416,151 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2
 
 ////////////////////////////////////////////////////////////////////////
 
-void PCSX::SoftGPU::SoftRenderer::drawPolyFlat3(int32_t rgb) { drawPoly3Fi(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb); }
+static constexpr auto s_flatVariants = makeVariants<VARIANTS>([]<unsigned index>() {
+    using V = Variant<index>;
+    return &PCSX::SoftGPU::SoftRenderer::drawPoly3Fi<V::blend, V::abr, V::checkMask>;
+});
+
+void PCSX::SoftGPU::SoftRenderer::drawPolyFlat3(int32_t rgb) {
+    (this->*s_flatVariants[variantIndex(*this)])(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb);
+}
 
 void PCSX::SoftGPU::SoftRenderer::drawPolyFlat4(int32_t rgb) {
-    drawPoly3Fi(m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, rgb);
-    drawPoly3Fi(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb);
+    const auto draw = s_flatVariants[variantIndex(*this)];
+    (this->*draw)(m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, rgb);
+    (this->*draw)(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
-void PCSX::SoftGPU::SoftRenderer::drawPoly3TEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                                int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
-                                                int16_t ty3, int16_t clX, int16_t clY) {
-    int i, j, xmin, xmax, ymin, ymax;
+template <PCSX::GPU::Shape shape, PCSX::GPU::TexDepth depth, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr,
+          bool checkMask>
+void PCSX::SoftGPU::SoftRenderer::drawPolyTextured(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
+                                                   int16_t y3, int16_t x4, int16_t y4, int16_t tx1, int16_t ty1,
+                                                   int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
+                                                   int16_t ty4, int16_t clX, int16_t clY) {
+    constexpr bool quad = shape == GPU::Shape::Quad;
+    // Opaque primitives, which used to have loops of their own, with a couple of quirks kept below.
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+
+    int32_t num;
+    int32_t i, j, xmin, xmax, ymin, ymax;
     int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY, YAdjust, XAdjust;
-    int32_t clutP;
-    int16_t tC1, tC2;
+    int32_t posX, posY, YAdjust = 0, clutP = 0;
 
     const auto drawX = m_drawX;
     const auto drawY = m_drawY;
-    const auto drawW = m_drawW;
     const auto drawH = m_drawH;
+    const auto drawW = m_drawW;
 
-    if (x1 > drawW && x2 > drawW && x3 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
+    if constexpr (quad) {
+        if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
+        if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
+        if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
+        if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
+    } else {
+        if (x1 > drawW && x2 > drawW && x3 > drawW) return;
+        if (y1 > drawH && y2 > drawH && y3 > drawH) return;
+        if (x1 < drawX && x2 < drawX && x3 < drawX) return;
+        if (y1 < drawY && y2 < drawY && y3 < drawY) return;
+    }
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
+
+    if constexpr (quad) {
+        if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
+    } else {
+        if (!setupSectionsFlatTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3)) return;
+    }
 
-    if (!setupSectionsFlatTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3)) return;
+    auto nextRow = [this]() {
+        if constexpr (quad) {
+            return nextRowFlatTextured4();
+        } else {
+            return nextRowFlatTextured3();
+        }
+    };
 
     ymax = m_yMax;
 
     for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured3()) return;
+        if (nextRow()) return;
     }
 
-    clutP = (clY << 10) + clX;
-
-    YAdjust = ((m_globalTextAddrY) << 11) + (m_globalTextAddrX << 1);
-    YAdjust += (m_textureWindow.y0 << 11) + (m_textureWindow.x0 >> 1);
-
-    difX = m_deltaRightU;
-    difX2 = difX << 1;
-    difY = m_deltaRightV;
-    difY2 = difY << 1;
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);  //-1; //!!!!!!!!!!!!!!!!
-            if (xmax > xmin) xmax--;
-
-            if (drawW < xmax) xmax = drawW;
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-
-                for (j = xmin; j < xmax; j += 2) {
-                    XAdjust = (posX >> 16) & maskX;
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    XAdjust = ((posX + difX) >> 16) & maskX;
-                    tC2 =
-                        vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
-
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                    getTextureTransColShade32Solid(pdest, color);
-
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    XAdjust = (posX >> 16) & maskX;
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    getTextureTransColShadeSolid(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-                }
-            }
-            if (nextRowFlatTextured3()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16) - 1;  //!!!!!!!!!!!!!!!!!!
-        if (drawW < xmax) xmax = drawW;
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-
-            for (j = xmin; j < xmax; j += 2) {
-                XAdjust = (posX >> 16) & maskX;
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                XAdjust = ((posX + difX) >> 16) & maskX;
-                tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
-
-                uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                getTextureTransColShade32(pdest, color);
-
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                XAdjust = (posX >> 16) & maskX;
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                getTextureTransColShade(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-            }
-        }
-        if (nextRowFlatTextured3()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly4TEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                                int16_t x4, int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2,
-                                                int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
-                                                int16_t clX, int16_t clY) {
-    int32_t num;
-    int32_t i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY, YAdjust, clutP, XAdjust;
-    int16_t tC1, tC2;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured4()) return;
-    }
-
-    clutP = (clY << 10) + clX;
-
-    YAdjust = ((m_globalTextAddrY) << 11) + (m_globalTextAddrX << 1);
-    YAdjust += (m_textureWindow.y0 << 11) + (m_textureWindow.x0 >> 1);
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                num = (xmax - xmin);
-                if (num == 0) num = 1;
-                difX = (m_rightU - posX) / num;
-                difY = (m_rightV - posY) / num;
-                difX2 = difX << 1;
-                difY2 = difY << 1;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-                xmax--;
-                if (drawW < xmax) xmax = drawW;
-
-                for (j = xmin; j < xmax; j += 2) {
-                    XAdjust = (posX >> 16) & maskX;
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    XAdjust = ((posX + difX) >> 16) & maskX;
-                    tC2 =
-                        vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
-
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                    getTextureTransColShade32Solid(pdest, color);
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    XAdjust = (posX >> 16) & maskX;
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    getTextureTransColShadeSolid(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-                }
-            }
-            if (nextRowFlatTextured4()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16);
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            num = (xmax - xmin);
-            if (num == 0) num = 1;
-            difX = (m_rightU - posX) / num;
-            difY = (m_rightV - posY) / num;
-            difX2 = difX << 1;
-            difY2 = difY << 1;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-            xmax--;
-            if (drawW < xmax) xmax = drawW;
-
-            for (j = xmin; j < xmax; j += 2) {
-                XAdjust = (posX >> 16) & maskX;
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                XAdjust = ((posX + difX) >> 16) & maskX;
-                tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
-
-                uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                getTextureTransColShade32(pdest, color);
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                XAdjust = (posX >> 16) & maskX;
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                getTextureTransColShade(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-            }
-        }
-        if (nextRowFlatTextured4()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly4TEx4_S(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
-                                                  int16_t y3, int16_t x4, int16_t y4, int16_t tx1, int16_t ty1,
-                                                  int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                                                  int16_t ty4, int16_t clX, int16_t clY) {
-    int32_t num;
-    int32_t i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY, YAdjust, clutP, XAdjust;
-    int16_t tC1, tC2;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured4()) return;
-    }
-
-    clutP = (clY << 10) + clX;
-
-    YAdjust = ((m_globalTextAddrY) << 11) + (m_globalTextAddrX << 1);
-    YAdjust += (m_textureWindow.y0 << 11) + (m_textureWindow.x0 >> 1);
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                num = (xmax - xmin);
-                if (num == 0) num = 1;
-                difX = (m_rightU - posX) / num;
-                difY = (m_rightV - posY) / num;
-                difX2 = difX << 1;
-                difY2 = difY << 1;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-                xmax--;
-                if (drawW < xmax) xmax = drawW;
-
-                for (j = xmin; j < xmax; j += 2) {
-                    XAdjust = (posX >> 16) & maskX;
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    XAdjust = ((posX + difX) >> 16) & maskX;
-                    tC2 =
-                        vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
-
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                    getTextureTransColShade32Solid(pdest, color);
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    XAdjust = (posX >> 16) & maskX;
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                    tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    getTextureTransColShadeSolid(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-                }
-            }
-            if (nextRowFlatTextured4()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16);
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            num = (xmax - xmin);
-            if (num == 0) num = 1;
-            difX = (m_rightU - posX) / num;
-            difY = (m_rightV - posY) / num;
-            difX2 = difX << 1;
-            difY2 = difY << 1;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-            xmax--;
-            if (drawW < xmax) xmax = drawW;
-
-            for (j = xmin; j < xmax; j += 2) {
-                XAdjust = (posX >> 16) & maskX;
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                XAdjust = ((posX + difX) >> 16) & maskX;
-                tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
-
-                uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                getTextureTransColG32Semi(pdest, color);
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                XAdjust = (posX >> 16) & maskX;
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
-                tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                getTextureTransColShadeSemi(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-            }
-        }
-        if (nextRowFlatTextured4()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly3TEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                                int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
-                                                int16_t ty3, int16_t clX, int16_t clY) {
-    int i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY, YAdjust, clutP;
-    int16_t tC1, tC2;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured3()) return;
-    }
-
-    clutP = (clY << 10) + clX;
-
-    YAdjust = ((m_globalTextAddrY) << 11) + (m_globalTextAddrX << 1);
-    YAdjust += (m_textureWindow.y0 << 11) + (m_textureWindow.x0);
-
-    difX = m_deltaRightU;
-    difX2 = difX << 1;
-    difY = m_deltaRightV;
-    difY2 = difY << 1;
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);  //-1; //!!!!!!!!!!!!!!!!
-            if (xmax > xmin) xmax--;
-
-            if (drawW < xmax) xmax = drawW;
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-
-                for (j = xmin; j < xmax; j += 2) {
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                    tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                    (((posX + difX) >> 16) & maskX))];
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                    getTextureTransColShade32Solid(pdest, color);
-                    posX += difX2;
-                    posY += difY2;
-                }
-
-                if (j == xmax) {
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                    getTextureTransColShadeSolid(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-                }
-            }
-            if (nextRowFlatTextured3()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16) - 1;  //!!!!!!!!!!!!!!!!!
-        if (drawW < xmax) xmax = drawW;
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-
-            for (j = xmin; j < xmax; j += 2) {
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                (((posX + difX) >> 16) & maskX))];
-                uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                getTextureTransColShade32(pdest, color);
-                posX += difX2;
-                posY += difY2;
-            }
-
-            if (j == xmax) {
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                getTextureTransColShade(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-            }
-        }
-        if (nextRowFlatTextured3()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly4TEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                                int16_t x4, int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2,
-                                                int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
-                                                int16_t clX, int16_t clY) {
-    int32_t num;
-    int32_t i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY, YAdjust, clutP;
-    int16_t tC1, tC2;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured4()) return;
-    }
-
-    clutP = (clY << 10) + clX;
-
-    YAdjust = ((m_globalTextAddrY) << 11) + (m_globalTextAddrX << 1);
-    YAdjust += (m_textureWindow.y0 << 11) + (m_textureWindow.x0);
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                num = (xmax - xmin);
-                if (num == 0) num = 1;
-                difX = (m_rightU - posX) / num;
-                difY = (m_rightV - posY) / num;
-                difX2 = difX << 1;
-                difY2 = difY << 1;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-                xmax--;
-                if (drawW < xmax) xmax = drawW;
-
-                for (j = xmin; j < xmax; j += 2) {
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                    tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                    (((posX + difX) >> 16) & maskX))];
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                    getTextureTransColShade32Solid(pdest, color);
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    tC1 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                    ((posX >> 16) & maskX))];
-                    getTextureTransColShadeSolid(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-                }
-            }
-            if (nextRowFlatTextured4()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16);
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            num = (xmax - xmin);
-            if (num == 0) num = 1;
-            difX = (m_rightU - posX) / num;
-            difY = (m_rightV - posY) / num;
-            difX2 = difX << 1;
-            difY2 = difY << 1;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-            xmax--;
-            if (drawW < xmax) xmax = drawW;
-
-            for (j = xmin; j < xmax; j += 2) {
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                (((posX + difX) >> 16) & maskX))];
-                uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                getTextureTransColShade32(pdest, color);
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                tC1 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                ((posX >> 16) & maskX))];
-                getTextureTransColShade(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-            }
-        }
-        if (nextRowFlatTextured4()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly4TEx8_S(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
-                                                  int16_t y3, int16_t x4, int16_t y4, int16_t tx1, int16_t ty1,
-                                                  int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                                                  int16_t ty4, int16_t clX, int16_t clY) {
-    int32_t num;
-    int32_t i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY, YAdjust, clutP;
-    int16_t tC1, tC2;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured4()) return;
-    }
-
-    clutP = (clY << 10) + clX;
-
-    YAdjust = ((m_globalTextAddrY) << 11) + (m_globalTextAddrX << 1);
-    YAdjust += (m_textureWindow.y0 << 11) + (m_textureWindow.x0);
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                num = (xmax - xmin);
-                if (num == 0) num = 1;
-                difX = (m_rightU - posX) / num;
-                difY = (m_rightV - posY) / num;
-                difX2 = difX << 1;
-                difY2 = difY << 1;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-                xmax--;
-                if (drawW < xmax) xmax = drawW;
-
-                for (j = xmin; j < xmax; j += 2) {
-                    tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                    tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                    (((posX + difX) >> 16) & maskX))];
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                    getTextureTransColShade32Solid(pdest, color);
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    tC1 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                    ((posX >> 16) & maskX))];
-                    getTextureTransColShadeSolid(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-                }
-            }
-            if (nextRowFlatTextured4()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16);
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            num = (xmax - xmin);
-            if (num == 0) num = 1;
-            difX = (m_rightU - posX) / num;
-            difY = (m_rightV - posY) / num;
-            difX2 = difX << 1;
-            difY2 = difY << 1;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-            xmax--;
-            if (drawW < xmax) xmax = drawW;
-
-            for (j = xmin; j < xmax; j += 2) {
-                tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                tC2 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                (((posX + difX) >> 16) & maskX))];
-                uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                uint32_t color = vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16;
-                getTextureTransColG32Semi(pdest, color);
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                tC1 = vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust +
-                                                ((posX >> 16) & maskX))];
-                getTextureTransColShadeSemi(&vram16[(i << 10) + j], vram16[clutP + tC1]);
-            }
-        }
-        if (nextRowFlatTextured4()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-// POLY 3 F-SHADED TEX 15 BIT
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly3TD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                              int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
-                                              int16_t ty3) {
-    int i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured3()) return;
-    }
-
-    difX = m_deltaRightU;
-    difX2 = difX << 1;
-    difY = m_deltaRightV;
-    difY2 = difY << 1;
+    if constexpr (depth != GPU::TexDepth::Tex16Bits) {
+        clutP = (clY << 10) + clX;
+        YAdjust = textureOffset();
+    }
 
     const auto vram = m_vram;
     const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
+    const auto decoded = m_decodedTexture;
     const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-    const auto globalTextAddrX = m_globalTextAddrX;
-    const auto globalTextAddrY = m_globalTextAddrY;
-    const auto textureWindow = m_textureWindow;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16) - 1;  //!!!!!!!!!!!!!
-            if (drawW < xmax) xmax = drawW;
-
-            if (xmax >= xmin) {
-                posX = m_leftU;
-                posY = m_leftV;
-
-                if (xmin < drawX) {
-                    j = drawX - xmin;
-                    xmin = drawX;
-                    posX += j * difX;
-                    posY += j * difY;
-                }
-
-                for (j = xmin; j < xmax; j += 2) {
-                    uint32_t *pdest = (uint32_t *)&vram16[(i << 10) + j];
-                    auto upX = (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0;
-                    auto upY = (((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0;
-                    auto dnX = ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0;
-                    auto dnY = ((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0;
-                    uint32_t color = vram16[upX + (upY << 10)];
-                    color <<= 16;
-                    color |= vram16[dnX + (dnY << 10)];
-                    getTextureTransColShade32Solid(pdest, color);
-
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    uint16_t *pdest = &vram16[(i << 10) + j];
-                    auto x = ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0;
-                    auto y = ((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0;
-                    uint16_t color = vram16[x + (y << 10)];
-                    getTextureTransColShadeSolid(pdest, color);
-                }
-            }
-            if (nextRowFlatTextured3()) return;
+    const auto maskY = m_textureWindow.y1 - 1;
+    const auto baseX = m_globalTextAddrX + m_textureWindow.x0;
+    const auto baseY = m_globalTextAddrY + m_textureWindow.y0;
+
+    auto texel = [&](int32_t u, int32_t v) -> uint16_t {
+        const int32_t x = (u >> 16) & maskX;
+        const int32_t y = (v >> 16) & maskY;
+        if constexpr (depth != GPU::TexDepth::Tex16Bits) {
+            if (decoded) return decoded[(y << 8) + x];
         }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16) - 1;  //!!!!!!!!!!!!!!
-        if (drawW < xmax) xmax = drawW;
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
+        if constexpr (depth == GPU::TexDepth::Tex4Bits) {
+            const int16_t tC = vram[(y << 11) + YAdjust + (x >> 1)];
+            return vram16[clutP + ((tC >> ((x & 1) << 2)) & 0xf)];
+        } else if constexpr (depth == GPU::TexDepth::Tex8Bits) {
+            return vram16[clutP + vram[(y << 11) + YAdjust + x]];
+        } else {
+            return vram16[((y + baseY) << 10) + x + baseX];
+        }
+    };
 
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
+    // Opaque 15 bits quads offset the first pixel of each pair by the texture window's top edge
+    // horizontally rather than vertically, which the span kernels can't do.
+    constexpr bool quirkyPairs = quad && solid && (depth == GPU::TexDepth::Tex16Bits);
 
+    auto drawRow = [&]() {
+        if (m_vectorSpans && !quirkyPairs) {
+            j = spanTexture<depth>(i, xmin, xmax, posX, posY, difX, difY, YAdjust, clutP);
+        } else {
             for (j = xmin; j < xmax; j += 2) {
-                getTextureTransColShade32(
-                    (uint32_t *)&vram16[(i << 10) + j],
-                    (((int32_t)vram16[(((((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                      (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0])
-                     << 16) |
-                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                               (((posX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
+                uint32_t color = texel(posX + difX, posY + difY);
+                color <<= 16;
+                if constexpr (quirkyPairs) {
+                    color |= vram16[((((posY >> 16) & maskY) + m_globalTextAddrY) << 10) + m_textureWindow.y0 +
+                                    ((posX >> 16) & maskX) + baseX];
+                } else {
+                    color |= texel(posX, posY);
+                }
+                getTextureTransColShade32<blend, abr, checkMask>((uint32_t *)&target[(i << shift) + j], color);
 
                 posX += difX2;
                 posY += difY2;
             }
-            if (j == xmax) {
-                getTextureTransColShade(&vram16[(i << 10) + j],
-                                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                               ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-            }
         }
-        if (nextRowFlatTextured3()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly4TD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                              int16_t x4, int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2,
-                                              int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4) {
-    int32_t num;
-    int32_t i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
-
-    ymax = m_yMax;
+        if (j == xmax) {
+            // 8 bits quads sample the odd pixel at the end of a row with the V coordinate of the pixel after it.
+            const auto color = (quad && (depth == GPU::TexDepth::Tex8Bits)) ? texel(posX, posY + difY)
+                                                                              : texel(posX, posY);
+            getTextureTransColShade<blend, abr, checkMask>(&target[(i << shift) + j], color);
+        }
+    };
 
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured4()) return;
+    if constexpr (!quad) {
+        difX = m_deltaRightU;
+        difX2 = difX << 1;
+        difY = m_deltaRightV;
+        difY2 = difY << 1;
     }
 
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-    const auto globalTextAddrX = m_globalTextAddrX;
-    const auto globalTextAddrY = m_globalTextAddrY;
-    const auto textureWindow = m_textureWindow;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);
+    for (i = ymin; i <= ymax; i++) {
+        xmin = (m_leftX >> 16);
+        xmax = (m_rightX >> 16);
 
+        if constexpr (quad) {
             if (xmax >= xmin) {
                 posX = m_leftU;
                 posY = m_leftV;
@@ -3498,219 +2581,71 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly4TD(int16_t x1, int16_t y1, int16_t x2
                 xmax--;
                 if (drawW < xmax) xmax = drawW;
 
-                for (j = xmin; j < xmax; j += 2) {
-                    getTextureTransColShade32Solid(
-                        (uint32_t *)&vram16[(i << 10) + j],
-                        (((int32_t)
-                              vram16[(((((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                     (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0])
-                         << 16) |
-                            vram16[((((posY >> 16) & maskY) + globalTextAddrY) << 10) + textureWindow.y0 +
-                                   ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    getTextureTransColShadeSolid(
-                        &vram16[(i << 10) + j],
-                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                               ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-                }
+                drawRow();
             }
-            if (nextRowFlatTextured4()) return;
-        }
-        return;
-    }
-
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16);
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            num = (xmax - xmin);
-            if (num == 0) num = 1;
-            difX = (m_rightU - posX) / num;
-            difY = (m_rightV - posY) / num;
-            difX2 = difX << 1;
-            difY2 = difY << 1;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
+        } else {
+            // Opaque paletted triangles keep the rightmost pixel of single pixel rows.
+            if (solid && (depth != GPU::TexDepth::Tex16Bits)) {
+                if (xmax > xmin) xmax--;
+            } else {
+                xmax--;
             }
-            xmax--;
             if (drawW < xmax) xmax = drawW;
 
-            for (j = xmin; j < xmax; j += 2) {
-                getTextureTransColShade32(
-                    (uint32_t *)&vram16[(i << 10) + j],
-                    (((int32_t)vram16[(((((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                      (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0])
-                     << 16) |
-                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                               ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                getTextureTransColShade(&vram16[(i << 10) + j],
-                                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                               ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-            }
-        }
-        if (nextRowFlatTextured4()) return;
-    }
-}
-
-////////////////////////////////////////////////////////////////////////
-
-void PCSX::SoftGPU::SoftRenderer::drawPoly4TD_S(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
-                                                int16_t x4, int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2,
-                                                int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4) {
-    int32_t num;
-    int32_t i, j, xmin, xmax, ymin, ymax;
-    int32_t difX, difY, difX2, difY2;
-    int32_t posX, posY;
-
-    const auto drawX = m_drawX;
-    const auto drawY = m_drawY;
-    const auto drawH = m_drawH;
-    const auto drawW = m_drawW;
-
-    if (x1 > drawW && x2 > drawW && x3 > drawW && x4 > drawW) return;
-    if (y1 > drawH && y2 > drawH && y3 > drawH && y4 > drawH) return;
-    if (x1 < drawX && x2 < drawX && x3 < drawX && x4 < drawX) return;
-    if (y1 < drawY && y2 < drawY && y3 < drawY && y4 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
-
-    if (!setupSectionsFlatTextured4(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4)) return;
-
-    ymax = m_yMax;
-
-    for (ymin = m_yMin; ymin < drawY; ymin++) {
-        if (nextRowFlatTextured4()) return;
-    }
-
-    const auto vram = m_vram;
-    const auto vram16 = m_vram16;
-    const auto maskX = m_textureWindow.x1 - 1;
-    const auto maskY = m_textureWindow.y1 - 1;
-    const auto globalTextAddrX = m_globalTextAddrX;
-    const auto globalTextAddrY = m_globalTextAddrY;
-    const auto textureWindow = m_textureWindow;
-
-    if (!m_checkMask && !m_drawSemiTrans) {
-        for (i = ymin; i <= ymax; i++) {
-            xmin = (m_leftX >> 16);
-            xmax = (m_rightX >> 16);
-
             if (xmax >= xmin) {
                 posX = m_leftU;
                 posY = m_leftV;
 
-                num = (xmax - xmin);
-                if (num == 0) num = 1;
-                difX = (m_rightU - posX) / num;
-                difY = (m_rightV - posY) / num;
-                difX2 = difX << 1;
-                difY2 = difY << 1;
-
                 if (xmin < drawX) {
                     j = drawX - xmin;
                     xmin = drawX;
                     posX += j * difX;
                     posY += j * difY;
                 }
-                xmax--;
-                if (drawW < xmax) xmax = drawW;
-
-                for (j = xmin; j < xmax; j += 2) {
-                    getTextureTransColShade32Solid(
-                        (uint32_t *)&vram16[(i << 10) + j],
-                        (((int32_t)
-                              vram16[(((((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                     (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0])
-                         << 16) |
-                            vram16[((((posY >> 16) & maskY) + globalTextAddrY) << 10) + textureWindow.y0 +
-                                   ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
 
-                    posX += difX2;
-                    posY += difY2;
-                }
-                if (j == xmax) {
-                    getTextureTransColShadeSolid(
-                        &vram16[(i << 10) + j],
-                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                               ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-                }
+                drawRow();
             }
-            if (nextRowFlatTextured4()) return;
         }
-        return;
+        if (nextRow()) return;
     }
+}
 
-    for (i = ymin; i <= ymax; i++) {
-        xmin = (m_leftX >> 16);
-        xmax = (m_rightX >> 16);
-
-        if (xmax >= xmin) {
-            posX = m_leftU;
-            posY = m_leftV;
-
-            num = (xmax - xmin);
-            if (num == 0) num = 1;
-            difX = (m_rightU - posX) / num;
-            difY = (m_rightV - posY) / num;
-            difX2 = difX << 1;
-            difY2 = difY << 1;
-
-            if (xmin < drawX) {
-                j = drawX - xmin;
-                xmin = drawX;
-                posX += j * difX;
-                posY += j * difY;
-            }
-            xmax--;
-            if (drawW < xmax) xmax = drawW;
-
-            for (j = xmin; j < xmax; j += 2) {
-                getTextureTransColG32Semi(
-                    (uint32_t *)&vram16[(i << 10) + j],
-                    (((int32_t)vram16[(((((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                                      (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0])
-                     << 16) |
-                        vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                               ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
+// One table per shape, of the variants for each texture depth and pixel pipeline state.
+template <PCSX::GPU::Shape shape>
+static constexpr auto s_texturedVariants = makeVariants<3 * VARIANTS>([]<unsigned index>() {
+    using V = Variant<index % VARIANTS>;
+    constexpr auto depth = static_cast<PCSX::GPU::TexDepth>(index / VARIANTS);
+    return &PCSX::SoftGPU::SoftRenderer::drawPolyTextured<shape, depth, V::blend, V::abr, V::checkMask>;
+});
+
+void PCSX::SoftGPU::SoftRenderer::drawPolyTextured3(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
+                                                    int16_t y3, int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2,
+                                                    int16_t tx3, int16_t ty3, int16_t clX, int16_t clY) {
+    scaleCoords(x1, y1, x2, y2, x3, y3);
+    const auto draw = s_texturedVariants<GPU::Shape::Tri>[static_cast<unsigned>(m_globalTextTP) * VARIANTS +
+                                                          variantIndex(*this)];
+    (this->*draw)(x1, y1, x2, y2, x3, y3, 0, 0, tx1, ty1, tx2, ty2, tx3, ty3, 0, 0, clX, clY);
+}
 
-                posX += difX2;
-                posY += difY2;
-            }
-            if (j == xmax) {
-                getTextureTransColShadeSemi(
-                    &vram16[(i << 10) + j],
-                    vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
-                           ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0]);
-            }
-        }
-        if (nextRowFlatTextured4()) return;
-    }
+void PCSX::SoftGPU::SoftRenderer::drawPolyTextured4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
+                                                    int16_t y3, int16_t x4, int16_t y4, int16_t tx1, int16_t ty1,
+                                                    int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
+                                                    int16_t ty4, int16_t clX, int16_t clY) {
+    scaleCoords(x1, y1, x2, y2, x3, y3, x4, y4);
+    const auto draw = s_texturedVariants<GPU::Shape::Quad>[static_cast<unsigned>(m_globalTextTP) * VARIANTS +
+                                                           variantIndex(*this)];
+    (this->*draw)(x1, y1, x2, y2, x3, y3, x4, y4, tx1, ty1, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY);
 }
 
 ////////////////////////////////////////////////////////////////////////
 // POLY 3/4 G-SHADED
 ////////////////////////////////////////////////////////////////////////
 
-template <bool useCachedDither>
+template <bool useCachedDither, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                               int32_t rgb1, int32_t rgb2, int32_t rgb3) {
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+
     int i, j, xmin, xmax, ymin, ymax;
     int32_t cR1, cG1, cB1;
     int32_t difR, difB, difG, difR2, difB2, difG2;
@@ -3724,8 +2659,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
     if (y1 > drawH && y2 > drawH && y3 > drawH) return;
     if (x1 < drawX && x2 < drawX && x3 < drawX) return;
     if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     if (!setupSectionsShade3(x1, y1, x2, y2, x3, y3, rgb1, rgb2, rgb3)) return;
 
@@ -3743,7 +2678,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
     difB2 = difB << 1;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -3752,7 +2688,33 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
     const auto setMask16 = m_setMask16;
     const auto setMask32 = m_setMask32;
 
-    if (!m_checkMask && !m_drawSemiTrans && !m_ditherMode) {
+    if (m_vectorSpans) {
+        for (i = ymin; i <= ymax; i++) {
+            xmin = (m_leftX >> 16);
+            xmax = (m_rightX >> 16) - 1;
+            if (drawW < xmax) xmax = drawW;
+
+            if (xmax >= xmin) {
+                cR1 = m_leftR;
+                cG1 = m_leftG;
+                cB1 = m_leftB;
+
+                if (xmin < drawX) {
+                    j = drawX - xmin;
+                    xmin = drawX;
+                    cR1 += j * difR;
+                    cG1 += j * difG;
+                    cB1 += j * difB;
+                }
+
+                spanShade(&target[(i << shift) + xmin], xmax - xmin + 1, cR1, cG1, cB1, difR, difG, difB);
+            }
+            if (nextRowShade3()) return;
+        }
+        return;
+    }
+
+    if (solid && !m_ditherMode) {
         for (i = ymin; i <= ymax; i++) {
             xmin = (m_leftX >> 16);
             xmax = (m_rightX >> 16) - 1;
@@ -3772,7 +2734,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
                 }
 
                 for (j = xmin; j < xmax; j += 2) {
-                    *((uint32_t *)&vram16[(i << 10) + j]) =
+                    *((uint32_t *)&target[(i << shift) + j]) =
                         ((((cR1 + difR) << 7) & 0x7c000000) | (((cG1 + difG) << 2) & 0x03e00000) |
                          (((cB1 + difB) >> 3) & 0x001f0000) | (((cR1) >> 9) & 0x7c00) | (((cG1) >> 14) & 0x03e0) |
                          (((cB1) >> 19) & 0x001f)) |
@@ -3783,7 +2745,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
                     cB1 += difB2;
                 }
                 if (j == xmax) {
-                    vram16[(i << 10) + j] =
+                    target[(i << shift) + j] =
                         (((cR1 >> 9) & 0x7c00) | ((cG1 >> 14) & 0x03e0) | ((cB1 >> 19) & 0x001f)) | setMask16;
                 }
             }
@@ -3812,8 +2774,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
                 }
 
                 for (j = xmin; j <= xmax; j++) {
-                    getShadeTransColDither<useCachedDither>(&vram16[(i << 10) + j], (cB1 >> 16), (cG1 >> 16),
-                                                            (cR1 >> 16));
+                    getShadeTransColDither<useCachedDither, blend, abr, checkMask>(
+                        &target[(i << shift) + j], (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
 
                     cR1 += difR;
                     cG1 += difG;
@@ -3842,8 +2804,9 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
                 }
 
                 for (j = xmin; j <= xmax; j++) {
-                    getShadeTransCol(&vram16[(i << 10) + j],
-                                     ((cR1 >> 9) & 0x7c00) | ((cG1 >> 14) & 0x03e0) | ((cB1 >> 19) & 0x001f));
+                    getShadeTransCol<blend, abr, checkMask>(
+                        &target[(i << shift) + j],
+                        ((cR1 >> 9) & 0x7c00) | ((cG1 >> 14) & 0x03e0) | ((cB1 >> 19) & 0x001f));
 
                     cR1 += difR;
                     cG1 += difG;
@@ -3857,33 +2820,33 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2
 
 ////////////////////////////////////////////////////////////////////////
 
+static constexpr auto s_shadeVariants = makeVariants<2 * VARIANTS>([]<unsigned index>() {
+    using V = DitherVariant<index>;
+    return &PCSX::SoftGPU::SoftRenderer::drawPoly3Gi<V::useCachedDither, V::blend, V::abr, V::checkMask>;
+});
+
 void PCSX::SoftGPU::SoftRenderer::drawPolyShade3(int32_t rgb1, int32_t rgb2, int32_t rgb3) {
-    if (s_ditherLUT) {
-        drawPoly3Gi<true>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
-    } else {
-        drawPoly3Gi<false>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
-    }
+    const auto draw = s_shadeVariants[ditherVariantIndex(*this)];
+    (this->*draw)(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
 }
 
 // draw two g-shaded tris for right psx shading emulation
 
 void PCSX::SoftGPU::SoftRenderer::drawPolyShade4(int32_t rgb1, int32_t rgb2, int32_t rgb3, int32_t rgb4) {
-    if (s_ditherLUT) {
-        drawPoly3Gi<true>(m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, rgb2, rgb4, rgb3);
-        drawPoly3Gi<true>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
-    } else {
-        drawPoly3Gi<false>(m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, rgb2, rgb4, rgb3);
-        drawPoly3Gi<false>(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
-    }
+    const auto draw = s_shadeVariants[ditherVariantIndex(*this)];
+    (this->*draw)(m_x1, m_y1, m_x3, m_y3, m_x2, m_y2, rgb2, rgb4, rgb3);
+    (this->*draw)(m_x0, m_y0, m_x1, m_y1, m_x2, m_y2, rgb1, rgb2, rgb3);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
-template <bool useCachedDither>
+template <bool useCachedDither, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
                                                   int16_t y3, int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2,
                                                   int16_t tx3, int16_t ty3, int16_t clX, int16_t clY, int32_t col1,
                                                   int32_t col2, int32_t col3) {
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+
     int i, j, xmin, xmax, ymin, ymax;
     int32_t cR1, cG1, cB1;
     int32_t difR, difB, difG, difR2, difB2, difG2;
@@ -3900,8 +2863,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
     if (y1 > drawH && y2 > drawH && y3 > drawH) return;
     if (x1 < drawX && x2 < drawX && x3 < drawX) return;
     if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     if (!setupSectionsShadeTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3)) return;
 
@@ -3930,6 +2893,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
 
     const auto vram = m_vram;
     const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -3939,7 +2904,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
     const auto setMask32 = m_setMask32;
     const auto ditherMode = m_ditherMode;
 
-    if (!m_checkMask && !m_drawSemiTrans && !ditherMode) {
+    if (solid && !ditherMode) {
         for (i = ymin; i <= ymax; i++) {
             xmin = ((m_leftX) >> 16);
             xmax = ((m_rightX) >> 16) - 1;  //!!!!!!!!!!!!!
@@ -3971,7 +2936,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
                         vram[static_cast<int32_t>(((((posY + difY) >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
                     tC2 = (tC2 >> ((XAdjust & 1) << 2)) & 0xf;
                     getTextureTransColShadeX32Solid(
-                        (uint32_t *)&vram16[(i << 10) + j], vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16,
+                        (uint32_t *)&target[(i << shift) + j],
+                        vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16,
                         (cB1 >> 16) | ((cB1 + difB) & 0xff0000), (cG1 >> 16) | ((cG1 + difG) & 0xff0000),
                         (cR1 >> 16) | ((cR1 + difR) & 0xff0000));
                     posX += difX2;
@@ -3984,8 +2950,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
                     XAdjust = (posX >> 16) & maskX;
                     tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
                     tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
-                    getTextureTransColShadeXSolid(&vram16[(i << 10) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16),
-                                                  (cR1 >> 16));
+                    getTextureTransColShadeXSolid(&target[(i << shift) + j], vram16[clutP + tC1], (cB1 >> 16),
+                                                  (cG1 >> 16), (cR1 >> 16));
                 }
             }
             if (nextRowShadeTextured3()) return;
@@ -4020,11 +2986,11 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
                 tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + (XAdjust >> 1))];
                 tC1 = (tC1 >> ((XAdjust & 1) << 2)) & 0xf;
                 if (ditherMode) {
-                    getTextureTransColShadeXDither<useCachedDither>(&vram16[(i << 10) + j], vram16[clutP + tC1],
-                                                                    (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
+                    getTextureTransColShadeXDither<useCachedDither, blend, abr, checkMask>(
+                        &target[(i << shift) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
                 } else {
-                    getTextureTransColShadeX(&vram16[(i << 10) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16),
-                                             (cR1 >> 16));
+                    getTextureTransColShadeX<blend, abr, checkMask>(
+                        &target[(i << shift) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
                 }
                 posX += difX;
                 posY += difY;
@@ -4039,15 +3005,18 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_
 
 ////////////////////////////////////////////////////////////////////////
 
+static constexpr auto s_shadeTexturedEx4Variants = makeVariants<2 * VARIANTS>([]<unsigned index>() {
+    using V = DitherVariant<index>;
+    return &PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4i<V::useCachedDither, V::blend, V::abr, V::checkMask>;
+});
+
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                                  int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                  int16_t ty3, int16_t clX, int16_t clY, int32_t col1, int32_t col2,
                                                  int32_t col3) {
-    if (s_ditherLUT) {
-        drawPoly3TGEx4i<true>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
-    } else {
-        drawPoly3TGEx4i<false>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
-    }
+    scaleCoords(x1, y1, x2, y2, x3, y3);
+    const auto draw = s_shadeTexturedEx4Variants[ditherVariantIndex(*this)];
+    (this->*draw)(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
 }
 
 void PCSX::SoftGPU::SoftRenderer::drawPoly4TGEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
@@ -4055,22 +3024,21 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly4TGEx4(int16_t x1, int16_t y1, int16_t
                                                  int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
                                                  int16_t clX, int16_t clY, int32_t col1, int32_t col2, int32_t col3,
                                                  int32_t col4) {
-    if (s_ditherLUT) {
-        drawPoly3TGEx4i<true>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
-        drawPoly3TGEx4i<true>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
-    } else {
-        drawPoly3TGEx4i<false>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
-        drawPoly3TGEx4i<false>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
-    }
+    scaleCoords(x1, y1, x2, y2, x3, y3, x4, y4);
+    const auto draw = s_shadeTexturedEx4Variants[ditherVariantIndex(*this)];
+    (this->*draw)(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
+    (this->*draw)(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
-template <bool useCachedDither>
+template <bool useCachedDither, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3,
                                                   int16_t y3, int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2,
                                                   int16_t tx3, int16_t ty3, int16_t clX, int16_t clY, int32_t col1,
                                                   int32_t col2, int32_t col3) {
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+
     int i, j, xmin, xmax, ymin, ymax;
     int32_t cR1, cG1, cB1;
     int32_t difR, difB, difG, difR2, difB2, difG2;
@@ -4087,8 +3055,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
     if (y1 > drawH && y2 > drawH && y3 > drawH) return;
     if (x1 < drawX && x2 < drawX && x3 < drawX) return;
     if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     if (!setupSectionsShadeTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3)) return;
 
@@ -4116,6 +3084,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
 
     const auto vram = m_vram;
     const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4125,7 +3095,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
     const auto setMask32 = m_setMask32;
     const auto ditherMode = m_ditherMode;
 
-    if (!m_checkMask && !m_drawSemiTrans && !m_ditherMode) {
+    if (solid && !ditherMode) {
         for (i = ymin; i <= ymax; i++) {
             xmin = (m_leftX >> 16);
             xmax = (m_rightX >> 16) - 1;  // !!!!!!!!!!!!!
@@ -4154,7 +3124,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
                                                     (((posX + difX) >> 16) & maskX))];
 
                     getTextureTransColShadeX32Solid(
-                        (uint32_t *)&vram16[(i << 10) + j], vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16,
+                        (uint32_t *)&target[(i << shift) + j],
+                        vram16[clutP + tC1] | ((int32_t)vram16[clutP + tC2]) << 16,
                         (cB1 >> 16) | ((cB1 + difB) & 0xff0000), (cG1 >> 16) | ((cG1 + difG) & 0xff0000),
                         (cR1 >> 16) | ((cR1 + difR) & 0xff0000));
                     posX += difX2;
@@ -4165,8 +3136,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
                 }
                 if (j == xmax) {
                     tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
-                    getTextureTransColShadeXSolid(&vram16[(i << 10) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16),
-                                                  (cR1 >> 16));
+                    getTextureTransColShadeXSolid(&target[(i << shift) + j], vram16[clutP + tC1], (cB1 >> 16),
+                                                  (cG1 >> 16), (cR1 >> 16));
                 }
             }
             if (nextRowShadeTextured3()) return;
@@ -4199,11 +3170,11 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
             for (j = xmin; j <= xmax; j++) {
                 tC1 = vram[static_cast<int32_t>((((posY >> 16) & maskY) << 11) + YAdjust + ((posX >> 16) & maskX))];
                 if (ditherMode) {
-                    getTextureTransColShadeXDither<useCachedDither>(&vram16[(i << 10) + j], vram16[clutP + tC1],
-                                                                    (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
+                    getTextureTransColShadeXDither<useCachedDither, blend, abr, checkMask>(
+                        &target[(i << shift) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
                 } else {
-                    getTextureTransColShadeX(&vram16[(i << 10) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16),
-                                             (cR1 >> 16));
+                    getTextureTransColShadeX<blend, abr, checkMask>(
+                        &target[(i << shift) + j], vram16[clutP + tC1], (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
                 }
                 posX += difX;
                 posY += difY;
@@ -4218,15 +3189,18 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_
 
 ////////////////////////////////////////////////////////////////////////
 
+static constexpr auto s_shadeTexturedEx8Variants = makeVariants<2 * VARIANTS>([]<unsigned index>() {
+    using V = DitherVariant<index>;
+    return &PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8i<V::useCachedDither, V::blend, V::abr, V::checkMask>;
+});
+
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                                  int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                  int16_t ty3, int16_t clX, int16_t clY, int32_t col1, int32_t col2,
                                                  int32_t col3) {
-    if (s_ditherLUT) {
-        drawPoly3TGEx8i<true>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
-    } else {
-        drawPoly3TGEx8i<false>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
-    }
+    scaleCoords(x1, y1, x2, y2, x3, y3);
+    const auto draw = s_shadeTexturedEx8Variants[ditherVariantIndex(*this)];
+    (this->*draw)(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, clX, clY, col1, col2, col3);
 }
 
 void PCSX::SoftGPU::SoftRenderer::drawPoly4TGEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
@@ -4234,21 +3208,20 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly4TGEx8(int16_t x1, int16_t y1, int16_t
                                                  int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
                                                  int16_t clX, int16_t clY, int32_t col1, int32_t col2, int32_t col3,
                                                  int32_t col4) {
-    if (s_ditherLUT) {
-        drawPoly3TGEx8i<true>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
-        drawPoly3TGEx8i<true>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
-    } else {
-        drawPoly3TGEx8i<false>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
-        drawPoly3TGEx8i<false>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
-    }
+    scaleCoords(x1, y1, x2, y2, x3, y3, x4, y4);
+    const auto draw = s_shadeTexturedEx8Variants[ditherVariantIndex(*this)];
+    (this->*draw)(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, clX, clY, col2, col4, col3);
+    (this->*draw)(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, clX, clY, col1, col2, col3);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
-template <bool useCachedDither>
+template <bool useCachedDither, PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                                 int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                 int16_t ty3, int32_t col1, int32_t col2, int32_t col3) {
+    constexpr bool solid = (blend == GPU::Blend::Off) && !checkMask;
+
     int i, j, xmin, xmax, ymin, ymax;
     int32_t cR1, cG1, cB1;
     int32_t difR, difB, difG, difR2, difB2, difG2;
@@ -4264,8 +3237,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
     if (y1 > drawH && y2 > drawH && y3 > drawH) return;
     if (x1 < drawX && x2 < drawX && x3 < drawX) return;
     if (y1 < drawY && y2 < drawY && y3 < drawY) return;
-    if (drawY >= drawH) return;
-    if (drawX >= drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     if (!setupSectionsShadeTextured3(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3)) return;
 
@@ -4288,6 +3261,8 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
 
     const auto vram = m_vram;
     const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4297,7 +3272,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
     const auto setMask32 = m_setMask32;
     const auto ditherMode = m_ditherMode;
 
-    if (!m_checkMask && !m_drawSemiTrans && !m_ditherMode) {
+    if (solid && !ditherMode) {
         for (i = ymin; i <= ymax; i++) {
             xmin = (m_leftX >> 16);
             xmax = (m_rightX >> 16) - 1;  //!!!!!!!!!!!!!!!!!!!!
@@ -4322,7 +3297,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
 
                 for (j = xmin; j < xmax; j += 2) {
                     getTextureTransColShadeX32Solid(
-                        (uint32_t *)&vram16[(i << 10) + j],
+                        (uint32_t *)&target[(i << shift) + j],
                         (((int32_t)
                               vram16[(((((posY + difY) >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
                                      (((posX + difX) >> 16) & maskX) + globalTextAddrX + textureWindow.x0])
@@ -4339,7 +3314,7 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
                 }
                 if (j == xmax) {
                     getTextureTransColShadeXSolid(
-                        &vram16[(i << 10) + j],
+                        &target[(i << shift) + j],
                         vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
                                ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0],
                         (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
@@ -4374,14 +3349,14 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
 
             for (j = xmin; j <= xmax; j++) {
                 if (ditherMode) {
-                    getTextureTransColShadeXDither<useCachedDither>(
-                        &vram16[(i << 10) + j],
+                    getTextureTransColShadeXDither<useCachedDither, blend, abr, checkMask>(
+                        &target[(i << shift) + j],
                         vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
                                ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0],
                         (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
                 } else {
-                    getTextureTransColShadeX(
-                        &vram16[(i << 10) + j],
+                    getTextureTransColShadeX<blend, abr, checkMask>(
+                        &target[(i << shift) + j],
                         vram16[((((posY >> 16) & maskY) + globalTextAddrY + textureWindow.y0) << 10) +
                                ((posX >> 16) & maskX) + globalTextAddrX + textureWindow.x0],
                         (cB1 >> 16), (cG1 >> 16), (cR1 >> 16));
@@ -4399,31 +3374,32 @@ void PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi(int16_t x1, int16_t y1, int16_t
 
 ////////////////////////////////////////////////////////////////////////
 
+static constexpr auto s_shadeTexturedDirectVariants = makeVariants<2 * VARIANTS>([]<unsigned index>() {
+    using V = DitherVariant<index>;
+    return &PCSX::SoftGPU::SoftRenderer::drawPoly3TGDi<V::useCachedDither, V::blend, V::abr, V::checkMask>;
+});
+
 void PCSX::SoftGPU::SoftRenderer::drawPoly3TGD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                                int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3,
                                                int16_t ty3, int32_t col1, int32_t col2, int32_t col3) {
-    if (s_ditherLUT) {
-        drawPoly3TGDi<true>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3);
-    } else {
-        drawPoly3TGDi<false>(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3);
-    }
+    scaleCoords(x1, y1, x2, y2, x3, y3);
+    const auto draw = s_shadeTexturedDirectVariants[ditherVariantIndex(*this)];
+    (this->*draw)(x1, y1, x2, y2, x3, y3, tx1, ty1, tx2, ty2, tx3, ty3, col1, col2, col3);
 }
 
 void PCSX::SoftGPU::SoftRenderer::drawPoly4TGD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3,
                                                int16_t x4, int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2,
                                                int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4, int16_t ty4,
                                                int32_t col1, int32_t col2, int32_t col3, int32_t col4) {
-    if (s_ditherLUT) {
-        drawPoly3TGDi<true>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, col2, col4, col3);
-        drawPoly3TGDi<true>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, col1, col2, col3);
-    } else {
-        drawPoly3TGDi<false>(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, col2, col4, col3);
-        drawPoly3TGDi<false>(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, col1, col2, col3);
-    }
+    scaleCoords(x1, y1, x2, y2, x3, y3, x4, y4);
+    const auto draw = s_shadeTexturedDirectVariants[ditherVariantIndex(*this)];
+    (this->*draw)(x2, y2, x3, y3, x4, y4, tx2, ty2, tx3, ty3, tx4, ty4, col2, col4, col3);
+    (this->*draw)(x1, y1, x2, y2, x4, y4, tx1, ty1, tx2, ty2, tx4, ty4, col1, col2, col3);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_E_SE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1) {
     int dx, dy, incrE, incrSE, d;
     uint32_t r0, g0, b0, r1, g1, b1;
@@ -4459,7 +3435,8 @@ void PCSX::SoftGPU::SoftRenderer::line_E_SE_Shade(int x0, int y0, int x1, int y1
     incrSE = 2 * (dy - dx); /* incr. used for move to SE */
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4470,8 +3447,9 @@ void PCSX::SoftGPU::SoftRenderer::line_E_SE_Shade(int x0, int y0, int x1, int y1
     const auto ditherMode = m_ditherMode;
 
     if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-        getShadeTransCol(&vram16[(y0 << 10) + x0],
-                         (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+        getShadeTransCol<blend, abr, checkMask>(
+            &target[(y0 << shift) + x0],
+            (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
     }
 
     while (x0 < x1) {
@@ -4488,14 +3466,16 @@ void PCSX::SoftGPU::SoftRenderer::line_E_SE_Shade(int x0, int y0, int x1, int y1
         b0 += db;
 
         if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-            getShadeTransCol(&vram16[(y0 << 10) + x0],
-                             (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+            getShadeTransCol<blend, abr, checkMask>(
+                &target[(y0 << shift) + x0],
+                (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_S_SE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1) {
     int dx, dy, incrS, incrSE, d;
     uint32_t r0, g0, b0, r1, g1, b1;
@@ -4531,7 +3511,8 @@ void PCSX::SoftGPU::SoftRenderer::line_S_SE_Shade(int x0, int y0, int x1, int y1
     incrSE = 2 * (dx - dy); /* incr. used for move to SE */
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4542,8 +3523,9 @@ void PCSX::SoftGPU::SoftRenderer::line_S_SE_Shade(int x0, int y0, int x1, int y1
     const auto ditherMode = m_ditherMode;
 
     if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-        getShadeTransCol(&vram16[(y0 << 10) + x0],
-                         (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+        getShadeTransCol<blend, abr, checkMask>(
+            &target[(y0 << shift) + x0],
+            (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
     }
 
     while (y0 < y1) {
@@ -4560,14 +3542,16 @@ void PCSX::SoftGPU::SoftRenderer::line_S_SE_Shade(int x0, int y0, int x1, int y1
         b0 += db;
 
         if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-            getShadeTransCol(&vram16[(y0 << 10) + x0],
-                             (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+            getShadeTransCol<blend, abr, checkMask>(
+                &target[(y0 << shift) + x0],
+                (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_N_NE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1) {
     int dx, dy, incrN, incrNE, d;
     uint32_t r0, g0, b0, r1, g1, b1;
@@ -4603,7 +3587,8 @@ void PCSX::SoftGPU::SoftRenderer::line_N_NE_Shade(int x0, int y0, int x1, int y1
     incrNE = 2 * (dx - dy); /* incr. used for move to NE */
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4614,8 +3599,9 @@ void PCSX::SoftGPU::SoftRenderer::line_N_NE_Shade(int x0, int y0, int x1, int y1
     const auto ditherMode = m_ditherMode;
 
     if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-        getShadeTransCol(&vram16[(y0 << 10) + x0],
-                         (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+        getShadeTransCol<blend, abr, checkMask>(
+            &target[(y0 << shift) + x0],
+            (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
     }
 
     while (y0 > y1) {
@@ -4632,14 +3618,16 @@ void PCSX::SoftGPU::SoftRenderer::line_N_NE_Shade(int x0, int y0, int x1, int y1
         b0 += db;
 
         if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-            getShadeTransCol(&vram16[(y0 << 10) + x0],
-                             (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+            getShadeTransCol<blend, abr, checkMask>(
+                &target[(y0 << shift) + x0],
+                (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_E_NE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1) {
     int dx, dy, incrE, incrNE, d;
     uint32_t r0, g0, b0, r1, g1, b1;
@@ -4675,7 +3663,8 @@ void PCSX::SoftGPU::SoftRenderer::line_E_NE_Shade(int x0, int y0, int x1, int y1
     incrNE = 2 * (dy - dx); /* incr. used for move to NE */
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4686,8 +3675,9 @@ void PCSX::SoftGPU::SoftRenderer::line_E_NE_Shade(int x0, int y0, int x1, int y1
     const auto ditherMode = m_ditherMode;
 
     if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-        getShadeTransCol(&vram16[(y0 << 10) + x0],
-                         (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+        getShadeTransCol<blend, abr, checkMask>(
+            &target[(y0 << shift) + x0],
+            (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
     }
 
     while (x0 < x1) {
@@ -4704,14 +3694,16 @@ void PCSX::SoftGPU::SoftRenderer::line_E_NE_Shade(int x0, int y0, int x1, int y1
         b0 += db;
 
         if ((x0 >= drawX) && (x0 < drawW) && (y0 >= drawY) && (y0 < drawH)) {
-            getShadeTransCol(&vram16[(y0 << 10) + x0],
-                             (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+            getShadeTransCol<blend, abr, checkMask>(
+                &target[(y0 << shift) + x0],
+                (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::vertLineShade(int x, int y0, int y1, uint32_t rgb0, uint32_t rgb1) {
     int y, dy;
     uint32_t r0, g0, b0, r1, g1, b1;
@@ -4751,7 +3743,8 @@ void PCSX::SoftGPU::SoftRenderer::vertLineShade(int x, int y0, int y1, uint32_t
     if (y1 > m_drawH) y1 = m_drawH;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4762,8 +3755,9 @@ void PCSX::SoftGPU::SoftRenderer::vertLineShade(int x, int y0, int y1, uint32_t
     const auto ditherMode = m_ditherMode;
 
     for (y = y0; y <= y1; y++) {
-        getShadeTransCol(&vram16[(y << 10) + x],
-                         (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+        getShadeTransCol<blend, abr, checkMask>(
+            &target[(y << shift) + x],
+            (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
         r0 += dr;
         g0 += dg;
         b0 += db;
@@ -4772,6 +3766,7 @@ void PCSX::SoftGPU::SoftRenderer::vertLineShade(int x, int y0, int y1, uint32_t
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::horzLineShade(int y, int x0, int x1, uint32_t rgb0, uint32_t rgb1) {
     int x, dx;
     uint32_t r0, g0, b0, r1, g1, b1;
@@ -4811,7 +3806,8 @@ void PCSX::SoftGPU::SoftRenderer::horzLineShade(int y, int x0, int x1, uint32_t
     if (x1 > m_drawW) x1 = m_drawW;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4822,8 +3818,9 @@ void PCSX::SoftGPU::SoftRenderer::horzLineShade(int y, int x0, int x1, uint32_t
     const auto ditherMode = m_ditherMode;
 
     for (x = x0; x <= x1; x++) {
-        getShadeTransCol(&vram16[(y << 10) + x],
-                         (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
+        getShadeTransCol<blend, abr, checkMask>(
+            &target[(y << shift) + x],
+            (uint16_t)(((r0 >> 9) & 0x7c00) | ((g0 >> 14) & 0x03e0) | ((b0 >> 19) & 0x001f)));
         r0 += dr;
         g0 += dg;
         b0 += db;
@@ -4832,6 +3829,7 @@ void PCSX::SoftGPU::SoftRenderer::horzLineShade(int y, int x0, int x1, uint32_t
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_E_SE_Flat(int x0, int y0, int x1, int y1, uint16_t color) {
     int dx, dy, incrE, incrSE, d, x, y;
 
@@ -4849,7 +3847,8 @@ void PCSX::SoftGPU::SoftRenderer::line_E_SE_Flat(int x0, int y0, int x1, int y1,
     y = y0;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4860,7 +3859,7 @@ void PCSX::SoftGPU::SoftRenderer::line_E_SE_Flat(int x0, int y0, int x1, int y1,
     const auto ditherMode = m_ditherMode;
 
     if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-        getShadeTransCol(&vram16[(y << 10) + x], color);
+        getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
     }
 
     while (x < x1) {
@@ -4873,13 +3872,14 @@ void PCSX::SoftGPU::SoftRenderer::line_E_SE_Flat(int x0, int y0, int x1, int y1,
             y++;
         }
         if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-            getShadeTransCol(&vram16[(y << 10) + x], color);
+            getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_S_SE_Flat(int x0, int y0, int x1, int y1, uint16_t color) {
     int dx, dy, incrS, incrSE, d, x, y;
 
@@ -4897,7 +3897,8 @@ void PCSX::SoftGPU::SoftRenderer::line_S_SE_Flat(int x0, int y0, int x1, int y1,
     y = y0;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4908,7 +3909,7 @@ void PCSX::SoftGPU::SoftRenderer::line_S_SE_Flat(int x0, int y0, int x1, int y1,
     const auto ditherMode = m_ditherMode;
 
     if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-        getShadeTransCol(&vram16[(y << 10) + x], color);
+        getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
     }
 
     while (y < y1) {
@@ -4921,13 +3922,14 @@ void PCSX::SoftGPU::SoftRenderer::line_S_SE_Flat(int x0, int y0, int x1, int y1,
             y++;
         }
         if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-            getShadeTransCol(&vram16[(y << 10) + x], color);
+            getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_N_NE_Flat(int x0, int y0, int x1, int y1, uint16_t color) {
     int dx, dy, incrN, incrNE, d, x, y;
 
@@ -4945,7 +3947,8 @@ void PCSX::SoftGPU::SoftRenderer::line_N_NE_Flat(int x0, int y0, int x1, int y1,
     y = y0;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -4956,7 +3959,7 @@ void PCSX::SoftGPU::SoftRenderer::line_N_NE_Flat(int x0, int y0, int x1, int y1,
     const auto ditherMode = m_ditherMode;
 
     if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-        getShadeTransCol(&vram16[(y << 10) + x], color);
+        getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
     }
 
     while (y > y1) {
@@ -4969,13 +3972,14 @@ void PCSX::SoftGPU::SoftRenderer::line_N_NE_Flat(int x0, int y0, int x1, int y1,
             y--;
         }
         if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-            getShadeTransCol(&vram16[(y << 10) + x], color);
+            getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::line_E_NE_Flat(int x0, int y0, int x1, int y1, uint16_t color) {
     int dx, dy, incrE, incrNE, d, x, y;
 
@@ -4993,7 +3997,8 @@ void PCSX::SoftGPU::SoftRenderer::line_E_NE_Flat(int x0, int y0, int x1, int y1,
     y = y0;
 
     const auto vram = m_vram;
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
     const auto maskX = m_textureWindow.x1 - 1;
     const auto maskY = m_textureWindow.y1 - 1;
     const auto globalTextAddrX = m_globalTextAddrX;
@@ -5004,7 +4009,7 @@ void PCSX::SoftGPU::SoftRenderer::line_E_NE_Flat(int x0, int y0, int x1, int y1,
     const auto ditherMode = m_ditherMode;
 
     if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-        getShadeTransCol(&vram16[(y << 10) + x], color);
+        getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
     }
 
     while (x < x1) {
@@ -5017,13 +4022,14 @@ void PCSX::SoftGPU::SoftRenderer::line_E_NE_Flat(int x0, int y0, int x1, int y1,
             y--;
         }
         if ((x >= drawX) && (x < drawW) && (y >= drawY) && (y < drawH)) {
-            getShadeTransCol(&vram16[(y << 10) + x], color);
+            getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
         }
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::vertLineFlat(int x, int y0, int y1, uint16_t color) {
     int y;
 
@@ -5035,15 +4041,17 @@ void PCSX::SoftGPU::SoftRenderer::vertLineFlat(int x, int y0, int y1, uint16_t c
     if (y0 < drawY) y0 = drawY;
     if (y1 > drawH) y1 = drawH;
 
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
 
     for (y = y0; y <= y1; y++) {
-        getShadeTransCol(&vram16[(y << 10) + x], color);
+        getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
 void PCSX::SoftGPU::SoftRenderer::horzLineFlat(int y, int x0, int x1, uint16_t color) {
     int x;
 
@@ -5055,17 +4063,24 @@ void PCSX::SoftGPU::SoftRenderer::horzLineFlat(int y, int x0, int x1, uint16_t c
     if (x0 < drawX) x0 = drawX;
     if (x1 > drawW) x1 = drawW;
 
-    const auto vram16 = m_vram16;
+    const auto target = m_target16;
+    const auto shift = m_targetShift;
+
+    if (m_vectorSpans) {
+        spanFlat(&target[(y << shift) + x0], x1 - x0 + 1, color);
+        return;
+    }
 
     for (x = x0; x <= x1; x++) {
-        getShadeTransCol(&vram16[(y << 10) + x], color);
+        getShadeTransCol<blend, abr, checkMask>(&target[(y << shift) + x], color);
     }
 }
 
 ///////////////////////////////////////////////////////////////////////
 
 /* Bresenham Line drawing function */
-void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineShade(int32_t rgb0, int32_t rgb1) {
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
+void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineShadei(int32_t rgb0, int32_t rgb1) {
     int16_t x0, y0, x1, y1, xt, yt;
     double m, dy, dx;
 
@@ -5078,23 +4093,23 @@ void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineShade(int32_t rgb0, int32_t rg
     if (y0 > m_drawH && y1 > m_drawH) return;
     if (x0 < m_drawX && x1 < m_drawX) return;
     if (y0 < m_drawY && y1 < m_drawY) return;
-    if (m_drawY >= m_drawH) return;
-    if (m_drawX >= m_drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     dx = x1 - x0;
     dy = y1 - y0;
 
     if (dx == 0) {
         if (dy > 0) {
-            vertLineShade(x0, y0, y1, rgb0, rgb1);
+            vertLineShade<blend, abr, checkMask>(x0, y0, y1, rgb0, rgb1);
         } else {
-            vertLineShade(x0, y1, y0, rgb1, rgb0);
+            vertLineShade<blend, abr, checkMask>(x0, y1, y0, rgb1, rgb0);
         }
     } else if (dy == 0) {
         if (dx > 0) {
-            horzLineShade(y0, x0, x1, rgb0, rgb1);
+            horzLineShade<blend, abr, checkMask>(y0, x0, x1, rgb0, rgb1);
         } else {
-            horzLineShade(y0, x1, x0, rgb1, rgb0);
+            horzLineShade<blend, abr, checkMask>(y0, x1, x0, rgb1, rgb0);
         }
     } else {
         if (dx < 0) {
@@ -5115,21 +4130,30 @@ void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineShade(int32_t rgb0, int32_t rg
 
         if (m >= 0) {
             if (m > 1) {
-                line_S_SE_Shade(x0, y0, x1, y1, rgb0, rgb1);
+                line_S_SE_Shade<blend, abr, checkMask>(x0, y0, x1, y1, rgb0, rgb1);
             } else {
-                line_E_SE_Shade(x0, y0, x1, y1, rgb0, rgb1);
+                line_E_SE_Shade<blend, abr, checkMask>(x0, y0, x1, y1, rgb0, rgb1);
             }
         } else if (m < -1) {
-            line_N_NE_Shade(x0, y0, x1, y1, rgb0, rgb1);
+            line_N_NE_Shade<blend, abr, checkMask>(x0, y0, x1, y1, rgb0, rgb1);
         } else {
-            line_E_NE_Shade(x0, y0, x1, y1, rgb0, rgb1);
+            line_E_NE_Shade<blend, abr, checkMask>(x0, y0, x1, y1, rgb0, rgb1);
         }
     }
 }
 
+void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineShade(int32_t rgb0, int32_t rgb1) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::drawSoftwareLineShadei<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(rgb0, rgb1);
+}
+
 ///////////////////////////////////////////////////////////////////////
 
-void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineFlat(int32_t rgb) {
+template <PCSX::GPU::Blend blend, PCSX::GPU::BlendFunction abr, bool checkMask>
+void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineFlati(int32_t rgb) {
     int16_t x0, y0, x1, y1, xt, yt;
     double m, dy, dx;
     uint16_t color = 0;
@@ -5143,8 +4167,8 @@ void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineFlat(int32_t rgb) {
     if (y0 > m_drawH && y1 > m_drawH) return;
     if (x0 < m_drawX && x1 < m_drawX) return;
     if (y0 < m_drawY && y1 < m_drawY) return;
-    if (m_drawY >= m_drawH) return;
-    if (m_drawX >= m_drawW) return;
+    if (m_areaY >= m_areaH) return;
+    if (m_areaX >= m_areaW) return;
 
     color = ((rgb & 0x00f80000) >> 9) | ((rgb & 0x0000f800) >> 6) | ((rgb & 0x000000f8) >> 3);
 
@@ -5155,15 +4179,15 @@ void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineFlat(int32_t rgb) {
         if (dy == 0) {
             return;  // Nothing to draw
         } else if (dy > 0) {
-            vertLineFlat(x0, y0, y1, color);
+            vertLineFlat<blend, abr, checkMask>(x0, y0, y1, color);
         } else {
-            vertLineFlat(x0, y1, y0, color);
+            vertLineFlat<blend, abr, checkMask>(x0, y1, y0, color);
         }
     } else if (dy == 0) {
         if (dx > 0) {
-            horzLineFlat(y0, x0, x1, color);
+            horzLineFlat<blend, abr, checkMask>(y0, x0, x1, color);
         } else {
-            horzLineFlat(y0, x1, x0, color);
+            horzLineFlat<blend, abr, checkMask>(y0, x1, x0, color);
         }
     } else {
         if (dx < 0) {
@@ -5182,16 +4206,24 @@ void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineFlat(int32_t rgb) {
 
         if (m >= 0) {
             if (m > 1) {
-                line_S_SE_Flat(x0, y0, x1, y1, color);
+                line_S_SE_Flat<blend, abr, checkMask>(x0, y0, x1, y1, color);
             } else {
-                line_E_SE_Flat(x0, y0, x1, y1, color);
+                line_E_SE_Flat<blend, abr, checkMask>(x0, y0, x1, y1, color);
             }
         } else if (m < -1) {
-            line_N_NE_Flat(x0, y0, x1, y1, color);
+            line_N_NE_Flat<blend, abr, checkMask>(x0, y0, x1, y1, color);
         } else {
-            line_E_NE_Flat(x0, y0, x1, y1, color);
+            line_E_NE_Flat<blend, abr, checkMask>(x0, y0, x1, y1, color);
         }
     }
 }
 
+void PCSX::SoftGPU::SoftRenderer::drawSoftwareLineFlat(int32_t rgb) {
+    static constexpr auto variants = makeVariants<VARIANTS>([]<unsigned index>() {
+        using V = Variant<index>;
+        return &SoftRenderer::drawSoftwareLineFlati<V::blend, V::abr, V::checkMask>;
+    });
+    (this->*variants[variantIndex(*this)])(rgb);
+}
+
 ///////////////////////////////////////////////////////////////////////
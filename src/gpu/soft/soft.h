@@ -28,7 +28,6 @@ namespace PCSX {
 namespace SoftGPU {
 
 struct SoftRenderer {
-    ~SoftRenderer();
     inline void resetRenderer() {
         m_globalTextAddrX = 0;
         m_globalTextAddrY = 0;
@@ -36,9 +35,13 @@ struct SoftRenderer {
         m_globalTextABR = GPU::BlendFunction::HalfBackAndHalfFront;
         m_drawX = m_drawY = 0;
         m_drawW = m_drawH = 0;
+        m_areaX = m_areaY = m_areaW = m_areaH = 0;
         m_checkMask = false;
         m_setMask16 = 0;
         m_setMask32 = 0;
+        m_target16 = m_vram16;
+        m_targetShift = 10;
+        m_upscale = 0;
     }
 
     int m_useDither = 0;
@@ -91,11 +94,17 @@ struct SoftRenderer {
     SoftRect m_textureWindow;
     bool m_ditherMode = false;
     int m_drawX, m_drawY, m_drawW, m_drawH;
+    // Extent of the drawing area as programmed by the GPU. The threaded rasterizer narrows m_drawY /
+    // m_drawH down to a band, and upscaling moves the inclusive ends, but the degenerate area checks
+    // need to see the real one.
+    int m_areaX = 0, m_areaY = 0, m_areaW = 0, m_areaH = 0;
 
     static constexpr int GPU_WIDTH = 1024;
     static constexpr int GPU_HEIGHT = 512;
     static constexpr int GPU_HEIGHT_MASK = 511;
 
+    static constexpr uint8_t s_dithertable[16] = {7, 0, 6, 1, 2, 5, 3, 4, 1, 6, 0, 7, 4, 3, 5, 2};
+
     bool m_drawSemiTrans = false;
     int16_t m_m1 = 255, m_m2 = 255, m_m3 = 255;
     int16_t m_y0, m_x0, m_y1, m_x1, m_y2, m_x2, m_y3, m_x3;  // global psx vertex coords
@@ -116,12 +125,39 @@ struct SoftRenderer {
     SoftDisplay m_softDisplay;
     uint8_t *m_vram;
     uint16_t *m_vram16;
+    // Where the primitives draw, with its row pitch as a shift. This is the VRAM itself, unless
+    // the state has been upscaled, in which case it is a shadow VRAM of (1024 << m_upscale) by
+    // (512 << m_upscale) pixels. Textures and CLUTs are always read from the native VRAM.
+    uint16_t *m_target16 = nullptr;
+    int m_targetShift = 10;
+    int m_upscale = 0;
+    // Turns a copy of the renderer state into one drawing the same primitives at 2^shift times the
+    // resolution into the target, by scaling the drawing area and the vertices. The primitives taking
+    // their vertices as arguments scale them on their own.
+    void upscale(uint16_t *target, int shift);
+    // Texels of the current 4 or 8 bits texture page, already looked up in its CLUT, if the
+    // caller has them at hand, see TextureCache. Indexed by the texture window masked V and U
+    // coordinates, 256 texels per row. Only the flat textured primitives make use of it.
+    const uint16_t *m_decodedTexture = nullptr;
+
+    // Byte offset in the VRAM the texel fetches of the 4 and 8 bits texture pages are relative to.
+    int32_t textureOffset() const {
+        const int32_t offset = ((m_globalTextAddrY + m_textureWindow.y0) << 11) + (m_globalTextAddrX << 1);
+        return offset + (m_globalTextTP == GPU::TexDepth::Tex4Bits ? (m_textureWindow.x0 >> 1) : m_textureWindow.x0);
+    }
+
+    template <typename... Coords>
+    void scaleCoords(Coords &...coords) const {
+        ((coords <<= m_upscale), ...);
+    }
 
     void applyOffset2();
     void applyOffset3();
     void applyOffset4();
 
     void fillSoftwareAreaTrans(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
+    void fillSoftwareAreaTransi(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col);
     void fillSoftwareArea(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t col);
     void drawPolyShade3(int32_t rgb1, int32_t rgb2, int32_t rgb3);
     void drawPolyShade4(int32_t rgb1, int32_t rgb2, int32_t rgb3, int32_t rgb4);
@@ -129,6 +165,10 @@ struct SoftRenderer {
     void drawPolyFlat4(int32_t rgb);
     void drawSoftwareLineShade(int32_t rgb0, int32_t rgb1);
     void drawSoftwareLineFlat(int32_t rgb);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
+    void drawSoftwareLineShadei(int32_t rgb0, int32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
+    void drawSoftwareLineFlati(int32_t rgb);
 
     int16_t m_yMin;
     int16_t m_yMax;
@@ -151,50 +191,62 @@ struct SoftRenderer {
                                      int16_t ty3, int16_t tx4, int16_t ty4, int32_t rgb1, int32_t rgb2, int32_t rgb3,
                                      int32_t rgb4);
 
+    // The blending and mask check state of the pixel functions is known at compile time, as the
+    // drawing functions are specialized over it, see soft.cc. The untemplated versions, or the ones
+    // only templated on the dithering table, look it up from the renderer at runtime.
+    template <bool useCachedDither, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
+    void getShadeTransColDither(uint16_t *pdest, int32_t m1, int32_t m2, int32_t m3);
     template <bool useCachedDither>
     void getShadeTransColDither(uint16_t *pdest, int32_t m1, int32_t m2, int32_t m3);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void getShadeTransCol(uint16_t *pdest, uint16_t color);
+    void getShadeTransCol(uint16_t *pdest, uint16_t color);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
+    void getShadeTransCol32(uint32_t *pdest, uint32_t color);
     void getShadeTransCol32(uint32_t *pdest, uint32_t color);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void getTextureTransColShade(uint16_t *pdest, uint16_t color);
-    void getTextureTransColShadeSolid(uint16_t *pdest, uint16_t color);
-    void getTextureTransColShadeSemi(uint16_t *pdest, uint16_t color);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void getTextureTransColShade32(uint32_t *pdest, uint32_t color);
-    void getTextureTransColShade32Solid(uint32_t *pdest, uint32_t color);
-    void getTextureTransColG32Semi(uint32_t *pdest, uint32_t color);
-    template <bool useCachedDither>
+    void getTextureTransColShade(uint16_t *pdest, uint16_t color);
+    void getTextureTransColShade32(uint32_t *pdest, uint32_t color);
+    template <bool useCachedDither, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void getTextureTransColShadeXDither(uint16_t *pdest, uint16_t color, int32_t m1, int32_t m2, int32_t m3);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void getTextureTransColShadeX(uint16_t *pdest, uint16_t color, int16_t m1, int16_t m2, int16_t m3);
     void getTextureTransColShadeXSolid(uint16_t *pdest, uint16_t color, int16_t m1, int16_t m2, int16_t m3);
     void getTextureTransColShadeX32Solid(uint32_t *pdest, uint32_t color, int16_t m1, int16_t m2, int16_t m3);
+
+    // Span kernels, see spans.cc. They draw a whole row of a primitive at once, and are pixel-exact
+    // with the per-pixel functions above, which the drawing loops fall back to when m_vectorSpans is off.
+    bool m_vectorSpans = true;
+    void spanFlat(uint16_t *pdest, int count, uint16_t color);
+    void spanShade(uint16_t *pdest, int count, int32_t cR, int32_t cG, int32_t cB, int32_t difR, int32_t difG,
+                   int32_t difB);
+    void spanTextured(uint16_t *pdest, const uint16_t *texels, int count);
+    // Draws the pixel pairs of a textured row, like the scalar loops do, and returns where the odd
+    // pixel left over is, if any, with posX and posY advanced to it, for the caller to finish the row.
+    template <GPU::TexDepth depth>
+    int spanTexture(int y, int xmin, int xmax, int32_t &posX, int32_t &posY, int32_t difX, int32_t difY,
+                    int32_t YAdjust, int32_t clutP);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void drawPoly3Fi(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int32_t rgb);
-    void drawPoly3TEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1, int16_t ty1,
-                       int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t clX, int16_t clY);
-    void drawPoly4TEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
-                       int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                       int16_t ty4, int16_t clX, int16_t clY);
-    void drawPoly4TEx4_S(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
-                         int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                         int16_t ty4, int16_t clX, int16_t clY);
-    void drawPoly3TEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1, int16_t ty1,
-                       int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t clX, int16_t clY);
-    void drawPoly4TEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
-                       int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                       int16_t ty4, int16_t clX, int16_t clY);
-    void drawPoly4TEx8_S(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
-                         int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                         int16_t ty4, int16_t clX, int16_t clY);
-    void drawPoly3TD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1, int16_t ty1,
-                     int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3);
-    void drawPoly4TD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
-                     int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                     int16_t ty4);
-    void drawPoly4TD_S(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
-                       int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
-                       int16_t ty4);
-    template <bool useCachedDither>
+    // Flat textured polygons and sprites. These look up the texture depth, blending and mask check
+    // state once, and hand the primitive over to the matching variant of drawPolyTextured, which
+    // is specialized over all of them at compile time. Triangles ignore their 4th vertex.
+    void drawPolyTextured3(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1,
+                           int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t clX, int16_t clY);
+    void drawPolyTextured4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4,
+                           int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3,
+                           int16_t tx4, int16_t ty4, int16_t clX, int16_t clY);
+    template <GPU::Shape shape, GPU::TexDepth depth, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
+    void drawPolyTextured(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4,
+                          int16_t y4, int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3,
+                          int16_t tx4, int16_t ty4, int16_t clX, int16_t clY);
+    template <bool useCachedDither, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void drawPoly3Gi(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int32_t rgb1, int32_t rgb2,
                      int32_t rgb3);
-    template <bool useCachedDither>
+    template <bool useCachedDither, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void drawPoly3TGEx4i(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1,
                          int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t clX, int16_t clY,
                          int32_t col1, int32_t col2, int32_t col3);
@@ -204,7 +256,7 @@ struct SoftRenderer {
     void drawPoly4TGEx4(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
                         int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
                         int16_t ty4, int16_t clX, int16_t clY, int32_t col1, int32_t col2, int32_t col3, int32_t col4);
-    template <bool useCachedDither>
+    template <bool useCachedDither, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void drawPoly3TGEx8i(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1,
                          int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t clX, int16_t clY,
                          int32_t col1, int32_t col2, int32_t col3);
@@ -214,7 +266,7 @@ struct SoftRenderer {
     void drawPoly4TGEx8(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
                         int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
                         int16_t ty4, int16_t clX, int16_t clY, int32_t col1, int32_t col2, int32_t col3, int32_t col4);
-    template <bool useCachedDither>
+    template <bool useCachedDither, GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void drawPoly3TGDi(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1, int16_t ty1,
                        int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int32_t col1, int32_t col2, int32_t col3);
     void drawPoly3TGD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t tx1, int16_t ty1,
@@ -222,17 +274,29 @@ struct SoftRenderer {
     void drawPoly4TGD(int16_t x1, int16_t y1, int16_t x2, int16_t y2, int16_t x3, int16_t y3, int16_t x4, int16_t y4,
                       int16_t tx1, int16_t ty1, int16_t tx2, int16_t ty2, int16_t tx3, int16_t ty3, int16_t tx4,
                       int16_t ty4, int32_t col1, int32_t col2, int32_t col3, int32_t col4);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_E_SE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_S_SE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_N_NE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_E_NE_Shade(int x0, int y0, int x1, int y1, uint32_t rgb0, uint32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void vertLineShade(int x, int y0, int y1, uint32_t rgb0, uint32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void horzLineShade(int y, int x0, int x1, uint32_t rgb0, uint32_t rgb1);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_E_SE_Flat(int x0, int y0, int x1, int y1, uint16_t col);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_S_SE_Flat(int x0, int y0, int x1, int y1, uint16_t col);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_N_NE_Flat(int x0, int y0, int x1, int y1, uint16_t col);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void line_E_NE_Flat(int x0, int y0, int x1, int y1, uint16_t col);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void vertLineFlat(int x, int y0, int y1, uint16_t col);
+    template <GPU::Blend blend, GPU::BlendFunction abr, bool checkMask>
     void horzLineFlat(int y, int x0, int x1, uint16_t col);
 
     void enableCachedDithering();
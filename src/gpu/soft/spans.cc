@@ -0,0 +1,520 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+// Span kernels for the software rasterizer. The per-pixel functions in soft.cc
+// remain the reference implementation: every kernel here has to produce exactly
+// the same VRAM contents as the scalar loops it replaces, quirks included.
+//
+// The shading is done with SSE2, eight pixels at a time, using 16 bits lanes.
+// Since SSE2 has no gather, the texel fetches use AVX2 when the host has it,
+// and fall back to a scalar loop otherwise. Other architectures simply loop
+// over the reference functions.
+
+#include <algorithm>
+#include <cstring>
+
+#include "gpu/soft/soft.h"
+#include "support/simd.h"
+
+namespace {
+
+using PCSX::GPU;
+using PCSX::SoftGPU::SoftRenderer;
+
+// Texel addressing of the flat textured primitives, one texel per pixel, stepping
+// along an affine span. The indices are computed exactly like the scalar loops do.
+template <GPU::TexDepth depth>
+void fetchTexelsScalar(const SoftRenderer &r, uint16_t *texels, int count, int32_t posX, int32_t posY, int32_t difX,
+                       int32_t difY, int32_t YAdjust, int32_t clutP) {
+    const auto vram = r.m_vram;
+    const auto vram16 = r.m_vram16;
+    const int32_t maskX = r.m_textureWindow.x1 - 1;
+    const int32_t maskY = r.m_textureWindow.y1 - 1;
+    const int32_t baseX = r.m_globalTextAddrX + r.m_textureWindow.x0;
+    const int32_t baseY = r.m_globalTextAddrY + r.m_textureWindow.y0;
+
+    for (int i = 0; i < count; i++) {
+        const int32_t x = (posX >> 16) & maskX;
+        const int32_t y = (posY >> 16) & maskY;
+        if constexpr (depth == GPU::TexDepth::Tex4Bits) {
+            int16_t tC = vram[(y << 11) + YAdjust + (x >> 1)];
+            tC = (tC >> ((x & 1) << 2)) & 0xf;
+            texels[i] = vram16[clutP + tC];
+        } else if constexpr (depth == GPU::TexDepth::Tex8Bits) {
+            texels[i] = vram16[clutP + vram[(y << 11) + YAdjust + x]];
+        } else {
+            texels[i] = vram16[((y + baseY) << 10) + x + baseX];
+        }
+        posX += difX;
+        posY += difY;
+    }
+}
+
+// Same, from a texture page decoded beforehand.
+void fetchDecodedScalar(const SoftRenderer &r, uint16_t *texels, int count, int32_t posX, int32_t posY, int32_t difX,
+                        int32_t difY) {
+    const auto decoded = r.m_decodedTexture;
+    const int32_t maskX = r.m_textureWindow.x1 - 1;
+    const int32_t maskY = r.m_textureWindow.y1 - 1;
+
+    for (int i = 0; i < count; i++) {
+        texels[i] = decoded[(((posY >> 16) & maskY) << 8) + ((posX >> 16) & maskX)];
+        posX += difX;
+        posY += difY;
+    }
+}
+
+// Whether the halfwords from d0 to d1 intersect any of the count ranges of width halfwords
+// starting at start, start + 1024, start + 2048, etc. That is, any of the rows of a rectangle.
+bool intersects(int32_t d0, int32_t d1, int32_t start, int32_t width, int32_t count) {
+    const int32_t first = -((start + width - 1 - d0) >> 10);
+    const int32_t last = (d1 - start) >> 10;
+    return std::max(first, 0) <= std::min(last, count - 1);
+}
+
+// Whether drawing the pixels from xmin to xmax of row y may change any of the texels
+// or CLUT entries the span is going to sample.
+template <GPU::TexDepth depth>
+bool samplesItself(const SoftRenderer &r, int y, int xmin, int xmax, int32_t YAdjust, int32_t clutP) {
+    const int32_t d0 = (y << 10) + xmin;
+    const int32_t d1 = (y << 10) + xmax;
+    const int32_t maskX = r.m_textureWindow.x1 - 1;
+    const int32_t maskY = r.m_textureWindow.y1 - 1;
+
+    if constexpr (depth == GPU::TexDepth::Tex16Bits) {
+        const int32_t baseX = r.m_globalTextAddrX + r.m_textureWindow.x0;
+        const int32_t baseY = r.m_globalTextAddrY + r.m_textureWindow.y0;
+        return intersects(d0, d1, (baseY << 10) + baseX, maskX + 1, maskY + 1);
+    } else {
+        const int32_t bytes = depth == GPU::TexDepth::Tex4Bits ? (maskX >> 1) : maskX;
+        const int32_t colors = depth == GPU::TexDepth::Tex4Bits ? 16 : 256;
+        const int32_t start = YAdjust >> 1;
+        const int32_t width = ((YAdjust + bytes) >> 1) - start + 1;
+        return intersects(d0, d1, start, width, maskY + 1) || intersects(d0, d1, clutP, colors, 1);
+    }
+}
+
+#ifdef PCSX_SIMD_X86
+
+template <GPU::TexDepth depth>
+AVX2_FUNC void fetchTexelsAVX2(const SoftRenderer &r, uint16_t *texels, int count, int32_t posX, int32_t posY,
+                               int32_t difX, int32_t difY, int32_t YAdjust, int32_t clutP) {
+    const auto vram = reinterpret_cast<const int *>(r.m_vram);
+    const auto vram16 = reinterpret_cast<const int *>(r.m_vram16);
+    const __m256i maskX = _mm256_set1_epi32(r.m_textureWindow.x1 - 1);
+    const __m256i maskY = _mm256_set1_epi32(r.m_textureWindow.y1 - 1);
+    const __m256i baseX = _mm256_set1_epi32(r.m_globalTextAddrX + r.m_textureWindow.x0);
+    const __m256i baseY = _mm256_set1_epi32(r.m_globalTextAddrY + r.m_textureWindow.y0);
+    const __m256i yAdjust = _mm256_set1_epi32(YAdjust);
+    const __m256i clut = _mm256_set1_epi32(clutP);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    // The fixed point coordinates are expected to wrap around, like the scalar loops' do.
+    const __m256i stepX = _mm256_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difX) << 3));
+    const __m256i stepY = _mm256_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difY) << 3));
+    __m256i u = _mm256_add_epi32(_mm256_set1_epi32(posX), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(difX)));
+    __m256i v = _mm256_add_epi32(_mm256_set1_epi32(posY), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(difY)));
+
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i x = _mm256_and_si256(_mm256_srai_epi32(u, 16), maskX);
+        const __m256i y = _mm256_and_si256(_mm256_srai_epi32(v, 16), maskY);
+        __m256i colors;
+        // The gathers read 32 bits at a time, which is fine since the VRAM allocation has a lot of slack.
+        if constexpr (depth == GPU::TexDepth::Tex4Bits) {
+            const __m256i offset =
+                _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(y, 11), yAdjust), _mm256_srli_epi32(x, 1));
+            __m256i tC = _mm256_i32gather_epi32(vram, offset, 1);
+            tC = _mm256_srlv_epi32(tC, _mm256_slli_epi32(_mm256_and_si256(x, _mm256_set1_epi32(1)), 2));
+            tC = _mm256_and_si256(tC, _mm256_set1_epi32(0xf));
+            colors = _mm256_i32gather_epi32(vram16, _mm256_add_epi32(clut, tC), 2);
+        } else if constexpr (depth == GPU::TexDepth::Tex8Bits) {
+            const __m256i offset = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(y, 11), yAdjust), x);
+            __m256i tC = _mm256_i32gather_epi32(vram, offset, 1);
+            tC = _mm256_and_si256(tC, _mm256_set1_epi32(0xff));
+            colors = _mm256_i32gather_epi32(vram16, _mm256_add_epi32(clut, tC), 2);
+        } else {
+            const __m256i index =
+                _mm256_add_epi32(_mm256_slli_epi32(_mm256_add_epi32(y, baseY), 10), _mm256_add_epi32(x, baseX));
+            colors = _mm256_i32gather_epi32(vram16, index, 2);
+        }
+        colors = _mm256_and_si256(colors, _mm256_set1_epi32(0xffff));
+        const __m128i packed =
+            _mm_packus_epi32(_mm256_castsi256_si128(colors), _mm256_extracti128_si256(colors, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(texels + i), packed);
+        u = _mm256_add_epi32(u, stepX);
+        v = _mm256_add_epi32(v, stepY);
+    }
+
+    fetchTexelsScalar<depth>(r, texels + i, count - i, posX + i * difX, posY + i * difY, difX, difY, YAdjust, clutP);
+}
+
+AVX2_FUNC void fetchDecodedAVX2(const SoftRenderer &r, uint16_t *texels, int count, int32_t posX, int32_t posY,
+                                 int32_t difX, int32_t difY) {
+    const auto decoded = reinterpret_cast<const int *>(r.m_decodedTexture);
+    const __m256i maskX = _mm256_set1_epi32(r.m_textureWindow.x1 - 1);
+    const __m256i maskY = _mm256_set1_epi32(r.m_textureWindow.y1 - 1);
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i stepX = _mm256_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difX) << 3));
+    const __m256i stepY = _mm256_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difY) << 3));
+    __m256i u = _mm256_add_epi32(_mm256_set1_epi32(posX), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(difX)));
+    __m256i v = _mm256_add_epi32(_mm256_set1_epi32(posY), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(difY)));
+
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i x = _mm256_and_si256(_mm256_srai_epi32(u, 16), maskX);
+        const __m256i y = _mm256_and_si256(_mm256_srai_epi32(v, 16), maskY);
+        // The decoded pages have a texel of slack at the end for these 32 bits reads.
+        __m256i colors = _mm256_i32gather_epi32(decoded, _mm256_add_epi32(_mm256_slli_epi32(y, 8), x), 2);
+        colors = _mm256_and_si256(colors, _mm256_set1_epi32(0xffff));
+        const __m128i packed =
+            _mm_packus_epi32(_mm256_castsi256_si128(colors), _mm256_extracti128_si256(colors, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(texels + i), packed);
+        u = _mm256_add_epi32(u, stepX);
+        v = _mm256_add_epi32(v, stepY);
+    }
+
+    fetchDecodedScalar(r, texels + i, count - i, posX + i * difX, posY + i * difY, difX, difY);
+}
+
+inline __m128i load8(const uint16_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+inline void store8(uint16_t *p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+inline __m128i splat(int v) { return _mm_set1_epi16(static_cast<int16_t>(v)); }
+
+// One of the three 5 bits channels of eight 1555 pixels.
+template <int n>
+inline __m128i channel(__m128i v) {
+    return _mm_and_si128(_mm_srli_epi16(v, n * 5), splat(0x1f));
+}
+
+inline __m128i merge(__m128i r, __m128i g, __m128i b) {
+    return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi16(g, 5)), _mm_slli_epi16(b, 10));
+}
+
+// Picks a where the mask lanes are set, b otherwise.
+inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// All ones in the lanes that have their mask bit set.
+inline __m128i masked(__m128i v) { return _mm_srai_epi16(v, 15); }
+
+// Runs a kernel over a span, eight pixels at a time. The last few pixels go
+// through a temporary buffer, so that the kernels never touch anything past the span.
+template <typename Kernel>
+void forEach8(uint16_t *pdest, int count, Kernel &&kernel) {
+    int i = 0;
+    for (; (i + 8) <= count; i += 8) store8(pdest + i, kernel(load8(pdest + i), i));
+    if (i >= count) return;
+    alignas(16) uint16_t tail[8] = {};
+    std::memcpy(tail, pdest + i, (count - i) * sizeof(uint16_t));
+    store8(tail, kernel(load8(tail), i));
+    std::memcpy(pdest + i, tail, (count - i) * sizeof(uint16_t));
+}
+
+// The per-span state of the SoftRenderer the kernels need.
+struct Shader {
+    explicit Shader(const SoftRenderer &r)
+        : checkMask(r.m_checkMask),
+          semiTrans(r.m_drawSemiTrans),
+          abr(r.m_globalTextABR),
+          setMask(splat(r.m_setMask16)),
+          m1(splat(r.m_m1)),
+          m2(splat(r.m_m2)),
+          m3(splat(r.m_m3)) {}
+
+    // getShadeTransCol
+    __m128i shade(__m128i d, __m128i c) const {
+        __m128i result;
+        if (!semiTrans) {
+            result = _mm_or_si128(c, setMask);
+        } else if (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
+            const __m128i half = splat(0x7bde);
+            result = _mm_add_epi16(_mm_srli_epi16(_mm_and_si128(d, half), 1), _mm_srli_epi16(_mm_and_si128(c, half), 1));
+            result = _mm_or_si128(result, setMask);
+        } else {
+            __m128i r, g, b;
+            if (abr == GPU::BlendFunction::FullBackAndFullFront) {
+                r = _mm_add_epi16(channel<0>(d), channel<0>(c));
+                g = _mm_add_epi16(channel<1>(d), channel<1>(c));
+                b = _mm_add_epi16(channel<2>(d), channel<2>(c));
+            } else if (abr == GPU::BlendFunction::FullBackSubFullFront) {
+                r = _mm_subs_epu16(channel<0>(d), channel<0>(c));
+                g = _mm_subs_epu16(channel<1>(d), channel<1>(c));
+                b = _mm_subs_epu16(channel<2>(d), channel<2>(c));
+            } else {
+                r = _mm_add_epi16(channel<0>(d), _mm_srli_epi16(channel<0>(c), 2));
+                g = _mm_add_epi16(channel<1>(d), _mm_srli_epi16(channel<1>(c), 2));
+                b = _mm_add_epi16(channel<2>(d), _mm_srli_epi16(channel<2>(c), 2));
+            }
+            const __m128i max = splat(0x1f);
+            result = _mm_or_si128(merge(_mm_min_epi16(r, max), _mm_min_epi16(g, max), _mm_min_epi16(b, max)), setMask);
+        }
+        if (checkMask) result = select(masked(d), d, result);
+        return result;
+    }
+
+    // getShadeTransColDither, with the three 8 bits components as signed 16 bits lanes.
+    __m128i shadeDither(__m128i d, __m128i m1, __m128i m2, __m128i m3, __m128i coeffs) const {
+        // Anything outside of this range ends up saturated the same way
+        // regardless of the blending, and this avoids overflowing the lanes.
+        const __m128i lo = splat(-1024), hi = splat(1023);
+        m1 = _mm_max_epi16(_mm_min_epi16(m1, hi), lo);
+        m2 = _mm_max_epi16(_mm_min_epi16(m2, hi), lo);
+        m3 = _mm_max_epi16(_mm_min_epi16(m3, hi), lo);
+
+        __m128i r = m1, b = m2, g = m3;
+        if (semiTrans) {
+            r = _mm_slli_epi16(channel<0>(d), 3);
+            b = _mm_slli_epi16(channel<1>(d), 3);
+            g = _mm_slli_epi16(channel<2>(d), 3);
+            if (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
+                r = _mm_add_epi16(_mm_srai_epi16(r, 1), _mm_srai_epi16(m1, 1));
+                b = _mm_add_epi16(_mm_srai_epi16(b, 1), _mm_srai_epi16(m2, 1));
+                g = _mm_add_epi16(_mm_srai_epi16(g, 1), _mm_srai_epi16(m3, 1));
+            } else if (abr == GPU::BlendFunction::FullBackAndFullFront) {
+                r = _mm_add_epi16(r, m1);
+                b = _mm_add_epi16(b, m2);
+                g = _mm_add_epi16(g, m3);
+            } else if (abr == GPU::BlendFunction::FullBackSubFullFront) {
+                r = _mm_max_epi16(_mm_sub_epi16(r, m1), _mm_setzero_si128());
+                b = _mm_max_epi16(_mm_sub_epi16(b, m2), _mm_setzero_si128());
+                g = _mm_max_epi16(_mm_sub_epi16(g, m3), _mm_setzero_si128());
+            } else {
+                r = _mm_add_epi16(r, _mm_srai_epi16(m1, 2));
+                b = _mm_add_epi16(b, _mm_srai_epi16(m2, 2));
+                g = _mm_add_epi16(g, _mm_srai_epi16(m3, 2));
+            }
+        }
+
+        __m128i result = merge(dither(r, coeffs), dither(b, coeffs), dither(g, coeffs));
+        result = _mm_or_si128(result, setMask);
+        if (checkMask) result = select(masked(d), d, result);
+        return result;
+    }
+
+    // getTextureTransColShade32, which is what the textured spans use for all of their pixels
+    // but the last one of odd spans. Unlike the 16 bits version, it handles all three channels
+    // the same way, and has its own rounding for the half blending.
+    __m128i texture(__m128i d, __m128i c) const {
+        const __m128i t1 = _mm_mullo_epi16(channel<0>(c), m1);
+        const __m128i t2 = _mm_mullo_epi16(channel<1>(c), m2);
+        const __m128i t3 = _mm_mullo_epi16(channel<2>(c), m3);
+        __m128i r = _mm_srli_epi16(t1, 7);
+        __m128i b = _mm_srli_epi16(t2, 7);
+        __m128i g = _mm_srli_epi16(t3, 7);
+
+        if (semiTrans) {
+            __m128i sr, sb, sg;
+            if (abr == GPU::BlendFunction::HalfBackAndHalfFront) {
+                sr = _mm_srli_epi16(_mm_add_epi16(_mm_slli_epi16(channel<0>(d), 7), t1), 8);
+                sb = _mm_srli_epi16(_mm_add_epi16(_mm_slli_epi16(channel<1>(d), 7), t2), 8);
+                sg = _mm_srli_epi16(_mm_add_epi16(_mm_slli_epi16(channel<2>(d), 7), t3), 8);
+            } else if (abr == GPU::BlendFunction::FullBackAndFullFront) {
+                sr = _mm_add_epi16(channel<0>(d), r);
+                sb = _mm_add_epi16(channel<1>(d), b);
+                sg = _mm_add_epi16(channel<2>(d), g);
+            } else if (abr == GPU::BlendFunction::FullBackSubFullFront) {
+                sr = _mm_subs_epu16(channel<0>(d), r);
+                sb = _mm_subs_epu16(channel<1>(d), b);
+                sg = _mm_subs_epu16(channel<2>(d), g);
+            } else {
+                sr = _mm_add_epi16(channel<0>(d), _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(channel<0>(c), 2), m1), 7));
+                sb = _mm_add_epi16(channel<1>(d), _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(channel<1>(c), 2), m2), 7));
+                sg = _mm_add_epi16(channel<2>(d), _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(channel<2>(c), 2), m3), 7));
+            }
+            // Only the texels with their semi transparency bit set get blended.
+            const __m128i semi = masked(c);
+            r = select(semi, sr, r);
+            b = select(semi, sb, b);
+            g = select(semi, sg, g);
+        }
+
+        const __m128i max = splat(0x1f);
+        __m128i result = merge(_mm_min_epi16(r, max), _mm_min_epi16(b, max), _mm_min_epi16(g, max));
+        result = _mm_or_si128(_mm_or_si128(result, setMask), _mm_and_si128(c, splat(0x8000)));
+
+        __m128i keep = _mm_cmpeq_epi16(c, _mm_setzero_si128());
+        if (checkMask) keep = _mm_or_si128(keep, masked(d));
+        return select(keep, d, result);
+    }
+
+    static __m128i dither(__m128i v, __m128i coeffs) {
+        // Saturate anything that isn't within 0..255.
+        const __m128i inRange = _mm_cmpeq_epi16(_mm_and_si128(v, splat(0xff00)), _mm_setzero_si128());
+        v = select(inRange, v, splat(0xff));
+        const __m128i low = _mm_and_si128(v, splat(7));
+        v = _mm_srli_epi16(v, 3);
+        const __m128i round = _mm_and_si128(_mm_cmplt_epi16(v, splat(0x1f)), _mm_cmpgt_epi16(low, coeffs));
+        return _mm_sub_epi16(v, round);
+    }
+
+    const bool checkMask;
+    const bool semiTrans;
+    const GPU::BlendFunction abr;
+    const __m128i setMask;
+    const __m128i m1, m2, m3;
+};
+
+#endif
+
+}  // namespace
+
+void PCSX::SoftGPU::SoftRenderer::spanFlat(uint16_t *pdest, int count, uint16_t color) {
+    if (count <= 0) return;
+#ifdef PCSX_SIMD_X86
+    const Shader shader(*this);
+    const __m128i c = splat(color);
+    forEach8(pdest, count, [&shader, c](__m128i d, int) { return shader.shade(d, c); });
+#else
+    for (int i = 0; i < count; i++) getShadeTransCol(pdest + i, color);
+#endif
+}
+
+void PCSX::SoftGPU::SoftRenderer::spanShade(uint16_t *pdest, int count, int32_t cR, int32_t cG, int32_t cB,
+                                            int32_t difR, int32_t difG, int32_t difB) {
+    if (count <= 0) return;
+#ifdef PCSX_SIMD_X86
+    const Shader shader(*this);
+    const bool dither = m_ditherMode;
+
+    // The 16.16 interpolants need 32 bits lanes, so each channel of eight pixels spans two registers.
+    auto start = [](int32_t c, int32_t dif, int first) {
+        return _mm_setr_epi32(c + dif * first, c + dif * (first + 1), c + dif * (first + 2), c + dif * (first + 3));
+    };
+    __m128i r[2] = {start(cR, difR, 0), start(cR, difR, 4)};
+    __m128i g[2] = {start(cG, difG, 0), start(cG, difG, 4)};
+    __m128i b[2] = {start(cB, difB, 0), start(cB, difB, 4)};
+    const __m128i stepR = _mm_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difR) << 3));
+    const __m128i stepG = _mm_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difG) << 3));
+    const __m128i stepB = _mm_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(difB) << 3));
+
+    // The dithering matrix only depends on the position modulo 4, so one row of it covers the whole span.
+    const int offset = pdest - m_target16;
+    const int x = offset & ((1 << m_targetShift) - 1);
+    const int y = offset >> m_targetShift;
+    alignas(16) int16_t coeffs[8];
+    for (int i = 0; i < 8; i++) coeffs[i] = s_dithertable[(y & 3) * 4 + ((x + i) & 3)];
+    const __m128i ditherCoeffs = _mm_load_si128(reinterpret_cast<const __m128i *>(coeffs));
+
+    forEach8(pdest, count, [&](__m128i d, int) {
+        __m128i result;
+        if (dither) {
+            auto component = [](const __m128i *c) {
+                return _mm_packs_epi32(_mm_srai_epi32(c[0], 16), _mm_srai_epi32(c[1], 16));
+            };
+            result = shader.shadeDither(d, component(b), component(g), component(r), ditherCoeffs);
+        } else {
+            auto color = [](__m128i r, __m128i g, __m128i b) {
+                return _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(r, 9), _mm_set1_epi32(0x7c00)),
+                                                 _mm_and_si128(_mm_srli_epi32(g, 14), _mm_set1_epi32(0x03e0))),
+                                    _mm_and_si128(_mm_srli_epi32(b, 19), _mm_set1_epi32(0x001f)));
+            };
+            result = shader.shade(d, _mm_packs_epi32(color(r[0], g[0], b[0]), color(r[1], g[1], b[1])));
+        }
+        for (int i = 0; i < 2; i++) {
+            r[i] = _mm_add_epi32(r[i], stepR);
+            g[i] = _mm_add_epi32(g[i], stepG);
+            b[i] = _mm_add_epi32(b[i], stepB);
+        }
+        return result;
+    });
+#else
+    for (int i = 0; i < count; i++) {
+        if (m_ditherMode) {
+            getShadeTransColDither<false>(pdest + i, cB >> 16, cG >> 16, cR >> 16);
+        } else {
+            getShadeTransCol(pdest + i, ((cR >> 9) & 0x7c00) | ((cG >> 14) & 0x03e0) | ((cB >> 19) & 0x001f));
+        }
+        cR += difR;
+        cG += difG;
+        cB += difB;
+    }
+#endif
+}
+
+void PCSX::SoftGPU::SoftRenderer::spanTextured(uint16_t *pdest, const uint16_t *texels, int count) {
+    if (count <= 0) return;
+    // The scalar loops draw pairs of pixels, and the odd one out with the 16 bits function.
+    const int pairs = count & ~1;
+#ifdef PCSX_SIMD_X86
+    const Shader shader(*this);
+    forEach8(pdest, pairs, [&](__m128i d, int i) {
+        alignas(16) uint16_t c[8] = {};
+        std::memcpy(c, texels + i, std::min(8, pairs - i) * sizeof(uint16_t));
+        return shader.texture(d, load8(c));
+    });
+#else
+    for (int i = 0; i < pairs; i += 2) {
+        getTextureTransColShade32(reinterpret_cast<uint32_t *>(pdest + i), texels[i] | (uint32_t(texels[i + 1]) << 16));
+    }
+#endif
+    if (pairs != count) getTextureTransColShade(pdest + pairs, texels[pairs]);
+}
+
+template <PCSX::GPU::TexDepth depth>
+int PCSX::SoftGPU::SoftRenderer::spanTexture(int y, int xmin, int xmax, int32_t &posX, int32_t &posY, int32_t difX,
+                                             int32_t difY, int32_t YAdjust, int32_t clutP) {
+    if (xmin >= xmax) return xmin;
+    const int count = (xmax - xmin + 1) & ~1;
+    // The scalar loops fetch the texels of each pair right before drawing it, so a row
+    // sampling its own pixels sees the ones it just drew. These rows go one pair at a time.
+    // Upscaled rows are drawn to the shadow VRAM, and never sample what they draw.
+    const bool self =
+        (m_target16 == m_vram16) && samplesItself<depth>(*this, y, xmin, xmin + count - 1, YAdjust, clutP);
+    const int chunk = self ? 2 : std::min(count, GPU_WIDTH);
+    uint16_t texels[GPU_WIDTH];
+
+    for (int x = 0; x < count; x += chunk) {
+        const int n = std::min(chunk, count - x);
+#ifdef PCSX_SIMD_X86
+        if ((depth != GPU::TexDepth::Tex16Bits) && m_decodedTexture) {
+            if (PCSX::SIMD::hasAVX2) {
+                fetchDecodedAVX2(*this, texels, n, posX, posY, difX, difY);
+            } else {
+                fetchDecodedScalar(*this, texels, n, posX, posY, difX, difY);
+            }
+        } else if (PCSX::SIMD::hasAVX2) {
+            fetchTexelsAVX2<depth>(*this, texels, n, posX, posY, difX, difY, YAdjust, clutP);
+        } else {
+            fetchTexelsScalar<depth>(*this, texels, n, posX, posY, difX, difY, YAdjust, clutP);
+        }
+#else
+        if ((depth != GPU::TexDepth::Tex16Bits) && m_decodedTexture) {
+            fetchDecodedScalar(*this, texels, n, posX, posY, difX, difY);
+        } else {
+            fetchTexelsScalar<depth>(*this, texels, n, posX, posY, difX, difY, YAdjust, clutP);
+        }
+#endif
+        spanTextured(&m_target16[(y << m_targetShift) + xmin + x], texels, n);
+        posX += n * difX;
+        posY += n * difY;
+    }
+
+    return xmin + count;
+}
+
+template int PCSX::SoftGPU::SoftRenderer::spanTexture<PCSX::GPU::TexDepth::Tex4Bits>(int, int, int, int32_t &,
+                                                                                      int32_t &, int32_t, int32_t,
+                                                                                      int32_t, int32_t);
+template int PCSX::SoftGPU::SoftRenderer::spanTexture<PCSX::GPU::TexDepth::Tex8Bits>(int, int, int, int32_t &,
+                                                                                      int32_t &, int32_t, int32_t,
+                                                                                      int32_t, int32_t);
+template int PCSX::SoftGPU::SoftRenderer::spanTexture<PCSX::GPU::TexDepth::Tex16Bits>(int, int, int, int32_t &,
+                                                                                       int32_t &, int32_t, int32_t,
+                                                                                       int32_t, int32_t);
@@ -0,0 +1,135 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "gpu/soft/texcache.h"
+
+PCSX::SoftGPU::Bands::Tiles PCSX::SoftGPU::TextureCache::sources(GPU::TexDepth depth, int32_t offset, int32_t clut) {
+    const bool tex4 = depth == GPU::TexDepth::Tex4Bits;
+    // Halfwords spanned by a row of texels, which may start in the middle of one with 4 bits textures.
+    const int32_t bytes = tex4 ? (PAGE_SIZE / 2) : PAGE_SIZE;
+    const int32_t start = offset >> 1;
+    const int32_t width = ((offset + bytes - 1) >> 1) - start + 1;
+    const int32_t x = start & (SoftRenderer::GPU_WIDTH - 1);
+    const int32_t y = start >> 10;
+    const int32_t colors = tex4 ? 16 : 256;
+
+    auto tiles = Bands::region(x, y, x + width - 1, y + PAGE_SIZE - 1);
+    tiles |= Bands::region(clut & (SoftRenderer::GPU_WIDTH - 1), clut >> 10,
+                           (clut & (SoftRenderer::GPU_WIDTH - 1)) + colors - 1, clut >> 10);
+    return tiles;
+}
+
+const uint16_t *PCSX::SoftGPU::TextureCache::lookup(const SoftRenderer &state, int clutX, int clutY, Bands &bands) {
+    const auto depth = state.m_globalTextTP;
+    if (depth == GPU::TexDepth::Tex16Bits) return nullptr;
+
+    const int32_t offset = state.textureOffset();
+    const int32_t clut = (clutY << 10) + clutX;
+    const auto tiles = sources(depth, offset, clut);
+    if ((tiles & Bands::region(state.m_drawX, state.m_drawY, state.m_drawW, state.m_drawH)).any()) return nullptr;
+
+    m_uses++;
+    Entry *victim = nullptr;
+    Entry *previous = nullptr;
+    for (auto &entry : m_entries) {
+        if ((entry.lastUse != 0) && (entry.depth == depth) && (entry.offset == offset) && (entry.clut == clut)) {
+            if (entry.valid) {
+                entry.lastUse = m_uses;
+                m_stats.hits++;
+                return entry.texels.get();
+            }
+            previous = &entry;
+            break;
+        }
+        // Least recently used, with the invalidated entries first.
+        if (!victim || (victim->valid && !entry.valid) ||
+            ((victim->valid == entry.valid) && (entry.lastUse < victim->lastUse))) {
+            victim = &entry;
+        }
+    }
+
+    m_stats.misses++;
+    if (previous) {
+        // The entry got invalidated by a write to the page, which either had to wait for
+        // the primitives sampling it to be done, or is still queued itself, and waited on here.
+        victim = previous;
+        bands.claim(tiles, {});
+    } else if (victim->lastUse != 0) {
+        // The queued primitives may still be sampling the page we're about to overwrite.
+        bands.sync();
+    } else {
+        bands.claim(tiles, {});
+    }
+
+    if (victim->valid) {
+        victim->valid = false;
+        m_sources.reset();
+        for (auto &entry : m_entries) {
+            if (entry.valid) m_sources |= entry.sources;
+        }
+    }
+    victim->depth = depth;
+    victim->offset = offset;
+    victim->clut = clut;
+    victim->sources = tiles;
+    victim->lastUse = m_uses;
+    decode(*victim, state);
+    victim->valid = true;
+    m_sources |= tiles;
+    return victim->texels.get();
+}
+
+void PCSX::SoftGPU::TextureCache::decode(Entry &entry, const SoftRenderer &state) {
+    // One extra texel, for the span kernels' gathers, which read 32 bits at a time.
+    if (!entry.texels) entry.texels.reset(new uint16_t[PAGE_SIZE * PAGE_SIZE + 1]());
+
+    const uint16_t *clut = state.m_vram16 + entry.clut;
+    for (int y = 0; y < PAGE_SIZE; y++) {
+        const uint8_t *src = state.m_vram + (y << 11) + entry.offset;
+        uint16_t *dest = entry.texels.get() + y * PAGE_SIZE;
+        if (entry.depth == GPU::TexDepth::Tex4Bits) {
+            for (int x = 0; x < (PAGE_SIZE / 2); x++) {
+                dest[x * 2] = clut[src[x] & 0xf];
+                dest[x * 2 + 1] = clut[src[x] >> 4];
+            }
+        } else {
+            for (int x = 0; x < PAGE_SIZE; x++) dest[x] = clut[src[x]];
+        }
+    }
+}
+
+void PCSX::SoftGPU::TextureCache::invalidate(const Bands::Tiles &writes) {
+    if (!(writes & m_sources).any()) return;
+
+    m_sources.reset();
+    for (auto &entry : m_entries) {
+        if (!entry.valid) continue;
+        if ((entry.sources & writes).any()) {
+            entry.valid = false;
+            m_stats.invalidations++;
+        } else {
+            m_sources |= entry.sources;
+        }
+    }
+}
+
+void PCSX::SoftGPU::TextureCache::clear() {
+    for (auto &entry : m_entries) entry.valid = false;
+    m_sources.reset();
+}
@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "gpu/soft/bands.h"
+#include "gpu/soft/soft.h"
+
+namespace PCSX {
+
+namespace SoftGPU {
+
+// Cache of 4 and 8 bits texture pages, decoded through their CLUT into 15 bits texels, which
+// the flat textured primitives then fetch with a single lookup instead of two. A page is keyed
+// on its depth, its CLUT address, and the VRAM offset the rasterizer addresses its texels from,
+// which accounts for the texture window offset. It is decoded as a whole 256x256 block, indexed
+// by the texture coordinates after the window masking, so that it can be shared by all of the
+// primitives sampling it, whatever their texture window size.
+//
+// Every entry remembers the VRAM tiles it was decoded from, and is dropped as soon as anything
+// writes to one of them. Primitives drawing over the page they sample don't use the cache at
+// all, since they have to see their own pixels.
+class TextureCache {
+  public:
+    static constexpr unsigned ENTRIES = 16;
+    static constexpr int PAGE_SIZE = 256;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        // Entries dropped because of a VRAM write.
+        uint64_t invalidations = 0;
+    };
+
+    // Returns the decoded texture page the renderer state points at, or nullptr if the
+    // primitive can't use one. Decoding a page waits for the bands to be done with whatever
+    // they still have to write to it, or to read from the entry it replaces.
+    const uint16_t *lookup(const SoftRenderer &state, int clutX, int clutY, Bands &bands);
+    // To be called for anything that writes to the VRAM, whether primitives, fills, copies or uploads.
+    void invalidate(const Bands::Tiles &writes);
+    void clear();
+
+    const Stats &stats() const { return m_stats; }
+    void resetStats() { m_stats = {}; }
+
+    // VRAM tiles a texture page, and its CLUT if any, are read from.
+    static Bands::Tiles sources(GPU::TexDepth depth, int32_t offset, int32_t clut);
+
+  private:
+    struct Entry {
+        std::unique_ptr<uint16_t[]> texels;
+        Bands::Tiles sources;
+        GPU::TexDepth depth;
+        int32_t offset = 0;
+        int32_t clut = 0;
+        uint64_t lastUse = 0;
+        bool valid = false;
+    };
+
+    void decode(Entry &entry, const SoftRenderer &state);
+
+    Entry m_entries[ENTRIES];
+    // Union of the sources of the valid entries, to make the writes that hit none of them cheap.
+    Bands::Tiles m_sources;
+    uint64_t m_uses = 0;
+    Stats m_stats;
+};
+
+}  // namespace SoftGPU
+
+}  // namespace PCSX
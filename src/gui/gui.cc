@@ -60,6 +60,7 @@ extern "C" {
 #include "core/sio1-server.h"
 #include "core/sio1.h"
 #include "core/sstate.h"
+#include "core/videorecorder.h"
 #include "core/web-server.h"
 #include "flags.h"
 #include "fmt/chrono.h"
@@ -1162,6 +1163,20 @@ void PCSX::GUI::endFrame() {
                     PCSX::g_emulator->m_cdrom->lidInterrupt();
                 }
                 ImGui::Separator();
+                auto& recorder = g_emulator->m_videoRecorder;
+                if (recorder->recording()) {
+                    if (ImGui::MenuItem(_("Stop video recording"))) recorder->stop();
+                    const auto stats = recorder->stats();
+                    ImGui::TextDisabled(_("%llu frames recorded, %llu dropped, %u queued"),
+                                        (unsigned long long)stats.framesEncoded,
+                                        (unsigned long long)stats.framesDropped, stats.queueDepth);
+                } else if (ImGui::MenuItem(_("Start video recording"))) {
+                    const auto filename =
+                        fmt::format("recording-{:%Y%m%d-%H%M%S}.mkv", fmt::localtime(std::time(nullptr)));
+                    const auto error = recorder->start(filename);
+                    addNotification(error.empty() ? fmt::format(f_("Recording to {}"), filename) : error);
+                }
+                ImGui::Separator();
                 if (ImGui::MenuItem(_("Reboot"))) {
                     g_system->quit(0x12eb007);
                 }
@@ -19,10 +19,12 @@
 
 #include "gui/widgets/gpulogger.h"
 
+#include "core/gpucapture.h"
 #include "core/gpulogger.h"
 #include "core/psxemulator.h"
 #include "core/system.h"
 #include "fmt/format.h"
+#include "imgui_stdlib.h"
 #include "support/imgui-helpers.h"
 
 void PCSX::Widgets::GPULogger::draw(PCSX::GPULogger* logger, const char* title) {
@@ -47,6 +49,20 @@ void PCSX::Widgets::GPULogger::draw(PCSX::GPULogger* logger, const char* title)
     if (ImGui::Button(_("Resume"))) {
         g_system->resume();
     }
+    auto& capture = g_emulator->m_gpuCapture;
+    if (capture->capturing()) {
+        if (ImGui::Button(_("Stop capture"))) capture->stop();
+    } else {
+        if (ImGui::Button(_("Start capture"))) capture->start(m_captureFilename);
+    }
+    ImGui::SameLine();
+    if (capture->capturing()) ImGui::BeginDisabled();
+    ImGui::InputText(_("Capture file"), &m_captureFilename);
+    if (capture->capturing()) ImGui::EndDisabled();
+    ImGuiHelpers::ShowHelpMarker(
+        _("Records all of the commands sent to the GPU, along with the VRAM at the start, into a file which can be "
+          "replayed offline using the gpu-replay tool, or the -gpu-replay command line argument. Captures are best "
+          "started while paused on a vsync breakpoint."));
     ImGui::Checkbox(_("Replay frame"), &m_replay);
     ImGuiHelpers::ShowHelpMarker(
         _("When enabled, the framebuffer will be constantly redrawned using the selected commands, allowing to see the "
@@ -102,6 +118,7 @@ void PCSX::Widgets::GPULogger::draw(PCSX::GPULogger* logger, const char* title)
             m_frameCounterOrigin = logger->m_frameCounter;
         }
         ImGui::Text(_("%i primitives"), logger->m_list.size());
+        ImGui::Text(_("%zu bytes logged"), logger->frameBytes());
         GPU::GPUStats stats;
         for (auto& logged : logger->m_list) {
             logged.cumulateStats(&stats);
@@ -110,9 +127,13 @@ void PCSX::Widgets::GPULogger::draw(PCSX::GPULogger* logger, const char* title)
         ImGui::Text(_("%i textured triangles"), stats.texturedTriangles);
         ImGui::Text(_("%i rectangles"), stats.rectangles);
         ImGui::Text(_("%i sprites"), stats.sprites);
+        ImGui::Text(_("%i lines"), stats.lines);
+        ImGui::Text(_("%i fills"), stats.fills);
+        ImGui::Text(_("%i VRAM copies"), stats.blits);
         ImGui::Text(_("%i pixel writes"), stats.pixelWrites);
         ImGui::Text(_("%i pixel reads"), stats.pixelReads);
         ImGui::Text(_("%i texel reads"), stats.texelReads);
+        ImGui::Text(_("%i semi-transparent pixels"), stats.semiTransparentPixels);
 
         ImGui::TreePop();
     }
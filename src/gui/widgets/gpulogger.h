@@ -22,6 +22,7 @@
 #include <stdint.h>
 
 #include <limits>
+#include <string>
 
 namespace PCSX {
 class GPULogger;
@@ -40,6 +41,7 @@ class GPULogger {
     bool m_setHighlightRange = false;
     bool m_hoverHighlight = false;
     uint64_t m_frameCounterOrigin = 0;
+    std::string m_captureFilename = "capture.gpu";
     unsigned m_beginHighlight = 0;
     unsigned m_endHighlight = std::numeric_limits<unsigned>::max();
 };
@@ -17,19 +17,28 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
  ***************************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <map>
 #include <string>
 
 #include "core/arguments.h"
+#include "core/audiodump.h"
 #include "core/cdrom.h"
+#include "core/framehashes.h"
 #include "core/gpu.h"
+#include "core/gpucapture.h"
+#include "core/gpucounters.h"
+#include "core/gteprofiler.h"
 #include "core/logger.h"
 #include "core/psxemulator.h"
 #include "core/r3000a.h"
 #include "core/sstate.h"
+#include "core/system.h"
 #include "core/ui.h"
+#include "core/videorecorder.h"
 #include "flags.h"
 #include "fmt/chrono.h"
 #include "gui/gui.h"
@@ -364,7 +373,16 @@ runner.init({
 
     // Starting up the whole emulator; we delay setting the GPU only now because why not.
     auto &emuSettings = emulator->settings;
+    // Dumping the audio goes without the audio device, and as fast as the emulation can go.
+    auto audioDump = args.get<std::string>("audio-dump");
+    emulator->m_spu->setHeadless(audioDump.has_value() || args.get<bool>("audio-headless", false));
     emulator->m_spu->open();
+    // The PGXP mode isn't a setting, but the benchmarks need to pick it: 0 is disabled, 1 memory only, 2 full.
+    auto pgxpMode = args.get<int>("pgxp-mode");
+    if (pgxpMode.has_value()) {
+        emulator->config().PGXP_Mode = std::clamp(pgxpMode.value(), 0, 2);
+        emulator->config().PGXP_GTE = emulator->config().PGXP_Mode > 0;
+    }
     emulator->init();
     emulator->m_gpu->init(s_ui);
     emulator->m_gpu->setDither(emuSettings.get<PCSX::Emulator::SettingDither>());
@@ -434,6 +452,74 @@ runner.init({
 
             system->m_inStartup = false;
 
+            // Replaying a GPU capture only needs the GPU, and exits once done.
+            auto gpuReplay = args.get<std::string>("gpu-replay");
+            if (gpuReplay.has_value()) {
+                const int loops = std::max(args.get<int>("gpu-replay-loops", 1), 1);
+                system->quit(PCSX::GPUCapture::benchmark(emulator->m_gpu.get(), gpuReplay.value(), loops));
+            }
+
+            // Recording from the very first frame, for the batch runs.
+            auto record = args.get<std::string>("record");
+            if (record.has_value()) {
+                auto error = emulator->m_videoRecorder->start(record.value());
+                if (!error.empty()) fmt::print(stderr, "{}\n", error);
+            }
+
+            // The SPU output as an audio file, and maybe each of the voices into their own.
+            if (audioDump.has_value()) {
+                auto error = emulator->m_audioDump->start(audioDump.value(), args.get<bool>("audio-stems", false));
+                if (!error.empty()) fmt::print(stderr, "{}\n", error);
+            }
+
+            // Hashing the displayed frames, and maybe checking them against a golden log. A golden log
+            // which can't be loaded fails the run, instead of silently comparing nothing.
+            auto frameHashes = args.get<std::string>("frame-hashes");
+            auto goldenHashes = args.get<std::string>("frame-hashes-golden");
+            if (frameHashes.has_value() || goldenHashes.has_value()) {
+                auto error = emulator->m_frameHashes->start(frameHashes.value_or(""));
+                if (error.empty() && goldenHashes.has_value()) {
+                    error = emulator->m_frameHashes->loadGolden(goldenHashes.value());
+                }
+                if (!error.empty()) {
+                    fmt::print(stderr, "{}\n", error);
+                    system->quit(1);
+                }
+            }
+
+            // The GPU counters of every frame, as a CSV file.
+            auto gpuCounters = args.get<std::string>("gpu-counters");
+            if (gpuCounters.has_value()) {
+                auto error = emulator->m_gpuCounters->start(gpuCounters.value());
+                if (!error.empty()) fmt::print(stderr, "{}\n", error);
+            }
+
+            // The GTE commands' statistics of every frame, as a CSV file.
+            auto gteProfiler = args.get<std::string>("gte-profiler");
+            if (gteProfiler.has_value()) {
+                auto error = emulator->m_gteProfiler->start(gteProfiler.value());
+                if (!error.empty()) fmt::print(stderr, "{}\n", error);
+            }
+
+            // Timing a number of frames, after a few more to warm up, then quitting. The interpreter's
+            // PGXP mode is part of the report, since this is what tools/pgxp-bench compares.
+            PCSX::EventBus::Listener benchListener(system->m_eventBus);
+            const int benchFrames = args.get<int>("bench-frames", 0);
+            if (benchFrames > 0) {
+                const int warmup = std::max(args.get<int>("bench-warmup", 60), 0);
+                benchListener.listen<PCSX::Events::GPU::VSync>(
+                    [emulator, system, benchFrames, warmup, frame = 0,
+                     start = std::chrono::steady_clock::now()](auto event) mutable {
+                        if (frame == warmup) start = std::chrono::steady_clock::now();
+                        if (frame++ != warmup + benchFrames) return;
+                        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                        fmt::print("PGXP mode {}: {} frames in {:.3f} s, {:.3f} ms per frame\n",
+                                   emulator->config().PGXP_Mode, benchFrames, elapsed.count(),
+                                   elapsed.count() * 1000.0 / benchFrames);
+                        system->quit(0);
+                    });
+            }
+
             // And finally, main loop.
             while (!system->quitting()) {
                 if (system->running()) {
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/adpcmcache.h"
+
+#include <algorithm>
+
+namespace {
+
+// Only the first 5 filters exist; the hardware clamps the others to the last one.
+constexpr int32_t c_filters[5][2] = {{0, 0}, {60, 0}, {115, -52}, {98, -55}, {122, -60}};
+
+}  // namespace
+
+PCSX::SPU::ADPCMCache::ADPCMCache()
+    : m_entries(new Entry[ENTRIES]), m_generations(new std::atomic<uint32_t>[RAM_SIZE / BLOCK_SIZE]) {
+    for (uint32_t i = 0; i < RAM_SIZE / BLOCK_SIZE; i++) m_generations[i].store(0, std::memory_order_relaxed);
+}
+
+void PCSX::SPU::ADPCMCache::filter(const Entry &entry, int32_t *samples, int32_t s1, int32_t s2) {
+    const int32_t f0 = c_filters[entry.filter][0];
+    const int32_t f1 = c_filters[entry.filter][1];
+    for (unsigned i = 0; i < SAMPLES; i++) {
+        const int32_t sample = entry.nibbles[i] + ((s1 * f0) >> 6) + ((s2 * f1) >> 6);
+        s2 = s1;
+        s1 = sample;
+        samples[i] = sample;
+    }
+}
+
+void PCSX::SPU::ADPCMCache::decode(const uint8_t *ram, uint32_t addr, int32_t *samples, int32_t &s1, int32_t &s2) {
+    const uint32_t block = (addr / BLOCK_SIZE) % (RAM_SIZE / BLOCK_SIZE);
+    Entry &entry = m_entries[block % ENTRIES];
+    const uint32_t generation = m_generations[block].load(std::memory_order_acquire);
+
+    if ((entry.block == block) && (entry.generation == generation)) {
+        if ((entry.filter == 0) || ((entry.s1 == s1) && (entry.s2 == s2))) {
+            m_stats.hits++;
+        } else {
+            m_stats.refilters++;
+            filter(entry, entry.samples, s1, s2);
+            entry.s1 = s1;
+            entry.s2 = s2;
+        }
+    } else {
+        m_stats.misses++;
+        const uint8_t *data = ram + block * BLOCK_SIZE;
+        const unsigned shift = data[0] & 0xf;
+        entry.block = block;
+        entry.generation = generation;
+        entry.filter = std::min(data[0] >> 4, 4);
+        for (unsigned i = 0; i < SAMPLES; i++) {
+            // The nibbles go in the top of a 16 bits word, and are shifted back down from there.
+            const int16_t nibble = int16_t(((data[2 + i / 2] >> ((i & 1) * 4)) & 0xf) << 12);
+            entry.nibbles[i] = nibble >> shift;
+        }
+        filter(entry, entry.samples, s1, s2);
+        entry.s1 = s1;
+        entry.s2 = s2;
+    }
+
+    std::copy(entry.samples, entry.samples + SAMPLES, samples);
+    s1 = entry.samples[SAMPLES - 1];
+    s2 = entry.samples[SAMPLES - 2];
+}
+
+void PCSX::SPU::ADPCMCache::invalidate(uint32_t addr, uint32_t size) {
+    if (size == 0) return;
+    size = std::min(size, RAM_SIZE);
+    const uint32_t first = (addr % RAM_SIZE) / BLOCK_SIZE;
+    // Counting the blocks the range overlaps, including the partial ones at both ends.
+    const uint32_t count = (((addr % BLOCK_SIZE) + size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    for (uint32_t i = 0; i < std::min(count, RAM_SIZE / BLOCK_SIZE); i++) {
+        m_generations[(first + i) % (RAM_SIZE / BLOCK_SIZE)].fetch_add(1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace PCSX {
+
+namespace SPU {
+
+// Decoded ADPCM blocks of the SPU RAM, so that looping instruments, and samples played by
+// several voices at once, don't get decoded over and over again. The decoding of a block is
+// split in two: the shifted nibbles, which only depend on the 16 bytes of the block, and the
+// prediction filter, which also depends on the last two samples before it. Both are kept, along
+// with the filter history they were run from, so a block played again with the same history, or
+// with the filter 0, which ignores it, costs a copy; a different history only runs the filter.
+//
+// The cache is direct mapped on the block's address. The writes to the SPU RAM, done by the
+// emulation thread while the SPU thread is decoding, bump a generation count for each block
+// they touch, after the memory is written; an entry is only good for the generation it was
+// decoded at, which makes sure a decoding racing with a write can't outlive it.
+class ADPCMCache {
+  public:
+    static constexpr uint32_t RAM_SIZE = 512 * 1024;
+    static constexpr uint32_t BLOCK_SIZE = 16;
+    static constexpr unsigned SAMPLES = 28;
+    static constexpr unsigned ENTRIES = 4096;
+
+    struct Stats {
+        // Blocks copied as they were, blocks which only had to go through the filter again,
+        // and blocks decoded from scratch.
+        uint64_t hits = 0;
+        uint64_t refilters = 0;
+        uint64_t misses = 0;
+    };
+
+    ADPCMCache();
+
+    // Decodes the block at addr of the SPU RAM into 28 samples, continuing from the filter
+    // history s1 and s2, the last sample and the one before, which are then updated.
+    void decode(const uint8_t *ram, uint32_t addr, int32_t *samples, int32_t &s1, int32_t &s2);
+    // To be called once size bytes of the SPU RAM at addr have been written, wrapping around.
+    void invalidate(uint32_t addr, uint32_t size);
+    void invalidateAll() { invalidate(0, RAM_SIZE); }
+
+    const Stats &stats() const { return m_stats; }
+    void resetStats() { m_stats = {}; }
+
+  private:
+    struct Entry {
+        uint32_t block = ~0u;
+        uint32_t generation = 0;
+        uint8_t filter = 0;
+        int32_t s1 = 0;
+        int32_t s2 = 0;
+        int16_t nibbles[SAMPLES];
+        int32_t samples[SAMPLES];
+    };
+
+    static void filter(const Entry &entry, int32_t *samples, int32_t s1, int32_t s2);
+
+    std::unique_ptr<Entry[]> m_entries;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_generations;
+    Stats m_stats;
+};
+
+}  // namespace SPU
+
+}  // namespace PCSX
@@ -88,6 +88,28 @@ with some games, but slows SPU processing.)"));
     changed |= ImGui::Checkbox(_("Capture/decode buffer IRQ"), &settings.get<DBufIRQ>().value);
     ImGuiHelpers::ShowHelpMarker(
         _("Activates SPU IRQs based on writes to the decode/capture buffer. This option is necessary for some games."));
+    changed |= ImGui::Checkbox(_("Synchronous"), &settings.get<Synchronous>().value);
+    ImGuiHelpers::ShowHelpMarker(_(R"(Runs the SPU in lockstep with the emulated CPU,
+instead of on its own thread. The sound becomes
+deterministic, and register writes take effect
+on the exact sample, at the cost of some speed.
+IRQs are still raised when the SPU catches up,
+up to ten samples after they occurred.
+Requires a restart of the emulator.)"));
+    changed |= ImGui::Checkbox(_("Dynamic rate control"), &settings.get<DynamicRate>().value);
+    ImGuiHelpers::ShowHelpMarker(_(R"(Keeps only a small amount of audio buffered
+ahead of the device, by adjusting the output
+pitch by a fraction of a percent whenever the
+emulation and the device drift apart. Lowers
+the audio latency down to the target below.)"));
+    if (settings.get<DynamicRate>()) {
+        changed |= ImGui::SliderInt(_("Latency target (ms)"), &settings.get<LatencyTarget>().value, 5, 40);
+        ImGui::Text(_("Buffered: %.1f ms, rate: %.4f"), m_audioOut.getBytesBuffered() * 1000.0 / 44100.0,
+                    m_audioOut.getRate());
+    }
+    ImGui::Text(_("Underruns: %u, dropped frames: %u"), m_audioOut.getUnderruns(), m_audioOut.getDroppedFrames());
+    ImGui::SameLine();
+    if (ImGui::Button(_("Reset counters"))) m_audioOut.resetCounters();
 
     ImGui::End();
     return changed;
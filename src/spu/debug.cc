@@ -160,6 +160,15 @@ void PCSX::SPU::impl::debug() {
                 ImGui::TextUnformatted(_("Irq addr:\nCtrl:\nStat:\nSpu mem:"));
                 ImGui::SameLine();
                 ImGui::Text("%li\n%04x\n%04x\n%i", pSpuIrq ? -1 : pSpuIrq - spuMemC, spuCtrl, spuStat, spuAddr);
+                const auto &stats = m_adpcmCache.stats();
+                const uint64_t blocks = stats.hits + stats.refilters + stats.misses;
+                ImGui::TextUnformatted(_("ADPCM cache"));
+                ImGui::TextUnformatted(_("Hits:\nRefiltered:\nDecoded:\nHit rate:"));
+                ImGui::SameLine();
+                ImGui::Text("%llu\n%llu\n%llu\n%.1f%%", (unsigned long long)stats.hits,
+                            (unsigned long long)stats.refilters, (unsigned long long)stats.misses,
+                            blocks ? 100.0 * (stats.hits + stats.refilters) / blocks : 0.0);
+                if (ImGui::Button(_("Reset"))) m_adpcmCache.resetStats();
             }
             ImGui::EndChild();
         }
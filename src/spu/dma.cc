@@ -29,6 +29,7 @@
 
 // SPU RAM -> Main RAM DMA
 void PCSX::SPU::impl::readDMAMem(uint16_t* mainMem, int size) {
+    catchUp();
     if (pMixIrq) cbMtx.lock();
 
     for (int i = 0; i < size; i++) {
@@ -58,12 +59,15 @@ void PCSX::SPU::impl::resetCaptureBuffer() {
 
 // Main RAM -> SPU RAM DMA
 void PCSX::SPU::impl::writeDMAMem(uint16_t* mainMem, int size) {
+    catchUp();
     if (pMixIrq) cbMtx.lock();
 
+    const uint32_t addr = spuAddr;
     for (int i = 0; i < size; i++) {
         spuMem[spuAddr >> 1] = *mainMem++;  // Copy 2 bytes
         spuAddr = (spuAddr + 2) & 0x7ffff;  // Increment SPU address and wrap around
     }
+    m_adpcmCache.invalidate(addr, size * 2);
 
     if (pMixIrq) cbMtx.unlock();
     iSpuAsyncWait = 0;
@@ -38,6 +38,7 @@
 #include "spu/registers.h"
 
 void PCSX::SPU::impl::save(SaveStates::SPU &spu) {
+    catchUp();
     RemoveThread();
 
     // Capture buffer
@@ -101,6 +102,7 @@ void PCSX::SPU::impl::load(const SaveStates::SPU &spu) {
     capBufVoiceIndex = spu.get<SaveStates::CBVoiceIndex>().value;
 
     spu.get<SaveStates::SPURam>().copyTo(reinterpret_cast<uint8_t *>(spuMem));
+    m_adpcmCache.invalidateAll();
     spu.get<SaveStates::SPUPorts>().copyTo(reinterpret_cast<uint8_t *>(regArea));
 
 #if 0
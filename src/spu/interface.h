@@ -27,8 +27,10 @@
 #include "core/spu.h"
 #include "core/sstate.h"
 #include "json.hpp"
+#include "spu/adpcmcache.h"
 #include "spu/adsr.h"
 #include "spu/miniaudio.h"
+#include "spu/reverbengine.h"
 #include "spu/types.h"
 #include "support/settings.h"
 
@@ -80,7 +82,11 @@ class impl final : public SPUInterface {
         }
     }
     uint32_t getCurrentFrames() override { return m_audioOut.getCurrentFrames(); }
-    void waitForGoal(uint32_t goal) override { m_audioOut.waitForGoal(goal); }
+    void waitForGoal(uint32_t goal) override {
+        if (!m_headless) m_audioOut.waitForGoal(goal);
+    }
+    uint32_t getLatencyTarget() override { return m_headless ? 0 : m_audioOut.getLatencyTarget(); }
+    void setHeadless(bool headless) override { m_headless = headless; }
 
   private:
     struct ADSRFlags {
@@ -153,6 +159,8 @@ class impl final : public SPUInterface {
 
     // spu
     void MainThread();
+    void mix(int count);
+    void catchUp();
     void writeCaptureBufferCD(int numbSamples);
     void SetupStreams();
     void RemoveStreams();
@@ -177,15 +185,12 @@ class impl final : public SPUInterface {
     void ReverbOn(int start, int end, uint16_t val);
 
     // reverb
-    int g_buffer(int iOff);              // get_buffer content helper: takes care about wraps
-    void s_buffer(int iOff, int iVal);   // set_buffer content helper: takes care about wraps and clipping
-    void s_buffer1(int iOff, int iVal);  // set_buffer (+1 sample) content helper: takes care about wraps and clipping
     void InitREVERB();
     void SetREVERB(uint16_t val);
     void StartREVERB(SPUCHAN *pChannel);
     void StoreREVERB(SPUCHAN *pChannel, int ns);
-    int MixREVERBLeft(int ns);
-    int MixREVERBRight();
+    // Adds the reverb of the block into SSumL and SSumR.
+    void MixREVERB(int count);
 
     // xa
     void FeedXA(xa_decode_t *xap);
@@ -225,6 +230,7 @@ class impl final : public SPUInterface {
 
     SPUCHAN s_chan[MAXCHAN + 1];  // channel + 1 infos (1 is security for fmod handling)
     REVERBInfo rvb;
+    ReverbEngine m_reverb{&m_adpcmCache};
 
     uint32_t m_noiseClock = 0;  // global noise generator
     uint32_t m_noiseCount = 0;  // global noise generator
@@ -239,21 +245,26 @@ class impl final : public SPUInterface {
     int bSpuInit = 0;
 
     std::thread hMainThread;
+    // In synchronous mode, there is no thread: the SPU is run from the emulation thread, as many
+    // samples as the CPU cycles elapsed since the last time, before anything can see or change
+    // its state. m_syncCycle is the cycle the last mixed sample ended at.
+    bool m_synchronous = false;
+    uint32_t m_syncCycle = 0;
+    // Mixes synchronously, and only ever hands the samples over to the recorders, never to the
+    // audio device, nor waits for it.
+    bool m_headless = false;
     uint32_t dwNewChannel = 0;  // flags for faster testing, if new channel starts
 
     void (*cddavCallback)(uint16_t, uint16_t) = 0;
 
     // certain globals (were local before, but with the new timeproc I need em global)
 
-    const int f[5][2] = {{0, 0}, {60, 0}, {115, -52}, {98, -55}, {122, -60}};
     int SSumR[NSSIZE];
     int SSumL[NSSIZE];
     int iFMod[NSSIZE];
     int iCycle = 0;
     int16_t *pS;
 
-    int lastch = -1;       // last channel processed on spu irq in timer mode
-    int lastns = 0;        // last ns pos
     int iSecureStart = 0;  // secure start counter
     int iSpuAsyncWait = 0;
 
@@ -281,6 +292,7 @@ class impl final : public SPUInterface {
     int &gvalr(int pos) { return gauss_window[4 + ((gauss_ptr + pos) & 3)]; }
 
     ADSR m_adsr;
+    ADPCMCache m_adpcmCache;
     MiniAudio m_audioOut = {settings};
     xa_decode_t m_cdda;
 
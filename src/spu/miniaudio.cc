@@ -178,6 +178,18 @@ void PCSX::SPU::MiniAudio::maybeRestart() {
     }
 }
 
+bool PCSX::SPU::MiniAudio::tryFeedStreamData(const Frame* data, size_t frames) {
+    const size_t target = getLatencyTarget();
+    if (target) {
+        m_rateControl.update(m_voicesStream.buffered(), target);
+        frames = m_rateControl.process(reinterpret_cast<const int16_t*>(data), frames, m_resampled);
+        data = reinterpret_cast<const Frame*>(m_resampled.data());
+    }
+    if (m_voicesStream.enqueue(data, frames, std::chrono::milliseconds{0})) return true;
+    m_droppedFrames += frames;
+    return false;
+}
+
 void PCSX::SPU::MiniAudio::callback(ma_device* device, float* output, ma_uint32 frameCount) {
     if (frameCount > VoiceStream::BUFFER_SIZE) {
         throw std::runtime_error("Too many frames requested by miniaudio");
@@ -191,8 +203,9 @@ void PCSX::SPU::MiniAudio::callback(ma_device* device, float* output, ma_uint32
     for (unsigned i = 0; i < STREAMS; i++) {
         size_t a = i == 0 ? m_voicesStream.dequeue(buffers[i].data(), frameCount)
                           : m_audioStream.dequeue(buffers[i].data(), frameCount);
+        // It's fine if it happens on stream 1 (cdda), which is often simply idle.
+        if ((i == 0) && (a < frameCount)) m_underruns++;
         for (size_t f = (muted ? 0 : a); f < frameCount; f++) {
-            // maybe warn about underflow? tho it's fine if it happens on stream 1 (cdda)
             buffers[i][f] = {};
         }
     }
@@ -21,6 +21,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <string>
@@ -35,6 +36,7 @@
 #define MA_NO_WAV
 
 #include "miniaudio/miniaudio.h"
+#include "spu/ratecontrol.h"
 #include "spu/settings.h"
 #include "support/circular.h"
 #include "support/eventbus.h"
@@ -76,6 +78,10 @@ class MiniAudio {
                 return false;
         }
     }
+    // Same as above, for the voices stream, but drops the frames instead of waiting if the
+    // device is behind. With the dynamic rate control on, the frames are resampled first, so
+    // that the device's buffer stays around the latency target.
+    bool tryFeedStreamData(const Frame* data, size_t frames);
     size_t getBytesBuffered(unsigned streamId = 0) {
         switch (streamId) {
             case 0:
@@ -106,6 +112,22 @@ class MiniAudio {
 #endif
     }
 
+    // The number of frames the voices stream should ideally hold, or 0 if the dynamic rate
+    // control is off, in which case it's simply kept as full as possible.
+    size_t getLatencyTarget() {
+        if (!m_settings.get<DynamicRate>()) return 0;
+        return std::clamp(m_settings.get<LatencyTarget>().value, 5, 40) * 44100 / 1000;
+    }
+    double getRate() { return m_rateControl.ratio(); }
+    // How many times the device found fewer frames than it needed, and how many frames were
+    // dropped because it had no room for them.
+    uint32_t getUnderruns() { return m_underruns.load(); }
+    uint32_t getDroppedFrames() { return m_droppedFrames.load(); }
+    void resetCounters() {
+        m_underruns = 0;
+        m_droppedFrames = 0;
+    }
+
   private:
     static constexpr unsigned STREAMS = 2;
     SettingsType& m_settings;
@@ -143,6 +165,11 @@ class MiniAudio {
     std::vector<std::string> m_devices;
 
     std::atomic<ma_uint32> m_frameCount;
+
+    RateControl m_rateControl;
+    std::vector<int16_t> m_resampled;
+    std::atomic<uint32_t> m_underruns = 0;
+    std::atomic<uint32_t> m_droppedFrames = 0;
 };
 
 }  // namespace SPU
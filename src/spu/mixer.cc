@@ -0,0 +1,234 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/mixer.h"
+
+#include <algorithm>
+
+#include "spu/gauss.h"
+#include "support/simd.h"
+
+namespace {
+
+using Block = PCSX::SPU::Mixer::Block;
+
+// The scalar versions pick up at sample first, where the vector ones stopped.
+
+void gaussScalar(Block &block, unsigned first, unsigned count) {
+    for (unsigned i = first; i < count; i++) {
+        const int vl = (block.phase[i] >> 6) & ~3;
+        int vr = (Gauss::gauss[vl] * block.taps[0][i]) & ~2047;
+        vr += (Gauss::gauss[vl + 1] * block.taps[1][i]) & ~2047;
+        vr += (Gauss::gauss[vl + 2] * block.taps[2][i]) & ~2047;
+        vr += (Gauss::gauss[vl + 3] * block.taps[3][i]) & ~2047;
+        block.samples[i] = vr >> 11;
+    }
+}
+
+void cubicScalar(Block &block, unsigned first, unsigned count) {
+    for (unsigned i = first; i < count; i++) {
+        const int32_t xd = (block.phase[i] >> 1) + 1;
+        const int32_t t0 = block.taps[0][i];
+        const int32_t t1 = block.taps[1][i];
+        const int32_t t2 = block.taps[2][i];
+        const int32_t t3 = block.taps[3][i];
+        // The products are allowed to wrap around, like they always did.
+        int32_t fa = t3 - 3 * t2 + 3 * t1 - t0;
+        fa = int32_t(int64_t(fa) * ((xd - (2 << 15)) / 6));
+        fa >>= 15;
+        fa += t2 - t1 - t1 + t0;
+        fa = int32_t(int64_t(fa) * ((xd - (1 << 15)) >> 1));
+        fa >>= 15;
+        fa += t1 - t0;
+        fa = int32_t(int64_t(fa) * xd);
+        fa >>= 15;
+        block.samples[i] = fa + t0;
+    }
+}
+
+void envelopeScalar(Block &block, unsigned first, unsigned count) {
+    for (unsigned i = first; i < count; i++) block.samples[i] = (block.envelope[i] * block.samples[i]) / 1023;
+}
+
+void panScalar(const Block &block, unsigned first, unsigned count, int32_t left, int32_t right, int32_t *sumLeft,
+               int32_t *sumRight) {
+    for (unsigned i = first; i < count; i++) {
+        sumLeft[i] += (block.samples[i] * left) / 0x4000;
+        sumRight[i] += (block.samples[i] * right) / 0x4000;
+    }
+}
+
+#ifdef PCSX_SIMD_X86
+
+// The vector versions return how many samples they went through, a multiple of 8.
+
+AVX2_FUNC __m256i load(const int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+AVX2_FUNC void store(int32_t *p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+
+// Integer division, truncated towards zero, through doubles: all of the dividends fit in the
+// mantissa, and no quotient can get close enough to an integer to be rounded over it.
+AVX2_FUNC __m256i divide(__m256i a, double divisor) {
+    const __m256d d = _mm256_set1_pd(divisor);
+    const __m128i lo = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(a)), d));
+    const __m128i hi = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1)), d));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+AVX2_FUNC unsigned gaussVector(Block &block, unsigned count) {
+    const __m256i mask = _mm256_set1_epi32(~2047);
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i vl = _mm256_and_si256(_mm256_srai_epi32(load(block.phase + i), 6), _mm256_set1_epi32(~3));
+        __m256i vr = _mm256_setzero_si256();
+        for (unsigned k = 0; k < 4; k++) {
+            const __m256i weight = _mm256_i32gather_epi32(Gauss::gauss + k, vl, 4);
+            vr = _mm256_add_epi32(vr, _mm256_and_si256(_mm256_mullo_epi32(weight, load(block.taps[k] + i)), mask));
+        }
+        store(block.samples + i, _mm256_srai_epi32(vr, 11));
+    }
+    return i;
+}
+
+AVX2_FUNC unsigned cubicVector(Block &block, unsigned count) {
+    const __m256i three = _mm256_set1_epi32(3);
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i xd = _mm256_add_epi32(_mm256_srai_epi32(load(block.phase + i), 1), _mm256_set1_epi32(1));
+        const __m256i t0 = load(block.taps[0] + i);
+        const __m256i t1 = load(block.taps[1] + i);
+        const __m256i t2 = load(block.taps[2] + i);
+        const __m256i t3 = load(block.taps[3] + i);
+        __m256i fa = _mm256_sub_epi32(t3, _mm256_mullo_epi32(t2, three));
+        fa = _mm256_add_epi32(fa, _mm256_mullo_epi32(t1, three));
+        fa = _mm256_sub_epi32(fa, t0);
+        fa = _mm256_mullo_epi32(fa, divide(_mm256_sub_epi32(xd, _mm256_set1_epi32(2 << 15)), 6.0));
+        fa = _mm256_srai_epi32(fa, 15);
+        fa = _mm256_add_epi32(fa, _mm256_add_epi32(_mm256_sub_epi32(_mm256_sub_epi32(t2, t1), t1), t0));
+        fa = _mm256_mullo_epi32(fa, _mm256_srai_epi32(_mm256_sub_epi32(xd, _mm256_set1_epi32(1 << 15)), 1));
+        fa = _mm256_srai_epi32(fa, 15);
+        fa = _mm256_add_epi32(fa, _mm256_sub_epi32(t1, t0));
+        fa = _mm256_srai_epi32(_mm256_mullo_epi32(fa, xd), 15);
+        store(block.samples + i, _mm256_add_epi32(fa, t0));
+    }
+    return i;
+}
+
+AVX2_FUNC unsigned envelopeVector(Block &block, unsigned count) {
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i product = _mm256_mullo_epi32(load(block.envelope + i), load(block.samples + i));
+        store(block.samples + i, divide(product, 1023.0));
+    }
+    return i;
+}
+
+// x / 0x4000, truncated towards zero like the C division.
+AVX2_FUNC __m256i divide0x4000(__m256i x) {
+    const __m256i bias = _mm256_and_si256(_mm256_srai_epi32(x, 31), _mm256_set1_epi32(0x3fff));
+    return _mm256_srai_epi32(_mm256_add_epi32(x, bias), 14);
+}
+
+AVX2_FUNC unsigned panVector(const Block &block, unsigned count, int32_t left, int32_t right, int32_t *sumLeft,
+                             int32_t *sumRight) {
+    const __m256i l = _mm256_set1_epi32(left);
+    const __m256i r = _mm256_set1_epi32(right);
+    unsigned i = 0;
+    for (; (i + 8) <= count; i += 8) {
+        const __m256i samples = load(block.samples + i);
+        store(sumLeft + i, _mm256_add_epi32(load(sumLeft + i), divide0x4000(_mm256_mullo_epi32(samples, l))));
+        store(sumRight + i, _mm256_add_epi32(load(sumRight + i), divide0x4000(_mm256_mullo_epi32(samples, r))));
+    }
+    return i;
+}
+
+#endif
+
+}  // namespace
+
+bool PCSX::SPU::Mixer::vectorized() {
+#ifdef PCSX_SIMD_X86
+    return PCSX::SIMD::hasAVX2;
+#else
+    return false;
+#endif
+}
+
+#ifdef PCSX_SIMD_X86
+#define VECTOR(call) ((PCSX::SIMD::hasAVX2 && !forceScalar) ? call : 0)
+#else
+#define VECTOR(call) 0
+#endif
+
+void PCSX::SPU::Mixer::gauss(Block &block, unsigned count, bool forceScalar) {
+    gaussScalar(block, VECTOR(gaussVector(block, count)), count);
+}
+
+void PCSX::SPU::Mixer::cubic(Block &block, unsigned count, bool forceScalar) {
+    cubicScalar(block, VECTOR(cubicVector(block, count)), count);
+}
+
+void PCSX::SPU::Mixer::envelope(Block &block, unsigned count, bool forceScalar) {
+    envelopeScalar(block, VECTOR(envelopeVector(block, count)), count);
+}
+
+void PCSX::SPU::Mixer::pan(const Block &block, unsigned count, int32_t left, int32_t right, int32_t *sumLeft,
+                           int32_t *sumRight, bool forceScalar) {
+    panScalar(block, VECTOR(panVector(block, count, left, right, sumLeft, sumRight)), count, left, right, sumLeft,
+              sumRight);
+}
+
+void PCSX::SPU::Mixer::voice(Block &block, unsigned ns, unsigned count, const Voice &voice, const Outputs &outputs,
+                             int32_t &sval, bool forceScalar) {
+    if (voice.interpolation == 3) {
+        cubic(block, ns, forceScalar);
+    } else if (voice.interpolation == 2) {
+        gauss(block, ns, forceScalar);
+    }
+    envelope(block, ns, forceScalar);  // mix adsr
+
+    // A stopped voice fills the rest of the block with silence in the capture buffer.
+    if (outputs.capture) {
+        int32_t &index = *outputs.captureIndex;
+        for (unsigned c = 0; c < ns; c++) {
+            outputs.capture[index] = std::min(0xFFFF, std::max(-0xFFFF, block.samples[c]));
+            index = (index + 1) % 0x200;
+        }
+        if (ns < count) {
+            for (unsigned c = ns; c < count; c++) outputs.capture[index + c] = 0;
+            index = (index + (count - ns)) % 0x200;
+        }
+    }
+
+    if (ns == 0) return;
+
+    if (voice.fmodSource) {
+        if (outputs.fmod) {
+            for (unsigned c = 0; c < ns; c++) outputs.fmod[c] = block.samples[c];
+        }
+        sval = block.samples[ns - 1];
+        return;
+    }
+
+    if (!voice.mute) pan(block, ns, voice.left, voice.right, outputs.sumLeft, outputs.sumRight, forceScalar);
+    if (outputs.reverb) {
+        for (unsigned c = 0; c < ns; c++) outputs.reverb[c] = voice.mute ? 0 : block.samples[c];
+    }
+    sval = voice.mute ? 0 : block.samples[ns - 1];
+}
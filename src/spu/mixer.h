@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+namespace PCSX {
+
+namespace SPU {
+
+// The arithmetic part of mixing a voice: interpolation, envelope, and volume. The mixer steps
+// a voice through a whole block of samples first, decoding, running the envelope and the noise
+// as it goes, and records what each sample needs here, as structure of arrays; these then run
+// over the block, eight samples at a time in 32 bits vector lanes when the host can, and one
+// sample at a time in plain C++ otherwise. Both give the same samples, bit for bit, as the
+// original per sample code did.
+class Mixer {
+  public:
+    // Large enough for the SPU thread's blocks, and a multiple of the vector width.
+    static constexpr unsigned BLOCK = 48;
+
+    struct Block {
+        // The four samples of the interpolation ring, oldest first, and the position between
+        // them, in 1.16 fixed point, as seen by each output sample.
+        int32_t taps[4][BLOCK];
+        int32_t phase[BLOCK];
+        // The envelope level, from 0 to 1023.
+        int32_t envelope[BLOCK];
+        // The voice's samples, filled in by the interpolation kernels or by the caller, and then
+        // scaled in place by the envelope.
+        int32_t samples[BLOCK];
+    };
+
+    // Whether the vectorized versions are going to be used on this host.
+    static bool vectorized();
+
+    // Interpolate the samples out of the taps and phases.
+    static void gauss(Block &block, unsigned count, bool forceScalar = false);
+    static void cubic(Block &block, unsigned count, bool forceScalar = false);
+    // samples = samples * envelope / 1023
+    static void envelope(Block &block, unsigned count, bool forceScalar = false);
+    // Accumulates the samples into the left and right sums, the volumes going from 0 to 0x3fff.
+    static void pan(const Block &block, unsigned count, int32_t left, int32_t right, int32_t *sumLeft,
+                    int32_t *sumRight, bool forceScalar = false);
+
+    // How a voice's samples are mixed in.
+    struct Voice {
+        // 2 for Gauss and 3 for cubic, the block holding taps and phases; anything else, and the
+        // block already holds the samples.
+        int interpolation = 0;
+        // The voice modulates the next one's pitch, instead of being heard.
+        bool fmodSource = false;
+        // The debug mute: the voice goes on, but is neither heard nor sent to the reverb.
+        bool mute = false;
+        int32_t left = 0;
+        int32_t right = 0;
+    };
+
+    // Where the mixed voice goes. Only the sums are required.
+    struct Outputs {
+        int32_t *sumLeft = nullptr;
+        int32_t *sumRight = nullptr;
+        // The modulation for the next voice, when this one is a source.
+        int32_t *fmod = nullptr;
+        // Voices 1 and 3 are captured in a ring of 0x200 samples, after the envelope, but before
+        // the volume. The ring is written past its end when the voice stops, as it always was.
+        uint16_t *capture = nullptr;
+        int32_t *captureIndex = nullptr;
+        // The voice's samples, as the reverb sees them.
+        int32_t *reverb = nullptr;
+    };
+
+    // Mixes a voice which was stepped through ns samples out of a block of count, stopping short
+    // of it if ns is smaller, and updates sval, the last sample it played.
+    static void voice(Block &block, unsigned ns, unsigned count, const Voice &voice, const Outputs &outputs,
+                      int32_t &sval, bool forceScalar = false);
+};
+
+}  // namespace SPU
+
+}  // namespace PCSX
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/ratecontrol.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr unsigned TAPS = PCSX::SPU::RateControl::TAPS;
+constexpr unsigned PHASES = PCSX::SPU::RateControl::PHASES;
+// How many input frames the filter looks at before the one an output frame starts from.
+constexpr unsigned LEAD = TAPS / 2 - 1;
+
+// Blackman windowed sinc, cut at the Nyquist frequency, as the ratio is never far enough from 1
+// for the aliasing to matter. Each phase is normalized, so that the gain is exactly 1, and the
+// first and last phases are plain copies of their input frame.
+struct Filter {
+    Filter() {
+        const double pi = std::acos(-1.0);
+        for (unsigned p = 0; p <= PHASES; p++) {
+            const double fraction = double(p) / PHASES;
+            double taps[TAPS];
+            double sum = 0.0;
+            for (unsigned k = 0; k < TAPS; k++) {
+                const double x = double(k) - LEAD - fraction;
+                const double n = (x + TAPS / 2) / TAPS;
+                const double window = 0.42 - 0.5 * std::cos(2.0 * pi * n) + 0.08 * std::cos(4.0 * pi * n);
+                double sinc;
+                if (x == std::floor(x)) {
+                    sinc = x == 0.0 ? 1.0 : 0.0;
+                } else {
+                    sinc = std::sin(pi * x) / (pi * x);
+                }
+                taps[k] = sinc * window;
+                sum += taps[k];
+            }
+            for (unsigned k = 0; k < TAPS; k++) coefs[p][k] = float(taps[k] / sum);
+        }
+    }
+    float coefs[PHASES + 1][TAPS];
+};
+
+const Filter &filter() {
+    static const Filter s_filter;
+    return s_filter;
+}
+
+int16_t clampToShort(float v) { return int16_t(std::clamp(std::lrint(v), -32768L, 32767L)); }
+
+}  // namespace
+
+void PCSX::SPU::RateControl::reset() {
+    m_history.assign(LEAD * 2, 0.0f);
+    m_position = LEAD;
+    m_ratio = 1.0;
+}
+
+void PCSX::SPU::RateControl::update(size_t buffered, size_t target) {
+    if (target == 0) return;
+    // Too much buffered means producing fewer frames, and too little means producing more.
+    const double error = std::clamp((double(target) - double(buffered)) / double(target), -1.0, 1.0);
+    m_ratio += (1.0 + error * MAX_DEVIATION - m_ratio) * SMOOTHING;
+}
+
+size_t PCSX::SPU::RateControl::process(const int16_t *in, size_t frames, std::vector<int16_t> &out) {
+    m_history.insert(m_history.end(), in, in + frames * 2);
+    const size_t available = m_history.size() / 2;
+    const double step = 1.0 / m_ratio;
+    const auto &coefs = filter().coefs;
+
+    out.clear();
+    while (true) {
+        const size_t i = size_t(m_position);
+        if ((i + TAPS / 2) >= available) break;
+        // The coefficients are interpolated between the two closest phases.
+        const double fraction = (m_position - i) * PHASES;
+        const unsigned phase = unsigned(fraction);
+        const float blend = float(fraction - phase);
+        const float *a = coefs[phase];
+        const float *b = coefs[phase + 1];
+        const float *src = m_history.data() + (i - LEAD) * 2;
+        float l = 0.0f, r = 0.0f;
+        for (unsigned k = 0; k < TAPS; k++) {
+            const float c = a[k] + (b[k] - a[k]) * blend;
+            l += src[k * 2 + 0] * c;
+            r += src[k * 2 + 1] * c;
+        }
+        out.push_back(clampToShort(l));
+        out.push_back(clampToShort(r));
+        m_position += step;
+    }
+
+    const size_t consumed = std::min(size_t(m_position) - LEAD, available);
+    m_history.erase(m_history.begin(), m_history.begin() + consumed * 2);
+    m_position -= consumed;
+    return out.size() / 2;
+}
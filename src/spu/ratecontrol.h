@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace PCSX {
+
+namespace SPU {
+
+// Dynamic rate control, for when the SPU output and the audio device run on different clocks.
+// The frames go through a windowed sinc resampler, whose ratio is nudged by a fraction of a
+// percent, up or down, depending on how far the device's buffer is from the target fill. The
+// pitch change stays well under what anyone can hear, while the buffer can be kept small
+// without ever running dry or overflowing.
+class RateControl {
+  public:
+    static constexpr unsigned TAPS = 16;
+    static constexpr unsigned PHASES = 256;
+    // How far the ratio may go from 1, either way.
+    static constexpr double MAX_DEVIATION = 0.005;
+    // How much of the way towards the ratio computed from the current fill each update goes.
+    static constexpr double SMOOTHING = 1.0 / 64.0;
+
+    RateControl() { reset(); }
+    void reset();
+
+    // Output frames per input frame.
+    double ratio() const { return m_ratio; }
+    void setRatio(double ratio) { m_ratio = ratio; }
+    // Moves the ratio according to the frames currently buffered by the device, and to the
+    // amount it should ideally hold.
+    void update(size_t buffered, size_t target);
+
+    // Frame pacing: the emulation, having produced up to the emulated frame, may only run ahead of
+    // the device, having consumed up to the consumed frame, by the latency target. Returns false if
+    // it's within that, or else true, with the frame the device needs to reach first in goal.
+    static bool pacingGoal(uint32_t emulated, uint32_t consumed, uint32_t target, uint32_t &goal) {
+        if (int32_t(emulated - consumed - target) <= 0) return false;
+        goal = emulated - target;
+        return true;
+    }
+
+    // Resamples stereo interleaved frames into out, and returns the number of frames written.
+    // The last few input frames are kept for the next call, as the filter needs to see past them.
+    size_t process(const int16_t *in, size_t frames, std::vector<int16_t> &out);
+
+  private:
+    // Input frames not consumed yet, stereo interleaved, and the position of the next output
+    // frame in them.
+    std::vector<float> m_history;
+    double m_position;
+    double m_ratio;
+};
+
+}  // namespace SPU
+
+}  // namespace PCSX
@@ -68,6 +68,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SPU::impl::writeRegister(uint32_t reg, uint16_t val) {
+    catchUp();
     const uint32_t r = reg & 0xfff;
 
     regArea[(r - 0xc00) >> 1] = val;
@@ -218,6 +219,7 @@ void PCSX::SPU::impl::writeRegister(uint32_t reg, uint16_t val) {
 
         case H_SPUdata:
             spuMem[spuAddr >> 1] = val;
+            m_adpcmCache.invalidate(spuAddr, 2);
             spuAddr += 2;
             if (spuAddr > 0x7ffff) {
                 spuAddr = 0;
@@ -488,6 +490,9 @@ void PCSX::SPU::impl::writeRegister(uint32_t reg, uint16_t val) {
             break;
     }
 
+    // Only once rvb holds the new value, as the SPU thread may pick it up right away.
+    if ((r == H_SPUReverbAddr) || ((r >= H_Reverb) && (r < H_Reverb + 64))) m_reverb.invalidate();
+
     iSpuAsyncWait = 0;
 }
 
@@ -496,6 +501,7 @@ void PCSX::SPU::impl::writeRegister(uint32_t reg, uint16_t val) {
 ////////////////////////////////////////////////////////////////////////
 
 uint16_t PCSX::SPU::impl::readRegister(uint32_t reg) {
+    catchUp();
     const uint32_t r = reg & 0xfff;
 
     iSpuAsyncWait = 0;
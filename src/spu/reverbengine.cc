@@ -0,0 +1,245 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/reverbengine.h"
+
+#include <algorithm>
+
+#include "support/simd.h"
+
+namespace {
+
+using Tap = PCSX::SPU::ReverbEngine::Tap;
+using REVERBInfo = PCSX::SPU::REVERBInfo;
+
+// The products which may overflow are allowed to wrap around, like they always did.
+int32_t mul(int32_t a, int32_t b) { return int32_t(int64_t(a) * b); }
+
+void tickScalar(int16_t *ram, const int32_t *addresses, const REVERBInfo &rvb, int inputL, int inputR, int &left,
+                int &right) {
+    auto get = [ram, addresses](Tap tap) -> int32_t { return ram[addresses[tap]]; };
+    auto set = [ram, addresses](Tap tap, int32_t value) {
+        ram[addresses[tap]] = std::clamp(value, -32768, 32767);
+    };
+
+    const int32_t iirInputA0 = get(Tap::IIR_SRC_A0) * rvb.IIR_COEF / 32768 + mul(inputL, rvb.IN_COEF_L) / 32768;
+    const int32_t iirInputA1 = get(Tap::IIR_SRC_A1) * rvb.IIR_COEF / 32768 + mul(inputR, rvb.IN_COEF_R) / 32768;
+    const int32_t iirInputB0 = get(Tap::IIR_SRC_B0) * rvb.IIR_COEF / 32768 + mul(inputL, rvb.IN_COEF_L) / 32768;
+    const int32_t iirInputB1 = get(Tap::IIR_SRC_B1) * rvb.IIR_COEF / 32768 + mul(inputR, rvb.IN_COEF_R) / 32768;
+
+    const int32_t iirAlpha = 32768 - rvb.IIR_ALPHA;
+    const int32_t iirA0 = mul(iirInputA0, rvb.IIR_ALPHA) / 32768 + get(Tap::IIR_DEST_A0) * iirAlpha / 32768;
+    const int32_t iirA1 = mul(iirInputA1, rvb.IIR_ALPHA) / 32768 + get(Tap::IIR_DEST_A1) * iirAlpha / 32768;
+    const int32_t iirB0 = mul(iirInputB0, rvb.IIR_ALPHA) / 32768 + get(Tap::IIR_DEST_B0) * iirAlpha / 32768;
+    const int32_t iirB1 = mul(iirInputB1, rvb.IIR_ALPHA) / 32768 + get(Tap::IIR_DEST_B1) * iirAlpha / 32768;
+
+    set(Tap::IIR_NEXT_A0, iirA0);
+    set(Tap::IIR_NEXT_A1, iirA1);
+    set(Tap::IIR_NEXT_B0, iirB0);
+    set(Tap::IIR_NEXT_B1, iirB1);
+
+    const int32_t acc0 = get(Tap::ACC_SRC_A0) * rvb.ACC_COEF_A / 32768 + get(Tap::ACC_SRC_B0) * rvb.ACC_COEF_B / 32768 +
+                         get(Tap::ACC_SRC_C0) * rvb.ACC_COEF_C / 32768 + get(Tap::ACC_SRC_D0) * rvb.ACC_COEF_D / 32768;
+    const int32_t acc1 = get(Tap::ACC_SRC_A1) * rvb.ACC_COEF_A / 32768 + get(Tap::ACC_SRC_B1) * rvb.ACC_COEF_B / 32768 +
+                         get(Tap::ACC_SRC_C1) * rvb.ACC_COEF_C / 32768 + get(Tap::ACC_SRC_D1) * rvb.ACC_COEF_D / 32768;
+
+    const int32_t fbA0 = get(Tap::FB_SRC_A0);
+    const int32_t fbA1 = get(Tap::FB_SRC_A1);
+    const int32_t fbB0 = get(Tap::FB_SRC_B0);
+    const int32_t fbB1 = get(Tap::FB_SRC_B1);
+
+    const int32_t fbAlphaX = int32_t(rvb.FB_ALPHA ^ 0xffff8000);
+    set(Tap::MIX_DEST_A0, acc0 - fbA0 * rvb.FB_ALPHA / 32768);
+    set(Tap::MIX_DEST_A1, acc1 - fbA1 * rvb.FB_ALPHA / 32768);
+    set(Tap::MIX_DEST_B0,
+        mul(rvb.FB_ALPHA, acc0) / 32768 - fbA0 * fbAlphaX / 32768 - fbB0 * rvb.FB_X / 32768);
+    set(Tap::MIX_DEST_B1,
+        mul(rvb.FB_ALPHA, acc1) / 32768 - fbA1 * fbAlphaX / 32768 - fbB1 * rvb.FB_X / 32768);
+
+    left = (get(Tap::MIX_DEST_A0) + get(Tap::MIX_DEST_B0)) / 3;
+    right = (get(Tap::MIX_DEST_A1) + get(Tap::MIX_DEST_B1)) / 3;
+}
+
+#ifdef PCSX_SIMD_X86
+
+// x / 32768, rounding towards zero.
+AVX2_FUNC __m128i divide(__m128i x) {
+    return _mm_srai_epi32(_mm_add_epi32(x, _mm_srli_epi32(_mm_srai_epi32(x, 31), 17)), 15);
+}
+
+AVX2_FUNC __m256i divide(__m256i x) {
+    return _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(_mm256_srai_epi32(x, 31), 17)), 15);
+}
+
+// The four lanes are the A0, A1, B0, and B1 flavors of the same stage.
+AVX2_FUNC __m128i gather(const int16_t *ram, const int32_t *addresses, Tap first) {
+    return _mm_setr_epi32(ram[addresses[first]], ram[addresses[first + 1]], ram[addresses[first + 2]],
+                          ram[addresses[first + 3]]);
+}
+
+// Saturated to 16 bits, and stored in lane order, as later lanes win when the addresses alias.
+AVX2_FUNC void scatter(int16_t *ram, const int32_t *addresses, Tap first, __m128i values) {
+    const __m128i packed = _mm_packs_epi32(values, values);
+    ram[addresses[first]] = _mm_extract_epi16(packed, 0);
+    ram[addresses[first + 1]] = _mm_extract_epi16(packed, 1);
+    ram[addresses[first + 2]] = _mm_extract_epi16(packed, 2);
+    ram[addresses[first + 3]] = _mm_extract_epi16(packed, 3);
+}
+
+AVX2_FUNC void tickAVX2(int16_t *ram, const int32_t *addresses, const REVERBInfo &rvb, int inputL, int inputR,
+                        int &left, int &right) {
+    // The IIR filters.
+    const __m128i input = _mm_setr_epi32(inputL, inputR, inputL, inputR);
+    const __m128i inputCoef = _mm_setr_epi32(rvb.IN_COEF_L, rvb.IN_COEF_R, rvb.IN_COEF_L, rvb.IN_COEF_R);
+    const __m128i src = gather(ram, addresses, Tap::IIR_SRC_A0);
+    const __m128i dest = gather(ram, addresses, Tap::IIR_DEST_A0);
+    const __m128i iirInput = _mm_add_epi32(divide(_mm_mullo_epi32(src, _mm_set1_epi32(rvb.IIR_COEF))),
+                                           divide(_mm_mullo_epi32(input, inputCoef)));
+    const __m128i iir = _mm_add_epi32(divide(_mm_mullo_epi32(iirInput, _mm_set1_epi32(rvb.IIR_ALPHA))),
+                                      divide(_mm_mullo_epi32(dest, _mm_set1_epi32(32768 - rvb.IIR_ALPHA))));
+    scatter(ram, addresses, Tap::IIR_NEXT_A0, iir);
+
+    // The comb filters, with the four taps of each side summed up in their half of the register.
+    const __m256i accSrc = _mm256_setr_epi32(
+        ram[addresses[Tap::ACC_SRC_A0]], ram[addresses[Tap::ACC_SRC_B0]], ram[addresses[Tap::ACC_SRC_C0]],
+        ram[addresses[Tap::ACC_SRC_D0]], ram[addresses[Tap::ACC_SRC_A1]], ram[addresses[Tap::ACC_SRC_B1]],
+        ram[addresses[Tap::ACC_SRC_C1]], ram[addresses[Tap::ACC_SRC_D1]]);
+    const __m256i accCoef = _mm256_setr_epi32(rvb.ACC_COEF_A, rvb.ACC_COEF_B, rvb.ACC_COEF_C, rvb.ACC_COEF_D,
+                                              rvb.ACC_COEF_A, rvb.ACC_COEF_B, rvb.ACC_COEF_C, rvb.ACC_COEF_D);
+    __m256i acc = divide(_mm256_mullo_epi32(accSrc, accCoef));
+    acc = _mm256_hadd_epi32(acc, acc);
+    acc = _mm256_hadd_epi32(acc, acc);
+    const int32_t acc0 = _mm256_extract_epi32(acc, 0);
+    const int32_t acc1 = _mm256_extract_epi32(acc, 4);
+
+    // And the feedback, which only the B outputs take the ACC scaling and the second tap for.
+    const __m128i fb = gather(ram, addresses, Tap::FB_SRC_A0);
+    const __m128i fbA = _mm_shuffle_epi32(fb, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m128i fbB = _mm_blend_epi32(_mm_setzero_si128(), fb, 0b1100);
+    const int32_t fbAlphaX = int32_t(rvb.FB_ALPHA ^ 0xffff8000);
+    const __m128i accs = _mm_setr_epi32(acc0, acc1, acc0, acc1);
+    const __m128i scaled = divide(_mm_mullo_epi32(accs, _mm_set1_epi32(rvb.FB_ALPHA)));
+    const __m128i fbACoef = _mm_setr_epi32(rvb.FB_ALPHA, rvb.FB_ALPHA, fbAlphaX, fbAlphaX);
+    const __m128i fbBCoef = _mm_setr_epi32(0, 0, rvb.FB_X, rvb.FB_X);
+    __m128i mix = _mm_blend_epi32(accs, scaled, 0b1100);
+    mix = _mm_sub_epi32(mix, divide(_mm_mullo_epi32(fbA, fbACoef)));
+    mix = _mm_sub_epi32(mix, divide(_mm_mullo_epi32(fbB, fbBCoef)));
+    scatter(ram, addresses, Tap::MIX_DEST_A0, mix);
+
+    // Read back, as the outputs may well alias each other.
+    left = (ram[addresses[Tap::MIX_DEST_A0]] + ram[addresses[Tap::MIX_DEST_B0]]) / 3;
+    right = (ram[addresses[Tap::MIX_DEST_A1]] + ram[addresses[Tap::MIX_DEST_B1]]) / 3;
+}
+
+#endif
+
+}  // namespace
+
+bool PCSX::SPU::ReverbEngine::vectorized() {
+#ifdef PCSX_SIMD_X86
+    return PCSX::SIMD::hasAVX2;
+#else
+    return false;
+#endif
+}
+
+// Exactly what looping over the work area did: going over its end wraps back to its start, but going
+// under its start wraps one sample short of its end.
+int PCSX::SPU::ReverbEngine::wrap(int address) const {
+    if (address > 0x3ffff) return m_start + (address - 0x40000) % m_size;
+    if (address < m_start) return m_start + (m_size - 2) - (m_start - address - 1) % (m_size - 1);
+    return address;
+}
+
+void PCSX::SPU::ReverbEngine::setup(const REVERBInfo &rvb) {
+    m_start = rvb.StartAddr;
+    m_size = 0x40000 - m_start;
+    m_offsets[IIR_SRC_A0] = rvb.IIR_SRC_A0 * 4;
+    m_offsets[IIR_SRC_A1] = rvb.IIR_SRC_A1 * 4;
+    m_offsets[IIR_SRC_B0] = rvb.IIR_SRC_B0 * 4;
+    m_offsets[IIR_SRC_B1] = rvb.IIR_SRC_B1 * 4;
+    m_offsets[IIR_DEST_A0] = rvb.IIR_DEST_A0 * 4;
+    m_offsets[IIR_DEST_A1] = rvb.IIR_DEST_A1 * 4;
+    m_offsets[IIR_DEST_B0] = rvb.IIR_DEST_B0 * 4;
+    m_offsets[IIR_DEST_B1] = rvb.IIR_DEST_B1 * 4;
+    m_offsets[IIR_NEXT_A0] = rvb.IIR_DEST_A0 * 4 + 1;
+    m_offsets[IIR_NEXT_A1] = rvb.IIR_DEST_A1 * 4 + 1;
+    m_offsets[IIR_NEXT_B0] = rvb.IIR_DEST_B0 * 4 + 1;
+    m_offsets[IIR_NEXT_B1] = rvb.IIR_DEST_B1 * 4 + 1;
+    m_offsets[ACC_SRC_A0] = rvb.ACC_SRC_A0 * 4;
+    m_offsets[ACC_SRC_B0] = rvb.ACC_SRC_B0 * 4;
+    m_offsets[ACC_SRC_C0] = rvb.ACC_SRC_C0 * 4;
+    m_offsets[ACC_SRC_D0] = rvb.ACC_SRC_D0 * 4;
+    m_offsets[ACC_SRC_A1] = rvb.ACC_SRC_A1 * 4;
+    m_offsets[ACC_SRC_B1] = rvb.ACC_SRC_B1 * 4;
+    m_offsets[ACC_SRC_C1] = rvb.ACC_SRC_C1 * 4;
+    m_offsets[ACC_SRC_D1] = rvb.ACC_SRC_D1 * 4;
+    m_offsets[FB_SRC_A0] = (rvb.MIX_DEST_A0 - rvb.FB_SRC_A) * 4;
+    m_offsets[FB_SRC_A1] = (rvb.MIX_DEST_A1 - rvb.FB_SRC_A) * 4;
+    m_offsets[FB_SRC_B0] = (rvb.MIX_DEST_B0 - rvb.FB_SRC_B) * 4;
+    m_offsets[FB_SRC_B1] = (rvb.MIX_DEST_B1 - rvb.FB_SRC_B) * 4;
+    m_offsets[MIX_DEST_A0] = rvb.MIX_DEST_A0 * 4;
+    m_offsets[MIX_DEST_A1] = rvb.MIX_DEST_A1 * 4;
+    m_offsets[MIX_DEST_B0] = rvb.MIX_DEST_B0 * 4;
+    m_offsets[MIX_DEST_B1] = rvb.MIX_DEST_B1 * 4;
+    m_linear = 0;
+}
+
+void PCSX::SPU::ReverbEngine::locate(int curr) {
+    m_curr = curr;
+    // The current address itself wraps after the end of the area.
+    unsigned linear = 0x40000 - curr;
+    for (unsigned tap = 0; tap < TAPS; tap++) {
+        const int address = m_offsets[tap] + curr;
+        m_addresses[tap] = wrap(address);
+        // Which also is where the addresses under the area get into it.
+        const int last = address < m_start ? 0x3fffe : 0x3ffff;
+        linear = std::min(linear, unsigned(last - m_addresses[tap] + 1));
+    }
+    m_linear = linear;
+}
+
+void PCSX::SPU::ReverbEngine::tick(int16_t *ram, const REVERBInfo &rvb, int inputL, int inputR, int &left,
+                                   int &right, bool forceScalar) {
+    const bool dirty = m_dirty.exchange(false, std::memory_order_acquire);
+    if (dirty || (rvb.StartAddr != m_start)) setup(rvb);
+    if ((m_linear == 0) || (rvb.CurrAddr != m_curr)) locate(rvb.CurrAddr);
+
+#ifdef PCSX_SIMD_X86
+    if (PCSX::SIMD::hasAVX2 && !forceScalar) {
+        tickAVX2(ram, m_addresses, rvb, inputL, inputR, left, right);
+    } else {
+        tickScalar(ram, m_addresses, rvb, inputL, inputR, left, right);
+    }
+#else
+    tickScalar(ram, m_addresses, rvb, inputL, inputR, left, right);
+#endif
+
+    if (m_adpcmCache) {
+        for (Tap tap : {IIR_NEXT_A0, IIR_NEXT_A1, IIR_NEXT_B0, IIR_NEXT_B1, MIX_DEST_A0, MIX_DEST_A1, MIX_DEST_B0,
+                        MIX_DEST_B1}) {
+            m_adpcmCache->invalidate(m_addresses[tap] * 2, 2);
+        }
+    }
+
+    for (unsigned tap = 0; tap < TAPS; tap++) m_addresses[tap]++;
+    m_curr++;
+    m_linear--;
+}
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "spu/adpcmcache.h"
+#include "spu/types.h"
+
+namespace PCSX {
+
+namespace SPU {
+
+// Neill's reverb steady-state, one 22050Hz tick at a time. Each tick reads and writes the reverb
+// work area at 28 addresses, all relative to the current one and wrapped into the work area in the
+// peculiar way the original helpers did it. Instead of computing them again for each of the reads
+// and writes, the addresses are computed once, and then simply move up by one sample each tick, for
+// as long as none of them can wrap; that is, until one of them reaches the end of the area, or the
+// registers change. The ticks themselves can't overlap, as each one reads what the previous one
+// wrote, but the four IIR filters, the eight comb taps, and the four feedback outputs of a tick go
+// through 32 bits vector lanes when the host can. Both give the same samples, bit for bit, as the
+// original per sample code did. The voices may play from the work area too, so the blocks of the
+// decoded ADPCM cache which the ticks write to get invalidated, if there's a cache.
+class ReverbEngine {
+  public:
+    ReverbEngine() = default;
+    explicit ReverbEngine(ADPCMCache *adpcmCache) : m_adpcmCache(adpcmCache) {}
+
+    // Whether the vectorized version is going to be used on this host.
+    static bool vectorized();
+
+    // The reverb registers, or the reverb area, changed. The register writes call this from the
+    // emulation thread, while the ticks may run on the SPU thread.
+    void invalidate() { m_dirty.store(true, std::memory_order_release); }
+    // Runs the tick at rvb.CurrAddr, with the mixed reverb input for it, and returns the wet output,
+    // before the reverb volume. Advancing rvb.CurrAddr afterwards is up to the caller.
+    void tick(int16_t *ram, const REVERBInfo &rvb, int inputL, int inputR, int &left, int &right,
+              bool forceScalar = false);
+
+    enum Tap : unsigned {
+        IIR_SRC_A0,
+        IIR_SRC_A1,
+        IIR_SRC_B0,
+        IIR_SRC_B1,
+        IIR_DEST_A0,
+        IIR_DEST_A1,
+        IIR_DEST_B0,
+        IIR_DEST_B1,
+        // The IIR filters write one sample past their destination.
+        IIR_NEXT_A0,
+        IIR_NEXT_A1,
+        IIR_NEXT_B0,
+        IIR_NEXT_B1,
+        ACC_SRC_A0,
+        ACC_SRC_B0,
+        ACC_SRC_C0,
+        ACC_SRC_D0,
+        ACC_SRC_A1,
+        ACC_SRC_B1,
+        ACC_SRC_C1,
+        ACC_SRC_D1,
+        FB_SRC_A0,
+        FB_SRC_A1,
+        FB_SRC_B0,
+        FB_SRC_B1,
+        MIX_DEST_A0,
+        MIX_DEST_A1,
+        MIX_DEST_B0,
+        MIX_DEST_B1,
+        TAPS,
+    };
+
+  private:
+    void setup(const REVERBInfo &rvb);
+    void locate(int curr);
+    int wrap(int address) const;
+
+    ADPCMCache *m_adpcmCache = nullptr;
+    std::atomic<bool> m_dirty = true;
+    // The work area, in samples, and the tap offsets from the current address, in samples too.
+    int m_start = 0;
+    int m_size = 0;
+    int32_t m_offsets[TAPS];
+    // The tap addresses at the current address, and how many more ticks they stay linear for.
+    int32_t m_addresses[TAPS];
+    int m_curr = -1;
+    unsigned m_linear = 0;
+};
+
+}  // namespace SPU
+
+}  // namespace PCSX
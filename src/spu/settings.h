@@ -35,7 +35,11 @@ typedef Setting<int, TYPESTRING("Interp"), 2> Interpolation;
 typedef Setting<bool, TYPESTRING("Mono")> Mono;
 typedef Setting<bool, TYPESTRING("DBufIRQ"), true> DBufIRQ;
 typedef Setting<bool, TYPESTRING("Mute")> Mute;
-typedef Settings<Backend, Device, NullSync, Streaming, Volume, SPUIRQWait, Reverb, Interpolation, Mono, DBufIRQ, Mute>
+typedef Setting<bool, TYPESTRING("Synchronous"), false> Synchronous;
+typedef Setting<bool, TYPESTRING("DynamicRate"), false> DynamicRate;
+typedef Setting<int, TYPESTRING("LatencyTarget"), 25> LatencyTarget;
+typedef Settings<Backend, Device, NullSync, Streaming, Volume, SPUIRQWait, Reverb, Interpolation, Mono, DBufIRQ, Mute,
+                 Synchronous, DynamicRate, LatencyTarget>
     SettingsType;
 
 }  // namespace SPU
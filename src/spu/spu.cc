@@ -93,13 +93,19 @@
 //
 //*************************************************************************//
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
+#include "core/audiodump.h"
+#include "core/psxemulator.h"
+#include "core/r3000a.h"
+#include "core/videorecorder.h"
 #include "spu/adsr.h"
 #include "spu/externals.h"
 #include "spu/gauss.h"
 #include "spu/interface.h"
+#include "spu/mixer.h"
 
 ////////////////////////////////////////////////////////////////////////
 // globals
@@ -436,373 +442,376 @@ inline int PCSX::SPU::impl::iGetInterpolationVal(SPUCHAN *pChannel) {
 
 ////////////////////////////////////////////////////////////////////////
 
-void PCSX::SPU::impl::MainThread() {
+void PCSX::SPU::impl::mix(int count) {
     int s_1, s_2, fa, ns;
     uint8_t *start;
-    unsigned int nSample;
-    int ch, predict_nr, shift_factor, flags, d, s;
+    int32_t samples[ADPCMCache::SAMPLES];
+    int ch, flags, d;
     int bIRQReturn = 0;
     int32_t tmpCapVoice1Index = 0;
     int32_t tmpCapVoice3Index = 0;
+    Mixer::Block block;
+    static_assert(NSSIZE <= Mixer::BLOCK);
 
     SPUCHAN *pChannel;
-    while (!bEndThread)  // until we are shutting down
-    {
-        int voldiv = 4 - settings.get<Volume>();
-        //--------------------------------------------------//
-        // ok, at the beginning we are looking if there is
-        // enuff free place in the dsound/oss buffer to
-        // fill in new data, or if there is a new channel to start.
-        // if not, we wait (thread) or return (timer/spuasync)
-        // until enuff free place is available/a new channel gets
-        // started
+    int voldiv = 4 - settings.get<Volume>();
 
-        if (dwNewChannel)    // new channel should start immedately?
-        {                    // (at least one bit 0 ... MAXCHANNEL is set?)
-            iSecureStart++;  // -> set iSecure
-            if (iSecureStart > 5)
-                iSecureStart = 0;  //    (if it is set 5 times - that means on 5 tries a new samples has been started -
-                                   //    in a row, we will reset it, to give the sound update a chance)
-        } else
-            iSecureStart = 0;  // 0: no new channel should start
+    // The voices which aren't playing are silent in their stems.
+    const bool stems = g_emulator->m_audioDump->stems();
+    int16_t stemSamples[MAXCHAN][NSSIZE * 2];
+    if (stems) memset(stemSamples, 0, sizeof(stemSamples));
 
-        while (!iSecureStart && !bEndThread &&              // no new start? no thread end?
-               (m_audioOut.getBytesBuffered() > TESTSIZE))  // and still enuff data in sound buffer?
-        {
-            iSecureStart = 0;  // reset secure
+    tmpCapVoice1Index = capBufVoiceIndex;
+    tmpCapVoice3Index = capBufVoiceIndex;
 
-            using namespace std::chrono_literals;
-            std::this_thread::sleep_for(5ms);
+    //--------------------------------------------------//
+    //- main channel loop                              -//
+    //--------------------------------------------------//
+    {
+        pChannel = s_chan;
+        for (ch = 0; ch < MAXCHAN;
+             ch++, pChannel++)  // loop em all... we will collect 1 ms of sound of each playing channel
+        {
+            if (pChannel->data.get<PCSX::SPU::Chan::New>().value) {
+                StartSound(pChannel);        // start new sound
+                dwNewChannel &= ~(1 << ch);  // clear new channel bit
+            }
 
-            if (dwNewChannel)
-                iSecureStart =
-                    1;  // if a new channel kicks in (or, of course, sound buffer runs low), we will leave the loop
-        }
+            if (!pChannel->data.get<PCSX::SPU::Chan::On>().value) {
+                // Although the voices may stop outputting audio, the capture buffer is still filling up.
+                if (pMixIrq && ch == 1) {
+                    std::unique_lock<std::mutex> lock(cbMtx);
+                    for (int c = 0; c < count; c++) spuMem[tmpCapVoice1Index + c + 0x400] = 0;
+                    tmpCapVoice1Index = (tmpCapVoice1Index + count) % 0x200;
+                } else if (pMixIrq && ch == 3) {
+                    std::unique_lock<std::mutex> lock(cbMtx);
+                    for (int c = 0; c < count; c++) spuMem[tmpCapVoice3Index + c + 0x600] = 0;
+                    tmpCapVoice3Index = (tmpCapVoice3Index + count) % 0x200;
+                }
+                continue;  // channel not playing? next
+            }
 
-        //--------------------------------------------------// continue from irq handling in timer mode?
+            if (pChannel->data.get<PCSX::SPU::Chan::ActFreq>().value !=
+                pChannel->data.get<PCSX::SPU::Chan::UsedFreq>().value)  // new psx frequency?
+                VoiceChangeFrequency(pChannel);
 
-        if (lastch >= 0)  // will be -1 if no continue is pending
-        {
-            ch = lastch;
-            ns = lastns;
-            lastch = -1;  // -> setup all kind of vars to continue
-            pChannel = &s_chan[ch];
-            goto GOON;  // -> directly jump to the continue point
-        }
+            // Gauss and cubic interpolations only need the last four decoded samples and the
+            // position, and are left for the block's mixing; the others step along the voice.
+            const int interpolation = settings.get<Interpolation>();
+            const bool interpolated = interpolation >= 2 && !pChannel->data.get<PCSX::SPU::Chan::Noise>().value &&
+                                      pChannel->data.get<PCSX::SPU::Chan::FMod>().value != 2;
 
-        tmpCapVoice1Index = capBufVoiceIndex;
-        tmpCapVoice3Index = capBufVoiceIndex;
+            ns = 0;
 
-        //--------------------------------------------------//
-        //- main channel loop                              -//
-        //--------------------------------------------------//
-        {
-            pChannel = s_chan;
-            for (ch = 0; ch < MAXCHAN;
-                 ch++, pChannel++)  // loop em all... we will collect 1 ms of sound of each playing channel
+            while (ns < count)  // loop until 1 ms of data is reached
             {
-                if (pChannel->data.get<PCSX::SPU::Chan::New>().value) {
-                    StartSound(pChannel);        // start new sound
-                    dwNewChannel &= ~(1 << ch);  // clear new channel bit
-                }
+                NoiseClock();
 
-                if (!pChannel->data.get<PCSX::SPU::Chan::On>().value) {
-                    // Although the voices may stop outputting audio, the capture buffer is still filling up.
-                    if (pMixIrq && ch == 1) {
-                        std::unique_lock<std::mutex> lock(cbMtx);
-                        for (int c = 0; c < NSSIZE; c++) spuMem[tmpCapVoice1Index + c + 0x400] = 0;
-                        tmpCapVoice1Index = (tmpCapVoice1Index + NSSIZE) % 0x200;
-                    } else if (pMixIrq && ch == 3) {
-                        std::unique_lock<std::mutex> lock(cbMtx);
-                        for (int c = 0; c < NSSIZE; c++) spuMem[tmpCapVoice3Index + c + 0x600] = 0;
-                        tmpCapVoice3Index = (tmpCapVoice3Index + NSSIZE) % 0x200;
-                    }
-                    continue;  // channel not playing? next
-                }
+                if (pChannel->data.get<PCSX::SPU::Chan::FMod>().value == 1 && iFMod[ns])  // fmod freq channel
+                    FModChangeFrequency(pChannel, ns);
+
+                while (pChannel->data.get<PCSX::SPU::Chan::spos>().value >= 0x10000L) {
+                    if (pChannel->data.get<PCSX::SPU::Chan::SBPos>().value == 28)  // 28 reached?
+                    {
+                        start = pChannel->pCurr;  // set up the current pos
 
-                if (pChannel->data.get<PCSX::SPU::Chan::ActFreq>().value !=
-                    pChannel->data.get<PCSX::SPU::Chan::UsedFreq>().value)  // new psx frequency?
-                    VoiceChangeFrequency(pChannel);
+                        if (start == (uint8_t *)-1)  // special "stop" sign
+                        {
+                            pChannel->data.get<PCSX::SPU::Chan::On>().value = false;  // -> turn everything off
+                            pChannel->ADSRX.get<exVolume>().value = 0;
+                            pChannel->ADSRX.get<exEnvelopeVol>().value = 0;
+                            goto ENDX;  // -> and done for this channel
+                        }
+
+                        pChannel->data.get<PCSX::SPU::Chan::SBPos>().value = 0;
+
+                        //////////////////////////////////////////// spu irq handler here? mmm... do it later
 
-                ns = 0;
+                        s_1 = pChannel->data.get<PCSX::SPU::Chan::s_1>().value;
+                        s_2 = pChannel->data.get<PCSX::SPU::Chan::s_2>().value;
 
-                while (ns < NSSIZE)  // loop until 1 ms of data is reached
-                {
-                    NoiseClock();
+                        flags = (int)start[1];
 
-                    if (pChannel->data.get<PCSX::SPU::Chan::FMod>().value == 1 && iFMod[ns])  // fmod freq channel
-                        FModChangeFrequency(pChannel, ns);
+                        m_adpcmCache.decode(spuMemC, start - spuMemC, samples, s_1, s_2);
+                        for (unsigned n = 0; n < ADPCMCache::SAMPLES; n++) {
+                            pChannel->data.get<PCSX::SPU::Chan::SB>().value[n].value = samples[n];
+                        }
+                        start += ADPCMCache::BLOCK_SIZE;
+
+                        //////////////////////////////////////////// irq check
 
-                    while (pChannel->data.get<PCSX::SPU::Chan::spos>().value >= 0x10000L) {
-                        if (pChannel->data.get<PCSX::SPU::Chan::SBPos>().value == 28)  // 28 reached?
+                        if ((spuCtrl & ControlFlags::IRQEnable))  // some callback and irq active?
                         {
-                            start = pChannel->pCurr;  // set up the current pos
-
-                            if (start == (uint8_t *)-1)  // special "stop" sign
-                            {
-                                pChannel->data.get<PCSX::SPU::Chan::On>().value = false;  // -> turn everything off
-                                pChannel->ADSRX.get<exVolume>().value = 0;
-                                pChannel->ADSRX.get<exEnvelopeVol>().value = 0;
-                                // Although the voices may stop outputting audio, the capture buffer is still filling
-                                // up. At this point, ns samples are already filled, we need (NSSIZE-ns) more samples.
-                                if (pMixIrq && ch == 1) {
-                                    std::unique_lock<std::mutex> lock(cbMtx);
-                                    for (int c = ns; c < NSSIZE; c++) spuMem[tmpCapVoice1Index + c + 0x400] = 0;
-                                    tmpCapVoice1Index = (tmpCapVoice1Index + (NSSIZE - ns)) % 0x200;
-                                } else if (pMixIrq && ch == 3) {
-                                    std::unique_lock<std::mutex> lock(cbMtx);
-                                    for (int c = ns; c < NSSIZE; c++) spuMem[tmpCapVoice3Index + c + 0x600] = 0;
-                                    tmpCapVoice3Index = (tmpCapVoice3Index + (NSSIZE - ns)) % 0x200;
+                            if ((pSpuIrq > start - 16 &&  // irq address reached?
+                                 pSpuIrq <= start) ||
+                                ((flags & 1) &&  // special: irq on looping addr, when stop/loop flag is set
+                                 (pSpuIrq > pChannel->pLoop - 16 && pSpuIrq <= pChannel->pLoop))) {
+                                pChannel->data.get<PCSX::SPU::Chan::IrqDone>().value = 1;  // -> debug flag
+                                scheduleInterrupt();                                       // -> call main emu
+
+                                // -> option: wait after irq for main emu, which already is in sync otherwise
+                                if (settings.get<SPUIRQWait>() && !m_synchronous) {
+                                    iSpuAsyncWait = 1;
+                                    bIRQReturn = 1;
                                 }
-                                goto ENDX;  // -> and done for this channel
                             }
+                        }
 
-                            pChannel->data.get<PCSX::SPU::Chan::SBPos>().value = 0;
+                        //////////////////////////////////////////// flag handler
 
-                            //////////////////////////////////////////// spu irq handler here? mmm... do it later
+                        if ((flags & 4) && (!pChannel->data.get<PCSX::SPU::Chan::IgnoreLoop>().value))
+                            pChannel->pLoop = start - 16;  // loop adress
 
-                            s_1 = pChannel->data.get<PCSX::SPU::Chan::s_1>().value;
-                            s_2 = pChannel->data.get<PCSX::SPU::Chan::s_2>().value;
+                        if (flags & 1)  // 1: stop/loop
+                        {
+                            // We play this block out first...
+                            // if(!(flags&2))                          // 1+2: do loop... otherwise: stop
+                            if (flags != 3 ||
+                                pChannel->pLoop == NULL)  // PETE: if we don't check exactly for 3, loop hang
+                                                          // ups will happen (DQ4, for example)
+                            {                             // and checking if pLoop is set avoids crashes, yeah
+                                start = (uint8_t *)-1;
+                            } else {
+                                start = pChannel->pLoop;
+                            }
+                        }
 
-                            predict_nr = (int)*start;
-                            start++;
-                            shift_factor = predict_nr & 0xf;
-                            predict_nr >>= 4;
-                            flags = (int)*start;
-                            start++;
+                        pChannel->pCurr = start;  // store values for next cycle
+                        pChannel->data.get<PCSX::SPU::Chan::s_1>().value = s_1;
+                        pChannel->data.get<PCSX::SPU::Chan::s_2>().value = s_2;
 
-                            // -------------------------------------- //
-                            for (nSample = 0; nSample < 28; start++) {
-                                d = (int)*start;
-                                s = ((d & 0xf) << 12);
-                                if (s & 0x8000) s |= 0xffff0000;
+                        ////////////////////////////////////////////
 
-                                fa = (s >> shift_factor);
-                                fa = fa + ((s_1 * f[predict_nr][0]) >> 6) + ((s_2 * f[predict_nr][1]) >> 6);
-                                s_2 = s_1;
-                                s_1 = fa;
-                                s = ((d & 0xf0) << 8);
+                        if (bIRQReturn)  // special return for "spu irq - wait for cpu action"
+                        {
+                            using namespace std::chrono_literals;
+                            bIRQReturn = 0;
+                            auto dwWatchTime = std::chrono::steady_clock::now() + 2500ms;
 
-                                pChannel->data.get<PCSX::SPU::Chan::SB>().value[nSample++].value = fa;
+                            while (iSpuAsyncWait && !bEndThread && std::chrono::steady_clock::now() < dwWatchTime) {
+                                std::this_thread::sleep_for(1ms);
+                            }
+                        }
+                    }
 
-                                if (s & 0x8000) s |= 0xffff0000;
-                                fa = (s >> shift_factor);
-                                fa = fa + ((s_1 * f[predict_nr][0]) >> 6) + ((s_2 * f[predict_nr][1]) >> 6);
-                                s_2 = s_1;
-                                s_1 = fa;
+                    fa = pChannel->data.get<PCSX::SPU::Chan::SB>()
+                             .value[pChannel->data.get<PCSX::SPU::Chan::SBPos>().value++]
+                             .value;  // get sample data
 
-                                pChannel->data.get<PCSX::SPU::Chan::SB>().value[nSample++].value = fa;
-                            }
+                    StoreInterpolationVal(pChannel, fa);  // store val for later interpolation
 
-                            //////////////////////////////////////////// irq check
-
-                            if ((spuCtrl & ControlFlags::IRQEnable))  // some callback and irq active?
-                            {
-                                if ((pSpuIrq > start - 16 &&  // irq address reached?
-                                     pSpuIrq <= start) ||
-                                    ((flags & 1) &&  // special: irq on looping addr, when stop/loop flag is set
-                                     (pSpuIrq > pChannel->pLoop - 16 && pSpuIrq <= pChannel->pLoop))) {
-                                    pChannel->data.get<PCSX::SPU::Chan::IrqDone>().value = 1;  // -> debug flag
-                                    scheduleInterrupt();                                       // -> call main emu
-
-                                    if (settings.get<SPUIRQWait>())  // -> option: wait after irq for main emu
-                                    {
-                                        iSpuAsyncWait = 1;
-                                        bIRQReturn = 1;
-                                    }
-                                }
-                            }
+                    pChannel->data.get<PCSX::SPU::Chan::spos>().value -= 0x10000L;
+                }
 
-                            //////////////////////////////////////////// flag handler
-
-                            if ((flags & 4) && (!pChannel->data.get<PCSX::SPU::Chan::IgnoreLoop>().value))
-                                pChannel->pLoop = start - 16;  // loop adress
-
-                            if (flags & 1)  // 1: stop/loop
-                            {
-                                // We play this block out first...
-                                // if(!(flags&2))                          // 1+2: do loop... otherwise: stop
-                                if (flags != 3 ||
-                                    pChannel->pLoop == NULL)  // PETE: if we don't check exactly for 3, loop hang
-                                                              // ups will happen (DQ4, for example)
-                                {                             // and checking if pLoop is set avoids crashes, yeah
-                                    start = (uint8_t *)-1;
-                                } else {
-                                    start = pChannel->pLoop;
-                                }
-                            }
+                ////////////////////////////////////////////////
+
+                if (interpolated) {
+                    auto &SB = pChannel->data.get<PCSX::SPU::Chan::SB>().value;
+                    const int gpos = SB[28].value;
+                    for (unsigned k = 0; k < 4; k++) block.taps[k][ns] = gval(k);
+                    block.phase[ns] = pChannel->data.get<PCSX::SPU::Chan::spos>().value;
+                } else if (pChannel->data.get<PCSX::SPU::Chan::Noise>().value) {
+                    block.samples[ns] = iGetNoiseVal(pChannel);  // get noise val
+                } else {
+                    block.samples[ns] = iGetInterpolationVal(pChannel);  // get sample val
+                }
+
+                block.envelope[ns] = m_adsr.mix(pChannel);
 
-                            pChannel->pCurr = start;  // store values for next cycle
-                            pChannel->data.get<PCSX::SPU::Chan::s_1>().value = s_1;
-                            pChannel->data.get<PCSX::SPU::Chan::s_2>().value = s_2;
+                ////////////////////////////////////////////////
+                // ok, go on until 1 ms data of this channel is collected
 
-                            ////////////////////////////////////////////
+                ns++;
+                pChannel->data.get<PCSX::SPU::Chan::spos>().value +=
+                    pChannel->data.get<PCSX::SPU::Chan::sinc>().value;
+            }
+        ENDX:
+            //////////////////////////////////////////////////
+            // the voice went through the block, or stopped after ns samples: on to the mixing
+
+            const bool mute = pChannel->data.get<PCSX::SPU::Chan::Mute>().value;  // debug mute
+            const bool reverb = pChannel->data.get<PCSX::SPU::Chan::RVBActive>().value;
+            Mixer::Voice voice;
+            voice.interpolation = interpolated ? interpolation : 0;
+            voice.fmodSource = pChannel->data.get<PCSX::SPU::Chan::FMod>().value == 2;
+            voice.mute = mute;
+            voice.left = pChannel->data.get<PCSX::SPU::Chan::LeftVolume>().value;
+            voice.right = pChannel->data.get<PCSX::SPU::Chan::RightVolume>().value;
+
+            // Panned on its own first when dumping stems, to keep the voice's output around.
+            int32_t left[Mixer::BLOCK] = {}, right[Mixer::BLOCK] = {};
+            int32_t sends[Mixer::BLOCK];
+            Mixer::Outputs outputs;
+            outputs.sumLeft = stems ? left : SSumL;
+            outputs.sumRight = stems ? right : SSumR;
+            outputs.fmod = iFMod;
+            outputs.reverb = reverb ? sends : nullptr;
+
+            std::unique_lock<std::mutex> lock(cbMtx, std::defer_lock);
+            if (pMixIrq && (ch == 1 || ch == 3)) {
+                outputs.capture = spuMem + (ch == 1 ? 0x400 : 0x600);
+                outputs.captureIndex = ch == 1 ? &tmpCapVoice1Index : &tmpCapVoice3Index;
+                lock.lock();
+            }
 
-                            if (bIRQReturn)  // special return for "spu irq - wait for cpu action"
-                            {
-                                using namespace std::chrono_literals;
-                                bIRQReturn = 0;
-                                auto dwWatchTime = std::chrono::steady_clock::now() + 2500ms;
+            auto &sval = pChannel->data.get<PCSX::SPU::Chan::sval>().value;
+            Mixer::voice(block, ns, count, voice, outputs, sval);
+            if (lock.owns_lock()) lock.unlock();
 
-                                while (iSpuAsyncWait && !bEndThread && std::chrono::steady_clock::now() < dwWatchTime) {
-                                    std::this_thread::sleep_for(1ms);
-                                }
-                            }
+            if (ns == 0 || voice.fmodSource) continue;
 
-                            ////////////////////////////////////////////
+            if (stems && !mute) {
+                for (int c = 0; c < ns; c++) {
+                    SSumL[c] += left[c];
+                    SSumR[c] += right[c];
+                    stemSamples[ch][c * 2 + 0] = std::clamp(left[c] / voldiv, -32767, 32767);
+                    stemSamples[ch][c * 2 + 1] = std::clamp(right[c] / voldiv, -32767, 32767);
+                }
+            }
 
-                        GOON:;
-                        }
+            //////////////////////////////////////////////
+            // now let us store sound data for reverb
 
-                        fa = pChannel->data.get<PCSX::SPU::Chan::SB>()
-                                 .value[pChannel->data.get<PCSX::SPU::Chan::SBPos>().value++]
-                                 .value;  // get sample data
+            if (reverb) {
+                const int32_t last = sval;
+                for (int c = 0; c < ns; c++) {
+                    sval = sends[c];
+                    StoreREVERB(pChannel, c);
+                }
+                sval = last;
+            }
+        }
+    }
 
-                        StoreInterpolationVal(pChannel, fa);  // store val for later interpolation
+    // Write from our temporary capture buffer to the actual SPU RAM.
+    writeCaptureBufferCD(count);
+    // The decode buffers, CD audio and voices 1 and 3, were all written to.
+    if (pMixIrq) m_adpcmCache.invalidate(0, 0x1000);
 
-                        pChannel->data.get<PCSX::SPU::Chan::spos>().value -= 0x10000L;
-                    }
+    //---------------------------------------------------//
+    //- here we have another 1 ms of sound data
+    //---------------------------------------------------//
 
-                    ////////////////////////////////////////////////
-
-                    if (pChannel->data.get<PCSX::SPU::Chan::Noise>().value)
-                        fa = iGetNoiseVal(pChannel);  // get noise val
-                    else
-                        fa = iGetInterpolationVal(pChannel);  // get sample val
-
-                    int32_t mixedSample = (m_adsr.mix(pChannel) * fa) / 1023;  // mix adsr
-                    pChannel->data.get<PCSX::SPU::Chan::sval>().value = mixedSample;
-
-                    // Capture buffer should contain voice1/3 sample after any adsr processing but before volume
-                    // processing?
-                    mixedSample = std::min(0xFFFF, std::max(-0xFFFF, mixedSample));
-                    if (pMixIrq && ch == 1) {
-                        std::unique_lock<std::mutex> lock(cbMtx);
-                        spuMem[tmpCapVoice1Index + 0x400] = mixedSample;
-                        tmpCapVoice1Index = (tmpCapVoice1Index + 1) % 0x200;
-                    } else if (pMixIrq && ch == 3) {
-                        std::unique_lock<std::mutex> lock(cbMtx);
-                        spuMem[tmpCapVoice3Index + 0x600] = mixedSample;
-                        tmpCapVoice3Index = (tmpCapVoice3Index + 1) % 0x200;
-                    }
+    ///////////////////////////////////////////////////////
+    // mix all channels (including reverb) into one buffer
 
-                    if (pChannel->data.get<PCSX::SPU::Chan::FMod>().value == 2)  // fmod freq channel
-                        iFMod[ns] = pChannel->data.get<PCSX::SPU::Chan::sval>()
-                                        .value;  // -> store 1T sample data, use that to do fmod on next channel
-                    else                         // no fmod freq channel
-                    {
-                        //////////////////////////////////////////////
-                        // ok, left/right sound volume (psx volume goes from 0 ... 0x3fff)
-
-                        if (pChannel->data.get<PCSX::SPU::Chan::Mute>().value)
-                            pChannel->data.get<PCSX::SPU::Chan::sval>().value = 0;  // debug mute
-                        else {
-                            SSumL[ns] += (pChannel->data.get<PCSX::SPU::Chan::sval>().value *
-                                          pChannel->data.get<PCSX::SPU::Chan::LeftVolume>().value) /
-                                         0x4000L;
-                            SSumR[ns] += (pChannel->data.get<PCSX::SPU::Chan::sval>().value *
-                                          pChannel->data.get<PCSX::SPU::Chan::RightVolume>().value) /
-                                         0x4000L;
-                        }
+    MixREVERB(count);
 
-                        //////////////////////////////////////////////
-                        // now let us store sound data for reverb
+    for (ns = 0; ns < count; ns++) {
+        d = SSumL[ns] / voldiv;
+        SSumL[ns] = 0;
+        if (d < -32767) d = -32767;
+        if (d > 32767) d = 32767;
+        *pS++ = d;
 
-                        if (pChannel->data.get<PCSX::SPU::Chan::RVBActive>().value) StoreREVERB(pChannel, ns);
-                    }
+        d = SSumR[ns] / voldiv;
+        SSumR[ns] = 0;
+        if (d < -32767) d = -32767;
+        if (d > 32767) d = 32767;
+        *pS++ = d;
+    }
 
-                    ////////////////////////////////////////////////
-                    // ok, go on until 1 ms data of this channel is collected
+    if (stems) {
+        for (ch = 0; ch < MAXCHAN; ch++) g_emulator->m_audioDump->voice(ch, stemSamples[ch], count);
+    }
 
-                    ns++;
-                    pChannel->data.get<PCSX::SPU::Chan::spos>().value +=
-                        pChannel->data.get<PCSX::SPU::Chan::sinc>().value;
+    //////////////////////////////////////////////////////
+    // special irq handling in the decode buffers (0x0000-0x1000)
+    // we know:
+    // the decode buffers are located in spu memory in the following way:
+    // 0x0000-0x03ff  CD audio left
+    // 0x0400-0x07ff  CD audio right
+    // 0x0800-0x0bff  Voice 1
+    // 0x0c00-0x0fff  Voice 3
+    // and decoded data is 16 bit for one sample
+    // we assume:
+    // even if voices 1/3 are off or no cd audio is playing, the internal
+    // play positions will move on and wrap after 0x400 bytes.
+    // Therefore: we just need a pointer from spumem+0 to spumem+3ff, and
+    // increase this pointer on each sample by 2 bytes. If this pointer
+    // (or 0x400 offsets of this pointer) hits the spuirq address, we generate
+    // an IRQ. Only problem: the "wait for cpu" option is kinda hard to do here
+    // in some of Peops timer modes. So: we ignore this option here (for now).
+    // Also note: we abuse the channel 0-3 irq debug display for those irqs
+    // (since that's the easiest way to display such irqs in debug mode :))
+
+    if (pMixIrq)  // pMixIRQ will only be set, if the config option is active
+    {
+        for (ns = 0; ns < count; ns++) {
+            if ((spuCtrl & ControlFlags::IRQEnable) && pSpuIrq && pSpuIrq < spuMemC + 0x1000) {
+                for (ch = 0; ch < 4; ch++) {
+                    if (pSpuIrq >= pMixIrq + (ch * 0x400) && pSpuIrq < pMixIrq + (ch * 0x400) + 2) {
+                        scheduleInterrupt();
+                        s_chan[ch].data.get<PCSX::SPU::Chan::IrqDone>().value = 1;
+                    }
                 }
-            ENDX:;
             }
+            pMixIrq += 2;
+            if (pMixIrq > spuMemC + 0x3ff) pMixIrq = spuMemC;
         }
+    }
 
-        // Write from our temporary capture buffer to the actual SPU RAM.
-        writeCaptureBufferCD(NSSIZE);
+    InitREVERB();
+}
 
-        //---------------------------------------------------//
-        //- here we have another 1 ms of sound data
-        //---------------------------------------------------//
+////////////////////////////////////////////////////////////////////////
 
-        ///////////////////////////////////////////////////////
-        // mix all channels (including reverb) into one buffer
+void PCSX::SPU::impl::MainThread() {
+    while (!bEndThread)  // until we are shutting down
+    {
+        //--------------------------------------------------//
+        // ok, at the beginning we are looking if there is
+        // enuff free place in the dsound/oss buffer to
+        // fill in new data, or if there is a new channel to start.
+        // if not, we wait (thread) or return (timer/spuasync)
+        // until enuff free place is available/a new channel gets
+        // started
 
-        for (ns = 0; ns < NSSIZE; ns++) {
-            SSumL[ns] += MixREVERBLeft(ns);
+        // With the dynamic rate control on, the buffer is only filled up to the latency target,
+        // one block at a time, instead of as much as it can take.
+        const size_t target = m_audioOut.getLatencyTarget();
+        const size_t threshold = target ? target : TESTSIZE;
 
-            d = SSumL[ns] / voldiv;
-            SSumL[ns] = 0;
-            if (d < -32767) d = -32767;
-            if (d > 32767) d = 32767;
-            *pS++ = d;
+        if (dwNewChannel)    // new channel should start immedately?
+        {                    // (at least one bit 0 ... MAXCHANNEL is set?)
+            iSecureStart++;  // -> set iSecure
+            if (iSecureStart > 5)
+                iSecureStart = 0;  //    (if it is set 5 times - that means on 5 tries a new samples has been started -
+                                   //    in a row, we will reset it, to give the sound update a chance)
+        } else
+            iSecureStart = 0;  // 0: no new channel should start
 
-            SSumR[ns] += MixREVERBRight();
+        while (!iSecureStart && !bEndThread &&               // no new start? no thread end?
+               (m_audioOut.getBytesBuffered() > threshold))  // and still enuff data in sound buffer?
+        {
+            iSecureStart = 0;  // reset secure
 
-            d = SSumR[ns] / voldiv;
-            SSumR[ns] = 0;
-            if (d < -32767) d = -32767;
-            if (d > 32767) d = 32767;
-            *pS++ = d;
-        }
+            using namespace std::chrono_literals;
+            std::this_thread::sleep_for(target ? 1ms : 5ms);
 
-        //////////////////////////////////////////////////////
-        // special irq handling in the decode buffers (0x0000-0x1000)
-        // we know:
-        // the decode buffers are located in spu memory in the following way:
-        // 0x0000-0x03ff  CD audio left
-        // 0x0400-0x07ff  CD audio right
-        // 0x0800-0x0bff  Voice 1
-        // 0x0c00-0x0fff  Voice 3
-        // and decoded data is 16 bit for one sample
-        // we assume:
-        // even if voices 1/3 are off or no cd audio is playing, the internal
-        // play positions will move on and wrap after 0x400 bytes.
-        // Therefore: we just need a pointer from spumem+0 to spumem+3ff, and
-        // increase this pointer on each sample by 2 bytes. If this pointer
-        // (or 0x400 offsets of this pointer) hits the spuirq address, we generate
-        // an IRQ. Only problem: the "wait for cpu" option is kinda hard to do here
-        // in some of Peops timer modes. So: we ignore this option here (for now).
-        // Also note: we abuse the channel 0-3 irq debug display for those irqs
-        // (since that's the easiest way to display such irqs in debug mode :))
-
-        if (pMixIrq)  // pMixIRQ will only be set, if the config option is active
-        {
-            for (ns = 0; ns < NSSIZE; ns++) {
-                if ((spuCtrl & ControlFlags::IRQEnable) && pSpuIrq && pSpuIrq < spuMemC + 0x1000) {
-                    for (ch = 0; ch < 4; ch++) {
-                        if (pSpuIrq >= pMixIrq + (ch * 0x400) && pSpuIrq < pMixIrq + (ch * 0x400) + 2) {
-                            scheduleInterrupt();
-                            s_chan[ch].data.get<PCSX::SPU::Chan::IrqDone>().value = 1;
-                        }
-                    }
-                }
-                pMixIrq += 2;
-                if (pMixIrq > spuMemC + 0x3ff) pMixIrq = spuMemC;
-            }
+            if (dwNewChannel)
+                iSecureStart =
+                    1;  // if a new channel kicks in (or, of course, sound buffer runs low), we will leave the loop
         }
 
-        InitREVERB();
+        mix(NSSIZE);
 
         //////////////////////////////////////////////////////
         // feed the sound
         // wanna have around 1/60 sec (16.666 ms) updates
 
-        if (iCycle++ > 16) {
+        if (target || (iCycle++ > 16)) {
             bool done = false;
+            const size_t frames = (((uint8_t *)pS) - ((uint8_t *)pSpuBuffer)) / sizeof(MiniAudio::Frame);
             while (!done) {
-                done =
-                    m_audioOut.feedStreamData(reinterpret_cast<MiniAudio::Frame *>(pSpuBuffer),
-                                              (((uint8_t *)pS) - ((uint8_t *)pSpuBuffer)) / sizeof(MiniAudio::Frame));
+                done = m_audioOut.feedStreamData(reinterpret_cast<MiniAudio::Frame *>(pSpuBuffer), frames);
                 if (bEndThread) {
                     bThreadEnded = 1;
                     return;
                 }
             }
+            g_emulator->m_videoRecorder->audio(reinterpret_cast<const int16_t *>(pSpuBuffer), frames, 0);
+            g_emulator->m_audioDump->audio(reinterpret_cast<const int16_t *>(pSpuBuffer), frames, 0);
             pS = (int16_t *)pSpuBuffer;
             iCycle = 0;
         }
@@ -849,6 +858,7 @@ void PCSX::SPU::impl::writeCaptureBufferCD(int numbSamples) {
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SPU::impl::async(uint32_t cycle) {
+    catchUp();
     if (iSpuAsyncWait) {
         iSpuAsyncWait++;
         if (iSpuAsyncWait <= 64) return;
@@ -861,6 +871,7 @@ void PCSX::SPU::impl::async(uint32_t cycle) {
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SPU::impl::playADPCMchannel(xa_decode_t *xap) {
+    catchUp();
     if (!settings.get<Streaming>()) return;  // no XA? bye
     if (!xap) return;
     if (!xap->freq) return;  // no xa freq ? bye
@@ -910,14 +921,53 @@ void PCSX::SPU::impl::SetupThread() {
     bThreadEnded = 0;
     bSpuInit = 1;  // flag: we are inited
 
+    m_synchronous = m_headless || settings.get<Synchronous>();
+    if (m_synchronous) {
+        m_syncCycle = g_emulator->m_cpu->m_regs.cycle;
+        return;
+    }
+
     hMainThread = std::thread([this]() { MainThread(); });
 }
 
+////////////////////////////////////////////////////////////////////////
+// CATCHUP: synchronous mode, mixes up to the current CPU cycle
+////////////////////////////////////////////////////////////////////////
+
+void PCSX::SPU::impl::catchUp() {
+    if (!m_synchronous || !bSpuInit) return;
+
+    const uint32_t cyclesPerSample = g_emulator->m_psxClockSpeed / 44100;
+    uint32_t samples = (g_emulator->m_cpu->m_regs.cycle - m_syncCycle) / cyclesPerSample;
+    m_syncCycle += samples * cyclesPerSample;
+    // More than a second at once can only be the cycle counter starting over.
+    if (samples > 44100) return;
+
+    while (samples) {
+        const uint32_t count = std::min(samples, uint32_t(NSSIZE));
+        mix(count);
+        samples -= count;
+
+        // Nothing here ever waits for the audio device: if it's behind, such as when running
+        // faster than real time, the frames it has no room for are dropped.
+        const size_t frames = (((uint8_t *)pS) - ((uint8_t *)pSpuBuffer)) / sizeof(MiniAudio::Frame);
+        if (!m_headless) m_audioOut.tryFeedStreamData(reinterpret_cast<MiniAudio::Frame *>(pSpuBuffer), frames);
+        g_emulator->m_videoRecorder->audio(reinterpret_cast<const int16_t *>(pSpuBuffer), frames, 0);
+        g_emulator->m_audioDump->audio(reinterpret_cast<const int16_t *>(pSpuBuffer), frames, 0);
+        pS = (int16_t *)pSpuBuffer;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////
 // REMOVETIMER: kill threads/timers
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SPU::impl::RemoveThread() {
+    if (m_synchronous) {
+        bSpuInit = 0;
+        return;
+    }
+
     bEndThread = 1;  // raise flag to end thread
 
     using namespace std::chrono_literals;
@@ -1040,6 +1090,7 @@ void PCSX::SPU::impl::registerCDDAVolume(void (*CDDAVcallback)(uint16_t, uint16_
 ////////////////////////////////////////////////////////////////////////
 
 void PCSX::SPU::impl::playCDDAchannel(int16_t *data, int size) {
+    catchUp();
     m_cdda.freq = 44100;
     m_cdda.nsamples = size / 4;
     m_cdda.stereo = 1;
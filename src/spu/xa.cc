@@ -29,6 +29,9 @@
 
 #include <algorithm>
 
+#include "core/audiodump.h"
+#include "core/psxemulator.h"
+#include "core/videorecorder.h"
 #include "spu/externals.h"
 #include "spu/gauss.h"
 #include "spu/interface.h"
@@ -159,5 +162,10 @@ void PCSX::SPU::impl::FeedXA(xa_decode_t *xap) {
     }
     if (pMixIrq) cbMtx.unlock();
 
-    m_audioOut.feedStreamData(reinterpret_cast<MiniAudio::Frame *>(XABuffer), (XAFeed - XABuffer), 1);
+    // Headless, the CD audio goes straight to the recorders.
+    const size_t frames = XAFeed - XABuffer;
+    if (m_headless || m_audioOut.feedStreamData(reinterpret_cast<MiniAudio::Frame *>(XABuffer), frames, 1)) {
+        g_emulator->m_videoRecorder->audio(reinterpret_cast<const int16_t *>(XABuffer), frames, 1);
+        g_emulator->m_audioDump->audio(reinterpret_cast<const int16_t *>(XABuffer), frames, 1);
+    }
 }
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace PCSX {
+
+// Bump allocator, for lots of small objects which all die at the same time. Memory is carved
+// out of large blocks, and only ever given back all at once, by reset(), which keeps the blocks
+// around for the next round. The objects' destructors are the caller's business.
+template <size_t BlockSize = 256 * 1024>
+class Arena {
+  public:
+    static constexpr size_t BLOCK_SIZE = BlockSize;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        while (m_block < m_blocks.size()) {
+            auto& block = m_blocks[m_block];
+            const size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+            if ((offset + size) <= block.size) {
+                m_offset = offset + size;
+                m_used += size;
+                return block.data.get() + offset;
+            }
+            m_block++;
+            m_offset = 0;
+        }
+        // Blocks are aligned for anything, and the ones too large for the standard size get their own.
+        m_blocks.push_back({std::unique_ptr<uint8_t[]>(new uint8_t[std::max(size, BLOCK_SIZE)]),
+                            std::max(size, BLOCK_SIZE)});
+        m_block = m_blocks.size() - 1;
+        m_offset = size;
+        m_used += size;
+        return m_blocks.back().data.get();
+    }
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+    void reset() {
+        m_block = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    // Bytes handed out since the last reset, and bytes reserved overall.
+    size_t used() const { return m_used; }
+    size_t reserved() const {
+        size_t ret = 0;
+        for (auto& block : m_blocks) ret += block.size;
+        return ret;
+    }
+
+  private:
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+    std::vector<Block> m_blocks;
+    size_t m_block = 0;
+    size_t m_offset = 0;
+    size_t m_used = 0;
+};
+
+}  // namespace PCSX
@@ -0,0 +1,198 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "support/hash64.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "support/simd.h"
+
+namespace {
+
+constexpr uint32_t PRIME32_1 = 0x9e3779b1;
+constexpr uint64_t PRIME64_1 = 0x9e3779b185ebca87;
+constexpr uint64_t PRIME64_2 = 0xc2b2ae3d27d4eb4f;
+constexpr uint64_t PRIME64_3 = 0x165667b19e3779f9;
+
+constexpr unsigned LANES = PCSX::Hash64::LANES;
+constexpr size_t STRIPE_SIZE = PCSX::Hash64::STRIPE_SIZE;
+constexpr unsigned STRIPES_PER_BLOCK = PCSX::Hash64::STRIPES_PER_BLOCK;
+
+struct Keys {
+    uint64_t accumulate[LANES];
+    uint64_t scramble[LANES];
+};
+
+// Any well spread out set of constants will do; these come out of splitmix64.
+constexpr Keys makeKeys() {
+    Keys keys = {};
+    uint64_t state = PRIME64_3;
+    auto next = [&state]() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    };
+    for (auto &key : keys.accumulate) key = next();
+    for (auto &key : keys.scramble) key = next();
+    return keys;
+}
+
+constexpr Keys c_keys = makeKeys();
+
+uint64_t read64(const uint8_t *data) {
+    uint64_t ret;
+    std::memcpy(&ret, data, sizeof(ret));
+    return ret;
+}
+
+uint64_t rotl(uint64_t value, unsigned amount) { return (value << amount) | (value >> (64 - amount)); }
+
+void scrambleScalar(uint64_t *acc) {
+    for (unsigned i = 0; i < LANES; i++) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= c_keys.scramble[i];
+        acc[i] = a * PRIME32_1;
+    }
+}
+
+void accumulateScalar(uint64_t *acc, const uint8_t *stripes, size_t count, unsigned &stripe) {
+    for (size_t s = 0; s < count; s++, stripes += STRIPE_SIZE) {
+        for (unsigned i = 0; i < LANES; i++) {
+            const uint64_t data = read64(stripes + i * sizeof(uint64_t));
+            const uint64_t keyed = data ^ c_keys.accumulate[i];
+            acc[i ^ 1] += data;
+            acc[i] += (keyed & 0xffffffff) * (keyed >> 32);
+        }
+        if (++stripe == STRIPES_PER_BLOCK) {
+            scrambleScalar(acc);
+            stripe = 0;
+        }
+    }
+}
+
+#ifdef PCSX_SIMD_X86
+
+// Four lanes at a time; the neighbouring lane swap of the scalar version is a shuffle within each half.
+AVX2_FUNC __m256i accumulateLanes(__m256i acc, const uint8_t *data, __m256i key) {
+    const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    const __m256i keyed = _mm256_xor_si256(words, key);
+    const __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+    const __m256i swapped = _mm256_shuffle_epi32(words, _MM_SHUFFLE(1, 0, 3, 2));
+    return _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+}
+
+// There's no 64 bits multiplication, so it's done as two 32x32 ones, which is enough for a 32 bits prime.
+AVX2_FUNC __m256i scrambleLanes(__m256i acc, __m256i key) {
+    const __m256i prime = _mm256_set1_epi32(int(PRIME32_1));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+    acc = _mm256_xor_si256(acc, key);
+    const __m256i low = _mm256_mul_epu32(acc, prime);
+    const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+    return _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+}
+
+AVX2_FUNC void accumulateAVX2(uint64_t *acc, const uint8_t *stripes, size_t count, unsigned &stripe) {
+    const auto keys = reinterpret_cast<const __m256i *>(&c_keys);
+    const __m256i key0 = _mm256_loadu_si256(keys + 0), key1 = _mm256_loadu_si256(keys + 1);
+    const __m256i scramble0 = _mm256_loadu_si256(keys + 2), scramble1 = _mm256_loadu_si256(keys + 3);
+    __m256i acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc));
+    __m256i acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + 4));
+    for (size_t s = 0; s < count; s++, stripes += STRIPE_SIZE) {
+        acc0 = accumulateLanes(acc0, stripes, key0);
+        acc1 = accumulateLanes(acc1, stripes + 32, key1);
+        if (++stripe == STRIPES_PER_BLOCK) {
+            acc0 = scrambleLanes(acc0, scramble0);
+            acc1 = scrambleLanes(acc1, scramble1);
+            stripe = 0;
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc), acc0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + 4), acc1);
+}
+
+const PCSX::Hash64::Accumulate s_accumulate = PCSX::SIMD::hasAVX2 ? accumulateAVX2 : accumulateScalar;
+
+#else
+
+const PCSX::Hash64::Accumulate s_accumulate = accumulateScalar;
+
+#endif
+
+uint64_t mix(uint64_t a, uint64_t b) {
+    a *= PRIME64_1;
+    b = rotl(b, 31) * PRIME64_2;
+    return a ^ b ^ (a >> 29);
+}
+
+uint64_t avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+}  // namespace
+
+PCSX::Hash64::Hash64(uint64_t seed, bool forceScalar)
+    : m_accumulate(forceScalar ? accumulateScalar : s_accumulate), m_seed(seed) {
+    for (unsigned i = 0; i < LANES; i++) m_acc[i] = (seed ^ c_keys.accumulate[i]) * PRIME64_2;
+}
+
+void PCSX::Hash64::update(const void *data_, size_t size) {
+    auto data = static_cast<const uint8_t *>(data_);
+    m_length += size;
+    if (m_buffered) {
+        const size_t fill = std::min(size, STRIPE_SIZE - m_buffered);
+        std::memcpy(m_buffer + m_buffered, data, fill);
+        m_buffered += fill;
+        data += fill;
+        size -= fill;
+        if (m_buffered < STRIPE_SIZE) return;
+        m_accumulate(m_acc, m_buffer, 1, m_stripe);
+        m_buffered = 0;
+    }
+    const size_t stripes = size / STRIPE_SIZE;
+    m_accumulate(m_acc, data, stripes, m_stripe);
+    data += stripes * STRIPE_SIZE;
+    size -= stripes * STRIPE_SIZE;
+    std::memcpy(m_buffer, data, size);
+    m_buffered = size;
+}
+
+uint64_t PCSX::Hash64::digest() const {
+    uint64_t acc[LANES];
+    std::memcpy(acc, m_acc, sizeof(acc));
+    unsigned stripe = m_stripe;
+    // The last partial stripe is padded with zeroes; the length then tells such inputs apart.
+    if (m_buffered) {
+        uint8_t last[STRIPE_SIZE] = {};
+        std::memcpy(last, m_buffer, m_buffered);
+        accumulateScalar(acc, last, 1, stripe);
+    }
+    scrambleScalar(acc);
+    uint64_t h = (m_length * PRIME64_1) ^ m_seed;
+    for (unsigned i = 0; i < LANES; i += 2) h += mix(acc[i], acc[i + 1]);
+    return avalanche(h);
+}
@@ -0,0 +1,60 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace PCSX {
+
+// A fast non-cryptographic 64 bits hash, for comparing large buffers such as framebuffers. It is
+// built like the long input loop of XXH3: eight 64 bits lanes, each accumulating the product of
+// the two halves of its input word mixed with a key, scrambled every kilobyte. It isn't compatible
+// with XXH3 itself. The vectorized version is picked at runtime, and gives the same results as the
+// scalar one. Data can be fed in pieces of any size, with the same result as a single update.
+class Hash64 {
+  public:
+    explicit Hash64(uint64_t seed = 0, bool forceScalar = false);
+    void update(const void *data, size_t size);
+    uint64_t digest() const;
+
+    static uint64_t hash(const void *data, size_t size, uint64_t seed = 0) {
+        Hash64 hash(seed);
+        hash.update(data, size);
+        return hash.digest();
+    }
+
+    static constexpr unsigned LANES = 8;
+    static constexpr size_t STRIPE_SIZE = LANES * sizeof(uint64_t);
+    static constexpr unsigned STRIPES_PER_BLOCK = 16;
+    using Accumulate = void (*)(uint64_t *acc, const uint8_t *stripes, size_t count, unsigned &stripe);
+
+  private:
+    Accumulate m_accumulate;
+    uint64_t m_seed;
+    uint64_t m_acc[LANES];
+    uint8_t m_buffer[STRIPE_SIZE];
+    size_t m_buffered = 0;
+    uint64_t m_length = 0;
+    unsigned m_stripe = 0;
+};
+
+}  // namespace PCSX
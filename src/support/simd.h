@@ -0,0 +1,78 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+// The x86 SIMD kernels are built regardless of the compiler's target, and only run once the host CPU
+// has been checked for the instructions they need. Everything else falls back to portable code.
+#if defined(__x86_64__) || defined(_M_AMD64)
+#define PCSX_SIMD_X86
+#if defined(__GNUC__) || defined(__clang__)
+#define SSSE3_FUNC [[gnu::target("ssse3")]]
+#define AVX2_FUNC [[gnu::target("avx2")]]
+#else
+#define SSSE3_FUNC
+#define AVX2_FUNC
+#include <intrin.h>
+#endif
+
+#include "immintrin.h"
+
+namespace PCSX {
+
+namespace SIMD {
+
+inline bool detectSSSE3() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3");
+#else
+    int info[4];
+    __cpuid(info, 1);
+    return info[2] & (1 << 9);
+#endif
+}
+
+// AVX2 also needs the OS to save the upper halves of the YMM registers.
+inline bool detectAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || ((_xgetbv(0) & 6) != 6)) return false;
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#endif
+}
+
+// Inline variables, so they're initialized before any static of a file including this header
+// which depends on them, such as a function pointer picking a kernel.
+inline const bool hasSSSE3 = detectSSSE3();
+inline const bool hasAVX2 = detectAVX2();
+
+}  // namespace SIMD
+
+}  // namespace PCSX
+
+#endif
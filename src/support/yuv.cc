@@ -0,0 +1,217 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "support/yuv.h"
+
+#include "support/simd.h"
+
+namespace {
+
+struct RGB {
+    int r, g, b;
+};
+
+struct Source15 {
+    using Pixel = uint16_t;
+    static RGB load(const uint16_t *row, unsigned x) {
+        const unsigned pixel = row[x];
+        const int r = pixel & 0x1f, g = (pixel >> 5) & 0x1f, b = (pixel >> 10) & 0x1f;
+        return {(r << 3) | (r >> 2), (g << 3) | (g >> 2), (b << 3) | (b >> 2)};
+    }
+};
+
+struct Source24 {
+    using Pixel = uint8_t;
+    static RGB load(const uint8_t *row, unsigned x) { return {row[x * 3 + 0], row[x * 3 + 1], row[x * 3 + 2]}; }
+};
+
+uint8_t luma(const RGB &c) { return ((66 * c.r + 129 * c.g + 25 * c.b + 128) >> 8) + 16; }
+
+// Converts two rows of pixels, starting at an even column, into their two rows of luma and their row of chroma.
+template <typename Source>
+void rowsScalar(const typename Source::Pixel *row0, const typename Source::Pixel *row1, unsigned x, unsigned width,
+                uint8_t *y0, uint8_t *y1, uint8_t *u, uint8_t *v) {
+    for (; x < width; x += 2) {
+        const unsigned x1 = (x + 1) < width ? x + 1 : x;
+        const RGB c00 = Source::load(row0, x), c01 = Source::load(row0, x1);
+        const RGB c10 = Source::load(row1, x), c11 = Source::load(row1, x1);
+        y0[x] = luma(c00);
+        y1[x] = luma(c10);
+        if (x1 != x) {
+            y0[x1] = luma(c01);
+            y1[x1] = luma(c11);
+        }
+        const int r = (c00.r + c01.r + c10.r + c11.r + 2) >> 2;
+        const int g = (c00.g + c01.g + c10.g + c11.g + 2) >> 2;
+        const int b = (c00.b + c01.b + c10.b + c11.b + 2) >> 2;
+        u[x >> 1] = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+        v[x >> 1] = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+    }
+}
+
+// Returns how many columns it converted, all of the remaining ones being left to the scalar version.
+using Rows15 = unsigned (*)(const uint16_t *, const uint16_t *, unsigned, uint8_t *, uint8_t *, uint8_t *, uint8_t *);
+using Rows24 = unsigned (*)(const uint8_t *, const uint8_t *, unsigned, uint8_t *, uint8_t *, uint8_t *, uint8_t *);
+
+template <typename Source>
+void convert(const typename Source::Pixel *src, unsigned stride, unsigned width, unsigned height,
+             const PCSX::YUV::Picture &dest,
+             unsigned (*rows)(const typename Source::Pixel *, const typename Source::Pixel *, unsigned, uint8_t *,
+                              uint8_t *, uint8_t *, uint8_t *)) {
+    for (unsigned j = 0; j < height; j += 2) {
+        const bool last = (j + 1) == height;
+        const auto row0 = src + j * stride;
+        const auto row1 = last ? row0 : row0 + stride;
+        // Odd heights convert their last row twice over the same luma row.
+        uint8_t *y0 = dest.planes[0] + j * dest.strides[0];
+        uint8_t *y1 = last ? y0 : y0 + dest.strides[0];
+        uint8_t *u = dest.planes[1] + (j >> 1) * dest.strides[1];
+        uint8_t *v = dest.planes[2] + (j >> 1) * dest.strides[2];
+        const unsigned done = rows ? rows(row0, row1, width, y0, y1, u, v) : 0;
+        rowsScalar<Source>(row0, row1, done, width, y0, y1, u, v);
+    }
+}
+
+#ifdef PCSX_SIMD_X86
+
+struct Channels {
+    __m256i r, g, b;
+};
+
+AVX2_FUNC inline __m256i expand5(__m256i c) {
+    return _mm256_or_si256(_mm256_slli_epi16(c, 3), _mm256_srli_epi16(c, 2));
+}
+
+AVX2_FUNC inline Channels load15(const uint16_t *p) {
+    const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    const __m256i mask = _mm256_set1_epi16(0x1f);
+    return {expand5(_mm256_and_si256(pixels, mask)), expand5(_mm256_and_si256(_mm256_srli_epi16(pixels, 5), mask)),
+            expand5(_mm256_and_si256(_mm256_srli_epi16(pixels, 10), mask))};
+}
+
+// Picks one of the channels of 8 packed 24 bits pixels into 16 bits lanes. The first 5 pixels come from
+// the first 16 bytes, and the last 3 ones from the 16 bytes starting at the 8th, so as not to read past them.
+AVX2_FUNC inline __m128i channel24(__m128i lo, __m128i hi, int c) {
+    const auto z = char(0x80);
+    const __m128i maskLo = _mm_setr_epi8(c, z, 3 + c, z, 6 + c, z, 9 + c, z, 12 + c, z, z, z, z, z, z, z);
+    const __m128i maskHi = _mm_setr_epi8(z, z, z, z, z, z, z, z, z, z, 7 + c, z, 10 + c, z, 13 + c, z);
+    return _mm_or_si128(_mm_shuffle_epi8(lo, maskLo), _mm_shuffle_epi8(hi, maskHi));
+}
+
+AVX2_FUNC inline Channels load24(const uint8_t *p) {
+    const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 8));
+    const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 24));
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32));
+    return {_mm256_set_m128i(channel24(b0, b1, 0), channel24(a0, a1, 0)),
+            _mm256_set_m128i(channel24(b0, b1, 1), channel24(a0, a1, 1)),
+            _mm256_set_m128i(channel24(b0, b1, 2), channel24(a0, a1, 2))};
+}
+
+// None of the sums overflow 16 bits, so the arithmetic is exactly the scalar one.
+AVX2_FUNC inline __m256i luma(const Channels &c) {
+    __m256i y = _mm256_mullo_epi16(c.r, _mm256_set1_epi16(66));
+    y = _mm256_add_epi16(y, _mm256_mullo_epi16(c.g, _mm256_set1_epi16(129)));
+    y = _mm256_add_epi16(y, _mm256_mullo_epi16(c.b, _mm256_set1_epi16(25)));
+    y = _mm256_srli_epi16(_mm256_add_epi16(y, _mm256_set1_epi16(128)), 8);
+    return _mm256_add_epi16(y, _mm256_set1_epi16(16));
+}
+
+// Averages the 2x2 blocks of a channel into 32 bits lanes.
+AVX2_FUNC inline __m256i average(__m256i row0, __m256i row1) {
+    const __m256i sums = _mm256_madd_epi16(_mm256_add_epi16(row0, row1), _mm256_set1_epi16(1));
+    return _mm256_srai_epi32(_mm256_add_epi32(sums, _mm256_set1_epi32(2)), 2);
+}
+
+AVX2_FUNC inline __m256i chroma(__m256i r, __m256i g, __m256i b, int cr, int cg, int cb) {
+    __m256i c = _mm256_mullo_epi32(r, _mm256_set1_epi32(cr));
+    c = _mm256_add_epi32(c, _mm256_mullo_epi32(g, _mm256_set1_epi32(cg)));
+    c = _mm256_add_epi32(c, _mm256_mullo_epi32(b, _mm256_set1_epi32(cb)));
+    c = _mm256_srai_epi32(_mm256_add_epi32(c, _mm256_set1_epi32(128)), 8);
+    return _mm256_add_epi32(c, _mm256_set1_epi32(128));
+}
+
+template <Channels (*load)(const uint8_t *), unsigned size>
+AVX2_FUNC unsigned rowsAVX2(const uint8_t *row0, const uint8_t *row1, unsigned width, uint8_t *y0, uint8_t *y1,
+                            uint8_t *u, uint8_t *v) {
+    unsigned x = 0;
+    for (; (x + 16) <= width; x += 16) {
+        const Channels c0 = load(row0 + x * size);
+        const Channels c1 = load(row1 + x * size);
+
+        // The packing interleaves the 128 bits lanes, which the permutation puts back in order.
+        __m256i ys = _mm256_packus_epi16(luma(c0), luma(c1));
+        ys = _mm256_permute4x64_epi64(ys, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(y0 + x), _mm256_castsi256_si128(ys));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(y1 + x), _mm256_extracti128_si256(ys, 1));
+
+        const __m256i r = average(c0.r, c1.r), g = average(c0.g, c1.g), b = average(c0.b, c1.b);
+        __m256i uv = _mm256_packs_epi32(chroma(r, g, b, -38, -74, 112), chroma(r, g, b, 112, -94, -18));
+        uv = _mm256_packus_epi16(uv, uv);
+        uv = _mm256_permutevar8x32_epi32(uv, _mm256_setr_epi32(0, 4, 1, 5, 0, 0, 0, 0));
+        const __m128i packed = _mm256_castsi256_si128(uv);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(u + (x >> 1)), packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(v + (x >> 1)), _mm_srli_si128(packed, 8));
+    }
+    return x;
+}
+
+AVX2_FUNC Channels load15Bytes(const uint8_t *p) { return load15(reinterpret_cast<const uint16_t *>(p)); }
+
+unsigned rows15AVX2(const uint16_t *row0, const uint16_t *row1, unsigned width, uint8_t *y0, uint8_t *y1, uint8_t *u,
+                    uint8_t *v) {
+    return rowsAVX2<load15Bytes, 2>(reinterpret_cast<const uint8_t *>(row0), reinterpret_cast<const uint8_t *>(row1),
+                                    width, y0, y1, u, v);
+}
+
+unsigned rows24AVX2(const uint8_t *row0, const uint8_t *row1, unsigned width, uint8_t *y0, uint8_t *y1, uint8_t *u,
+                    uint8_t *v) {
+    return rowsAVX2<load24, 3>(row0, row1, width, y0, y1, u, v);
+}
+
+const Rows15 s_rows15 = PCSX::SIMD::hasAVX2 ? rows15AVX2 : nullptr;
+const Rows24 s_rows24 = PCSX::SIMD::hasAVX2 ? rows24AVX2 : nullptr;
+
+#else
+
+const Rows15 s_rows15 = nullptr;
+const Rows24 s_rows24 = nullptr;
+
+#endif
+
+}  // namespace
+
+void PCSX::YUV::convert15(const uint16_t *src, unsigned stride, unsigned width, unsigned height, const Picture &dest) {
+    ::convert<Source15>(src, stride, width, height, dest, s_rows15);
+}
+
+void PCSX::YUV::convert24(const uint8_t *src, unsigned stride, unsigned width, unsigned height, const Picture &dest) {
+    ::convert<Source24>(src, stride, width, height, dest, s_rows24);
+}
+
+void PCSX::YUV::convert15Scalar(const uint16_t *src, unsigned stride, unsigned width, unsigned height,
+                                const Picture &dest) {
+    ::convert<Source15>(src, stride, width, height, dest, nullptr);
+}
+
+void PCSX::YUV::convert24Scalar(const uint8_t *src, unsigned stride, unsigned width, unsigned height,
+                                const Picture &dest) {
+    ::convert<Source24>(src, stride, width, height, dest, nullptr);
+}
@@ -0,0 +1,47 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+namespace PCSX {
+
+// Converts the PlayStation framebuffers, either 15 bits or packed 24 bits, into planar YUV 4:2:0
+// pictures, which is what the video encoders want. The coefficients are the BT.601 limited range
+// ones, and the chroma is the average of each 2x2 block. Odd sizes repeat the last row or column.
+// The vectorized versions are picked at runtime, and produce the exact same output as the scalar ones.
+struct YUV {
+    struct Picture {
+        uint8_t *planes[3];
+        int strides[3];
+    };
+
+    // The source strides are in pixels for 15 bits, and in bytes for 24 bits.
+    static void convert15(const uint16_t *src, unsigned stride, unsigned width, unsigned height, const Picture &dest);
+    static void convert24(const uint8_t *src, unsigned stride, unsigned width, unsigned height, const Picture &dest);
+
+    static void convert15Scalar(const uint16_t *src, unsigned stride, unsigned width, unsigned height,
+                                const Picture &dest);
+    static void convert24Scalar(const uint8_t *src, unsigned stride, unsigned width, unsigned height,
+                                const Picture &dest);
+};
+
+}  // namespace PCSX
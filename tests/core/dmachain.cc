@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/dmachain.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::DMAChain;
+
+namespace {
+
+constexpr uint32_t MASK = 0x1ffffc;
+constexpr uint32_t END = 0xffffff;
+
+struct RAM {
+    RAM() : words(0x200000 / 4) {}
+    // Writes a node at addr, with count payload words, each holding its own address.
+    void node(uint32_t addr, uint32_t count, uint32_t next) {
+        words[addr >> 2] = (count << 24) | (next & 0xffffff);
+        for (uint32_t i = 1; i <= count; i++) words[(addr >> 2) + i] = addr + i * 4;
+    }
+    std::vector<uint32_t> words;
+};
+
+struct Packet {
+    uint32_t addr;
+    uint32_t count;
+};
+
+uint32_t walk(DMAChain &chain, const RAM &ram, uint32_t addr, std::vector<Packet> &packets) {
+    packets.clear();
+    return chain.walk(ram.words.data(), addr, MASK, [&](const uint32_t *words, uint32_t count, uint32_t addr) {
+        for (uint32_t i = 0; i < count; i++) EXPECT_EQ(words[i], addr + (i + 1) * 4);
+        packets.push_back({addr, count});
+    });
+}
+
+}  // namespace
+
+TEST(DMAChain, FollowsTheList) {
+    RAM ram;
+    DMAChain chain;
+    std::vector<Packet> packets;
+    ram.node(0x1000, 3, 0x80);
+    ram.node(0x80, 0, 0x2000);
+    ram.node(0x2000, 1, END);
+
+    EXPECT_EQ(walk(chain, ram, 0x1000, packets), 1 + 4 + 1 + 2);
+    ASSERT_EQ(packets.size(), 2);
+    EXPECT_EQ(packets[0].addr, 0x1000);
+    EXPECT_EQ(packets[0].count, 3);
+    EXPECT_EQ(packets[1].addr, 0x2000);
+    EXPECT_EQ(packets[1].count, 1);
+
+    // Any next address with bit 23 set ends the list.
+    ram.node(0x2000, 1, 0x800000);
+    EXPECT_EQ(walk(chain, ram, 0x1000, packets), 1 + 4 + 1 + 2);
+    EXPECT_EQ(packets.size(), 2);
+
+    // Addresses wrap within the RAM.
+    ram.node(0x2000, 1, 0x200000 + 0x3000);
+    ram.node(0x3000, 2, END);
+    EXPECT_EQ(walk(chain, ram, 0x1000, packets), 1 + 4 + 1 + 2 + 3);
+    ASSERT_EQ(packets.size(), 3);
+    EXPECT_EQ(packets[2].addr, 0x3000);
+}
+
+TEST(DMAChain, OrderingTable) {
+    RAM ram;
+    DMAChain chain;
+    std::vector<Packet> packets;
+    // A cleared ordering table walked backwards, like OTC leaves it, with a couple of primitives linked in.
+    constexpr uint32_t OT = 0x10000;
+    constexpr uint32_t ENTRIES = 4096;
+    for (uint32_t i = 0; i < ENTRIES; i++) ram.node(OT + i * 4, 0, i == 0 ? END : OT + (i - 1) * 4);
+    ram.node(OT + 100 * 4, 0, 0x40000);
+    ram.node(0x40000, 5, 0x40100);
+    ram.node(0x40100, 7, OT + 99 * 4);
+
+    EXPECT_EQ(walk(chain, ram, OT + (ENTRIES - 1) * 4, packets), 1 + ENTRIES + 6 + 8);
+    ASSERT_EQ(packets.size(), 2);
+    EXPECT_EQ(packets[0].addr, 0x40000);
+    EXPECT_EQ(packets[1].addr, 0x40100);
+}
+
+TEST(DMAChain, CutsLoops) {
+    RAM ram;
+    DMAChain chain;
+    std::vector<Packet> packets;
+
+    ram.node(0x100, 2, 0x100);
+    EXPECT_EQ(walk(chain, ram, 0x100, packets), 1 + 3);
+    EXPECT_EQ(packets.size(), 1);
+
+    // A long cycle, entered from outside of it, runs once through.
+    ram.node(0x200, 1, 0x10000);
+    for (uint32_t i = 0; i < 1000; i++) ram.node(0x10000 + i * 16, 2, 0x10000 + ((i + 1) % 1000) * 16);
+    EXPECT_EQ(walk(chain, ram, 0x200, packets), 1 + 2 + 1000 * 3);
+    EXPECT_EQ(packets.size(), 1001);
+
+    // Going through a mirror of a node already visited is the same loop.
+    ram.node(0x300, 1, 0x200000 + 0x300);
+    EXPECT_EQ(walk(chain, ram, 0x300, packets), 1 + 2);
+
+    // Nodes visited by a previous walk don't count.
+    for (unsigned i = 0; i < 70000; i++) {
+        ram.node(0x400, 1, END);
+        ASSERT_EQ(walk(chain, ram, 0x400, packets), 1 + 2) << "walk " << i;
+    }
+}
@@ -0,0 +1,236 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "core/gtekernels.h"
+
+#include <string.h>
+
+#include <random>
+
+#include "core/gte.h"
+#include "gtest/gtest.h"
+
+using PCSX::GTEKernels;
+
+namespace {
+
+constexpr uint32_t SF = 1 << 19;
+constexpr uint32_t NCT = 0x4a000020 | SF;
+constexpr uint32_t NCCT = 0x4a00003f | SF;
+constexpr uint32_t NCDT = 0x4a000016 | SF;
+constexpr uint32_t DPCT = 0x4a00002a | SF;
+
+struct Files {
+    GTEKernels::Registers regs() { return {words, words + 32}; }
+    uint32_t *data() { return words; }
+    uint32_t *ctrl() { return words + 32; }
+    uint32_t words[64] = {};
+};
+
+void run(uint32_t op, Files &files, bool forceScalar) {
+    switch (op & 0x3f) {
+        case NCT & 0x3f:
+            GTEKernels::NCT(files.regs(), op, forceScalar);
+            break;
+        case NCCT & 0x3f:
+            GTEKernels::NCCT(files.regs(), op, forceScalar);
+            break;
+        case NCDT & 0x3f:
+            GTEKernels::NCDT(files.regs(), op, forceScalar);
+            break;
+        case DPCT & 0x3f:
+            GTEKernels::DPCT(files.regs(), op, forceScalar);
+            break;
+    }
+}
+
+}  // namespace
+
+TEST(GTEKernels, DPCTWithoutDepth) {
+    // With IR0 at 0, the colors go through the FIFO untouched, save for the code byte.
+    for (bool forceScalar : {true, false}) {
+        Files files;
+        files.data()[6] = 0x55000000;
+        files.data()[20] = 0x00102030;
+        files.data()[21] = 0x00405060;
+        files.data()[22] = 0x007080f0;
+        run(DPCT, files, forceScalar);
+        EXPECT_EQ(files.data()[20], 0x55102030);
+        EXPECT_EQ(files.data()[21], 0x55405060);
+        EXPECT_EQ(files.data()[22], 0x557080f0);
+        EXPECT_EQ(files.data()[25], 0xf0 << 4);
+        EXPECT_EQ(files.data()[26], 0x80 << 4);
+        EXPECT_EQ(files.data()[27], 0x70 << 4);
+        EXPECT_EQ(files.data()[9], 0xf0 << 4);
+        EXPECT_EQ(files.ctrl()[31], 0);
+    }
+}
+
+TEST(GTEKernels, MACOverflow) {
+    // The light matrix turns the first vertex into IR1 = 0x1000, which the color matrix then
+    // pushes past the 44 bits of the MAC unit, on top of a background color right under the limit.
+    Files reference;
+    reference.data()[0] = 0x1000;
+    reference.ctrl()[8] = 0x1000;
+    reference.ctrl()[13] = 0x7fffffff;
+    reference.ctrl()[16] = 0x7fff;
+    for (bool forceScalar : {true, false}) {
+        Files files = reference;
+        run(NCT, files, forceScalar);
+        EXPECT_EQ(files.ctrl()[31] & ((1u << 31) | (1 << 30)), (1u << 31) | (1 << 30));
+        // The sum wrapped around to a negative value, which saturates IR1 and the red component
+        // of the first color, now at the bottom of the FIFO.
+        EXPECT_NE(files.ctrl()[31] & (1 << 24), 0);
+        EXPECT_NE(files.ctrl()[31] & (1 << 21), 0);
+        EXPECT_EQ(files.data()[20] & 0xff, 0);
+    }
+}
+
+TEST(GTEKernels, VectorMatchesScalar) {
+    // Both versions are the same one otherwise.
+    if (!GTEKernels::vectorized()) return;
+    std::mt19937 rng(1234);
+    const uint32_t ops[] = {NCT, NCCT, NCDT, DPCT};
+    for (unsigned i = 0; i < 100000; i++) {
+        Files reference;
+        // Half of the runs with small values, which stay within the vectorized path, and half with
+        // anything, which mostly overflows into the scalar one.
+        const uint32_t mask = (i & 1) ? 0x0fff0fff : 0xffffffff;
+        for (auto &word : reference.words) word = rng() & mask;
+        reference.ctrl()[31] = 0;
+        const uint32_t op = (ops[i % 4] & ~(SF | (1 << 10))) | (rng() & (SF | (1 << 10)));
+        Files scalar = reference;
+        Files vector = reference;
+        run(op, scalar, true);
+        run(op, vector, false);
+        for (unsigned w = 0; w < 64; w++) {
+            ASSERT_EQ(scalar.words[w], vector.words[w]) << "run " << i << ", op " << op << ", word " << w;
+        }
+    }
+}
+
+namespace {
+
+// The interpreter, running on a register file of its own.
+struct Interpreter {
+    Interpreter(Files &files) {
+        static_assert(sizeof(PCSX::psxCP2Data) == 32 * 4 && sizeof(PCSX::psxCP2Ctrl) == 32 * 4);
+        memcpy(data.r, files.data(), sizeof(data));
+        memcpy(ctrl.r, files.ctrl(), sizeof(ctrl));
+        gte.setRegisters(&data, &ctrl);
+    }
+    void store(Files &files) {
+        memcpy(files.data(), data.r, sizeof(data));
+        memcpy(files.ctrl(), ctrl.r, sizeof(ctrl));
+    }
+    PCSX::psxCP2Data data;
+    PCSX::psxCP2Ctrl ctrl;
+    PCSX::GTE gte;
+};
+
+// What the three vertices commands do, out of the interpreter's one vertex commands: each of
+// the vertices in turn goes through V0, or for DPCT, each of the FIFO's colors through RGBC,
+// and FLAG gathers all three runs' flags.
+void runSingles(uint32_t op, Files &files) {
+    Interpreter interpreter(files);
+    auto &data = interpreter.data.r;
+    const uint32_t v0[2] = {data[0], data[1]};
+    const uint32_t rgbc = data[6];
+    uint32_t flag = 0;
+    for (unsigned v = 0; v < 3; v++) {
+        const uint32_t single = op & ~0x3f;
+        data[0] = v0[0];
+        data[1] = v0[1];
+        if (v) {
+            data[0] = data[v * 2];
+            data[1] = (v0[1] & 0xffff0000) | (data[v * 2 + 1] & 0xffff);
+        }
+        switch (op & 0x3f) {
+            case NCT & 0x3f:
+                interpreter.gte.NCS(single | 0x1e);
+                break;
+            case NCCT & 0x3f:
+                interpreter.gte.NCCS(single | 0x1b);
+                break;
+            case NCDT & 0x3f:
+                interpreter.gte.NCDS(single | 0x13);
+                break;
+            case DPCT & 0x3f:
+                data[6] = (rgbc & 0xff000000) | (data[20] & 0x00ffffff);
+                interpreter.gte.DPCS(single | 0x10);
+                break;
+        }
+        flag |= interpreter.ctrl.r[31];
+    }
+    data[0] = v0[0];
+    data[1] = v0[1];
+    data[6] = rgbc;
+    interpreter.ctrl.r[31] = flag;
+    interpreter.store(files);
+}
+
+// The three vertices commands, as the interpreter runs them.
+void runTriple(uint32_t op, Files &files) {
+    Interpreter interpreter(files);
+    switch (op & 0x3f) {
+        case NCT & 0x3f:
+            interpreter.gte.NCT(op);
+            break;
+        case NCCT & 0x3f:
+            interpreter.gte.NCCT(op);
+            break;
+        case NCDT & 0x3f:
+            interpreter.gte.NCDT(op);
+            break;
+        case DPCT & 0x3f:
+            interpreter.gte.DPCT(op);
+            break;
+    }
+    interpreter.store(files);
+}
+
+}  // namespace
+
+TEST(GTEKernels, MatchesInterpreter) {
+    // The scalar version always runs, and the vector one, through the interpreter's entry points,
+    // when the host has it.
+    std::mt19937 rng(1234);
+    const uint32_t ops[] = {NCT, NCCT, NCDT, DPCT};
+    for (unsigned i = 0; i < 100000; i++) {
+        Files reference;
+        // A third of the runs with small values, which stay within the vectorized path and mostly
+        // away from the saturations, and the rest with anything, which mostly overflows the MAC
+        // units into the scalar one, and saturates the IR registers and the colors.
+        const uint32_t mask = (i % 3) == 0 ? 0x0fff0fff : (i % 3) == 1 ? 0x7fff7fff : 0xffffffff;
+        for (auto &word : reference.words) word = rng() & mask;
+        // FLAG is left over from before the command, which has to clear it.
+        const uint32_t op = (ops[i % 4] & ~(SF | (1 << 10))) | (rng() & (SF | (1 << 10)));
+        Files singles = reference;
+        Files triple = reference;
+        Files scalar = reference;
+        scalar.ctrl()[31] = 0;
+        runSingles(op, singles);
+        runTriple(op, triple);
+        run(op, scalar, true);
+        for (unsigned w = 0; w < 64; w++) {
+            ASSERT_EQ(scalar.words[w], singles.words[w]) << "run " << i << ", op " << op << ", word " << w;
+            ASSERT_EQ(triple.words[w], singles.words[w]) << "run " << i << ", op " << op << ", word " << w;
+        }
+    }
+}
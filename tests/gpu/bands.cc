@@ -0,0 +1,268 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "gpu/soft/bands.h"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+#include "gpu/soft/soft.h"
+#include "gtest/gtest.h"
+
+using PCSX::GPU;
+using PCSX::SoftGPU::Bands;
+using PCSX::SoftGPU::SoftRenderer;
+
+namespace {
+
+// What the soft GPU passes as the writes of a primitive: the bounding box of its vertices, clipped to
+// the drawing area.
+Bands::Tiles covered(const SoftRenderer &state, std::initializer_list<int> xs, std::initializer_list<int> ys) {
+    return Bands::region(std::max(std::min(xs), state.m_drawX), std::max(std::min(ys), state.m_drawY),
+                         std::min(std::max(xs), state.m_drawW), std::min(std::max(ys), state.m_drawH));
+}
+
+struct Target {
+    Target() : allocated(1024 * 512 * 2 + 1024 * 1024) {
+        renderer.m_vram = allocated.data() + 512 * 1024;
+        renderer.m_vram16 = reinterpret_cast<uint16_t *>(renderer.m_vram);
+        renderer.resetRenderer();
+        GPU::TWindow window;
+        renderer.twindow(&window);
+        renderer.m_softDisplay.DrawOffset.x = renderer.m_softDisplay.DrawOffset.y = 0;
+    }
+    std::vector<uint8_t> allocated;
+    SoftRenderer renderer;
+};
+
+// Draws the same random scene twice, once directly, and once through the bands,
+// and returns whether both VRAMs ended up identical.
+bool drawScene(unsigned threads, unsigned seed, unsigned count) {
+    Target reference, banded;
+    std::mt19937 gen(seed);
+    auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+
+    for (auto &b : reference.allocated) b = rnd(0, 255);
+    banded.allocated = reference.allocated;
+
+    Bands bands;
+    bands.start(threads);
+
+    auto both = [&](auto &&f) {
+        f(reference.renderer);
+        f(banded.renderer);
+    };
+
+    for (unsigned i = 0; i < count; i++) {
+        if (rnd(0, 15) == 0) {
+            GPU::DrawingAreaStart start;
+            GPU::DrawingAreaEnd end;
+            start.x = rnd(0, 700);
+            start.y = rnd(0, 400);
+            end.x = std::min<int>(start.x + rnd(0, 400), 1023);
+            end.y = std::min<int>(start.y + rnd(-2, 300), 511);
+            both([&](SoftRenderer &r) {
+                r.drawingAreaStart(&start);
+                r.drawingAreaEnd(&end);
+            });
+        }
+        if (rnd(0, 7) == 0) {
+            GPU::TPage tpage;
+            tpage.tx = rnd(0, 15);
+            tpage.ty = rnd(0, 1);
+            tpage.blendFunction = GPU::BlendFunction(rnd(0, 3));
+            tpage.texDepth = GPU::TexDepth(rnd(0, 2));
+            both([&](SoftRenderer &r) { r.texturePage(&tpage); });
+        }
+        if (rnd(0, 15) == 0) {
+            GPU::MaskBit mask;
+            mask.set = rnd(0, 1);
+            mask.check = rnd(0, 1);
+            both([&](SoftRenderer &r) { r.maskBit(&mask); });
+        }
+
+        const auto &state = reference.renderer;
+        const bool semi = rnd(0, 1);
+        const int16_t m = rnd(0, 255);
+        int16_t x[4], y[4], u[4], v[4];
+        int32_t c[4];
+        const int cx = rnd(state.m_drawX - 32, state.m_drawW + 32);
+        const int cy = rnd(state.m_drawY - 32, state.m_drawH + 32);
+        const int size = rnd(1, 128);
+        for (unsigned j = 0; j < 4; j++) {
+            x[j] = cx + rnd(-size, size);
+            y[j] = cy + rnd(-size, size);
+            u[j] = rnd(0, 255);
+            v[j] = rnd(0, 255);
+            c[j] = rnd(0, 0xffffff);
+        }
+        const int16_t clX = rnd(0, 63) * 16;
+        const int16_t clY = rnd(0, 511);
+        both([&](SoftRenderer &r) {
+            r.m_drawSemiTrans = semi;
+            r.m_m1 = r.m_m2 = r.m_m3 = m;
+            r.m_x0 = x[0];
+            r.m_y0 = y[0];
+            r.m_x1 = x[1];
+            r.m_y1 = y[1];
+            r.m_x2 = x[2];
+            r.m_y2 = y[2];
+            r.m_x3 = x[3];
+            r.m_y3 = y[3];
+        });
+
+        // The worst case texture footprint, like the soft GPU computes it
+        const auto reads =
+            Bands::region(state.m_globalTextAddrX, state.m_globalTextAddrY, state.m_globalTextAddrX + 255,
+                          state.m_globalTextAddrY + 255) |
+            Bands::region(clX, clY, clX + 255, clY);
+        Bands::Clip clip = Bands::Clip::Area;
+        Bands::Draw draw;
+        // The far corner of the sprites and the fills.
+        int farX = x[0], farY = y[0];
+        switch (rnd(0, 11)) {
+            case 0:
+                draw = [=](SoftRenderer &r) { r.drawPolyFlat3(c[0]); };
+                break;
+            case 1:
+                draw = [=](SoftRenderer &r) { r.drawPolyShade4(c[0], c[1], c[2], c[3]); };
+                break;
+            case 2:
+                draw = [=](SoftRenderer &r) {
+                    r.drawPolyTextured3(x[0], y[0], x[1], y[1], x[2], y[2], u[0], v[0], u[1], v[1], u[2], v[2], clX,
+                                        clY);
+                };
+                break;
+            case 3:
+                draw = [=](SoftRenderer &r) {
+                    r.drawPolyTextured4(x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3], u[0], v[0], u[1], v[1], u[2],
+                                        v[2], u[3], v[3], clX, clY);
+                };
+                break;
+            case 4:
+                draw = [=](SoftRenderer &r) {
+                    r.drawPoly3TGD(x[0], y[0], x[1], y[1], x[2], y[2], u[0], v[0], u[1], v[1], u[2], v[2], c[0], c[1],
+                                   c[2]);
+                };
+                break;
+            case 5:
+                draw = [=](SoftRenderer &r) {
+                    r.drawPoly4TGEx4(x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3], u[0], v[0], u[1], v[1], u[2],
+                                     v[2], u[3], v[3], clX, clY, c[0], c[1], c[2], c[3]);
+                };
+                break;
+            case 6: {
+                const int16_t w = rnd(1, 64);
+                const int16_t h = rnd(1, 64);
+                farX = x[0] + w;
+                farY = y[0] + h;
+                draw = [=](SoftRenderer &r) {
+                    r.drawPolyTextured4(x[0], y[0], x[0] + w, y[0], x[0] + w, y[0] + h, x[0], y[0] + h, u[0], v[0],
+                                        u[0] + w, v[0], u[0] + w, v[0] + h, u[0], v[0] + h, clX, clY);
+                };
+                break;
+            }
+            case 7: {
+                const int16_t w = rnd(0, 100);
+                const int16_t h = rnd(0, 100);
+                farX = x[0] + w;
+                farY = y[0] + h;
+                draw = [=](SoftRenderer &r) { r.fillSoftwareAreaTrans(x[0], y[0], x[0] + w, y[0] + h, c[0]); };
+                break;
+            }
+            case 8:
+                clip = Bands::Clip::Line;
+                draw = [=](SoftRenderer &r) { r.drawSoftwareLineFlat(c[0]); };
+                break;
+            case 9:
+                clip = Bands::Clip::Line;
+                both([&](SoftRenderer &r) { r.m_x1 = r.m_x0; });
+                draw = [=](SoftRenderer &r) { r.drawSoftwareLineShade(c[0], c[1]); };
+                break;
+            case 10:
+                clip = Bands::Clip::Line;
+                both([&](SoftRenderer &r) { r.m_y1 = r.m_y0; });
+                draw = [=](SoftRenderer &r) { r.drawSoftwareLineShade(c[0], c[1]); };
+                break;
+            case 11: {
+                // Something touching the VRAM directly, such as a fast fill
+                const int16_t fx = rnd(0, 1000), fy = rnd(0, 500), fw = rnd(1, 64) * 2, fh = rnd(1, 64);
+                reference.renderer.fillSoftwareArea(fx, fy, fx + fw, fy + fh, c[0]);
+                bands.claim({}, Bands::region(fx, fy, fx + fw - 1, fy + fh - 1));
+                banded.renderer.fillSoftwareArea(fx, fy, fx + fw, fy + fh, c[0]);
+                continue;
+            }
+        }
+        draw(reference.renderer);
+        const auto writes = covered(state, {x[0], x[1], x[2], x[3], farX}, {y[0], y[1], y[2], y[3], farY});
+        bands.submit(banded.renderer, clip, reads, writes, std::move(draw));
+    }
+
+    bands.sync();
+    return std::memcmp(reference.allocated.data(), banded.allocated.data(), reference.allocated.size()) == 0;
+}
+
+}  // namespace
+
+TEST(SoftBands, Region) {
+    EXPECT_TRUE(Bands::region(10, 10, 5, 20).none());
+    EXPECT_EQ(Bands::region(0, 0, 63, 63).count(), 1);
+    EXPECT_EQ(Bands::region(0, 0, 1023, 511).count(), Bands::TILES_X * Bands::TILES_Y);
+    // Spilling past the right edge lands on the left side of the next row.
+    EXPECT_TRUE(Bands::region(960, 0, 1030, 0).test(Bands::TILES_X - 1));
+    EXPECT_TRUE(Bands::region(960, 63, 1030, 63).test(Bands::TILES_X));
+}
+
+TEST(SoftBands, Rects) {
+    EXPECT_TRUE(Bands::rects({}).empty());
+    auto all = Bands::rects(Bands::region(0, 0, 1023, 511));
+    ASSERT_EQ(all.size(), 1);
+    EXPECT_EQ(all[0].x, 0);
+    EXPECT_EQ(all[0].y, 0);
+    EXPECT_EQ(all[0].w, 1024);
+    EXPECT_EQ(all[0].h, 512);
+
+    std::mt19937 gen(1234);
+    for (unsigned i = 0; i < 1000; i++) {
+        Bands::Tiles tiles;
+        const unsigned regions = std::uniform_int_distribution<unsigned>(0, 8)(gen);
+        for (unsigned j = 0; j < regions; j++) {
+            std::uniform_int_distribution<int> x(0, 1023), y(0, 511);
+            tiles |= Bands::region(x(gen), y(gen), x(gen), y(gen));
+        }
+        // Every tile has to be covered exactly once.
+        Bands::Tiles covered;
+        for (auto &rect : Bands::rects(tiles)) {
+            const auto r = Bands::region(rect.x, rect.y, rect.x + rect.w - 1, rect.y + rect.h - 1);
+            ASSERT_EQ(rect.w * rect.h, r.count() * 64 * 64);
+            ASSERT_TRUE((covered & r).none());
+            covered |= r;
+        }
+        ASSERT_EQ(covered, tiles) << "iteration " << i;
+    }
+}
+
+TEST(SoftBands, MatchesSingleThread) {
+    for (unsigned threads = 2; threads <= 7; threads++) {
+        EXPECT_TRUE(drawScene(threads, threads * 1337, 4000));
+    }
+}
@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "gpu/soft/blit.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::SoftGPU::VRAMBlit;
+
+namespace {
+
+std::vector<uint16_t> randomPixels(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint16_t> ret(count);
+    for (auto &pixel : ret) pixel = rng();
+    return ret;
+}
+
+uint16_t &at(std::vector<uint16_t> &vram, int x, int y) {
+    return vram[(y & (VRAMBlit::HEIGHT - 1)) * VRAMBlit::WIDTH + (x & (VRAMBlit::WIDTH - 1))];
+}
+
+const VRAMBlit::Mask c_masks[] = {{false, 0}, {false, 0x8000}, {true, 0}, {true, 0x8000}};
+
+}  // namespace
+
+TEST(VRAMBlit, FillSpan) {
+    std::vector<uint16_t> pixels(100, 0x1234);
+    VRAMBlit::fillSpan(pixels.data() + 3, 90, 0x8421);
+    for (unsigned i = 0; i < pixels.size(); i++) {
+        EXPECT_EQ(pixels[i], ((i >= 3) && (i < 93)) ? 0x8421 : 0x1234) << "pixel " << i;
+    }
+}
+
+TEST(VRAMBlit, CopySpanMatchesScalar) {
+    for (const auto mask : c_masks) {
+        for (unsigned count : {1, 7, 8, 9, 31, 640}) {
+            // Disjoint spans, then overlapping ones both ways.
+            for (int offset : {2000, 5, -5, 9, -9, 0}) {
+                auto expected = randomPixels(4000, count);
+                auto actual = expected;
+                VRAMBlit::copySpanScalar(expected.data() + 1000 + offset, expected.data() + 1000, count, mask);
+                VRAMBlit::copySpan(actual.data() + 1000 + offset, actual.data() + 1000, count, mask);
+                ASSERT_EQ(actual, expected) << "count " << count << ", offset " << offset << ", check "
+                                            << mask.check << ", set " << mask.set;
+            }
+        }
+    }
+}
+
+TEST(VRAMBlit, CopySpanIsAMemmove) {
+    std::vector<uint16_t> pixels = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    VRAMBlit::copySpan(pixels.data() + 2, pixels.data(), 10, {false, 0x8000});
+    EXPECT_EQ(pixels, std::vector<uint16_t>({1, 2, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007, 0x8008,
+                                             0x8009, 0x800a}));
+}
+
+TEST(VRAMBlit, MaskCheck) {
+    std::vector<uint16_t> dest = {0x8000, 0x0001, 0xffff, 0x7fff, 0x8000, 0x0001, 0xffff, 0x7fff, 0x8123};
+    const std::vector<uint16_t> src = {0x1111, 0x2222, 0x3333, 0x4444, 0x5555, 0x6666, 0x7777, 0x8888, 0x9999};
+    VRAMBlit::copySpan(dest.data(), src.data(), dest.size(), {true, 0});
+    EXPECT_EQ(dest, std::vector<uint16_t>({0x8000, 0x2222, 0xffff, 0x4444, 0x8000, 0x6666, 0xffff, 0x8888, 0x8123}));
+}
+
+TEST(VRAMBlit, CopyWraps) {
+    for (const auto mask : c_masks) {
+        auto expected = randomPixels(VRAMBlit::WIDTH * VRAMBlit::HEIGHT, 1);
+        auto actual = expected;
+        // Both rectangles go over the right and bottom edges, without overlapping each other.
+        constexpr int srcX = 1000, srcY = 200, destX = 900, destY = 490, w = 100, h = 40;
+        for (int j = 0; j < h; j++) {
+            for (int i = 0; i < w; i++) {
+                auto &d = at(expected, destX + i, destY + j);
+                d = ((mask.check && (d & 0x8000)) ? d : (at(expected, srcX + i, srcY + j) | mask.set));
+            }
+        }
+        VRAMBlit::copy(actual.data(), srcX, srcY, destX, destY, w, h, mask);
+        ASSERT_EQ(actual, expected) << "check " << mask.check << ", set " << mask.set;
+    }
+}
+
+TEST(VRAMBlit, UploadWraps) {
+    for (const auto mask : c_masks) {
+        auto expected = randomPixels(VRAMBlit::WIDTH * VRAMBlit::HEIGHT, 2);
+        auto actual = expected;
+        // Wider than the VRAM, so that the end of each row overwrites its start.
+        constexpr int x = 1020, y = 510, w = 1100, h = 5;
+        const auto pixels = randomPixels(w * h, 3);
+        for (int j = 0; j < h; j++) {
+            for (int i = 0; i < w; i++) {
+                auto &d = at(expected, x + i, y + j);
+                d = ((mask.check && (d & 0x8000)) ? d : (pixels[j * w + i] | mask.set));
+            }
+        }
+        VRAMBlit::upload(actual.data(), x, y, w, h, pixels.data(), mask);
+        ASSERT_EQ(actual, expected) << "check " << mask.check << ", set " << mask.set;
+    }
+}
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "gpu/soft/display.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::SoftGPU::DisplayConverter;
+
+TEST(SoftDisplay, Convert15) {
+    const uint16_t pixels[] = {0x0000, 0x7fff, 0x001f, 0x03e0, 0x7c00, 0x8000 | (1 << 10) | (16 << 5) | 30};
+    uint32_t dest[6];
+    DisplayConverter::convert15(pixels, dest, 6);
+    EXPECT_EQ(dest[0], 0xff000000);
+    EXPECT_EQ(dest[1], 0xffffffff);
+    EXPECT_EQ(dest[2], 0xff0000ff);
+    EXPECT_EQ(dest[3], 0xff00ff00);
+    EXPECT_EQ(dest[4], 0xffff0000);
+    // The mask bit doesn't show.
+    EXPECT_EQ(dest[5], 0xff0884f7);
+}
+
+TEST(SoftDisplay, Convert24Wraps) {
+    std::vector<uint16_t> vram(1024 * 512);
+    std::mt19937 rng(1234);
+    for (auto &pixel : vram) pixel = rng();
+    auto bytes = reinterpret_cast<const uint8_t *>(vram.data());
+
+    // A 640 pixels wide display starting towards the right edge, and the bottom one.
+    constexpr int x = 800, y = 500, width = 640, height = 24;
+    std::vector<uint32_t> dest(width * height);
+    DisplayConverter::convert(vram.data(), 0, x, y, width, height, true, dest.data());
+    for (int j = 0; j < height; j++) {
+        const int row = ((y + j) & 511) * 2048;
+        for (int i = 0; i < width; i++) {
+            uint32_t expected = 0xff000000;
+            for (int k = 0; k < 3; k++) expected |= bytes[row + ((x * 2 + i * 3 + k) & 2047)] << (k * 8);
+            ASSERT_EQ(dest[j * width + i], expected) << i << ", " << j;
+        }
+    }
+}
+
+TEST(SoftDisplay, Convert15Upscaled) {
+    constexpr int shift = 1;
+    std::vector<uint16_t> vram((1024 << shift) * (512 << shift));
+    for (unsigned i = 0; i < vram.size(); i++) vram[i] = i & 0x7fff;
+
+    constexpr int x = 1900, y = 1000, width = 320, height = 48;
+    std::vector<uint32_t> dest(width * height);
+    DisplayConverter::convert(vram.data(), shift, x, y, width, height, false, dest.data());
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            uint32_t converted;
+            const uint16_t pixel = vram[((y + j) & 1023) * 2048 + ((x + i) & 2047)];
+            DisplayConverter::convert15(&pixel, &converted, 1);
+            ASSERT_EQ(dest[j * width + i], converted) << i << ", " << j;
+        }
+    }
+}
+
+TEST(SoftDisplay, MatchesScalar) {
+    std::vector<uint16_t> src(1100);
+    std::mt19937 rng(5678);
+    for (auto &pixel : src) pixel = rng();
+    auto bytes = reinterpret_cast<const uint8_t *>(src.data());
+    std::vector<uint32_t> expected(700), actual(700);
+
+    // All of the lengths around the vector sizes, from all of the alignments.
+    for (unsigned offset = 0; offset < 32; offset++) {
+        for (unsigned count = 0; count < 80; count++) {
+            DisplayConverter::convert15Scalar(src.data() + offset, expected.data(), count);
+            DisplayConverter::convert15(src.data() + offset, actual.data(), count);
+            for (unsigned i = 0; i < count; i++) ASSERT_EQ(actual[i], expected[i]) << offset << ", " << count;
+            DisplayConverter::convert24Scalar(bytes + offset, expected.data(), count);
+            DisplayConverter::convert24(bytes + offset, actual.data(), count);
+            for (unsigned i = 0; i < count; i++) ASSERT_EQ(actual[i], expected[i]) << offset << ", " << count;
+        }
+    }
+    // And a few full rows.
+    for (unsigned count : {256u, 320u, 368u, 512u, 640u, 682u}) {
+        expected.assign(count, 0);
+        actual.assign(count, 0);
+        DisplayConverter::convert15Scalar(src.data() + 3, expected.data(), count);
+        DisplayConverter::convert15(src.data() + 3, actual.data(), count);
+        EXPECT_EQ(actual, expected) << count;
+        DisplayConverter::convert24Scalar(bytes + 5, expected.data(), count);
+        DisplayConverter::convert24(bytes + 5, actual.data(), count);
+        EXPECT_EQ(actual, expected) << count;
+    }
+}
+
+TEST(SoftDisplay, Convert24Width682) {
+    // 682 pixels are 2046 bytes, so a display this wide straddles the right edge of the VRAM
+    // from almost any start.
+    std::vector<uint16_t> vram(1024 * 512);
+    std::mt19937 rng(91011);
+    for (auto &pixel : vram) pixel = rng();
+    auto bytes = reinterpret_cast<const uint8_t *>(vram.data());
+
+    constexpr int width = 682, height = 4;
+    std::vector<uint32_t> dest(width * height);
+    for (int x : {0, 1, 2, 3, 341, 682, 1021, 1022, 1023}) {
+        DisplayConverter::convert(vram.data(), 0, x, 510, width, height, true, dest.data());
+        for (int j = 0; j < height; j++) {
+            const int row = ((510 + j) & 511) * 2048;
+            for (int i = 0; i < width; i++) {
+                uint32_t expected = 0xff000000;
+                for (int k = 0; k < 3; k++) expected |= bytes[row + ((x * 2 + i * 3 + k) & 2047)] << (k * 8);
+                ASSERT_EQ(dest[j * width + i], expected) << x << ": " << i << ", " << j;
+            }
+        }
+    }
+}
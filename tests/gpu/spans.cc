@@ -0,0 +1,253 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gpu/soft/soft.h"
+#include "gtest/gtest.h"
+
+using PCSX::GPU;
+using PCSX::SoftGPU::SoftRenderer;
+
+namespace {
+
+struct Target {
+    explicit Target(bool vectorSpans) : allocated(1024 * 512 * 2 + 1024 * 1024) {
+        renderer.m_vram = allocated.data() + 512 * 1024;
+        renderer.m_vram16 = reinterpret_cast<uint16_t *>(renderer.m_vram);
+        renderer.resetRenderer();
+        GPU::TWindow window;
+        window.x = window.y = window.w = window.h = 0;
+        renderer.twindow(&window);
+        renderer.m_softDisplay.DrawOffset.x = renderer.m_softDisplay.DrawOffset.y = 0;
+        renderer.m_vectorSpans = vectorSpans;
+    }
+    std::vector<uint8_t> allocated;
+    SoftRenderer renderer;
+};
+
+// Every combination of the state the span kernels care about.
+void randomState(SoftRenderer &r, std::mt19937 &gen) {
+    auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+    GPU::MaskBit mask;
+    mask.set = rnd(0, 1);
+    mask.check = rnd(0, 1);
+    r.maskBit(&mask);
+    r.m_drawSemiTrans = rnd(0, 1);
+    r.m_globalTextABR = GPU::BlendFunction(rnd(0, 3));
+    r.m_ditherMode = rnd(0, 1);
+    r.m_m1 = rnd(0, 255);
+    r.m_m2 = rnd(0, 255);
+    r.m_m3 = rnd(0, 255);
+}
+
+}  // namespace
+
+TEST(SoftSpans, KernelsMatchScalar) {
+    Target target(true);
+    auto &r = target.renderer;
+    std::mt19937 gen(1234);
+    auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+    uint16_t *vram16 = r.m_vram16;
+
+    for (unsigned i = 0; i < 20000; i++) {
+        randomState(r, gen);
+        const int x = rnd(0, 1000);
+        const int y = rnd(0, 511);
+        const int count = rnd(0, 1023 - x);
+        uint16_t *pdest = vram16 + (y << 10) + x;
+        std::vector<uint16_t> background(count), expected(count), texels(count);
+        for (auto &p : background) p = rnd(0, 0xffff);
+        // Plenty of transparent texels, and of texels with and without the semi transparency bit.
+        for (auto &t : texels) t = rnd(0, 3) == 0 ? 0 : rnd(0, 0xffff);
+
+        switch (i % 3) {
+            case 0: {
+                const uint16_t color = rnd(0, 0xffff);
+                std::memcpy(pdest, background.data(), count * 2);
+                for (int j = 0; j < count; j++) r.getShadeTransCol(pdest + j, color);
+                std::memcpy(expected.data(), pdest, count * 2);
+                std::memcpy(pdest, background.data(), count * 2);
+                r.spanFlat(pdest, count, color);
+                break;
+            }
+            case 1: {
+                // Interpolants going way out of range, to exercise the saturation.
+                int32_t c[3], dif[3];
+                for (unsigned j = 0; j < 3; j++) {
+                    c[j] = rnd(-64 << 16, 320 << 16);
+                    dif[j] = rnd(-4 << 16, 4 << 16);
+                }
+                std::memcpy(pdest, background.data(), count * 2);
+                int32_t cR = c[0], cG = c[1], cB = c[2];
+                for (int j = 0; j < count; j++) {
+                    if (r.m_ditherMode) {
+                        r.getShadeTransColDither<false>(pdest + j, cB >> 16, cG >> 16, cR >> 16);
+                    } else {
+                        r.getShadeTransCol(pdest + j, ((cR >> 9) & 0x7c00) | ((cG >> 14) & 0x03e0) | ((cB >> 19) & 0x1f));
+                    }
+                    cR += dif[0];
+                    cG += dif[1];
+                    cB += dif[2];
+                }
+                std::memcpy(expected.data(), pdest, count * 2);
+                std::memcpy(pdest, background.data(), count * 2);
+                r.spanShade(pdest, count, c[0], c[1], c[2], dif[0], dif[1], dif[2]);
+                break;
+            }
+            case 2: {
+                std::memcpy(pdest, background.data(), count * 2);
+                int j;
+                for (j = 0; j < (count - 1); j += 2) {
+                    r.getTextureTransColShade32(reinterpret_cast<uint32_t *>(pdest + j),
+                                                texels[j] | (uint32_t(texels[j + 1]) << 16));
+                }
+                if (j == (count - 1)) r.getTextureTransColShade(pdest + j, texels[j]);
+                std::memcpy(expected.data(), pdest, count * 2);
+                std::memcpy(pdest, background.data(), count * 2);
+                r.spanTextured(pdest, texels.data(), count);
+                break;
+            }
+        }
+        ASSERT_EQ(std::memcmp(expected.data(), pdest, count * 2), 0) << "kernel " << (i % 3) << ", iteration " << i;
+    }
+}
+
+TEST(SoftSpans, PrimitivesMatchScalar) {
+    Target scalar(false), vector(true);
+    std::mt19937 gen(4321);
+    auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+
+    for (auto &b : scalar.allocated) b = rnd(0, 255);
+    vector.allocated = scalar.allocated;
+
+    auto both = [&](auto &&f) {
+        f(scalar.renderer);
+        f(vector.renderer);
+    };
+
+    for (unsigned i = 0; i < 6000; i++) {
+        if (rnd(0, 15) == 0) {
+            GPU::DrawingAreaStart start;
+            GPU::DrawingAreaEnd end;
+            start.x = rnd(0, 700);
+            start.y = rnd(0, 400);
+            end.x = std::min<int>(start.x + rnd(0, 400), 1023);
+            end.y = std::min<int>(start.y + rnd(0, 300), 511);
+            both([&](SoftRenderer &r) {
+                r.drawingAreaStart(&start);
+                r.drawingAreaEnd(&end);
+            });
+        }
+        if (rnd(0, 7) == 0) {
+            GPU::TPage tpage;
+            tpage.tx = rnd(0, 15);
+            tpage.ty = rnd(0, 1);
+            tpage.texDepth = GPU::TexDepth(rnd(0, 2));
+            GPU::TWindow window;
+            window.x = window.y = window.w = window.h = 0;
+            if (rnd(0, 1)) {
+                window.x = rnd(0, 31);
+                window.y = rnd(0, 31);
+                window.w = rnd(0, 31);
+                window.h = rnd(0, 31);
+            }
+            both([&](SoftRenderer &r) {
+                r.texturePage(&tpage);
+                r.twindow(&window);
+            });
+        }
+        const unsigned seed = gen();
+        both([seed](SoftRenderer &r) {
+            std::mt19937 state(seed);
+            randomState(r, state);
+        });
+
+        const auto &state = scalar.renderer;
+        int16_t x[4], y[4], u[4], v[4];
+        int32_t c[4];
+        const int cx = rnd(state.m_drawX - 32, state.m_drawW + 32);
+        const int cy = rnd(state.m_drawY - 32, state.m_drawH + 32);
+        const int size = rnd(1, 128);
+        for (unsigned j = 0; j < 4; j++) {
+            x[j] = cx + rnd(-size, size);
+            y[j] = cy + rnd(-size, size);
+            u[j] = rnd(0, 255);
+            v[j] = rnd(0, 255);
+            c[j] = rnd(0, 0xffffff);
+        }
+        const int16_t clX = rnd(0, 63) * 16;
+        const int16_t clY = rnd(0, 511);
+        both([&](SoftRenderer &r) {
+            r.m_x0 = x[0];
+            r.m_y0 = y[0];
+            r.m_x1 = x[1];
+            r.m_y1 = y[1];
+            r.m_x2 = x[2];
+            r.m_y2 = y[2];
+            r.m_x3 = x[3];
+            r.m_y3 = y[3];
+        });
+
+        const int16_t w = rnd(0, 100);
+        const int16_t h = rnd(0, 100);
+        both([&](SoftRenderer &r) {
+            const unsigned primitive = i % 13;
+            // Every depth of the flat textured primitives, whatever the texture page says.
+            if ((primitive >= 2) && (primitive <= 10)) r.m_globalTextTP = GPU::TexDepth((primitive - 2) / 3);
+            switch (primitive) {
+                case 0:
+                    r.drawPolyFlat4(c[0]);
+                    break;
+                case 1:
+                    r.drawPolyShade4(c[0], c[1], c[2], c[3]);
+                    break;
+                case 2:
+                case 5:
+                case 8:
+                    r.drawPolyTextured3(x[0], y[0], x[1], y[1], x[2], y[2], u[0], v[0], u[1], v[1], u[2], v[2], clX,
+                                        clY);
+                    break;
+                case 3:
+                case 6:
+                case 9:
+                    r.drawPolyTextured4(x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3], u[0], v[0], u[1], v[1], u[2],
+                                        v[2], u[3], v[3], clX, clY);
+                    break;
+                case 4:
+                case 7:
+                case 10:
+                    r.drawPolyTextured4(x[0], y[0], x[0] + w, y[0], x[0] + w, y[0] + h, x[0], y[0] + h, u[0], v[0],
+                                        u[0] + w, v[0], u[0] + w, v[0] + h, u[0], v[0] + h, clX, clY);
+                    break;
+                case 11:
+                    r.fillSoftwareAreaTrans(x[0], y[0], x[0] + w, y[0] + h, c[0]);
+                    break;
+                case 12:
+                    r.m_y1 = r.m_y0;
+                    r.drawSoftwareLineFlat(c[0]);
+                    break;
+            }
+        });
+        ASSERT_EQ(std::memcmp(scalar.allocated.data(), vector.allocated.data(), scalar.allocated.size()), 0)
+            << "primitive " << (i % 13) << ", iteration " << i;
+    }
+}
@@ -0,0 +1,261 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "gpu/soft/texcache.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gpu/soft/soft.h"
+#include "gtest/gtest.h"
+
+using PCSX::GPU;
+using PCSX::SoftGPU::Bands;
+using PCSX::SoftGPU::SoftRenderer;
+using PCSX::SoftGPU::TextureCache;
+
+namespace {
+
+struct Target {
+    Target() : allocated(1024 * 512 * 2 + 1024 * 1024) {
+        renderer.m_vram = allocated.data() + 512 * 1024;
+        renderer.m_vram16 = reinterpret_cast<uint16_t *>(renderer.m_vram);
+        renderer.resetRenderer();
+        GPU::TWindow window;
+        window.x = window.y = window.w = window.h = 0;
+        renderer.twindow(&window);
+        renderer.m_softDisplay.DrawOffset.x = renderer.m_softDisplay.DrawOffset.y = 0;
+    }
+    std::vector<uint8_t> allocated;
+    SoftRenderer renderer;
+};
+
+void setDrawingArea(SoftRenderer &r, int x0, int y0, int x1, int y1) {
+    GPU::DrawingAreaStart start;
+    GPU::DrawingAreaEnd end;
+    start.x = x0;
+    start.y = y0;
+    end.x = x1;
+    end.y = y1;
+    r.drawingAreaStart(&start);
+    r.drawingAreaEnd(&end);
+}
+
+void setTexturePage(SoftRenderer &r, int tx, int ty, GPU::TexDepth depth) {
+    GPU::TPage tpage;
+    tpage.tx = tx;
+    tpage.ty = ty;
+    tpage.texDepth = depth;
+    r.texturePage(&tpage);
+}
+
+}  // namespace
+
+TEST(SoftTextureCache, DecodesLikeTheRasterizer) {
+    Target target;
+    auto &r = target.renderer;
+    std::mt19937 gen(1234);
+    auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+    for (auto &b : target.allocated) b = rnd(0, 255);
+    // An empty drawing area, which can't overlap any of the pages.
+    setDrawingArea(r, 1, 1, 0, 0);
+
+    for (unsigned i = 0; i < 200; i++) {
+        TextureCache cache;
+        Bands bands;
+        const auto depth = GPU::TexDepth(i & 1);
+        setTexturePage(r, rnd(0, 15), rnd(0, 1), depth);
+        GPU::TWindow window;
+        window.x = rnd(0, 31);
+        window.y = rnd(0, 31);
+        window.w = rnd(0, 31);
+        window.h = rnd(0, 31);
+        r.twindow(&window);
+        const int clX = rnd(0, 63) * 16;
+        const int clY = rnd(0, 511);
+
+        const uint16_t *decoded = cache.lookup(r, clX, clY, bands);
+        ASSERT_NE(decoded, nullptr);
+        const int32_t offset = r.textureOffset();
+        const uint16_t *clut = r.m_vram16 + (clY << 10) + clX;
+        for (int y = 0; y < TextureCache::PAGE_SIZE; y++) {
+            for (int x = 0; x < TextureCache::PAGE_SIZE; x++) {
+                uint16_t expected;
+                if (depth == GPU::TexDepth::Tex4Bits) {
+                    expected = clut[(r.m_vram[(y << 11) + offset + (x >> 1)] >> ((x & 1) << 2)) & 0xf];
+                } else {
+                    expected = clut[r.m_vram[(y << 11) + offset + x]];
+                }
+                ASSERT_EQ(decoded[(y << 8) + x], expected) << "iteration " << i << ", texel " << x << ", " << y;
+            }
+        }
+    }
+}
+
+TEST(SoftTextureCache, Invalidation) {
+    Target target;
+    auto &r = target.renderer;
+    TextureCache cache;
+    Bands bands;
+    setDrawingArea(r, 0, 0, 319, 239);
+    // 4 bits page at 640,256, CLUT at 0,480.
+    setTexturePage(r, 10, 1, GPU::TexDepth::Tex4Bits);
+
+    EXPECT_NE(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_NE(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().misses, 1);
+    EXPECT_EQ(cache.stats().hits, 1);
+
+    // Writes elsewhere, including right next to the page, keep the entry.
+    cache.invalidate(Bands::region(0, 0, 319, 239));
+    cache.invalidate(Bands::region(704, 256, 767, 511));
+    cache.invalidate(Bands::region(64, 480, 127, 480));
+    EXPECT_NE(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().hits, 2);
+    EXPECT_EQ(cache.stats().invalidations, 0);
+
+    // Writing to either the page or the CLUT drops it.
+    cache.invalidate(Bands::region(700, 400, 700, 400));
+    EXPECT_EQ(cache.stats().invalidations, 1);
+    EXPECT_NE(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().misses, 2);
+    cache.invalidate(Bands::region(15, 480, 15, 480));
+    EXPECT_EQ(cache.stats().invalidations, 2);
+    EXPECT_NE(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().misses, 3);
+
+    // Different CLUTs are different entries.
+    EXPECT_NE(cache.lookup(r, 16, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().misses, 4);
+
+    // Primitives sampling their own drawing area, and 15 bits textures, don't use the cache.
+    setDrawingArea(r, 640, 0, 1023, 511);
+    EXPECT_EQ(cache.lookup(r, 0, 480, bands), nullptr);
+    setDrawingArea(r, 0, 0, 319, 239);
+    setTexturePage(r, 10, 1, GPU::TexDepth::Tex16Bits);
+    EXPECT_EQ(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().hits + cache.stats().misses, 6);
+
+    cache.clear();
+    setTexturePage(r, 10, 1, GPU::TexDepth::Tex4Bits);
+    EXPECT_NE(cache.lookup(r, 0, 480, bands), nullptr);
+    EXPECT_EQ(cache.stats().misses, 5);
+}
+
+// Draws the same random scene with and without the cache, invalidating it the way the
+// GPU does, and checks that both VRAMs stay identical.
+TEST(SoftTextureCache, PrimitivesMatchUncached) {
+    Target uncached, cached;
+    std::mt19937 gen(4321);
+    auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+    for (auto &b : uncached.allocated) b = rnd(0, 255);
+    cached.allocated = uncached.allocated;
+
+    TextureCache cache;
+    Bands bands;
+    auto both = [&](auto &&f) {
+        f(uncached.renderer);
+        f(cached.renderer);
+    };
+
+    // A handful of CLUTs, so that the pages get reused.
+    int16_t cluts[4][2];
+    for (auto &clut : cluts) {
+        clut[0] = rnd(0, 63) * 16;
+        clut[1] = rnd(0, 511);
+    }
+
+    for (unsigned i = 0; i < 6000; i++) {
+        if (rnd(0, 15) == 0) {
+            const int x = rnd(0, 700);
+            const int y = rnd(0, 400);
+            const int w = rnd(0, 400);
+            const int h = rnd(0, 300);
+            both([&](SoftRenderer &r) {
+                setDrawingArea(r, x, y, std::min(x + w, 1023), std::min(y + h, 511));
+            });
+        }
+        if (rnd(0, 63) == 0) {
+            const int tx = rnd(0, 15);
+            const int ty = rnd(0, 1);
+            const auto depth = GPU::TexDepth(rnd(0, 2));
+            GPU::TWindow window;
+            window.x = window.y = window.w = window.h = 0;
+            if (rnd(0, 1)) {
+                window.x = rnd(0, 31);
+                window.y = rnd(0, 31);
+                window.w = rnd(0, 31);
+                window.h = rnd(0, 31);
+            }
+            both([&](SoftRenderer &r) {
+                setTexturePage(r, tx, ty, depth);
+                r.twindow(&window);
+            });
+        }
+        if (rnd(0, 31) == 0) {
+            // Uploads, which may land on a cached page or CLUT.
+            const int x = rnd(0, 1000);
+            const int y = rnd(0, 500);
+            const int w = rnd(1, 1023 - x);
+            const int h = rnd(1, 511 - y);
+            const uint16_t color = rnd(0, 0xffff);
+            both([&](SoftRenderer &r) { r.fillSoftwareArea(x, y, x + w, y + h, color); });
+            cache.invalidate(Bands::region(x, y, x + w - 1, y + h - 1));
+        }
+
+        const bool semi = rnd(0, 1);
+        const bool vectorSpans = rnd(0, 1);
+        const int16_t m = rnd(0, 255);
+        const auto &state = uncached.renderer;
+        int16_t x[4], y[4], u[4], v[4];
+        const int cx = rnd(state.m_drawX - 32, state.m_drawW + 32);
+        const int cy = rnd(state.m_drawY - 32, state.m_drawH + 32);
+        const int size = rnd(1, 128);
+        for (unsigned j = 0; j < 4; j++) {
+            x[j] = cx + rnd(-size, size);
+            y[j] = cy + rnd(-size, size);
+            u[j] = rnd(0, 255);
+            v[j] = rnd(0, 255);
+        }
+        const auto &clut = cluts[rnd(0, 3)];
+        const int16_t clX = clut[0];
+        const int16_t clY = clut[1];
+
+        cached.renderer.m_decodedTexture = cache.lookup(cached.renderer, clX, clY, bands);
+        both([&](SoftRenderer &r) {
+            r.m_drawSemiTrans = semi;
+            r.m_vectorSpans = vectorSpans;
+            r.m_m1 = r.m_m2 = r.m_m3 = m;
+            if (i & 1) {
+                r.drawPolyTextured4(x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3], u[0], v[0], u[1], v[1], u[2],
+                                    v[2], u[3], v[3], clX, clY);
+            } else {
+                r.drawPolyTextured3(x[0], y[0], x[1], y[1], x[2], y[2], u[0], v[0], u[1], v[1], u[2], v[2], clX,
+                                    clY);
+            }
+        });
+        cache.invalidate(Bands::region(state.m_drawX, state.m_drawY, state.m_drawW, state.m_drawH));
+        ASSERT_EQ(std::memcmp(uncached.allocated.data(), cached.allocated.data(), uncached.allocated.size()), 0)
+            << "iteration " << i;
+    }
+
+    EXPECT_GT(cache.stats().hits, 0);
+    EXPECT_GT(cache.stats().invalidations, 0);
+}
@@ -0,0 +1,245 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gpu/soft/bands.h"
+#include "gpu/soft/soft.h"
+#include "gtest/gtest.h"
+
+using PCSX::GPU;
+using PCSX::SoftGPU::Bands;
+using PCSX::SoftGPU::SoftRenderer;
+
+namespace {
+
+// A native VRAM, and a shadow one at 2^shift times its resolution, like the soft GPU keeps them.
+struct Target {
+    explicit Target(int shift)
+        : allocated(1024 * 512 * 2 + 1024 * 1024), shadow(((512 << shift) + 1) * (1024 << shift)), shift(shift) {
+        renderer.m_vram = allocated.data() + 512 * 1024;
+        renderer.m_vram16 = reinterpret_cast<uint16_t *>(renderer.m_vram);
+        renderer.resetRenderer();
+        GPU::TWindow window;
+        window.x = window.y = window.w = window.h = 0;
+        renderer.twindow(&window);
+        renderer.m_softDisplay.DrawOffset.x = renderer.m_softDisplay.DrawOffset.y = 0;
+    }
+    SoftRenderer upscaled() {
+        SoftRenderer r = renderer;
+        r.upscale(shadow.data(), shift);
+        return r;
+    }
+    // Nearest neighbour, like the soft GPU does for what gets to the VRAM without being drawn.
+    void upsample() {
+        for (int y = 0; y < (512 << shift); y++) {
+            for (int x = 0; x < (1024 << shift); x++) {
+                shadow[(y << (10 + shift)) + x] = nativePixel(x >> shift, y >> shift);
+            }
+        }
+    }
+    uint16_t shadowPixel(int x, int y) const { return shadow[(y << (10 + shift)) + x]; }
+    uint16_t nativePixel(int x, int y) const { return renderer.m_vram16[(y << 10) + x]; }
+    std::vector<uint8_t> allocated;
+    std::vector<uint16_t> shadow;
+    SoftRenderer renderer;
+    int shift;
+};
+
+void setDrawingArea(SoftRenderer &r, int x0, int y0, int x1, int y1) {
+    GPU::DrawingAreaStart start;
+    GPU::DrawingAreaEnd end;
+    start.x = x0;
+    start.y = y0;
+    end.x = x1;
+    end.y = y1;
+    r.drawingAreaStart(&start);
+    r.drawingAreaEnd(&end);
+}
+
+}  // namespace
+
+// Opaque axis aligned primitives have nothing to gain from the extra resolution, and have
+// to cover exactly the blocks of the native pixels they cover.
+TEST(SoftUpscale, AxisAlignedPrimitivesCoverTheirBlocks) {
+    for (int shift = 1; shift <= 3; shift++) {
+        Target target(shift);
+        auto &r = target.renderer;
+        std::mt19937 gen(shift * 1234);
+        auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+        // Sprites out of a 15 bits texture page, at the bottom of the VRAM.
+        for (int y = 256; y < 512; y++) {
+            for (int x = 0; x < 256; x++) r.m_vram16[(y << 10) + x] = rnd(0, 0xffff);
+        }
+        GPU::TPage tpage;
+        tpage.tx = 0;
+        tpage.ty = 1;
+        tpage.texDepth = GPU::TexDepth::Tex16Bits;
+        r.texturePage(&tpage);
+        target.upsample();
+
+        for (unsigned i = 0; i < 300; i++) {
+            const int ax = rnd(300, 700), ay = rnd(0, 400);
+            setDrawingArea(r, ax, ay, ax + rnd(0, 300), ay + rnd(0, 100));
+            const int16_t x = rnd(r.m_drawX - 32, r.m_drawW);
+            const int16_t y = rnd(r.m_drawY - 32, r.m_drawH);
+            const int16_t w = rnd(1, 100);
+            const int16_t h = rnd(1, 100);
+            const int32_t rgb = rnd(0, 0xffffff);
+            const uint16_t color = rnd(0, 0xffff);
+            const int16_t u = rnd(0, 255);
+            const int16_t v = rnd(0, 255);
+            r.m_drawSemiTrans = false;
+            r.m_x0 = r.m_x2 = x;
+            r.m_x1 = r.m_x3 = x + w;
+            r.m_y0 = r.m_y1 = y;
+            r.m_y2 = r.m_y3 = y + h;
+
+            auto upscaled = target.upscaled();
+            for (auto *renderer : {&r, &upscaled}) {
+                switch (i % 3) {
+                    case 0:
+                        renderer->fillSoftwareAreaTrans(x, y, x + w, y + h, color);
+                        break;
+                    case 1:
+                        renderer->drawPolyFlat4(rgb);
+                        break;
+                    case 2:
+                        renderer->drawPolyTextured4(x, y, x + w, y, x + w, y + h, x, y + h, u, v, u + w, v, u + w,
+                                                    v + h, u, v + h, 0, 0);
+                        break;
+                }
+            }
+        }
+
+        for (int y = 0; y < (512 << shift); y++) {
+            for (int x = 0; x < (1024 << shift); x++) {
+                ASSERT_EQ(target.shadowPixel(x, y), target.nativePixel(x >> shift, y >> shift))
+                    << "shift " << shift << ", pixel " << x << ", " << y;
+            }
+        }
+    }
+}
+
+// The bands have to clip the upscaled primitives to the upscaled extent of their band.
+TEST(SoftUpscale, BandsMatchSingleThread) {
+    for (int shift = 1; shift <= 2; shift++) {
+        Target reference(shift), banded(shift);
+        std::mt19937 gen(shift * 4321);
+        auto rnd = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+        for (auto &b : reference.allocated) b = rnd(0, 255);
+        banded.allocated = reference.allocated;
+        reference.upsample();
+        banded.upsample();
+
+        Bands bands;
+        bands.start(3 + shift);
+        auto both = [&](auto &&f) {
+            f(reference.renderer);
+            f(banded.renderer);
+        };
+
+        for (unsigned i = 0; i < 2000; i++) {
+            if (rnd(0, 15) == 0) {
+                const int x = rnd(0, 700), y = rnd(0, 400);
+                const int w = rnd(0, 400), h = rnd(-2, 300);
+                both([&](SoftRenderer &r) { setDrawingArea(r, x, y, std::min(x + w, 1023), std::min(y + h, 511)); });
+            }
+            if (rnd(0, 7) == 0) {
+                GPU::TPage tpage;
+                tpage.tx = rnd(0, 15);
+                tpage.ty = rnd(0, 1);
+                tpage.blendFunction = GPU::BlendFunction(rnd(0, 3));
+                tpage.texDepth = GPU::TexDepth(rnd(0, 2));
+                both([&](SoftRenderer &r) { r.texturePage(&tpage); });
+            }
+
+            const auto &state = reference.renderer;
+            const bool semi = rnd(0, 1);
+            int16_t x[4], y[4], u[4], v[4];
+            int32_t c[4];
+            const int cx = rnd(state.m_drawX - 32, state.m_drawW + 32);
+            const int cy = rnd(state.m_drawY - 32, state.m_drawH + 32);
+            const int size = rnd(1, 128);
+            for (unsigned j = 0; j < 4; j++) {
+                x[j] = cx + rnd(-size, size);
+                y[j] = cy + rnd(-size, size);
+                u[j] = rnd(0, 255);
+                v[j] = rnd(0, 255);
+                c[j] = rnd(0, 0xffffff);
+            }
+            const int16_t clX = rnd(0, 63) * 16;
+            const int16_t clY = rnd(0, 511);
+            both([&](SoftRenderer &r) {
+                r.m_drawSemiTrans = semi;
+                r.m_x0 = x[0];
+                r.m_y0 = y[0];
+                r.m_x1 = x[1];
+                r.m_y1 = y[1];
+                r.m_x2 = x[2];
+                r.m_y2 = y[2];
+                r.m_x3 = x[3];
+                r.m_y3 = y[3];
+            });
+
+            Bands::Clip clip = Bands::Clip::Area;
+            Bands::Draw draw;
+            switch (rnd(0, 4)) {
+                case 0:
+                    draw = [=](SoftRenderer &r) { r.drawPolyShade4(c[0], c[1], c[2], c[3]); };
+                    break;
+                case 1:
+                    draw = [=](SoftRenderer &r) {
+                        r.drawPolyTextured4(x[0], y[0], x[1], y[1], x[2], y[2], x[3], y[3], u[0], v[0], u[1], v[1],
+                                            u[2], v[2], u[3], v[3], clX, clY);
+                    };
+                    break;
+                case 2:
+                    draw = [=](SoftRenderer &r) {
+                        r.drawPoly3TGD(x[0], y[0], x[1], y[1], x[2], y[2], u[0], v[0], u[1], v[1], u[2], v[2], c[0],
+                                       c[1], c[2]);
+                    };
+                    break;
+                case 3:
+                    draw = [=](SoftRenderer &r) { r.fillSoftwareAreaTrans(x[0], y[0], x[1], y[1], c[0]); };
+                    break;
+                case 4:
+                    clip = Bands::Clip::Line;
+                    draw = [=](SoftRenderer &r) { r.drawSoftwareLineShade(c[0], c[1]); };
+                    break;
+            }
+            auto upscaled = reference.upscaled();
+            draw(upscaled);
+            upscaled = banded.upscaled();
+            // The primitives only read from the native VRAM, which nothing writes to here. What they
+            // write is tracked through the native tiles the shadow VRAM mirrors.
+            const auto writes = Bands::region(std::max<int>(std::min({x[0], x[1], x[2], x[3]}), state.m_drawX),
+                                              std::max<int>(std::min({y[0], y[1], y[2], y[3]}), state.m_drawY),
+                                              std::min<int>(std::max({x[0], x[1], x[2], x[3]}), state.m_drawW),
+                                              std::min<int>(std::max({y[0], y[1], y[2], y[3]}), state.m_drawH));
+            bands.submit(upscaled, clip, {}, writes, std::move(draw));
+        }
+
+        bands.sync();
+        EXPECT_EQ(reference.shadow, banded.shadow) << "shift " << shift;
+    }
+}
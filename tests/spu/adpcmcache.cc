@@ -0,0 +1,145 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/adpcmcache.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::SPU::ADPCMCache;
+
+namespace {
+
+// The decoder the SPU thread had before the cache.
+void decode(const uint8_t *start, int32_t *samples, int32_t &s_1, int32_t &s_2) {
+    static const int f[5][2] = {{0, 0}, {60, 0}, {115, -52}, {98, -55}, {122, -60}};
+    int predict_nr = *start++;
+    const int shift_factor = predict_nr & 0xf;
+    predict_nr >>= 4;
+    start++;
+    for (unsigned nSample = 0; nSample < 28; start++) {
+        const int d = *start;
+        for (int s : {(d & 0xf) << 12, (d & 0xf0) << 8}) {
+            if (s & 0x8000) s |= 0xffff0000;
+            int fa = (s >> shift_factor);
+            fa = fa + ((s_1 * f[predict_nr][0]) >> 6) + ((s_2 * f[predict_nr][1]) >> 6);
+            s_2 = s_1;
+            s_1 = fa;
+            samples[nSample++] = fa;
+        }
+    }
+}
+
+struct RAM {
+    RAM() : bytes(ADPCMCache::RAM_SIZE) {
+        std::mt19937 gen(42);
+        for (auto &byte : bytes) byte = gen();
+        // Valid filters only, the other ones having no reference to check against.
+        for (uint32_t addr = 0; addr < bytes.size(); addr += 16) bytes[addr] = (bytes[addr] % 5) << 4 | (addr & 0xf);
+    }
+    std::vector<uint8_t> bytes;
+};
+
+void check(ADPCMCache &cache, const RAM &ram, uint32_t addr, int32_t s1, int32_t s2) {
+    int32_t expected[28], samples[28];
+    int32_t es1 = s1, es2 = s2;
+    decode(ram.bytes.data() + addr, expected, es1, es2);
+    cache.decode(ram.bytes.data(), addr, samples, s1, s2);
+    for (unsigned i = 0; i < 28; i++) ASSERT_EQ(samples[i], expected[i]) << "block " << addr << ", sample " << i;
+    EXPECT_EQ(s1, es1);
+    EXPECT_EQ(s2, es2);
+}
+
+}  // namespace
+
+TEST(ADPCMCache, MatchesTheDecoder) {
+    RAM ram;
+    ADPCMCache cache;
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<uint32_t> block(0, 255);
+    std::uniform_int_distribution<int32_t> history(-40000, 40000);
+    for (unsigned i = 0; i < 20000; i++) {
+        const int32_t s1 = (i & 1) ? history(gen) : 0;
+        const int32_t s2 = (i & 1) ? history(gen) : 0;
+        ASSERT_NO_FATAL_FAILURE(check(cache, ram, block(gen) * 16, s1, s2));
+    }
+    const auto &stats = cache.stats();
+    EXPECT_EQ(stats.misses, 256);
+    EXPECT_EQ(stats.hits + stats.refilters + stats.misses, 20000);
+    EXPECT_GT(stats.hits, 0);
+    EXPECT_GT(stats.refilters, 0);
+}
+
+TEST(ADPCMCache, LoopingVoice) {
+    RAM ram;
+    ADPCMCache cache;
+    // A voice playing the same 4 blocks over and over, with the filter history carried along.
+    int32_t s1 = 0, s2 = 0;
+    int32_t es1 = 0, es2 = 0;
+    int32_t expected[28], samples[28];
+    for (unsigned loop = 0; loop < 100; loop++) {
+        for (uint32_t addr = 0x1000; addr < 0x1040; addr += 16) {
+            decode(ram.bytes.data() + addr, expected, es1, es2);
+            cache.decode(ram.bytes.data(), addr, samples, s1, s2);
+            for (unsigned i = 0; i < 28; i++) ASSERT_EQ(samples[i], expected[i]);
+        }
+    }
+    EXPECT_EQ(cache.stats().misses, 4);
+    cache.resetStats();
+    EXPECT_EQ(cache.stats().hits, 0);
+}
+
+TEST(ADPCMCache, Invalidation) {
+    RAM ram;
+    ADPCMCache cache;
+    for (uint32_t addr = 0; addr < 0x100; addr += 16) check(cache, ram, addr, 0, 0);
+    EXPECT_EQ(cache.stats().misses, 16);
+
+    // A 2 bytes write in the middle of a block.
+    ram.bytes[0x25] ^= 0x55;
+    cache.invalidate(0x24, 2);
+    for (uint32_t addr = 0; addr < 0x100; addr += 16) check(cache, ram, addr, 0, 0);
+    EXPECT_EQ(cache.stats().misses, 17);
+
+    // A write straddling two blocks.
+    ram.bytes[0x4f] ^= 0x55;
+    ram.bytes[0x50] = (ram.bytes[0x50] & 0x0f) | 0x30;
+    cache.invalidate(0x4e, 4);
+    for (uint32_t addr = 0; addr < 0x100; addr += 16) check(cache, ram, addr, 0, 0);
+    EXPECT_EQ(cache.stats().misses, 19);
+
+    // One wrapping around the end of the RAM.
+    check(cache, ram, ADPCMCache::RAM_SIZE - 32, 0, 0);
+    check(cache, ram, ADPCMCache::RAM_SIZE - 16, 0, 0);
+    ram.bytes[ADPCMCache::RAM_SIZE - 1] ^= 0x55;
+    ram.bytes[3] ^= 0x55;
+    cache.invalidate(ADPCMCache::RAM_SIZE - 2, 6);
+    const uint64_t misses = cache.stats().misses;
+    check(cache, ram, ADPCMCache::RAM_SIZE - 32, 0, 0);
+    check(cache, ram, ADPCMCache::RAM_SIZE - 16, 0, 0);
+    check(cache, ram, 0, 0, 0);
+    EXPECT_EQ(cache.stats().misses, misses + 2);
+
+    cache.invalidateAll();
+    for (uint32_t addr = 0; addr < 0x100; addr += 16) check(cache, ram, addr, 0, 0);
+    EXPECT_EQ(cache.stats().misses, misses + 2 + 16);
+}
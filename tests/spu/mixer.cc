@@ -0,0 +1,346 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/mixer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "spu/gauss.h"
+
+using PCSX::SPU::Mixer;
+
+namespace {
+
+// Voices in the state the mixer leaves them in: 16 bits taps, phases below 0x10000, and the
+// envelope's range, with a few extremes thrown in.
+void randomize(Mixer::Block &block, std::mt19937 &gen) {
+    std::uniform_int_distribution<int32_t> tap(-32767, 32767);
+    std::uniform_int_distribution<int32_t> phase(0, 0xffff);
+    std::uniform_int_distribution<int32_t> envelope(0, 1023);
+    for (unsigned i = 0; i < Mixer::BLOCK; i++) {
+        for (unsigned k = 0; k < 4; k++) block.taps[k][i] = tap(gen);
+        block.phase[i] = phase(gen);
+        block.envelope[i] = envelope(gen);
+        block.samples[i] = tap(gen);
+    }
+    block.taps[0][3] = block.taps[1][3] = 32767;
+    block.taps[2][3] = block.taps[3][3] = -32767;
+    block.phase[3] = 0xffff;
+    block.envelope[3] = 1023;
+    block.samples[5] = -32767;
+    block.envelope[5] = 1023;
+}
+
+// The per sample code the kernels replace.
+int32_t originalCubic(const Mixer::Block &block, unsigned i) {
+    auto gval = [&](unsigned k) { return block.taps[k][i]; };
+    long xd = (block.phase[i] >> 1) + 1;
+    int fa = gval(3) - 3 * gval(2) + 3 * gval(1) - gval(0);
+    fa *= (xd - (2 << 15)) / 6;
+    fa >>= 15;
+    fa += gval(2) - gval(1) - gval(1) + gval(0);
+    fa *= (xd - (1 << 15)) >> 1;
+    fa >>= 15;
+    fa += gval(1) - gval(0);
+    fa *= xd;
+    fa >>= 15;
+    return fa + gval(0);
+}
+
+int32_t originalGauss(const Mixer::Block &block, unsigned i) {
+    const int vl = (block.phase[i] >> 6) & ~3;
+    int vr = (Gauss::gauss[vl] * block.taps[0][i]) & ~2047;
+    vr += (Gauss::gauss[vl + 1] * block.taps[1][i]) & ~2047;
+    vr += (Gauss::gauss[vl + 2] * block.taps[2][i]) & ~2047;
+    vr += (Gauss::gauss[vl + 3] * block.taps[3][i]) & ~2047;
+    return vr >> 11;
+}
+
+}  // namespace
+
+TEST(SPUMixer, Interpolation) {
+    std::mt19937 gen(1234);
+    for (unsigned round = 0; round < 200; round++) {
+        Mixer::Block block;
+        randomize(block, gen);
+        const unsigned count = round % (Mixer::BLOCK + 1);
+        for (unsigned cubic = 0; cubic < 2; cubic++) {
+            Mixer::Block vector = block, scalar = block;
+            if (cubic) {
+                Mixer::cubic(vector, count);
+                Mixer::cubic(scalar, count, true);
+            } else {
+                Mixer::gauss(vector, count);
+                Mixer::gauss(scalar, count, true);
+            }
+            for (unsigned i = 0; i < Mixer::BLOCK; i++) {
+                const int32_t expected =
+                    i >= count ? block.samples[i] : cubic ? originalCubic(block, i) : originalGauss(block, i);
+                ASSERT_EQ(scalar.samples[i], expected) << "round " << round << ", sample " << i;
+                ASSERT_EQ(vector.samples[i], expected) << "round " << round << ", sample " << i;
+            }
+        }
+    }
+}
+
+TEST(SPUMixer, EnvelopeAndPan) {
+    std::mt19937 gen(5678);
+    std::uniform_int_distribution<int32_t> volume(0, 0x3fff);
+    for (unsigned round = 0; round < 200; round++) {
+        Mixer::Block block;
+        randomize(block, gen);
+        const unsigned count = round % (Mixer::BLOCK + 1);
+        const int32_t left = round == 0 ? 0x3fff : volume(gen);
+        const int32_t right = volume(gen);
+        Mixer::Block vector = block, scalar = block;
+        Mixer::envelope(vector, count);
+        Mixer::envelope(scalar, count, true);
+        int32_t sums[4][Mixer::BLOCK] = {};
+        Mixer::pan(vector, count, left, right, sums[0], sums[1]);
+        Mixer::pan(scalar, count, left, right, sums[2], sums[3], true);
+        for (unsigned i = 0; i < count; i++) {
+            const int32_t sample = (block.envelope[i] * block.samples[i]) / 1023;
+            ASSERT_EQ(scalar.samples[i], sample) << "round " << round << ", sample " << i;
+            ASSERT_EQ(vector.samples[i], sample) << "round " << round << ", sample " << i;
+            for (unsigned side = 0; side < 4; side += 2) {
+                ASSERT_EQ(sums[side][i], (sample * left) / 0x4000L) << "round " << round << ", sample " << i;
+                ASSERT_EQ(sums[side + 1][i], (sample * right) / 0x4000L) << "round " << round << ", sample " << i;
+            }
+        }
+        for (unsigned i = count; i < Mixer::BLOCK; i++) {
+            ASSERT_EQ(vector.samples[i], block.samples[i]);
+            for (unsigned side = 0; side < 4; side++) ASSERT_EQ(sums[side][i], 0);
+        }
+    }
+}
+
+namespace {
+
+constexpr unsigned VOICES = 24;
+
+// A voice, and what stepping it through a block gave: the mixer's input. Stepping itself, the
+// decoding, pitch and envelope, is the same code for both mixers, and isn't in the picture.
+struct Voice {
+    bool on;
+    bool noise;
+    int fmod;  // 0: none, 1: modulated by the previous voice, 2: modulates the next one
+    bool mute;
+    bool reverb;
+    int32_t left, right;
+    // How many samples it played before hitting its stop sign, the whole block if it didn't.
+    unsigned ns;
+    int32_t taps[4][Mixer::BLOCK];
+    int32_t phase[Mixer::BLOCK];
+    int32_t raw[Mixer::BLOCK];
+    int32_t envelope[Mixer::BLOCK];
+};
+
+struct Corpus {
+    int interpolation;
+    bool capture;
+    unsigned count;
+    Voice voices[VOICES];
+};
+
+// Everything the mixer leaves behind.
+struct State {
+    int32_t sumLeft[Mixer::BLOCK] = {};
+    int32_t sumRight[Mixer::BLOCK] = {};
+    int32_t fmod[Mixer::BLOCK] = {};
+    // The decode buffers of voices 1 and 3, with some room for the stopped voices' overrun.
+    uint16_t capture[2][0x200 + Mixer::BLOCK] = {};
+    int32_t captureIndex[2] = {};
+    int32_t sends[VOICES][Mixer::BLOCK] = {};
+    int32_t sval[VOICES] = {};
+
+    bool operator==(const State &other) const { return memcmp(this, &other, sizeof(State)) == 0; }
+};
+
+void randomize(Corpus &corpus, std::mt19937 &gen) {
+    auto pick = [&gen](int min, int max) { return std::uniform_int_distribution<int>(min, max)(gen); };
+    corpus.interpolation = pick(0, 3);
+    corpus.capture = pick(0, 3) != 0;
+    corpus.count = pick(0, 3) == 0 ? pick(1, 45) : 45;
+    for (unsigned ch = 0; ch < VOICES; ch++) {
+        auto &voice = corpus.voices[ch];
+        voice.on = pick(0, 7) != 0;
+        voice.noise = pick(0, 5) == 0;
+        voice.fmod = 0;
+        voice.mute = pick(0, 9) == 0;
+        voice.reverb = pick(0, 2) == 0;
+        voice.left = pick(0, 4) == 0 ? 0x3fff : pick(0, 0x3fff);
+        voice.right = pick(0, 0x3fff);
+        voice.ns = pick(0, 4) == 0 ? pick(0, corpus.count) : corpus.count;
+        for (unsigned i = 0; i < Mixer::BLOCK; i++) {
+            for (unsigned k = 0; k < 4; k++) voice.taps[k][i] = pick(-32767, 32767);
+            voice.phase[i] = pick(0, 0xffff);
+            voice.raw[i] = pick(-32768, 32767);
+            voice.envelope[i] = pick(0, 3) == 0 ? 1023 : pick(0, 1023);
+        }
+    }
+    // FModOn makes pairs: the voice before a modulated one is its source.
+    for (unsigned ch = 1; ch < VOICES; ch++) {
+        if (pick(0, 5) || corpus.voices[ch - 1].fmod) continue;
+        corpus.voices[ch].fmod = 1;
+        corpus.voices[ch - 1].fmod = 2;
+    }
+}
+
+// The part of stepping which touches the mixer's state: a modulated voice consumes the
+// modulation of the samples where there was any.
+void consumeModulation(const Voice &voice, State &state) {
+    if (voice.fmod != 1) return;
+    for (unsigned ns = 0; ns < voice.ns; ns++) state.fmod[ns] = 0;
+}
+
+// The per voice and per sample loop the block mixer replaced.
+void originalMix(const Corpus &corpus, State &state) {
+    for (unsigned ch = 0; ch < VOICES; ch++) {
+        const auto &voice = corpus.voices[ch];
+        if (!voice.on) continue;
+        consumeModulation(voice, state);
+        const bool captured = corpus.capture && (ch == 1 || ch == 3);
+        auto &capture = state.capture[ch == 1 ? 0 : 1];
+        auto &index = state.captureIndex[ch == 1 ? 0 : 1];
+        auto &sval = state.sval[ch];
+        unsigned ns = 0;
+        for (; ns < voice.ns; ns++) {
+            Mixer::Block block;
+            for (unsigned k = 0; k < 4; k++) block.taps[k][ns] = voice.taps[k][ns];
+            block.phase[ns] = voice.phase[ns];
+            int fa = voice.raw[ns];
+            if (corpus.interpolation >= 2 && !voice.noise && voice.fmod != 2) {
+                fa = corpus.interpolation == 3 ? originalCubic(block, ns) : originalGauss(block, ns);
+            }
+
+            int32_t mixedSample = (voice.envelope[ns] * fa) / 1023;
+            sval = mixedSample;
+
+            mixedSample = std::min(0xFFFF, std::max(-0xFFFF, mixedSample));
+            if (captured) {
+                capture[index] = mixedSample;
+                index = (index + 1) % 0x200;
+            }
+
+            if (voice.fmod == 2) {
+                state.fmod[ns] = sval;
+            } else {
+                if (voice.mute) {
+                    sval = 0;
+                } else {
+                    state.sumLeft[ns] += (sval * voice.left) / 0x4000L;
+                    state.sumRight[ns] += (sval * voice.right) / 0x4000L;
+                }
+                if (voice.reverb) state.sends[ch][ns] = sval;
+            }
+        }
+        if (ns < corpus.count && captured) {
+            for (unsigned c = ns; c < corpus.count; c++) capture[index + c] = 0;
+            index = (index + (corpus.count - ns)) % 0x200;
+        }
+    }
+}
+
+void blockMix(const Corpus &corpus, State &state, bool forceScalar) {
+    for (unsigned ch = 0; ch < VOICES; ch++) {
+        const auto &voice = corpus.voices[ch];
+        if (!voice.on) continue;
+        consumeModulation(voice, state);
+        const bool interpolated = corpus.interpolation >= 2 && !voice.noise && voice.fmod != 2;
+        Mixer::Block block;
+        for (unsigned ns = 0; ns < voice.ns; ns++) {
+            if (interpolated) {
+                for (unsigned k = 0; k < 4; k++) block.taps[k][ns] = voice.taps[k][ns];
+                block.phase[ns] = voice.phase[ns];
+            } else {
+                block.samples[ns] = voice.raw[ns];
+            }
+            block.envelope[ns] = voice.envelope[ns];
+        }
+
+        Mixer::Voice mixed;
+        mixed.interpolation = interpolated ? corpus.interpolation : 0;
+        mixed.fmodSource = voice.fmod == 2;
+        mixed.mute = voice.mute;
+        mixed.left = voice.left;
+        mixed.right = voice.right;
+        Mixer::Outputs outputs;
+        outputs.sumLeft = state.sumLeft;
+        outputs.sumRight = state.sumRight;
+        outputs.fmod = state.fmod;
+        outputs.reverb = voice.reverb ? state.sends[ch] : nullptr;
+        if (corpus.capture && (ch == 1 || ch == 3)) {
+            outputs.capture = state.capture[ch == 1 ? 0 : 1];
+            outputs.captureIndex = &state.captureIndex[ch == 1 ? 0 : 1];
+        }
+        Mixer::voice(block, voice.ns, corpus.count, mixed, outputs, state.sval[ch], forceScalar);
+    }
+}
+
+}  // namespace
+
+TEST(SPUMixer, WholeMixerMatchesOriginal) {
+    std::mt19937 gen(9012);
+    for (unsigned round = 0; round < 500; round++) {
+        auto corpus = std::make_unique<Corpus>();
+        randomize(*corpus, gen);
+        // Whatever the previous blocks left behind.
+        State initial;
+        std::uniform_int_distribution<int32_t> sample(-32767, 32767);
+        for (unsigned i = 0; i < Mixer::BLOCK; i++) initial.fmod[i] = sample(gen);
+        for (unsigned ch = 0; ch < VOICES; ch++) initial.sval[ch] = sample(gen);
+        for (auto &buffer : initial.capture) {
+            for (auto &word : buffer) word = sample(gen);
+        }
+        initial.captureIndex[0] = std::uniform_int_distribution<int32_t>(0, 0x1ff)(gen);
+        initial.captureIndex[1] = round % 2 ? 0x1ff : initial.captureIndex[0];
+
+        auto original = std::make_unique<State>(initial);
+        auto vector = std::make_unique<State>(initial);
+        auto scalar = std::make_unique<State>(initial);
+        originalMix(*corpus, *original);
+        blockMix(*corpus, *vector, false);
+        blockMix(*corpus, *scalar, true);
+
+        for (unsigned i = 0; i < Mixer::BLOCK; i++) {
+            ASSERT_EQ(vector->sumLeft[i], original->sumLeft[i]) << "round " << round << ", sample " << i;
+            ASSERT_EQ(vector->sumRight[i], original->sumRight[i]) << "round " << round << ", sample " << i;
+            ASSERT_EQ(vector->fmod[i], original->fmod[i]) << "round " << round << ", sample " << i;
+        }
+        for (unsigned i = 0; i < 0x200 + Mixer::BLOCK; i++) {
+            ASSERT_EQ(vector->capture[0][i], original->capture[0][i]) << "round " << round << ", voice 1 at " << i;
+            ASSERT_EQ(vector->capture[1][i], original->capture[1][i]) << "round " << round << ", voice 3 at " << i;
+        }
+        for (unsigned ch = 0; ch < VOICES; ch++) {
+            ASSERT_EQ(vector->sval[ch], original->sval[ch]) << "round " << round << ", voice " << ch;
+            for (unsigned i = 0; i < Mixer::BLOCK; i++) {
+                ASSERT_EQ(vector->sends[ch][i], original->sends[ch][i])
+                    << "round " << round << ", voice " << ch << ", sample " << i;
+            }
+        }
+        ASSERT_TRUE(*vector == *original) << "round " << round;
+        ASSERT_TRUE(*scalar == *original) << "round " << round;
+    }
+}
@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "spu/ratecontrol.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::SPU::RateControl;
+
+TEST(RateControl, PassesThroughAtUnity) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> sample(-32768, 32767);
+    std::vector<int16_t> input(20000 * 2);
+    for (auto &s : input) s = sample(gen);
+
+    RateControl rateControl;
+    std::vector<int16_t> output, chunk;
+    for (size_t frame = 0, size = 1; frame < input.size() / 2; frame += size, size = (size * 7) % 300 + 1) {
+        size = std::min(size, input.size() / 2 - frame);
+        rateControl.process(input.data() + frame * 2, size, chunk);
+        output.insert(output.end(), chunk.begin(), chunk.end());
+    }
+    // The filter holds back the frames it needs to see past.
+    ASSERT_EQ(output.size(), input.size() - RateControl::TAPS);
+    for (size_t i = 0; i < output.size(); i++) ASSERT_EQ(output[i], input[i]) << "sample " << i;
+}
+
+TEST(RateControl, Resamples) {
+    constexpr double FREQUENCY = 1000.0;
+    constexpr double AMPLITUDE = 10000.0;
+    const double pi = std::acos(-1.0);
+    std::vector<int16_t> input;
+    for (unsigned i = 0; i < 44100; i++) {
+        const int16_t s = std::lrint(AMPLITUDE * std::sin(2.0 * pi * FREQUENCY * i / 44100.0));
+        input.push_back(s);
+        input.push_back(-s);
+    }
+
+    for (double ratio : {1.0 - RateControl::MAX_DEVIATION, 0.9987, 1.0023, 1.0 + RateControl::MAX_DEVIATION}) {
+        RateControl rateControl;
+        rateControl.setRatio(ratio);
+        std::vector<int16_t> output, chunk;
+        for (size_t frame = 0; frame < input.size() / 2; frame += 45) {
+            rateControl.process(input.data() + frame * 2, std::min<size_t>(45, input.size() / 2 - frame), chunk);
+            output.insert(output.end(), chunk.begin(), chunk.end());
+        }
+        const double expected = (input.size() / 2 - RateControl::TAPS / 2) * ratio;
+        EXPECT_NEAR(output.size() / 2, expected, 2.0) << "ratio " << ratio;
+        // Output frame n is the input at n / ratio, which is where the original sine is.
+        for (size_t n = 0; n < output.size() / 2; n++) {
+            const double s = AMPLITUDE * std::sin(2.0 * pi * FREQUENCY * (n / ratio) / 44100.0);
+            ASSERT_NEAR(output[n * 2 + 0], s, 4.0) << "ratio " << ratio << ", frame " << n;
+            ASSERT_NEAR(output[n * 2 + 1], -s, 4.0) << "ratio " << ratio << ", frame " << n;
+        }
+    }
+}
+
+TEST(RateControl, HoldsTheTarget) {
+    // A minute of audio, with the producer's clock off from the device's, pushing blocks of
+    // 45 frames, and the device pulling 256 frames at a time.
+    constexpr size_t TARGET = 1100;
+    constexpr unsigned BLOCK = 45;
+    constexpr unsigned PERIOD = 256;
+    constexpr unsigned SECONDS = 60;
+    const std::vector<int16_t> silence(BLOCK * 2);
+
+    for (double drift : {-0.002, -0.0003, 0.0, 0.0005, 0.002}) {
+        RateControl rateControl;
+        std::vector<int16_t> chunk;
+        size_t buffered = 0;
+        double produced = 0.0;
+        unsigned underruns = 0;
+        size_t lowest = TARGET, highest = TARGET;
+        for (unsigned t = 0; t < 44100 * SECONDS; t++) {
+            produced += 1.0 + drift;
+            if (produced >= BLOCK) {
+                produced -= BLOCK;
+                rateControl.update(buffered, TARGET);
+                buffered += rateControl.process(silence.data(), BLOCK, chunk);
+            }
+            if ((t % PERIOD) == (PERIOD - 1)) {
+                const bool settled = t > 44100 * 5;
+                if (buffered < PERIOD) {
+                    if (settled) underruns++;
+                    buffered = 0;
+                } else {
+                    buffered -= PERIOD;
+                }
+                if (settled) {
+                    lowest = std::min(lowest, buffered);
+                    highest = std::max(highest, buffered);
+                }
+            }
+        }
+        EXPECT_EQ(underruns, 0) << "drift " << drift;
+        EXPECT_GT(lowest, TARGET / 4) << "drift " << drift;
+        EXPECT_LT(highest, TARGET * 7 / 4) << "drift " << drift;
+        EXPECT_NEAR(rateControl.ratio(), 1.0 - drift, 0.0005) << "drift " << drift;
+    }
+}
+
+TEST(RateControl, PacingHoldsTheTarget) {
+    // The emulation loop, running infinitely fast, and only held back by the frame pacing, against
+    // either the device itself, or a null device whose clock is off from it. The SPU produces
+    // blocks of 45 frames, and the device pulls 256 frames at a time.
+    constexpr uint32_t TARGET = 1100;
+    constexpr unsigned BLOCK = 45;
+    constexpr unsigned PERIOD = 256;
+    constexpr unsigned SECONDS = 60;
+    const std::vector<int16_t> silence(BLOCK * 2);
+
+    for (double drift : {0.0, -0.001, 0.0005, 0.001}) {
+        RateControl rateControl;
+        std::vector<int16_t> chunk;
+        uint32_t emulated = 0, consumed = 0, paced = 0;
+        double pacingClock = 0.0;
+        size_t buffered = 0;
+        unsigned underruns = 0;
+        double total = 0.0;
+        unsigned samples = 0;
+        for (unsigned t = 0; t < 44100 * SECONDS; t++) {
+            uint32_t goal;
+            while (!RateControl::pacingGoal(emulated, paced, TARGET, goal)) {
+                emulated += BLOCK;
+                rateControl.update(buffered, TARGET);
+                buffered += rateControl.process(silence.data(), BLOCK, chunk);
+            }
+            // The emulation is always just past the target ahead of what paces it.
+            ASSERT_GT(emulated - paced, TARGET);
+            ASSERT_LE(emulated - paced, TARGET + BLOCK);
+            ASSERT_EQ(goal, emulated - TARGET);
+            pacingClock += 1.0 + drift;
+            const bool settled = t > 44100 * 10;
+            if (settled) {
+                total += buffered;
+                samples++;
+            }
+            if ((t % PERIOD) != (PERIOD - 1)) continue;
+
+            if (buffered < PERIOD) {
+                if (settled) underruns++;
+                buffered = 0;
+            } else {
+                buffered -= PERIOD;
+            }
+            consumed += PERIOD;
+            // The null device runs on its own clock; otherwise, the pacing follows the device.
+            paced = drift == 0.0 ? consumed : uint32_t(pacingClock);
+        }
+        // With a clock drift, the rate control settles a bit off the target, by the drift over the
+        // maximum deviation. The fill swings by a period around it, as the device pulls its frames
+        // all at once.
+        EXPECT_EQ(underruns, 0) << "drift " << drift;
+        const double expected = TARGET * (1.0 + drift / RateControl::MAX_DEVIATION);
+        EXPECT_NEAR(total / samples, expected, PERIOD) << "drift " << drift;
+        EXPECT_NEAR(rateControl.ratio(), 1.0 - drift, 0.0005) << "drift " << drift;
+    }
+}
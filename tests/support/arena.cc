@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include "support/arena.h"
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(Arena, AlignmentAndUsage) {
+    PCSX::Arena<1024> arena;
+    EXPECT_EQ(arena.used(), 0);
+    auto a = static_cast<uint8_t *>(arena.allocate(3, 1));
+    auto b = static_cast<uint64_t *>(arena.allocate(sizeof(uint64_t), alignof(uint64_t)));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(uint64_t), 0);
+    EXPECT_GE(reinterpret_cast<uint8_t *>(b), a + 3);
+    EXPECT_EQ(arena.used(), 3 + sizeof(uint64_t));
+    EXPECT_EQ(arena.reserved(), 1024);
+}
+
+TEST(Arena, BlocksDontOverlap) {
+    PCSX::Arena<1024> arena;
+    std::vector<std::pair<uint8_t *, size_t>> allocations;
+    for (unsigned i = 0; i < 500; i++) {
+        // Including some larger than a block.
+        const size_t size = (i % 50) == 0 ? 3000 : (i % 97) + 1;
+        auto p = static_cast<uint8_t *>(arena.allocate(size, 8));
+        std::memset(p, i & 0xff, size);
+        allocations.push_back({p, size});
+    }
+    for (unsigned i = 0; i < allocations.size(); i++) {
+        auto [p, size] = allocations[i];
+        for (size_t j = 0; j < size; j++) ASSERT_EQ(p[j], i & 0xff) << "allocation " << i;
+    }
+}
+
+TEST(Arena, ResetReusesBlocks) {
+    PCSX::Arena<1024> arena;
+    for (unsigned i = 0; i < 100; i++) arena.allocate(100);
+    const size_t reserved = arena.reserved();
+    for (unsigned round = 0; round < 10; round++) {
+        arena.reset();
+        EXPECT_EQ(arena.used(), 0);
+        for (unsigned i = 0; i < 100; i++) arena.allocate(100);
+    }
+    EXPECT_EQ(arena.reserved(), reserved);
+}
+
+TEST(Arena, Create) {
+    struct Point {
+        Point(int x, int y) : x(x), y(y) {}
+        int x, y;
+    };
+    PCSX::Arena<> arena;
+    auto p = arena.create<Point>(1, 2);
+    EXPECT_EQ(p->x, 1);
+    EXPECT_EQ(p->y, 2);
+    EXPECT_EQ(arena.used(), sizeof(Point));
+}
@@ -0,0 +1,88 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+
+#include "support/yuv.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using PCSX::YUV;
+
+namespace {
+
+struct Picture {
+    Picture(unsigned width, unsigned height)
+        : width(width), height(height), y(width * height), u(((width + 1) / 2) * ((height + 1) / 2)), v(u.size()) {}
+    YUV::Picture planes() {
+        return {{y.data(), u.data(), v.data()}, {int(width), int((width + 1) / 2), int((width + 1) / 2)}};
+    }
+    bool operator==(const Picture &other) const { return (y == other.y) && (u == other.u) && (v == other.v); }
+    unsigned width, height;
+    std::vector<uint8_t> y, u, v;
+};
+
+}  // namespace
+
+TEST(YUV, Colors) {
+    const uint16_t pixels[] = {0x0000, 0x0000, 0x7fff, 0x7fff, 0x0000, 0x0000, 0x7fff, 0x7fff};
+    Picture picture(4, 2);
+    YUV::convert15(pixels, 4, 4, 2, picture.planes());
+    EXPECT_EQ(picture.y[0], 16);
+    EXPECT_EQ(picture.y[2], 235);
+    EXPECT_EQ(picture.y[7], 235);
+    EXPECT_EQ(picture.u[0], 128);
+    EXPECT_EQ(picture.v[1], 128);
+
+    // Pure red, in both depths.
+    const uint8_t red24[] = {255, 0, 0, 255, 0, 0};
+    const uint16_t red15[] = {0x1f, 0x1f};
+    Picture red(2, 1);
+    YUV::convert24(red24, 6, 2, 1, red.planes());
+    EXPECT_EQ(red.y[0], 82);
+    EXPECT_EQ(red.u[0], 90);
+    EXPECT_EQ(red.v[0], 240);
+    Picture red2(2, 1);
+    YUV::convert15(red15, 2, 2, 1, red2.planes());
+    EXPECT_TRUE(red == red2);
+}
+
+TEST(YUV, MatchesScalar) {
+    std::mt19937 rng(42);
+    // Sizes the vectorized loops don't divide evenly, including the 24 bits 682 pixels wide mode.
+    const unsigned sizes[][2] = {{320, 240}, {368, 240}, {511, 7}, {682, 480}, {17, 3}, {1, 1}, {640, 479}};
+    for (auto [width, height] : sizes) {
+        std::vector<uint16_t> vram15(width * height);
+        for (auto &pixel : vram15) pixel = rng();
+        std::vector<uint8_t> vram24(width * height * 3);
+        for (auto &byte : vram24) byte = rng();
+
+        Picture a(width, height), b(width, height);
+        YUV::convert15(vram15.data(), width, width, height, a.planes());
+        YUV::convert15Scalar(vram15.data(), width, width, height, b.planes());
+        EXPECT_TRUE(a == b) << "15 bits " << width << "x" << height;
+
+        Picture c(width, height), d(width, height);
+        YUV::convert24(vram24.data(), width * 3, width, height, c.planes());
+        YUV::convert24Scalar(vram24.data(), width * 3, width, height, d.planes());
+        EXPECT_TRUE(c == d) << "24 bits " << width << "x" << height;
+    }
+}
@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string_view>
+#include <vector>
+
+#include "main/main.h"
+
+// Runs the emulator just long enough to feed a GPU capture through its GPU. Without any
+// other argument, this is the software renderer, without any UI. Any extra argument is
+// passed on to the emulator, such as -gpu-replay-loops to average the timings over several
+// passes, or -openglgpu to benchmark the OpenGL renderer, which needs the full UI.
+int main(int argc, char** argv) {
+    if ((argc < 2) || (strcmp(argv[1], "-h") == 0)) {
+        fprintf(stderr, "Usage: %s capture.gpu [-gpu-replay-loops count] [-openglgpu] [emulator arguments...]\n",
+                argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+
+    bool opengl = false;
+    for (int i = 2; i < argc; i++) {
+        if (std::string_view(argv[i]) == "-openglgpu") opengl = true;
+    }
+
+    std::vector<char*> args;
+    args.push_back(argv[0]);
+    args.push_back(const_cast<char*>("-testmode"));
+    if (!opengl) {
+        args.push_back(const_cast<char*>("-no-ui"));
+        args.push_back(const_cast<char*>("-softgpu"));
+    }
+    args.push_back(const_cast<char*>("-gpu-replay"));
+    args.push_back(argv[1]);
+    for (int i = 2; i < argc; i++) args.push_back(argv[i]);
+    args.push_back(nullptr);
+
+    return pcsxMain(args.size() - 1, args.data());
+}
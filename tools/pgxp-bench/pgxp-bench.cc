@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright (C) 2026 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "main/main.h"
+
+// Runs the same software through the interpreter with PGXP disabled, in memory only mode, and
+// in full mode, one after the other, each time for the same number of frames after the same
+// warmup. Each run prints how long its frames took. The arguments are passed on to the emulator,
+// so they need to point it at something to run, such as -bios, -loadexe or -iso, and may override
+// the number of frames with -bench-frames or -bench-warmup.
+int main(int argc, char** argv) {
+    if ((argc < 2) || (strcmp(argv[1], "-h") == 0)) {
+        fprintf(stderr,
+                "Usage: %s [-bench-frames count] [-bench-warmup count] -bios bios.bin [-loadexe file.exe | -iso "
+                "file.cue] [emulator arguments...]\n",
+                argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+
+    bool frames = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string_view(argv[i]) == "-bench-frames") frames = true;
+    }
+
+    for (int mode = 0; mode <= 2; mode++) {
+        std::string pgxpMode = std::to_string(mode);
+        std::vector<char*> args;
+        args.push_back(argv[0]);
+        args.push_back(const_cast<char*>("-testmode"));
+        args.push_back(const_cast<char*>("-no-ui"));
+        args.push_back(const_cast<char*>("-run"));
+        args.push_back(const_cast<char*>("-interpreter"));
+        args.push_back(const_cast<char*>("-softgpu"));
+        args.push_back(const_cast<char*>("-audio-headless"));
+        if (!frames) {
+            args.push_back(const_cast<char*>("-bench-frames"));
+            args.push_back(const_cast<char*>("600"));
+        }
+        args.push_back(const_cast<char*>("-pgxp-mode"));
+        args.push_back(pgxpMode.data());
+        for (int i = 1; i < argc; i++) args.push_back(argv[i]);
+        args.push_back(nullptr);
+
+        int ret = pcsxMain(args.size() - 1, args.data());
+        if (ret != 0) return ret;
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/***************************************************************************
+ *   Copyright (C) 2022 PCSX-Redux authors                                 *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.           *
+ ***************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "gpu/soft/blit.h"
+
+using PCSX::SoftGPU::VRAMBlit;
+
+namespace {
+
+constexpr int WIDTH = VRAMBlit::WIDTH;
+constexpr int HEIGHT = VRAMBlit::HEIGHT;
+
+uint16_t blend(uint16_t dest, uint16_t src, VRAMBlit::Mask mask) {
+    return (mask.check && (dest & 0x8000)) ? dest : (src | mask.set);
+}
+
+// The pixel by pixel versions, as the software GPU used to do them, for comparison.
+void fillPixels(uint16_t *vram, int x, int y, int w, int h, uint16_t color) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) vram[(y + j) * WIDTH + x + i] = color;
+    }
+}
+
+void copyPixels(uint16_t *vram, int srcX, int srcY, int destX, int destY, int w, int h, VRAMBlit::Mask mask) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            uint16_t &dest = vram[((destY + j) & (HEIGHT - 1)) * WIDTH + ((destX + i) & (WIDTH - 1))];
+            dest = blend(dest, vram[((srcY + j) & (HEIGHT - 1)) * WIDTH + ((srcX + i) & (WIDTH - 1))], mask);
+        }
+    }
+}
+
+void uploadPixels(uint16_t *vram, int x, int y, int w, int h, const uint16_t *pixels, VRAMBlit::Mask mask) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            uint16_t &dest = vram[((y + j) & (HEIGHT - 1)) * WIDTH + ((x + i) & (WIDTH - 1))];
+            dest = blend(dest, *pixels++, mask);
+        }
+    }
+}
+
+double time(unsigned iterations, const std::function<void()> &op) {
+    using Clock = std::chrono::steady_clock;
+    op();
+    const auto start = Clock::now();
+    for (unsigned i = 0; i < iterations; i++) op();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / iterations;
+}
+
+void report(const char *name, size_t pixels, double before, double after) {
+    const double bytes = pixels * sizeof(uint16_t);
+    std::printf("%-40s %8.4f ms -> %8.4f ms, %6.2fx, %6.2f GB/s\n", name, before, after, before / after,
+                bytes / (after * 1e6));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const unsigned iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 1000;
+    std::vector<uint16_t> vram(WIDTH * HEIGHT);
+    std::vector<uint16_t> movie(WIDTH * HEIGHT);
+    std::mt19937 rng(1234);
+    for (auto &pixel : vram) pixel = rng();
+    for (auto &pixel : movie) pixel = rng();
+    const VRAMBlit::Mask none = {};
+    const VRAMBlit::Mask masked = {true, 0x8000};
+
+    report("full screen clear, 640x480", 640 * 480,
+           time(iterations, [&]() { fillPixels(vram.data(), 0, 0, 640, 480, 0x1234); }), time(iterations, [&]() {
+               for (int y = 0; y < 480; y++) VRAMBlit::fillSpan(vram.data() + y * WIDTH, 640, 0x1234);
+           }));
+
+    report("15 bits upload, 640x480", 640 * 480,
+           time(iterations, [&]() { uploadPixels(vram.data(), 0, 0, 640, 480, movie.data(), none); }),
+           time(iterations, [&]() { VRAMBlit::upload(vram.data(), 0, 0, 640, 480, movie.data(), none); }));
+    // A 320x240 24 bits movie frame is 480 halfwords wide.
+    report("24 bits movie upload, 320x240", 480 * 240,
+           time(iterations, [&]() { uploadPixels(vram.data(), 0, 0, 480, 240, movie.data(), none); }),
+           time(iterations, [&]() { VRAMBlit::upload(vram.data(), 0, 0, 480, 240, movie.data(), none); }));
+    report("15 bits upload, 640x480, masked", 640 * 480,
+           time(iterations, [&]() { uploadPixels(vram.data(), 0, 0, 640, 480, movie.data(), masked); }),
+           time(iterations, [&]() { VRAMBlit::upload(vram.data(), 0, 0, 640, 480, movie.data(), masked); }));
+
+    report("VRAM copy, 320x240", 320 * 240,
+           time(iterations, [&]() { copyPixels(vram.data(), 0, 0, 640, 256, 320, 240, none); }),
+           time(iterations, [&]() { VRAMBlit::copy(vram.data(), 0, 0, 640, 256, 320, 240, none); }));
+    report("VRAM copy, 320x240, masked", 320 * 240,
+           time(iterations, [&]() { copyPixels(vram.data(), 0, 0, 640, 256, 320, 240, masked); }),
+           time(iterations, [&]() { VRAMBlit::copy(vram.data(), 0, 0, 640, 256, 320, 240, masked); }));
+    report("VRAM copy, 320x240, wrapping", 320 * 240,
+           time(iterations, [&]() { copyPixels(vram.data(), 0, 0, 900, 400, 320, 240, none); }),
+           time(iterations, [&]() { VRAMBlit::copy(vram.data(), 0, 0, 900, 400, 320, 240, none); }));
+
+    // So that none of the above gets optimized away.
+    unsigned checksum = 0;
+    for (auto pixel : vram) checksum = checksum * 31 + pixel;
+    std::printf("VRAM checksum: %08x\n", checksum);
+    return 0;
+}